@@ -19,6 +19,17 @@
 
 namespace OHOS {
 namespace Notification {
+namespace {
+enum BinaryTag : uint32_t {
+    TAG_KEY = 1,
+    TAG_NAME = 2,
+    TAG_PIXEL_MAP = 3,
+    TAG_URI = 4,
+    TAG_IS_MACHINE = 5,
+    TAG_IS_USER_IMPORTANT = 6,
+};
+}  // namespace
+
 MessageUser::MessageUser() : uri_("")
 {}
 
@@ -151,6 +162,66 @@ MessageUser *MessageUser::FromJson(const nlohmann::json &jsonObject)
     return messageUser;
 }
 
+bool MessageUser::ToBinary(NotificationBinaryWriter &writer) const
+{
+    writer.WriteString(TAG_KEY, key_);
+    writer.WriteString(TAG_NAME, name_);
+    writer.WriteString(TAG_PIXEL_MAP, AnsImageUtil::PackImage(pixelMap_));
+    writer.WriteString(TAG_URI, uri_.ToString());
+    writer.WriteBool(TAG_IS_MACHINE, isMachine_);
+    writer.WriteBool(TAG_IS_USER_IMPORTANT, isUserImportant_);
+
+    return true;
+}
+
+MessageUser *MessageUser::FromBinary(NotificationBinaryReader &reader)
+{
+    MessageUser *messageUser = new (std::nothrow) MessageUser();
+    if (messageUser == nullptr) {
+        ANS_LOGE("Failed to create messageUse instance");
+        return nullptr;
+    }
+
+    uint32_t tag = 0;
+    std::string value;
+    while (reader.Next(tag)) {
+        switch (tag) {
+            case TAG_KEY:
+                reader.ReadString(messageUser->key_);
+                break;
+            case TAG_NAME:
+                reader.ReadString(messageUser->name_);
+                break;
+            case TAG_PIXEL_MAP:
+                if (reader.ReadString(value)) {
+                    messageUser->pixelMap_ = AnsImageUtil::UnPackImage(value);
+                }
+                break;
+            case TAG_URI:
+                if (reader.ReadString(value)) {
+                    messageUser->uri_ = Uri(value);
+                }
+                break;
+            case TAG_IS_MACHINE:
+                reader.ReadBool(messageUser->isMachine_);
+                break;
+            case TAG_IS_USER_IMPORTANT:
+                reader.ReadBool(messageUser->isUserImportant_);
+                break;
+            default:
+                reader.Skip();
+                break;
+        }
+    }
+    if (reader.HasError()) {
+        ANS_LOGE("Invalid binary of messageUser");
+        delete messageUser;
+        return nullptr;
+    }
+
+    return messageUser;
+}
+
 bool MessageUser::Marshalling(Parcel &parcel) const
 {
     if (!parcel.WriteString(key_)) {
@@ -196,7 +267,7 @@ bool MessageUser::Marshalling(Parcel &parcel) const
     }
 
     if (valid) {
-        if (!parcel.WriteParcelable(pixelMap_.get())) {
+        if (!AnsImageUtil::WriteImage(parcel, pixelMap_)) {
             ANS_LOGE("Failed to write pixelMap");
             return false;
         }
@@ -224,7 +295,7 @@ bool MessageUser::ReadFromParcel(Parcel &parcel)
 
     bool valid = parcel.ReadBool();
     if (valid) {
-        pixelMap_ = std::shared_ptr<Media::PixelMap>(parcel.ReadParcelable<Media::PixelMap>());
+        pixelMap_ = AnsImageUtil::ReadImage(parcel);
         if (!pixelMap_) {
             ANS_LOGE("Failed to read pixelMap");
             return false;
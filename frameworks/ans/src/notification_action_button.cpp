@@ -22,6 +22,15 @@
 
 namespace OHOS {
 namespace Notification {
+namespace {
+enum BinaryTag : uint32_t {
+    TAG_ICON = 1,
+    TAG_TITLE = 2,
+    TAG_WANT_AGENT = 3,
+    TAG_EXTRAS = 4,
+};
+}  // namespace
+
 std::shared_ptr<NotificationActionButton> NotificationActionButton::Create(const std::shared_ptr<Media::PixelMap> &icon,
     const std::string &title, const std::shared_ptr<AbilityRuntime::WantAgent::WantAgent> &wantAgent,
     const std::shared_ptr<AAFwk::WantParams> &extras, NotificationConstant::SemanticActionButton semanticActionButton,
@@ -272,6 +281,68 @@ NotificationActionButton *NotificationActionButton::FromJson(const nlohmann::jso
     return pButton;
 }
 
+bool NotificationActionButton::ToBinary(NotificationBinaryWriter &writer) const
+{
+    writer.WriteString(TAG_ICON, AnsImageUtil::PackImage(icon_));
+    writer.WriteString(TAG_TITLE, title_);
+    writer.WriteString(
+        TAG_WANT_AGENT, wantAgent_ ? AbilityRuntime::WantAgent::WantAgentHelper::ToString(wantAgent_) : "");
+
+    std::string extrasStr;
+    if (extras_) {
+        AAFwk::WantParamWrapper wWrapper(*extras_);
+        extrasStr = wWrapper.ToString();
+    }
+    writer.WriteString(TAG_EXTRAS, extrasStr);
+
+    return true;
+}
+
+NotificationActionButton *NotificationActionButton::FromBinary(NotificationBinaryReader &reader)
+{
+    auto pButton = new (std::nothrow) NotificationActionButton();
+    if (pButton == nullptr) {
+        ANS_LOGE("Failed to create actionButton instance");
+        return nullptr;
+    }
+
+    uint32_t tag = 0;
+    std::string value;
+    while (reader.Next(tag)) {
+        switch (tag) {
+            case TAG_ICON:
+                if (reader.ReadString(value)) {
+                    pButton->icon_ = AnsImageUtil::UnPackImage(value);
+                }
+                break;
+            case TAG_TITLE:
+                reader.ReadString(pButton->title_);
+                break;
+            case TAG_WANT_AGENT:
+                if (reader.ReadString(value)) {
+                    pButton->wantAgent_ = AbilityRuntime::WantAgent::WantAgentHelper::FromString(value);
+                }
+                break;
+            case TAG_EXTRAS:
+                if (reader.ReadString(value) && !value.empty()) {
+                    AAFwk::WantParams params = AAFwk::WantParamWrapper::ParseWantParams(value);
+                    pButton->extras_ = std::make_shared<AAFwk::WantParams>(params);
+                }
+                break;
+            default:
+                reader.Skip();
+                break;
+        }
+    }
+    if (reader.HasError()) {
+        ANS_LOGE("Invalid binary of actionButton");
+        delete pButton;
+        return nullptr;
+    }
+
+    return pButton;
+}
+
 bool NotificationActionButton::Marshalling(Parcel &parcel) const
 {
     if (!parcel.WriteString(title_)) {
@@ -303,7 +374,7 @@ bool NotificationActionButton::Marshalling(Parcel &parcel) const
     }
 
     if (valid) {
-        if (!parcel.WriteParcelable(icon_.get())) {
+        if (!AnsImageUtil::WriteImage(parcel, icon_)) {
             ANS_LOGE("Failed to write icon");
             return false;
         }
@@ -379,7 +450,7 @@ bool NotificationActionButton::ReadFromParcel(Parcel &parcel)
 
     valid = parcel.ReadBool();
     if (valid) {
-        icon_ = std::shared_ptr<Media::PixelMap>(parcel.ReadParcelable<Media::PixelMap>());
+        icon_ = AnsImageUtil::ReadImage(parcel);
         if (!icon_) {
             ANS_LOGE("Failed to read icon");
             return false;
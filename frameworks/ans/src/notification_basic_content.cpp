@@ -18,6 +18,15 @@
 
 namespace OHOS {
 namespace Notification {
+namespace {
+// The tags from 16 are left to the fields of the subclasses.
+enum BinaryTag : uint32_t {
+    TAG_TEXT = 1,
+    TAG_TITLE = 2,
+    TAG_ADDITIONAL_TEXT = 3,
+};
+}  // namespace
+
 NotificationBasicContent::~NotificationBasicContent()
 {}
 
@@ -86,6 +95,32 @@ void NotificationBasicContent::ReadFromJson(const nlohmann::json &jsonObject)
     }
 }
 
+bool NotificationBasicContent::ToBinary(NotificationBinaryWriter &writer) const
+{
+    writer.WriteString(TAG_TEXT, text_);
+    writer.WriteString(TAG_TITLE, title_);
+    writer.WriteString(TAG_ADDITIONAL_TEXT, additionalText_);
+
+    return true;
+}
+
+bool NotificationBasicContent::ReadFromBinary(uint32_t tag, NotificationBinaryReader &reader)
+{
+    switch (tag) {
+        case TAG_TEXT:
+            reader.ReadString(text_);
+            return true;
+        case TAG_TITLE:
+            reader.ReadString(title_);
+            return true;
+        case TAG_ADDITIONAL_TEXT:
+            reader.ReadString(additionalText_);
+            return true;
+        default:
+            return false;
+    }
+}
+
 bool NotificationBasicContent::Marshalling(Parcel &parcel) const
 {
     if (!parcel.WriteString(text_)) {
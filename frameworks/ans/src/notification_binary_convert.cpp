@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "notification_binary_convert.h"
+
+namespace OHOS {
+namespace Notification {
+namespace {
+constexpr uint32_t WIRE_TYPE_VARINT = 0;
+constexpr uint32_t WIRE_TYPE_LENGTH_DELIMITED = 1;
+constexpr uint32_t WIRE_TYPE_BITS = 1;
+constexpr uint32_t WIRE_TYPE_MASK = (1 << WIRE_TYPE_BITS) - 1;
+constexpr uint32_t VARINT_PAYLOAD_BITS = 7;
+constexpr uint8_t VARINT_PAYLOAD_MASK = 0x7F;
+constexpr uint8_t VARINT_CONTINUATION = 0x80;
+constexpr uint32_t VARINT_MAX_SHIFT = 63;
+constexpr uint32_t INT64_SIGN_SHIFT = 63;
+
+uint64_t ZigZagEncode(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> INT64_SIGN_SHIFT);
+}
+
+int64_t ZigZagDecode(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+}  // namespace
+
+constexpr uint8_t NotificationBinaryConverter::BINARY_MAGIC;
+constexpr uint32_t NotificationBinaryConverter::BINARY_VERSION;
+
+void NotificationBinaryWriter::WriteInt(uint32_t tag, int64_t value)
+{
+    WriteKey(tag, WIRE_TYPE_VARINT);
+    WriteVarint(ZigZagEncode(value));
+}
+
+void NotificationBinaryWriter::WriteBool(uint32_t tag, bool value)
+{
+    WriteKey(tag, WIRE_TYPE_VARINT);
+    WriteVarint(value ? 1 : 0);
+}
+
+void NotificationBinaryWriter::WriteString(uint32_t tag, std::string_view value)
+{
+    WriteKey(tag, WIRE_TYPE_LENGTH_DELIMITED);
+    WriteVarint(value.size());
+    data_.append(value.data(), value.size());
+}
+
+void NotificationBinaryWriter::WriteStrings(uint32_t tag, const std::vector<std::string> &values)
+{
+    for (auto &value : values) {
+        WriteString(tag, value);
+    }
+}
+
+bool NotificationBinaryWriter::WriteObject(uint32_t tag, const NotificationBinaryConvertionBase *object)
+{
+    if (object == nullptr) {
+        return true;
+    }
+
+    NotificationBinaryWriter objectWriter;
+    if (!object->ToBinary(objectWriter)) {
+        ANS_LOGE("Cannot convert the object to binary");
+        return false;
+    }
+    WriteString(tag, objectWriter.GetData());
+    return true;
+}
+
+const std::string &NotificationBinaryWriter::GetData() const
+{
+    return data_;
+}
+
+void NotificationBinaryWriter::Append(std::string_view data)
+{
+    data_.append(data.data(), data.size());
+}
+
+void NotificationBinaryWriter::WriteKey(uint32_t tag, uint32_t wireType)
+{
+    WriteVarint((static_cast<uint64_t>(tag) << WIRE_TYPE_BITS) | wireType);
+}
+
+void NotificationBinaryWriter::WriteVarint(uint64_t value)
+{
+    while (value > VARINT_PAYLOAD_MASK) {
+        data_.push_back(static_cast<char>((value & VARINT_PAYLOAD_MASK) | VARINT_CONTINUATION));
+        value >>= VARINT_PAYLOAD_BITS;
+    }
+    data_.push_back(static_cast<char>(value));
+}
+
+NotificationBinaryReader::NotificationBinaryReader(std::string_view data) : data_(data)
+{}
+
+bool NotificationBinaryReader::Next(uint32_t &tag)
+{
+    if (hasError_ || offset_ >= data_.size()) {
+        return false;
+    }
+
+    uint64_t key = 0;
+    if (!ReadVarint(key)) {
+        return false;
+    }
+    wireType_ = static_cast<uint32_t>(key & WIRE_TYPE_MASK);
+    tag = static_cast<uint32_t>(key >> WIRE_TYPE_BITS);
+    return true;
+}
+
+bool NotificationBinaryReader::ReadInt(int64_t &value)
+{
+    uint64_t rawValue = 0;
+    if (wireType_ != WIRE_TYPE_VARINT || !ReadVarint(rawValue)) {
+        return Fail();
+    }
+    value = ZigZagDecode(rawValue);
+    return true;
+}
+
+bool NotificationBinaryReader::ReadBool(bool &value)
+{
+    uint64_t rawValue = 0;
+    if (wireType_ != WIRE_TYPE_VARINT || !ReadVarint(rawValue)) {
+        return Fail();
+    }
+    value = (rawValue != 0);
+    return true;
+}
+
+bool NotificationBinaryReader::ReadString(std::string &value)
+{
+    std::string_view bytes;
+    if (!ReadString(bytes)) {
+        return false;
+    }
+    value.assign(bytes.data(), bytes.size());
+    return true;
+}
+
+bool NotificationBinaryReader::ReadString(std::string_view &value)
+{
+    if (wireType_ != WIRE_TYPE_LENGTH_DELIMITED || !ReadBytes(value)) {
+        return Fail();
+    }
+    return true;
+}
+
+bool NotificationBinaryReader::ReadStrings(std::vector<std::string> &values)
+{
+    std::string_view bytes;
+    if (!ReadString(bytes)) {
+        return false;
+    }
+    values.emplace_back(bytes.data(), bytes.size());
+    return true;
+}
+
+bool NotificationBinaryReader::ReadObject(NotificationBinaryReader &reader)
+{
+    std::string_view bytes;
+    if (!ReadString(bytes)) {
+        return false;
+    }
+    reader = NotificationBinaryReader(bytes);
+    return true;
+}
+
+bool NotificationBinaryReader::Skip()
+{
+    if (wireType_ == WIRE_TYPE_VARINT) {
+        uint64_t value = 0;
+        return ReadVarint(value) || Fail();
+    }
+
+    std::string_view bytes;
+    return ReadBytes(bytes) || Fail();
+}
+
+bool NotificationBinaryReader::HasError() const
+{
+    return hasError_;
+}
+
+bool NotificationBinaryReader::ReadVarint(uint64_t &value)
+{
+    value = 0;
+    for (uint32_t shift = 0; shift <= VARINT_MAX_SHIFT; shift += VARINT_PAYLOAD_BITS) {
+        if (offset_ >= data_.size()) {
+            return Fail();
+        }
+        auto byte = static_cast<uint8_t>(data_[offset_++]);
+        value |= static_cast<uint64_t>(byte & VARINT_PAYLOAD_MASK) << shift;
+        if ((byte & VARINT_CONTINUATION) == 0) {
+            return true;
+        }
+    }
+    return Fail();
+}
+
+bool NotificationBinaryReader::ReadBytes(std::string_view &value)
+{
+    uint64_t length = 0;
+    if (!ReadVarint(length)) {
+        return false;
+    }
+    if (length > data_.size() - offset_) {
+        return Fail();
+    }
+    value = data_.substr(offset_, length);
+    offset_ += length;
+    return true;
+}
+
+bool NotificationBinaryReader::Fail()
+{
+    hasError_ = true;
+    return false;
+}
+
+bool NotificationBinaryConverter::ConvertToBinaryString(
+    const NotificationBinaryConvertionBase *convertionBase, std::string &binaryString)
+{
+    if (convertionBase == nullptr) {
+        ANS_LOGE("Converter : Invalid base object");
+        return false;
+    }
+
+    // The header is the magic byte and the version as field 0, followed by the fields of the object.
+    NotificationBinaryWriter writer;
+    writer.Append(std::string_view(reinterpret_cast<const char *>(&BINARY_MAGIC), sizeof(BINARY_MAGIC)));
+    writer.WriteInt(0, BINARY_VERSION);
+    if (!convertionBase->ToBinary(writer)) {
+        ANS_LOGE("Converter : Cannot convert to binary");
+        return false;
+    }
+    binaryString = writer.GetData();
+
+    return true;
+}
+
+bool NotificationBinaryConverter::IsBinaryString(std::string_view str)
+{
+    return !str.empty() && (static_cast<uint8_t>(str.front()) == BINARY_MAGIC);
+}
+
+bool NotificationBinaryConverter::OpenBinaryString(std::string_view binaryString, NotificationBinaryReader &reader)
+{
+    if (!IsBinaryString(binaryString)) {
+        return false;
+    }
+
+    reader = NotificationBinaryReader(binaryString.substr(sizeof(BINARY_MAGIC)));
+    uint32_t tag = 0;
+    int64_t version = 0;
+    if (!reader.Next(tag) || (tag != 0) || !reader.ReadInt(version)) {
+        return false;
+    }
+    if ((version <= 0) || (version > BINARY_VERSION)) {
+        ANS_LOGE("Converter : Unsupported binary version %{public}lld", static_cast<long long>(version));
+        return false;
+    }
+
+    return true;
+}
+}  // namespace Notification
+}  // namespace OHOS
@@ -18,6 +18,13 @@
 
 namespace OHOS {
 namespace Notification {
+namespace {
+enum BinaryTag : uint32_t {
+    TAG_CONTENT_TYPE = 1,
+    TAG_CONTENT = 2,
+};
+}  // namespace
+
 NotificationContent::NotificationContent(const std::shared_ptr<NotificationNormalContent> &normalContent)
 {
     if (!normalContent) {
@@ -158,6 +165,64 @@ NotificationContent *NotificationContent::FromJson(const nlohmann::json &jsonObj
     return pContent;
 }
 
+bool NotificationContent::ToBinary(NotificationBinaryWriter &writer) const
+{
+    writer.WriteInt(TAG_CONTENT_TYPE, static_cast<int32_t>(contentType_));
+
+    if (!content_) {
+        ANS_LOGE("Invalid content. Cannot convert to binary.");
+        return false;
+    }
+
+    if (!writer.WriteObject(TAG_CONTENT, content_.get())) {
+        ANS_LOGE("Cannot convert content to binary");
+        return false;
+    }
+
+    return true;
+}
+
+NotificationContent *NotificationContent::FromBinary(NotificationBinaryReader &reader)
+{
+    auto pContent = new (std::nothrow) NotificationContent();
+    if (pContent == nullptr) {
+        ANS_LOGE("Failed to create NotificationContent instance");
+        return nullptr;
+    }
+
+    // The content is converted once its type is known, whatever the order of the fields.
+    bool hasContentType = false;
+    NotificationBinaryReader contentReader;
+    bool hasContent = false;
+    uint32_t tag = 0;
+    while (reader.Next(tag)) {
+        switch (tag) {
+            case TAG_CONTENT_TYPE:
+                hasContentType = reader.ReadInt(pContent->contentType_);
+                break;
+            case TAG_CONTENT:
+                hasContent = reader.ReadObject(contentReader);
+                break;
+            default:
+                reader.Skip();
+                break;
+        }
+    }
+    if (reader.HasError() || !hasContentType || !hasContent) {
+        ANS_LOGE("Incomplete NotificationContent binary. Cannot convert content from binary.");
+        delete pContent;
+        return nullptr;
+    }
+
+    if (!ConvertBinaryToContent(pContent, contentReader)) {
+        delete pContent;
+        pContent = nullptr;
+        return nullptr;
+    }
+
+    return pContent;
+}
+
 bool NotificationContent::Marshalling(Parcel &parcel) const
 {
     if (!parcel.WriteInt32(static_cast<int32_t>(contentType_))) {
@@ -284,5 +349,45 @@ bool NotificationContent::ConvertJsonToContent(NotificationContent *target, cons
 
     return true;
 }
+
+bool NotificationContent::ConvertBinaryToContent(NotificationContent *target, NotificationBinaryReader &reader)
+{
+    if (target == nullptr) {
+        ANS_LOGE("Invalid input parameter");
+        return false;
+    }
+
+    NotificationBasicContent *pBasicContent {nullptr};
+    switch (target->contentType_) {
+        case NotificationContent::Type::BASIC_TEXT:
+            pBasicContent = NotificationNormalContent::FromBinary(reader);
+            break;
+        case NotificationContent::Type::CONVERSATION:
+            pBasicContent = NotificationConversationalContent::FromBinary(reader);
+            break;
+        case NotificationContent::Type::LONG_TEXT:
+            pBasicContent = NotificationLongTextContent::FromBinary(reader);
+            break;
+        case NotificationContent::Type::MEDIA:
+            pBasicContent = NotificationMediaContent::FromBinary(reader);
+            break;
+        case NotificationContent::Type::MULTILINE:
+            pBasicContent = NotificationMultiLineContent::FromBinary(reader);
+            break;
+        case NotificationContent::Type::PICTURE:
+            pBasicContent = NotificationPictureContent::FromBinary(reader);
+            break;
+        default:
+            ANS_LOGE("Invalid contentType");
+            break;
+    }
+    if (pBasicContent == nullptr) {
+        ANS_LOGE("Parse content error!");
+        return false;
+    }
+    target->content_ = std::shared_ptr<NotificationBasicContent>(pBasicContent);
+
+    return true;
+}
 }  // namespace Notification
 }  // namespace OHOS
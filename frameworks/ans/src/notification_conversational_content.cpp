@@ -18,6 +18,15 @@
 
 namespace OHOS {
 namespace Notification {
+namespace {
+enum BinaryTag : uint32_t {
+    TAG_MESSAGE_USER = 16,
+    TAG_CONVERSATION_TITLE = 17,
+    TAG_IS_GROUP = 18,
+    TAG_MESSAGES = 19,
+};
+}  // namespace
+
 NotificationConversationalContent::NotificationConversationalContent(const MessageUser &messageUser)
     : messageUser_(messageUser)
 {}
@@ -174,6 +183,88 @@ NotificationConversationalContent *NotificationConversationalContent::FromJson(c
     return pContent;
 }
 
+bool NotificationConversationalContent::ToBinary(NotificationBinaryWriter &writer) const
+{
+    if (!NotificationBasicContent::ToBinary(writer)) {
+        ANS_LOGE("Cannot convert basicContent to binary");
+        return false;
+    }
+
+    if (!writer.WriteObject(TAG_MESSAGE_USER, &messageUser_)) {
+        ANS_LOGE("Cannot convert messageUser to binary");
+        return false;
+    }
+    writer.WriteString(TAG_CONVERSATION_TITLE, conversationTitle_);
+    writer.WriteBool(TAG_IS_GROUP, isGroup_);
+    for (auto &msg : messages_) {
+        if (!msg) {
+            continue;
+        }
+
+        if (!writer.WriteObject(TAG_MESSAGES, msg.get())) {
+            ANS_LOGE("Cannot convert conversationalMessage to binary");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+NotificationConversationalContent *NotificationConversationalContent::FromBinary(NotificationBinaryReader &reader)
+{
+    auto pContent = new (std::nothrow) NotificationConversationalContent();
+    if (pContent == nullptr) {
+        ANS_LOGE("Failed to create conversationalContent instance");
+        return nullptr;
+    }
+
+    uint32_t tag = 0;
+    NotificationBinaryReader objectReader;
+    while (reader.Next(tag)) {
+        switch (tag) {
+            case TAG_MESSAGE_USER:
+                if (reader.ReadObject(objectReader)) {
+                    std::unique_ptr<MessageUser> pUser(MessageUser::FromBinary(objectReader));
+                    if (pUser != nullptr) {
+                        pContent->messageUser_ = *pUser;
+                    }
+                }
+                break;
+            case TAG_CONVERSATION_TITLE:
+                reader.ReadString(pContent->conversationTitle_);
+                break;
+            case TAG_IS_GROUP:
+                reader.ReadBool(pContent->isGroup_);
+                break;
+            case TAG_MESSAGES: {
+                if (!reader.ReadObject(objectReader)) {
+                    break;
+                }
+                auto pMsg = NotificationConversationalMessage::FromBinary(objectReader);
+                if (pMsg == nullptr) {
+                    ANS_LOGE("Failed to parse message ");
+                    delete pContent;
+                    return nullptr;
+                }
+                pContent->messages_.emplace_back(pMsg);
+                break;
+            }
+            default:
+                if (!pContent->ReadFromBinary(tag, reader)) {
+                    reader.Skip();
+                }
+                break;
+        }
+    }
+    if (reader.HasError()) {
+        ANS_LOGE("Invalid binary of conversationalContent");
+        delete pContent;
+        return nullptr;
+    }
+
+    return pContent;
+}
+
 bool NotificationConversationalContent::Marshalling(Parcel &parcel) const
 {
     if (!NotificationBasicContent::Marshalling(parcel)) {
@@ -18,6 +18,16 @@
 
 namespace OHOS {
 namespace Notification {
+namespace {
+enum BinaryTag : uint32_t {
+    TAG_ARRIVED_TIME = 1,
+    TAG_TEXT = 2,
+    TAG_SENDER = 3,
+    TAG_URI = 4,
+    TAG_MIME_TYPE = 5,
+};
+}  // namespace
+
 NotificationConversationalMessage::NotificationConversationalMessage(
     const std::string &text, int64_t timestamp, const MessageUser &sender)
     : arrivedTime_(timestamp), text_(text), sender_(sender)
@@ -130,6 +140,69 @@ NotificationConversationalMessage *NotificationConversationalMessage::FromJson(c
     return pMessage;
 }
 
+bool NotificationConversationalMessage::ToBinary(NotificationBinaryWriter &writer) const
+{
+    writer.WriteInt(TAG_ARRIVED_TIME, arrivedTime_);
+    writer.WriteString(TAG_TEXT, text_);
+    if (!writer.WriteObject(TAG_SENDER, &sender_)) {
+        ANS_LOGE("Cannot convert sender to binary");
+        return false;
+    }
+    writer.WriteString(TAG_URI, uri_ ? uri_->ToString() : "");
+    writer.WriteString(TAG_MIME_TYPE, mimeType_);
+
+    return true;
+}
+
+NotificationConversationalMessage *NotificationConversationalMessage::FromBinary(NotificationBinaryReader &reader)
+{
+    auto pMessage = new (std::nothrow) NotificationConversationalMessage();
+    if (pMessage == nullptr) {
+        ANS_LOGE("Failed to create conversationalMessage instance");
+        return nullptr;
+    }
+
+    uint32_t tag = 0;
+    std::string value;
+    NotificationBinaryReader userReader;
+    while (reader.Next(tag)) {
+        switch (tag) {
+            case TAG_ARRIVED_TIME:
+                reader.ReadInt(pMessage->arrivedTime_);
+                break;
+            case TAG_TEXT:
+                reader.ReadString(pMessage->text_);
+                break;
+            case TAG_SENDER:
+                if (reader.ReadObject(userReader)) {
+                    std::unique_ptr<MessageUser> pUser(MessageUser::FromBinary(userReader));
+                    if (pUser != nullptr) {
+                        pMessage->sender_ = *pUser;
+                    }
+                }
+                break;
+            case TAG_URI:
+                if (reader.ReadString(value) && !value.empty()) {
+                    pMessage->uri_ = std::make_shared<Uri>(value);
+                }
+                break;
+            case TAG_MIME_TYPE:
+                reader.ReadString(pMessage->mimeType_);
+                break;
+            default:
+                reader.Skip();
+                break;
+        }
+    }
+    if (reader.HasError()) {
+        ANS_LOGE("Invalid binary of conversationalMessage");
+        delete pMessage;
+        return nullptr;
+    }
+
+    return pMessage;
+}
+
 bool NotificationConversationalMessage::Marshalling(Parcel &parcel) const
 {
     if (!parcel.WriteInt64(arrivedTime_)) {
@@ -18,6 +18,14 @@
 
 namespace OHOS {
 namespace Notification {
+namespace {
+enum BinaryTag : uint32_t {
+    TAG_IS_DISTRIBUTED = 1,
+    TAG_DEVICES_SUPPORT_DISPLAY = 2,
+    TAG_DEVICES_SUPPORT_OPERATE = 3,
+};
+}  // namespace
+
 NotificationDistributedOptions::NotificationDistributedOptions(
     bool distribute, const std::vector<std::string> &dvsDisplay, const std::vector<std::string> &dvsOperate)
     : isDistributed_(distribute), devicesSupportDisplay_(dvsDisplay), devicesSupportOperate_(dvsOperate)
@@ -112,6 +120,49 @@ NotificationDistributedOptions *NotificationDistributedOptions::FromJson(const n
     return pOpt;
 }
 
+bool NotificationDistributedOptions::ToBinary(NotificationBinaryWriter &writer) const
+{
+    writer.WriteBool(TAG_IS_DISTRIBUTED, isDistributed_);
+    writer.WriteStrings(TAG_DEVICES_SUPPORT_DISPLAY, devicesSupportDisplay_);
+    writer.WriteStrings(TAG_DEVICES_SUPPORT_OPERATE, devicesSupportOperate_);
+
+    return true;
+}
+
+NotificationDistributedOptions *NotificationDistributedOptions::FromBinary(NotificationBinaryReader &reader)
+{
+    auto pOpt = new (std::nothrow) NotificationDistributedOptions();
+    if (pOpt == nullptr) {
+        ANS_LOGE("Failed to create distributedOptions instance");
+        return nullptr;
+    }
+
+    uint32_t tag = 0;
+    while (reader.Next(tag)) {
+        switch (tag) {
+            case TAG_IS_DISTRIBUTED:
+                reader.ReadBool(pOpt->isDistributed_);
+                break;
+            case TAG_DEVICES_SUPPORT_DISPLAY:
+                reader.ReadStrings(pOpt->devicesSupportDisplay_);
+                break;
+            case TAG_DEVICES_SUPPORT_OPERATE:
+                reader.ReadStrings(pOpt->devicesSupportOperate_);
+                break;
+            default:
+                reader.Skip();
+                break;
+        }
+    }
+    if (reader.HasError()) {
+        ANS_LOGE("Invalid binary of distributedOptions");
+        delete pOpt;
+        return nullptr;
+    }
+
+    return pOpt;
+}
+
 bool NotificationDistributedOptions::Marshalling(Parcel &parcel) const
 {
     if (!parcel.WriteBool(isDistributed_)) {
@@ -18,6 +18,13 @@
 
 namespace OHOS {
 namespace Notification {
+namespace {
+enum BinaryTag : uint32_t {
+    TAG_SOUND_ENABLED = 1,
+    TAG_VIBRATION_ENABLED = 2,
+};
+}  // namespace
+
 void NotificationFlags::SetSoundEnabled(NotificationConstant::FlagStatus soundEnabled)
 {
     soundEnabled_ = soundEnabled;
@@ -79,6 +86,45 @@ NotificationFlags *NotificationFlags::FromJson(const nlohmann::json &jsonObject)
     return pFlags;
 }
 
+bool NotificationFlags::ToBinary(NotificationBinaryWriter &writer) const
+{
+    writer.WriteInt(TAG_SOUND_ENABLED, static_cast<int64_t>(soundEnabled_));
+    writer.WriteInt(TAG_VIBRATION_ENABLED, static_cast<int64_t>(vibrationEnabled_));
+
+    return true;
+}
+
+NotificationFlags *NotificationFlags::FromBinary(NotificationBinaryReader &reader)
+{
+    auto pFlags = new (std::nothrow) NotificationFlags();
+    if (pFlags == nullptr) {
+        ANS_LOGE("Failed to create notificationFlags instance");
+        return nullptr;
+    }
+
+    uint32_t tag = 0;
+    while (reader.Next(tag)) {
+        switch (tag) {
+            case TAG_SOUND_ENABLED:
+                reader.ReadInt(pFlags->soundEnabled_);
+                break;
+            case TAG_VIBRATION_ENABLED:
+                reader.ReadInt(pFlags->vibrationEnabled_);
+                break;
+            default:
+                reader.Skip();
+                break;
+        }
+    }
+    if (reader.HasError()) {
+        ANS_LOGE("Invalid binary of notificationFlags");
+        delete pFlags;
+        return nullptr;
+    }
+
+    return pFlags;
+}
+
 bool NotificationFlags::Marshalling(Parcel &parcel) const
 {
     if (!parcel.WriteUint8(static_cast<uint8_t>(soundEnabled_))) {
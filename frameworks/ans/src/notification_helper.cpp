@@ -110,6 +110,18 @@ ErrCode NotificationHelper::CancelNotification(const std::string &label, int32_t
     return DelayedSingleton<AnsNotification>::GetInstance()->CancelNotification(label, notificationId);
 }
 
+ErrCode NotificationHelper::PublishNotificationBatch(
+    const std::string &label, const std::vector<NotificationRequest> &requests, std::vector<ErrCode> &results)
+{
+    return DelayedSingleton<AnsNotification>::GetInstance()->PublishNotificationBatch(label, requests, results);
+}
+
+ErrCode NotificationHelper::CancelNotificationBatch(
+    const std::string &label, const std::vector<int32_t> &notificationIds, std::vector<ErrCode> &results)
+{
+    return DelayedSingleton<AnsNotification>::GetInstance()->CancelNotificationBatch(label, notificationIds, results);
+}
+
 ErrCode NotificationHelper::CancelAllNotifications()
 {
     return DelayedSingleton<AnsNotification>::GetInstance()->CancelAllNotifications();
@@ -19,6 +19,14 @@
 
 namespace OHOS {
 namespace Notification {
+namespace {
+enum BinaryTag : uint32_t {
+    TAG_LONG_TEXT = 16,
+    TAG_EXPANDED_TITLE = 17,
+    TAG_BRIEF_TEXT = 18,
+};
+}  // namespace
+
 const std::size_t NotificationLongTextContent::MAX_LONGTEXT_LENGTH {1024};
 
 NotificationLongTextContent::NotificationLongTextContent(const std::string &longText)
@@ -116,6 +124,56 @@ NotificationLongTextContent *NotificationLongTextContent::FromJson(const nlohman
     return pContent;
 }
 
+bool NotificationLongTextContent::ToBinary(NotificationBinaryWriter &writer) const
+{
+    if (!NotificationBasicContent::ToBinary(writer)) {
+        ANS_LOGE("Cannot convert basicContent to binary");
+        return false;
+    }
+
+    writer.WriteString(TAG_LONG_TEXT, longText_);
+    writer.WriteString(TAG_EXPANDED_TITLE, expandedTitle_);
+    writer.WriteString(TAG_BRIEF_TEXT, briefText_);
+
+    return true;
+}
+
+NotificationLongTextContent *NotificationLongTextContent::FromBinary(NotificationBinaryReader &reader)
+{
+    auto pContent = new (std::nothrow) NotificationLongTextContent();
+    if (pContent == nullptr) {
+        ANS_LOGE("Failed to create longTextContent instance");
+        return nullptr;
+    }
+
+    uint32_t tag = 0;
+    while (reader.Next(tag)) {
+        switch (tag) {
+            case TAG_LONG_TEXT:
+                reader.ReadString(pContent->longText_);
+                break;
+            case TAG_EXPANDED_TITLE:
+                reader.ReadString(pContent->expandedTitle_);
+                break;
+            case TAG_BRIEF_TEXT:
+                reader.ReadString(pContent->briefText_);
+                break;
+            default:
+                if (!pContent->ReadFromBinary(tag, reader)) {
+                    reader.Skip();
+                }
+                break;
+        }
+    }
+    if (reader.HasError()) {
+        ANS_LOGE("Invalid binary of longTextContent");
+        delete pContent;
+        return nullptr;
+    }
+
+    return pContent;
+}
+
 bool NotificationLongTextContent::Marshalling(Parcel &parcel) const
 {
     if (!NotificationBasicContent::Marshalling(parcel)) {
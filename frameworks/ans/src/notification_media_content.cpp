@@ -19,6 +19,12 @@
 
 namespace OHOS {
 namespace Notification {
+namespace {
+enum BinaryTag : uint32_t {
+    TAG_SEQUENCE_NUMBERS = 16,
+};
+}  // namespace
+
 void NotificationMediaContent::SetAVToken(const std::shared_ptr<AVToken> &avToken)
 {
     avToken_ = avToken;
@@ -87,6 +93,53 @@ NotificationMediaContent *NotificationMediaContent::FromJson(const nlohmann::jso
     return pContent;
 }
 
+bool NotificationMediaContent::ToBinary(NotificationBinaryWriter &writer) const
+{
+    if (!NotificationBasicContent::ToBinary(writer)) {
+        ANS_LOGE("Cannot convert basicContent to binary");
+        return false;
+    }
+
+    for (auto sequenceNumber : sequenceNumbers_) {
+        writer.WriteInt(TAG_SEQUENCE_NUMBERS, sequenceNumber);
+    }
+
+    return true;
+}
+
+NotificationMediaContent *NotificationMediaContent::FromBinary(NotificationBinaryReader &reader)
+{
+    auto pContent = new (std::nothrow) NotificationMediaContent();
+    if (pContent == nullptr) {
+        ANS_LOGE("Failed to create mediaContent instance");
+        return nullptr;
+    }
+
+    uint32_t tag = 0;
+    uint32_t sequenceNumber = 0;
+    while (reader.Next(tag)) {
+        switch (tag) {
+            case TAG_SEQUENCE_NUMBERS:
+                if (reader.ReadInt(sequenceNumber)) {
+                    pContent->sequenceNumbers_.emplace_back(sequenceNumber);
+                }
+                break;
+            default:
+                if (!pContent->ReadFromBinary(tag, reader)) {
+                    reader.Skip();
+                }
+                break;
+        }
+    }
+    if (reader.HasError()) {
+        ANS_LOGE("Invalid binary of mediaContent");
+        delete pContent;
+        return nullptr;
+    }
+
+    return pContent;
+}
+
 bool NotificationMediaContent::Marshalling(Parcel &parcel) const
 {
     if (!NotificationBasicContent::Marshalling(parcel)) {
@@ -21,6 +21,14 @@
 
 namespace OHOS {
 namespace Notification {
+namespace {
+enum BinaryTag : uint32_t {
+    TAG_EXPANDED_TITLE = 16,
+    TAG_BRIEF_TEXT = 17,
+    TAG_ALL_LINES = 18,
+};
+}  // namespace
+
 const std::vector<std::string>::size_type NotificationMultiLineContent::MAX_LINES {7};
 
 void NotificationMultiLineContent::SetExpandedTitle(const std::string &exTitle)
@@ -117,6 +125,56 @@ NotificationMultiLineContent *NotificationMultiLineContent::FromJson(const nlohm
     return pContent;
 }
 
+bool NotificationMultiLineContent::ToBinary(NotificationBinaryWriter &writer) const
+{
+    if (!NotificationBasicContent::ToBinary(writer)) {
+        ANS_LOGE("Cannot convert basicContent to binary");
+        return false;
+    }
+
+    writer.WriteString(TAG_EXPANDED_TITLE, expandedTitle_);
+    writer.WriteString(TAG_BRIEF_TEXT, briefText_);
+    writer.WriteStrings(TAG_ALL_LINES, allLines_);
+
+    return true;
+}
+
+NotificationMultiLineContent *NotificationMultiLineContent::FromBinary(NotificationBinaryReader &reader)
+{
+    auto pContent = new (std::nothrow) NotificationMultiLineContent();
+    if (pContent == nullptr) {
+        ANS_LOGE("Failed to create multiLineContent instance");
+        return nullptr;
+    }
+
+    uint32_t tag = 0;
+    while (reader.Next(tag)) {
+        switch (tag) {
+            case TAG_EXPANDED_TITLE:
+                reader.ReadString(pContent->expandedTitle_);
+                break;
+            case TAG_BRIEF_TEXT:
+                reader.ReadString(pContent->briefText_);
+                break;
+            case TAG_ALL_LINES:
+                reader.ReadStrings(pContent->allLines_);
+                break;
+            default:
+                if (!pContent->ReadFromBinary(tag, reader)) {
+                    reader.Skip();
+                }
+                break;
+        }
+    }
+    if (reader.HasError()) {
+        ANS_LOGE("Invalid binary of multiLineContent");
+        delete pContent;
+        return nullptr;
+    }
+
+    return pContent;
+}
+
 bool NotificationMultiLineContent::Marshalling(Parcel &parcel) const
 {
     if (!NotificationBasicContent::Marshalling(parcel)) {
@@ -46,6 +46,34 @@ NotificationNormalContent *NotificationNormalContent::FromJson(const nlohmann::j
     return pContent;
 }
 
+bool NotificationNormalContent::ToBinary(NotificationBinaryWriter &writer) const
+{
+    return NotificationBasicContent::ToBinary(writer);
+}
+
+NotificationNormalContent *NotificationNormalContent::FromBinary(NotificationBinaryReader &reader)
+{
+    auto pContent = new (std::nothrow) NotificationNormalContent();
+    if (pContent == nullptr) {
+        ANS_LOGE("Failed to create normalContent instance");
+        return nullptr;
+    }
+
+    uint32_t tag = 0;
+    while (reader.Next(tag)) {
+        if (!pContent->ReadFromBinary(tag, reader)) {
+            reader.Skip();
+        }
+    }
+    if (reader.HasError()) {
+        ANS_LOGE("Invalid binary of normalContent");
+        delete pContent;
+        return nullptr;
+    }
+
+    return pContent;
+}
+
 bool NotificationNormalContent::Marshalling(Parcel &parcel) const
 {
     return NotificationBasicContent::Marshalling(parcel);
@@ -19,6 +19,14 @@
 
 namespace OHOS {
 namespace Notification {
+namespace {
+enum BinaryTag : uint32_t {
+    TAG_EXPANDED_TITLE = 16,
+    TAG_BRIEF_TEXT = 17,
+    TAG_BIG_PICTURE = 18,
+};
+}  // namespace
+
 void NotificationPictureContent::SetExpandedTitle(const std::string &exTitle)
 {
     expandedTitle_ = exTitle;
@@ -104,6 +112,59 @@ NotificationPictureContent *NotificationPictureContent::FromJson(const nlohmann:
     return pContent;
 }
 
+bool NotificationPictureContent::ToBinary(NotificationBinaryWriter &writer) const
+{
+    if (!NotificationBasicContent::ToBinary(writer)) {
+        ANS_LOGE("Cannot convert basicContent to binary");
+        return false;
+    }
+
+    writer.WriteString(TAG_EXPANDED_TITLE, expandedTitle_);
+    writer.WriteString(TAG_BRIEF_TEXT, briefText_);
+    writer.WriteString(TAG_BIG_PICTURE, AnsImageUtil::PackImage(bigPicture_));
+
+    return true;
+}
+
+NotificationPictureContent *NotificationPictureContent::FromBinary(NotificationBinaryReader &reader)
+{
+    auto pContent = new (std::nothrow) NotificationPictureContent();
+    if (pContent == nullptr) {
+        ANS_LOGE("Failed to create pictureContent instance");
+        return nullptr;
+    }
+
+    uint32_t tag = 0;
+    std::string value;
+    while (reader.Next(tag)) {
+        switch (tag) {
+            case TAG_EXPANDED_TITLE:
+                reader.ReadString(pContent->expandedTitle_);
+                break;
+            case TAG_BRIEF_TEXT:
+                reader.ReadString(pContent->briefText_);
+                break;
+            case TAG_BIG_PICTURE:
+                if (reader.ReadString(value)) {
+                    pContent->bigPicture_ = AnsImageUtil::UnPackImage(value);
+                }
+                break;
+            default:
+                if (!pContent->ReadFromBinary(tag, reader)) {
+                    reader.Skip();
+                }
+                break;
+        }
+    }
+    if (reader.HasError()) {
+        ANS_LOGE("Invalid binary of pictureContent");
+        delete pContent;
+        return nullptr;
+    }
+
+    return pContent;
+}
+
 bool NotificationPictureContent::Marshalling(Parcel &parcel) const
 {
     if (!NotificationBasicContent::Marshalling(parcel)) {
@@ -128,7 +189,7 @@ bool NotificationPictureContent::Marshalling(Parcel &parcel) const
     }
 
     if (valid) {
-        if (!parcel.WriteParcelable(bigPicture_.get())) {
+        if (!AnsImageUtil::WriteImage(parcel, bigPicture_)) {
             ANS_LOGE("Failed to write bigPicture");
             return false;
         }
@@ -167,7 +228,7 @@ bool NotificationPictureContent::ReadFromParcel(Parcel &parcel)
 
     auto valid = parcel.ReadBool();
     if (valid) {
-        bigPicture_ = std::shared_ptr<Media::PixelMap>(parcel.ReadParcelable<Media::PixelMap>());
+        bigPicture_ = AnsImageUtil::ReadImage(parcel);
         if (!bigPicture_) {
             ANS_LOGE("Failed to read bigPicture");
             return false;
@@ -22,6 +22,45 @@
 
 namespace OHOS {
 namespace Notification {
+namespace {
+// The tags are grouped by kind: numbers from 1, strings from 16, bools from 32 and objects from 48.
+enum BinaryTag : uint32_t {
+    TAG_ID = 1,
+    TAG_COLOR = 2,
+    TAG_DELIVERY_TIME = 3,
+    TAG_AUTO_DELETED_TIME = 4,
+    TAG_CREATOR_UID = 5,
+    TAG_CREATOR_PID = 6,
+    TAG_CREATOR_USER_ID = 7,
+    TAG_RECEIVER_USER_ID = 8,
+    TAG_BADGE_NUMBER = 9,
+    TAG_SLOT_TYPE = 10,
+    TAG_BADGE_ICON_STYLE = 11,
+    TAG_CREATOR_BUNDLE_NAME = 16,
+    TAG_OWNER_BUNDLE_NAME = 17,
+    TAG_GROUP_NAME = 18,
+    TAG_LABEL = 19,
+    TAG_CLASSIFICATION = 20,
+    TAG_SHOW_DELIVERY_TIME = 32,
+    TAG_TAP_DISMISSED = 33,
+    TAG_COLOR_ENABLED = 34,
+    TAG_IS_ONGOING = 35,
+    TAG_IS_ALERT_ONCE = 36,
+    TAG_IS_STOPWATCH = 37,
+    TAG_IS_COUNTDOWN = 38,
+    TAG_IS_UNREMOVABLE = 39,
+    TAG_IS_FLOATING_ICON = 40,
+    TAG_WANT_AGENT = 48,
+    TAG_CONTENT = 49,
+    TAG_ACTION_BUTTONS = 50,
+    TAG_EXTRA_INFO = 51,
+    TAG_SMALL_ICON = 52,
+    TAG_LARGE_ICON = 53,
+    TAG_DISTRIBUTED_OPTIONS = 54,
+    TAG_NOTIFICATION_FLAGS = 55,
+};
+}  // namespace
+
 const std::string NotificationRequest::CLASSIFICATION_ALARM {"alarm"};
 const std::string NotificationRequest::CLASSIFICATION_CALL {"call"};
 const std::string NotificationRequest::CLASSIFICATION_EMAIL {"email"};
@@ -829,6 +868,75 @@ NotificationRequest *NotificationRequest::FromJson(const nlohmann::json &jsonObj
     return pRequest;
 }
 
+bool NotificationRequest::ToBinary(NotificationBinaryWriter &writer) const
+{
+    writer.WriteInt(TAG_ID, notificationId_);
+    writer.WriteInt(TAG_COLOR, color_);
+    writer.WriteInt(TAG_DELIVERY_TIME, deliveryTime_);
+    writer.WriteInt(TAG_AUTO_DELETED_TIME, autoDeletedTime_);
+    writer.WriteInt(TAG_CREATOR_UID, creatorUid_);
+    writer.WriteInt(TAG_CREATOR_PID, creatorPid_);
+    writer.WriteInt(TAG_CREATOR_USER_ID, creatorUserId_);
+    writer.WriteInt(TAG_RECEIVER_USER_ID, receiverUserId_);
+    writer.WriteInt(TAG_BADGE_NUMBER, badgeNumber_);
+    writer.WriteInt(TAG_SLOT_TYPE, static_cast<int32_t>(slotType_));
+    writer.WriteInt(TAG_BADGE_ICON_STYLE, static_cast<int32_t>(badgeStyle_));
+
+    writer.WriteString(TAG_CREATOR_BUNDLE_NAME, creatorBundleName_);
+    writer.WriteString(TAG_OWNER_BUNDLE_NAME, ownerBundleName_);
+    writer.WriteString(TAG_GROUP_NAME, groupName_);
+    writer.WriteString(TAG_LABEL, label_);
+    writer.WriteString(TAG_CLASSIFICATION, classification_);
+
+    writer.WriteBool(TAG_SHOW_DELIVERY_TIME, showDeliveryTime_);
+    writer.WriteBool(TAG_TAP_DISMISSED, tapDismissed_);
+    writer.WriteBool(TAG_COLOR_ENABLED, colorEnabled_);
+    writer.WriteBool(TAG_IS_ONGOING, inProgress_);
+    writer.WriteBool(TAG_IS_ALERT_ONCE, alertOneTime_);
+    writer.WriteBool(TAG_IS_STOPWATCH, showStopwatch_);
+    writer.WriteBool(TAG_IS_COUNTDOWN, isCountdown_);
+    writer.WriteBool(TAG_IS_UNREMOVABLE, unremovable_);
+    writer.WriteBool(TAG_IS_FLOATING_ICON, floatingIcon_);
+
+    if (!ConvertObjectsToBinary(writer)) {
+        ANS_LOGE("Cannot convert objects to binary");
+        return false;
+    }
+
+    return true;
+}
+
+NotificationRequest *NotificationRequest::FromBinary(NotificationBinaryReader &reader)
+{
+    auto pRequest = new (std::nothrow) NotificationRequest();
+    if (pRequest == nullptr) {
+        ANS_LOGE("Failed to create request instance");
+        return nullptr;
+    }
+
+    uint32_t tag = 0;
+    while (reader.Next(tag)) {
+        if (ConvertBinaryToNum(pRequest, tag, reader) || ConvertBinaryToString(pRequest, tag, reader) ||
+            ConvertBinaryToBool(pRequest, tag, reader)) {
+            continue;
+        }
+
+        if (!ConvertBinaryToObject(pRequest, tag, reader)) {
+            delete pRequest;
+            pRequest = nullptr;
+            return nullptr;
+        }
+    }
+    if (reader.HasError()) {
+        ANS_LOGE("Invalid binary of request");
+        delete pRequest;
+        pRequest = nullptr;
+        return nullptr;
+    }
+
+    return pRequest;
+}
+
 bool NotificationRequest::Marshalling(Parcel &parcel) const
 {
     // write int
@@ -1108,7 +1216,7 @@ bool NotificationRequest::Marshalling(Parcel &parcel) const
     }
 
     if (valid) {
-        if (!parcel.WriteParcelable(littleIcon_.get())) {
+        if (!AnsImageUtil::WriteImage(parcel, littleIcon_)) {
             ANS_LOGE("Failed to write littleIcon");
             return false;
         }
@@ -1121,7 +1229,7 @@ bool NotificationRequest::Marshalling(Parcel &parcel) const
     }
 
     if (valid) {
-        if (!parcel.WriteParcelable(bigIcon_.get())) {
+        if (!AnsImageUtil::WriteImage(parcel, bigIcon_)) {
             ANS_LOGE("Failed to write bigIcon");
             return false;
         }
@@ -1355,7 +1463,7 @@ bool NotificationRequest::ReadFromParcel(Parcel &parcel)
 
     valid = parcel.ReadBool();
     if (valid) {
-        littleIcon_ = std::shared_ptr<Media::PixelMap>(parcel.ReadParcelable<Media::PixelMap>());
+        littleIcon_ = AnsImageUtil::ReadImage(parcel);
         if (!littleIcon_) {
             ANS_LOGE("Failed to read littleIcon");
             return false;
@@ -1364,7 +1472,7 @@ bool NotificationRequest::ReadFromParcel(Parcel &parcel)
 
     valid = parcel.ReadBool();
     if (valid) {
-        bigIcon_ = std::shared_ptr<Media::PixelMap>(parcel.ReadParcelable<Media::PixelMap>());
+        bigIcon_ = AnsImageUtil::ReadImage(parcel);
         if (!bigIcon_) {
             ANS_LOGE("Failed to read bigIcon");
             return false;
@@ -1881,5 +1989,235 @@ bool NotificationRequest::ConvertJsonToNotificationFlags(
 
     return true;
 }
+
+bool NotificationRequest::ConvertObjectsToBinary(NotificationBinaryWriter &writer) const
+{
+    writer.WriteString(
+        TAG_WANT_AGENT, wantAgent_ ? AbilityRuntime::WantAgent::WantAgentHelper::ToString(wantAgent_) : "");
+
+    if (!writer.WriteObject(TAG_CONTENT, notificationContent_.get())) {
+        ANS_LOGE("Cannot convert notificationContent to binary");
+        return false;
+    }
+
+    for (auto &btn : actionButtons_) {
+        if (!writer.WriteObject(TAG_ACTION_BUTTONS, btn.get())) {
+            ANS_LOGE("Cannot convert actionButton to binary");
+            return false;
+        }
+    }
+
+    std::string extraInfoStr;
+    if (additionalParams_) {
+        AAFwk::WantParamWrapper wWrapper(*additionalParams_);
+        extraInfoStr = wWrapper.ToString();
+    }
+    writer.WriteString(TAG_EXTRA_INFO, extraInfoStr);
+
+    writer.WriteString(TAG_SMALL_ICON, AnsImageUtil::PackImage(littleIcon_));
+    writer.WriteString(TAG_LARGE_ICON, AnsImageUtil::PackImage(bigIcon_));
+
+    if (!writer.WriteObject(TAG_DISTRIBUTED_OPTIONS, &distributedOptions_)) {
+        ANS_LOGE("Cannot convert distributedOptions to binary");
+        return false;
+    }
+
+    if (!writer.WriteObject(TAG_NOTIFICATION_FLAGS, notificationFlags_.get())) {
+        ANS_LOGE("Cannot convert notificationFlags to binary");
+        return false;
+    }
+
+    return true;
+}
+
+bool NotificationRequest::ConvertBinaryToNum(
+    NotificationRequest *target, uint32_t tag, NotificationBinaryReader &reader)
+{
+    switch (tag) {
+        case TAG_ID:
+            reader.ReadInt(target->notificationId_);
+            break;
+        case TAG_COLOR:
+            reader.ReadInt(target->color_);
+            break;
+        case TAG_DELIVERY_TIME:
+            reader.ReadInt(target->deliveryTime_);
+            break;
+        case TAG_AUTO_DELETED_TIME:
+            reader.ReadInt(target->autoDeletedTime_);
+            break;
+        case TAG_CREATOR_UID:
+            reader.ReadInt(target->creatorUid_);
+            break;
+        case TAG_CREATOR_PID:
+            reader.ReadInt(target->creatorPid_);
+            break;
+        case TAG_CREATOR_USER_ID:
+            reader.ReadInt(target->creatorUserId_);
+            break;
+        case TAG_RECEIVER_USER_ID:
+            reader.ReadInt(target->receiverUserId_);
+            break;
+        case TAG_BADGE_NUMBER:
+            reader.ReadInt(target->badgeNumber_);
+            break;
+        case TAG_SLOT_TYPE:
+            reader.ReadInt(target->slotType_);
+            break;
+        case TAG_BADGE_ICON_STYLE:
+            reader.ReadInt(target->badgeStyle_);
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+bool NotificationRequest::ConvertBinaryToString(
+    NotificationRequest *target, uint32_t tag, NotificationBinaryReader &reader)
+{
+    switch (tag) {
+        case TAG_CREATOR_BUNDLE_NAME:
+            reader.ReadString(target->creatorBundleName_);
+            break;
+        case TAG_OWNER_BUNDLE_NAME:
+            reader.ReadString(target->ownerBundleName_);
+            break;
+        case TAG_GROUP_NAME:
+            reader.ReadString(target->groupName_);
+            break;
+        case TAG_LABEL:
+            reader.ReadString(target->label_);
+            break;
+        case TAG_CLASSIFICATION:
+            reader.ReadString(target->classification_);
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+bool NotificationRequest::ConvertBinaryToBool(
+    NotificationRequest *target, uint32_t tag, NotificationBinaryReader &reader)
+{
+    switch (tag) {
+        case TAG_SHOW_DELIVERY_TIME:
+            reader.ReadBool(target->showDeliveryTime_);
+            break;
+        case TAG_TAP_DISMISSED:
+            reader.ReadBool(target->tapDismissed_);
+            break;
+        case TAG_COLOR_ENABLED:
+            reader.ReadBool(target->colorEnabled_);
+            break;
+        case TAG_IS_ONGOING:
+            reader.ReadBool(target->inProgress_);
+            break;
+        case TAG_IS_ALERT_ONCE:
+            reader.ReadBool(target->alertOneTime_);
+            break;
+        case TAG_IS_STOPWATCH:
+            reader.ReadBool(target->showStopwatch_);
+            break;
+        case TAG_IS_COUNTDOWN:
+            reader.ReadBool(target->isCountdown_);
+            break;
+        case TAG_IS_UNREMOVABLE:
+            reader.ReadBool(target->unremovable_);
+            break;
+        case TAG_IS_FLOATING_ICON:
+            reader.ReadBool(target->floatingIcon_);
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+bool NotificationRequest::ConvertBinaryToObject(
+    NotificationRequest *target, uint32_t tag, NotificationBinaryReader &reader)
+{
+    std::string value;
+    NotificationBinaryReader objectReader;
+    switch (tag) {
+        case TAG_WANT_AGENT:
+            if (reader.ReadString(value)) {
+                target->wantAgent_ = AbilityRuntime::WantAgent::WantAgentHelper::FromString(value);
+            }
+            break;
+        case TAG_CONTENT:
+            if (reader.ReadObject(objectReader)) {
+                auto pContent = NotificationContent::FromBinary(objectReader);
+                if (pContent == nullptr) {
+                    ANS_LOGE("Failed to parse notification content!");
+                    return false;
+                }
+                target->notificationContent_ = std::shared_ptr<NotificationContent>(pContent);
+            }
+            break;
+        case TAG_ACTION_BUTTONS:
+            if (reader.ReadObject(objectReader)) {
+                auto pBtn = NotificationActionButton::FromBinary(objectReader);
+                if (pBtn == nullptr) {
+                    ANS_LOGE("Failed to parse actionButton!");
+                    return false;
+                }
+                target->actionButtons_.emplace_back(pBtn);
+            }
+            break;
+        case TAG_EXTRA_INFO:
+            if (reader.ReadString(value) && !value.empty()) {
+                AAFwk::WantParams params = AAFwk::WantParamWrapper::ParseWantParams(value);
+                target->additionalParams_ = std::make_shared<AAFwk::WantParams>(params);
+            }
+            break;
+        case TAG_SMALL_ICON:
+            if (reader.ReadString(value)) {
+                target->littleIcon_ = AnsImageUtil::UnPackImage(value);
+            }
+            break;
+        case TAG_LARGE_ICON:
+            if (reader.ReadString(value)) {
+                target->bigIcon_ = AnsImageUtil::UnPackImage(value);
+            }
+            break;
+        default:
+            return ConvertBinaryToOptions(target, tag, reader);
+    }
+    return true;
+}
+
+bool NotificationRequest::ConvertBinaryToOptions(
+    NotificationRequest *target, uint32_t tag, NotificationBinaryReader &reader)
+{
+    NotificationBinaryReader objectReader;
+    switch (tag) {
+        case TAG_DISTRIBUTED_OPTIONS:
+            if (reader.ReadObject(objectReader)) {
+                std::unique_ptr<NotificationDistributedOptions> pOpt(
+                    NotificationDistributedOptions::FromBinary(objectReader));
+                if (pOpt == nullptr) {
+                    ANS_LOGE("Failed to parse distributedOptions!");
+                    return false;
+                }
+                target->distributedOptions_ = *pOpt;
+            }
+            break;
+        case TAG_NOTIFICATION_FLAGS:
+            if (reader.ReadObject(objectReader)) {
+                auto pFlags = NotificationFlags::FromBinary(objectReader);
+                if (pFlags == nullptr) {
+                    ANS_LOGE("Failed to parse notificationFlags!");
+                    return false;
+                }
+                target->notificationFlags_ = std::shared_ptr<NotificationFlags>(pFlags);
+            }
+            break;
+        default:
+            reader.Skip();
+            break;
+    }
+    return true;
+}
 }  // namespace Notification
 }  // namespace OHOS
@@ -15,6 +15,9 @@
 
 #include "notification_sorting_map.h"
 
+#include <algorithm>
+#include <unordered_set>
+
 #include "parcel.h"
 
 namespace OHOS {
@@ -43,14 +46,91 @@ void NotificationSortingMap::SetKey(const std::string &key)
 
 bool NotificationSortingMap::GetNotificationSorting(const std::string &key, NotificationSorting &sorting) const
 {
-    for (auto item : sortings_) {
-        if (item.first == key) {
-            sorting = item.second;
-            return true;
+    auto iter = sortings_.find(key);
+    if (iter == sortings_.end()) {
+        return false;
+    }
+
+    sorting = iter->second;
+    return true;
+}
+
+void NotificationSortingMap::SetVersion(uint64_t version)
+{
+    version_ = version;
+}
+
+uint64_t NotificationSortingMap::GetVersion() const
+{
+    return version_;
+}
+
+void NotificationSortingMap::SetDelta(uint64_t baseVersion, const std::vector<std::string> &removedKeys)
+{
+    isDelta_ = true;
+    baseVersion_ = baseVersion;
+    removedKeys_ = removedKeys;
+}
+
+bool NotificationSortingMap::IsDelta() const
+{
+    return isDelta_;
+}
+
+uint64_t NotificationSortingMap::GetBaseVersion() const
+{
+    return baseVersion_;
+}
+
+std::vector<std::string> NotificationSortingMap::GetRemovedKeys() const
+{
+    return removedKeys_;
+}
+
+bool NotificationSortingMap::ApplyDelta(const NotificationSortingMap &delta)
+{
+    if (isDelta_ || !delta.isDelta_ || (version_ == 0) || (delta.baseVersion_ != version_)) {
+        return false;
+    }
+
+    std::unordered_set<std::string> staleKeys(delta.removedKeys_.begin(), delta.removedKeys_.end());
+    for (auto &sorting : delta.sortings_) {
+        staleKeys.insert(sorting.first);
+    }
+
+    // The sortings kept from this map are still in the right relative order.
+    std::vector<NotificationSorting> sortingList;
+    sortingList.reserve(sortings_.size() + delta.sortings_.size());
+    for (auto &sorting : sortings_) {
+        if (staleKeys.find(sorting.first) == staleKeys.end()) {
+            sortingList.push_back(sorting.second);
         }
     }
+    std::sort(sortingList.begin(), sortingList.end(), [](const NotificationSorting &first,
+        const NotificationSorting &second) { return first.GetRanking() < second.GetRanking(); });
+
+    // Inserting the changed sortings in ranking order puts each one at its final position.
+    std::vector<NotificationSorting> changedList;
+    changedList.reserve(delta.sortings_.size());
+    for (auto &sorting : delta.sortings_) {
+        changedList.push_back(sorting.second);
+    }
+    std::sort(changedList.begin(), changedList.end(), [](const NotificationSorting &first,
+        const NotificationSorting &second) { return first.GetRanking() < second.GetRanking(); });
+    for (auto &sorting : changedList) {
+        size_t position = std::min(static_cast<size_t>(sorting.GetRanking()), sortingList.size());
+        sortingList.insert(sortingList.begin() + position, sorting);
+    }
 
-    return false;
+    sortedKey_.clear();
+    sortings_.clear();
+    for (size_t i = 0; i < sortingList.size(); i++) {
+        sortingList[i].ranking_ = static_cast<uint64_t>(i);
+        sortedKey_.push_back(sortingList[i].GetKey());
+        sortings_[sortingList[i].GetKey()] = sortingList[i];
+    }
+    version_ = delta.version_;
+    return true;
 }
 
 void NotificationSortingMap::SetNotificationSorting(const std::vector<NotificationSorting> &sortingList)
@@ -82,6 +162,28 @@ bool NotificationSortingMap::Marshalling(Parcel &parcel) const
         }
     }
 
+    if (!parcel.WriteUint64(version_)) {
+        ANS_LOGE("Can't write version");
+        return false;
+    }
+
+    if (!parcel.WriteBool(isDelta_)) {
+        ANS_LOGE("Can't write isDelta");
+        return false;
+    }
+
+    if (isDelta_) {
+        if (!parcel.WriteUint64(baseVersion_)) {
+            ANS_LOGE("Can't write baseVersion");
+            return false;
+        }
+
+        if (!parcel.WriteStringVector(removedKeys_)) {
+            ANS_LOGE("Can't write removedKeys");
+            return false;
+        }
+    }
+
     return ret;
 }
 
@@ -102,6 +204,20 @@ NotificationSortingMap *NotificationSortingMap::Unmarshalling(Parcel &parcel)
     }
 
     NotificationSortingMap *sortingMap = new (std::nothrow) NotificationSortingMap(sortings);
+    if (sortingMap == nullptr) {
+        return nullptr;
+    }
+
+    sortingMap->version_ = parcel.ReadUint64();
+    sortingMap->isDelta_ = parcel.ReadBool();
+    if (sortingMap->isDelta_) {
+        sortingMap->baseVersion_ = parcel.ReadUint64();
+        if (!parcel.ReadStringVector(&sortingMap->removedKeys_)) {
+            ANS_LOGE("Failed to read removedKeys");
+            delete sortingMap;
+            return nullptr;
+        }
+    }
     return sortingMap;
 }
 
@@ -114,6 +230,8 @@ std::string NotificationSortingMap::Dump() const
     }
     return "NotificationSortingMap{ "
             "sortedkey = [" + keys + "]"
+            ", version = " + std::to_string(version_) +
+            ", isDelta = " + (isDelta_ ? "true" : "false") +
             " }";
 }
 }  // namespace Notification
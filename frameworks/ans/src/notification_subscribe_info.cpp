@@ -28,6 +28,7 @@ NotificationSubscribeInfo::~NotificationSubscribeInfo()
 NotificationSubscribeInfo::NotificationSubscribeInfo(const NotificationSubscribeInfo &subscribeInfo)
 {
     appNames_ = subscribeInfo.GetAppNames();
+    sortingMapDelta_ = subscribeInfo.IsSortingMapDeltaEnabled();
 }
 
 void NotificationSubscribeInfo::AddAppName(const std::string appName)
@@ -55,6 +56,16 @@ int32_t NotificationSubscribeInfo::GetAppUserId() const
     return userId_;
 }
 
+void NotificationSubscribeInfo::SetSortingMapDeltaEnabled(bool enabled)
+{
+    sortingMapDelta_ = enabled;
+}
+
+bool NotificationSubscribeInfo::IsSortingMapDeltaEnabled() const
+{
+    return sortingMapDelta_;
+}
+
 bool NotificationSubscribeInfo::Marshalling(Parcel &parcel) const
 {
     // write appNames_
@@ -62,6 +73,12 @@ bool NotificationSubscribeInfo::Marshalling(Parcel &parcel) const
         ANS_LOGE("Can't write appNames_");
         return false;
     }
+
+    // write sortingMapDelta_
+    if (!parcel.WriteBool(sortingMapDelta_)) {
+        ANS_LOGE("Can't write sortingMapDelta_");
+        return false;
+    }
     return true;
 }
 
@@ -79,6 +96,7 @@ NotificationSubscribeInfo *NotificationSubscribeInfo::Unmarshalling(Parcel &parc
 bool NotificationSubscribeInfo::ReadFromParcel(Parcel &parcel)
 {
     parcel.ReadStringVector(&appNames_);
+    sortingMapDelta_ = parcel.ReadBool();
     return true;
 }
 
@@ -91,6 +109,7 @@ std::string NotificationSubscribeInfo::Dump()
     }
     return "NotificationSubscribeInfo{ "
             "appNames = [" + appNames + "]" +
+            ", sortingMapDelta = " + (sortingMapDelta_ ? "true" : "false") +
             " }";
 }
 }  // namespace Notification
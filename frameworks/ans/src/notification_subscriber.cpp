@@ -15,6 +15,10 @@
 
 #include "notification_subscriber.h"
 
+#include <cinttypes>
+
+#include "event_handler.h"
+#include "event_runner.h"
 #include "iservice_registry.h"
 #include "system_ability_definition.h"
 
@@ -33,6 +37,24 @@ const sptr<NotificationSubscriber::SubscriberImpl> NotificationSubscriber::GetIm
     return impl_;
 }
 
+void NotificationSubscriber::OnBatchConsumed(const std::vector<std::shared_ptr<Notification>> &requests,
+    const std::shared_ptr<NotificationSortingMap> &sortingMap)
+{
+    for (auto &request : requests) {
+        OnConsumed(request, sortingMap);
+        OnConsumed(request);
+    }
+}
+
+void NotificationSubscriber::OnBatchCanceled(const std::vector<std::shared_ptr<Notification>> &requests,
+    const std::shared_ptr<NotificationSortingMap> &sortingMap, int32_t deleteReason)
+{
+    for (auto &request : requests) {
+        OnCanceled(request, sortingMap, deleteReason);
+        OnCanceled(request);
+    }
+}
+
 NotificationSubscriber::SubscriberImpl::SubscriberImpl(NotificationSubscriber &subscriber) : subscriber_(subscriber)
 {
     recipient_ = new (std::nothrow) DeathRecipient(*this);
@@ -64,8 +86,10 @@ void NotificationSubscriber::SubscriberImpl::OnConsumed(const sptr<Notification>
 void NotificationSubscriber::SubscriberImpl::OnConsumed(
     const sptr<Notification> &notification, const sptr<NotificationSortingMap> &notificationMap)
 {
-    subscriber_.OnConsumed(
-        std::make_shared<Notification>(*notification), std::make_shared<NotificationSortingMap>(*notificationMap));
+    std::shared_ptr<Notification> request = std::make_shared<Notification>(*notification);
+    MergeSortingMap(notificationMap, [this, request](const std::shared_ptr<NotificationSortingMap> &sortingMap) {
+        subscriber_.OnConsumed(request, sortingMap);
+    });
 }
 
 void NotificationSubscriber::SubscriberImpl::OnCanceled(const sptr<Notification> &notification)
@@ -76,14 +100,18 @@ void NotificationSubscriber::SubscriberImpl::OnCanceled(const sptr<Notification>
 void NotificationSubscriber::SubscriberImpl::OnCanceled(
     const sptr<Notification> &notification, const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason)
 {
-    subscriber_.OnCanceled(std::make_shared<Notification>(*notification),
-        std::make_shared<NotificationSortingMap>(*notificationMap),
-        deleteReason);
+    std::shared_ptr<Notification> request = std::make_shared<Notification>(*notification);
+    MergeSortingMap(notificationMap,
+        [this, request, deleteReason](const std::shared_ptr<NotificationSortingMap> &sortingMap) {
+            subscriber_.OnCanceled(request, sortingMap, deleteReason);
+        });
 }
 
 void NotificationSubscriber::SubscriberImpl::OnUpdated(const sptr<NotificationSortingMap> &notificationMap)
 {
-    subscriber_.OnUpdate(std::make_shared<NotificationSortingMap>(*notificationMap));
+    MergeSortingMap(notificationMap, [this](const std::shared_ptr<NotificationSortingMap> &sortingMap) {
+        subscriber_.OnUpdate(sortingMap);
+    });
 }
 
 void NotificationSubscriber::SubscriberImpl::OnDoNotDisturbDateChange(const sptr<NotificationDoNotDisturbDate> &date)
@@ -97,6 +125,34 @@ void NotificationSubscriber::SubscriberImpl::OnEnabledNotificationChanged(
     subscriber_.OnEnabledNotificationChanged(std::make_shared<EnabledNotificationCallbackData>(*callbackData));
 }
 
+void NotificationSubscriber::SubscriberImpl::OnConsumedList(
+    const std::vector<sptr<Notification>> &notifications, const sptr<NotificationSortingMap> &notificationMap)
+{
+    // The sorting map is merged once for the whole batch.
+    std::vector<std::shared_ptr<Notification>> requests;
+    requests.reserve(notifications.size());
+    for (auto &notification : notifications) {
+        requests.emplace_back(std::make_shared<Notification>(*notification));
+    }
+    MergeSortingMap(notificationMap, [this, requests](const std::shared_ptr<NotificationSortingMap> &sortingMap) {
+        subscriber_.OnBatchConsumed(requests, sortingMap);
+    });
+}
+
+void NotificationSubscriber::SubscriberImpl::OnCanceledList(const std::vector<sptr<Notification>> &notifications,
+    const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason)
+{
+    std::vector<std::shared_ptr<Notification>> requests;
+    requests.reserve(notifications.size());
+    for (auto &notification : notifications) {
+        requests.emplace_back(std::make_shared<Notification>(*notification));
+    }
+    MergeSortingMap(notificationMap,
+        [this, requests, deleteReason](const std::shared_ptr<NotificationSortingMap> &sortingMap) {
+            subscriber_.OnBatchCanceled(requests, sortingMap, deleteReason);
+        });
+}
+
 bool NotificationSubscriber::SubscriberImpl::GetAnsManagerProxy()
 {
     if (proxy_ == nullptr) {
@@ -124,6 +180,102 @@ bool NotificationSubscriber::SubscriberImpl::GetAnsManagerProxy()
     return true;
 }
 
+void NotificationSubscriber::SubscriberImpl::MergeSortingMap(
+    const sptr<NotificationSortingMap> &notificationMap, const SortingMapCallback &callback)
+{
+    if (notificationMap == nullptr) {
+        callback(nullptr);
+        return;
+    }
+
+    bool needResync = false;
+    std::vector<SortingMapCallback> callbacks;
+    std::shared_ptr<NotificationSortingMap> sortingMap = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(sortingMapMutex_);
+        if (!notificationMap->IsDelta()) {
+            if (notificationMap->GetVersion() != 0) {
+                sortingMap_ = notificationMap;
+            }
+            // A full sorting map ends the resync, the callbacks held back meanwhile get it first.
+            isResyncing_ = false;
+            callbacks.swap(pendingCallbacks_);
+            sortingMap = std::make_shared<NotificationSortingMap>(*notificationMap);
+        } else if (isResyncing_) {
+            pendingCallbacks_.push_back(callback);
+            return;
+        } else if ((sortingMap_ == nullptr) || !sortingMap_->ApplyDelta(*notificationMap)) {
+            ANS_LOGW("Sorting map delta of version %{public}" PRIu64 " does not apply.", notificationMap->GetVersion());
+            isResyncing_ = true;
+            pendingCallbacks_.push_back(callback);
+            needResync = true;
+        } else {
+            sortingMap = std::make_shared<NotificationSortingMap>(*sortingMap_);
+        }
+    }
+
+    if (needResync) {
+        ResyncSortingMap();
+        return;
+    }
+    for (auto &pendingCallback : callbacks) {
+        pendingCallback(std::make_shared<NotificationSortingMap>(*sortingMap));
+    }
+    callback(sortingMap);
+}
+
+void NotificationSubscriber::SubscriberImpl::ResyncSortingMap()
+{
+    // The resync is a call into the service, it must not be made from the binder thread of the callback.
+    std::shared_ptr<AppExecFwk::EventHandler> handler = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(sortingMapMutex_);
+        if (resyncHandler_ == nullptr) {
+            resyncHandler_ = std::make_shared<AppExecFwk::EventHandler>(AppExecFwk::EventRunner::Create());
+        }
+        handler = resyncHandler_;
+    }
+
+    // The full sorting map comes back through OnUpdated.
+    sptr<SubscriberImpl> self = this;
+    auto resyncTask = [self]() {
+        if (!self->GetAnsManagerProxy()) {
+            self->OnResyncSortingMapFailed();
+            return;
+        }
+        ErrCode result = self->proxy_->ResyncSortingMap(self);
+        if (result != ERR_OK) {
+            ANS_LOGE("Failed to resync sorting map, result = %{public}d.", result);
+            self->OnResyncSortingMapFailed();
+        }
+    };
+    if ((handler == nullptr) || !handler->PostTask(resyncTask)) {
+        ANS_LOGE("Failed to post the sorting map resync.");
+        OnResyncSortingMapFailed();
+    }
+}
+
+void NotificationSubscriber::SubscriberImpl::OnResyncSortingMapFailed()
+{
+    std::vector<SortingMapCallback> callbacks;
+    std::shared_ptr<NotificationSortingMap> sortingMap = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(sortingMapMutex_);
+        if (!isResyncing_) {
+            return;
+        }
+        isResyncing_ = false;
+        callbacks.swap(pendingCallbacks_);
+        if (sortingMap_ != nullptr) {
+            sortingMap = std::make_shared<NotificationSortingMap>(*sortingMap_);
+        }
+    }
+    // The callbacks are not held back forever, they get the sorting map kept so far.
+    for (auto &callback : callbacks) {
+        callback((sortingMap == nullptr) ? nullptr : std::make_shared<NotificationSortingMap>(*sortingMap));
+    }
+}
+
 NotificationSubscriber::SubscriberImpl::DeathRecipient::DeathRecipient(SubscriberImpl &subscriberImpl)
     : subscriberImpl_(subscriberImpl) {};
 
@@ -19,11 +19,17 @@
 
 namespace OHOS {
 namespace Notification {
+namespace {
+const int32_t HOUR_SECONDS = 3600;
+const int32_t MIN_SECONDS = 60;
+}
+
 const uint8_t ReminderRequestCalendar::MAX_MONTHS_OF_YEAR = 12;
 const uint8_t ReminderRequestCalendar::MAX_DAYS_OF_MONTH = 31;
 const uint8_t ReminderRequestCalendar::JANUARY = 1;
 const uint8_t ReminderRequestCalendar::DECEMBER = 12;
 const uint8_t ReminderRequestCalendar::DEFAULT_SNOOZE_TIMES = 3;
+thread_local const ReminderRequestCalendar::RefreshPass *ReminderRequestCalendar::RefreshPass::current_ = nullptr;
 
 // For database recovery.
 const std::string ReminderRequestCalendar::REPEAT_DAYS = "repeat_days";
@@ -106,50 +112,56 @@ uint8_t ReminderRequestCalendar::GetDaysOfMonth(const uint16_t &year, const uint
     return days;
 }
 
+ReminderRequestCalendar::RefreshPass::RefreshPass() : previous_(current_)
+{
+    (void)time(&now_);  // unit is seconds.
+    (void)localtime_r(&now_, &nowTime_);
+    current_ = this;
+}
+
+ReminderRequestCalendar::RefreshPass::~RefreshPass()
+{
+    current_ = previous_;
+}
+
 uint8_t ReminderRequestCalendar::GetNextDay(
     const uint16_t &settedYear, const uint8_t &settedMonth, const tm &now, const tm &target) const
 {
-    uint32_t repeatDayTmp = repeatDay_;
     uint8_t daysOfSpecialMonth = GetDaysOfMonth(settedYear, settedMonth);
-    uint8_t setDayTmp = INVALID_U8_VALUE;
-    for (uint8_t i = 1; i <= daysOfSpecialMonth; i++) {
-        if ((repeatDayTmp & (1 << (i - 1))) > 0) {
-            struct tm setTime;
-            setTime.tm_year = GetCTime(TimeTransferType::YEAR, settedYear);
-            setTime.tm_mon = GetCTime(TimeTransferType::MONTH, settedMonth);
-            setTime.tm_mday = static_cast<int>(i);
-            setTime.tm_hour = target.tm_hour;
-            setTime.tm_min = target.tm_min;
-            setTime.tm_sec = target.tm_sec;
-            setTime.tm_isdst = -1;
-
-            struct tm nowTime;
-            nowTime.tm_year = now.tm_year;
-            nowTime.tm_mon = now.tm_mon;
-            nowTime.tm_mday = now.tm_mday;
-            nowTime.tm_hour = now.tm_hour;
-            nowTime.tm_min = now.tm_min;
-            nowTime.tm_sec = now.tm_sec;
-            nowTime.tm_isdst = -1;
-
-            if (mktime(&nowTime) >= mktime(&setTime)) {
-                continue;
-            } else {
-                setDayTmp = i;
-                return setDayTmp;
-            }
+    uint32_t days = repeatDay_ & ((1U << (daysOfSpecialMonth - 1)) | ((1U << (daysOfSpecialMonth - 1)) - 1));
+    uint16_t nowYear = static_cast<uint16_t>(GetActualTime(TimeTransferType::YEAR, now.tm_year));
+    uint8_t nowMonth = static_cast<uint8_t>(GetActualTime(TimeTransferType::MONTH, now.tm_mon));
+    if ((settedYear < nowYear) || ((settedYear == nowYear) && (settedMonth < nowMonth))) {
+        return INVALID_U8_VALUE;
+    }
+    if ((settedYear == nowYear) && (settedMonth == nowMonth)) {
+        // Only the days after now are left, today is left if the time of the day is still to come.
+        int32_t nowSeconds = (now.tm_hour * HOUR_SECONDS) + (now.tm_min * MIN_SECONDS) + now.tm_sec;
+        int32_t targetSeconds = (target.tm_hour * HOUR_SECONDS) + (target.tm_min * MIN_SECONDS) + target.tm_sec;
+        int32_t firstDay = (targetSeconds > nowSeconds) ? now.tm_mday : (now.tm_mday + 1);
+        if (firstDay > daysOfSpecialMonth) {
+            return INVALID_U8_VALUE;
         }
+        days &= ~((1U << (firstDay - 1)) - 1);
     }
-    return setDayTmp;
+    if (days == 0) {
+        return INVALID_U8_VALUE;
+    }
+    return static_cast<uint8_t>(__builtin_ctz(days) + 1);
 }
 
 uint64_t ReminderRequestCalendar::GetNextTriggerTime() const
 {
     uint64_t triggerTimeInMilli = INVALID_LONG_LONG_VALUE;
     time_t now;
-    (void)time(&now);  // unit is seconds.
     struct tm nowTime;
-    (void)localtime_r(&now, &nowTime);
+    if (RefreshPass::current_ != nullptr) {
+        now = RefreshPass::current_->now_;
+        nowTime = RefreshPass::current_->nowTime_;
+    } else {
+        (void)time(&now);  // unit is seconds.
+        (void)localtime_r(&now, &nowTime);
+    }
     nowTime.tm_sec = 0;
     struct tm tarTime;
     tarTime.tm_year = GetCTime(TimeTransferType::YEAR, firstDesignateYear_);
@@ -181,25 +193,28 @@ uint64_t ReminderRequestCalendar::GetNextTriggerTime() const
 uint64_t ReminderRequestCalendar::GetNextTriggerTimeAsRepeatReminder(const tm &nowTime, const tm &tarTime) const
 {
     uint64_t triggerTimeInMilli = INVALID_LONG_LONG_VALUE;
-    uint16_t setYear = static_cast<uint16_t>(GetActualTime(TimeTransferType::YEAR, nowTime.tm_year));
+    uint16_t nowYear = static_cast<uint16_t>(GetActualTime(TimeTransferType::YEAR, nowTime.tm_year));
+    uint8_t beginMonth = static_cast<uint8_t>(GetActualTime(TimeTransferType::MONTH, nowTime.tm_mon));
+    uint16_t setYear = INVALID_U16_VALUE;
     uint8_t setMonth = INVALID_U8_VALUE;
     uint8_t setDay = INVALID_U8_VALUE;
-    uint8_t beginMonth = static_cast<uint8_t>(GetActualTime(TimeTransferType::MONTH, nowTime.tm_mon));
-    uint8_t count = 1;
-    uint16_t repeatMonthTmp = repeatMonth_;
-    for (uint8_t i = beginMonth; i < (MAX_MONTHS_OF_YEAR + beginMonth + 1); i++) {
-        if ((repeatMonthTmp & (1 << ((i - 1) % MAX_MONTHS_OF_YEAR))) > 0) {
-            setMonth = (i % MAX_MONTHS_OF_YEAR);
-            setMonth = setMonth == 0 ? DECEMBER : setMonth;
-            if (count != 1) {
-                setYear = setMonth <= beginMonth ? setYear + 1 : setYear;
-            }
-            setDay = GetNextDay(setYear, setMonth, nowTime, tarTime);
-        }
+
+    // Bit i of the mask is the month i months after the begin month, up to the begin month of next year.
+    uint32_t repeatMonth = static_cast<uint32_t>(repeatMonth_);
+    uint32_t months = (repeatMonth | (repeatMonth << MAX_MONTHS_OF_YEAR)) >> (beginMonth - 1);
+    months &= (1U << (MAX_MONTHS_OF_YEAR + 1)) - 1;
+    while (months != 0) {
+        uint8_t offset = static_cast<uint8_t>(__builtin_ctz(months));
+        months &= months - 1;
+        setMonth = static_cast<uint8_t>(((beginMonth - 1 + offset) % MAX_MONTHS_OF_YEAR) + 1);
+        setYear = ((beginMonth - 1 + offset) >= MAX_MONTHS_OF_YEAR) ? (nowYear + 1) : nowYear;
+        setDay = GetNextDay(setYear, setMonth, nowTime, tarTime);
         if (setDay != INVALID_U8_VALUE) {
             break;
         }
-        count++;
+    }
+    if (setDay == INVALID_U8_VALUE) {
+        return triggerTimeInMilli;
     }
     if ((triggerTimeInMilli = GetTimeInstantMilli(setYear, setMonth, setDay, hour_, minute_, second_))
         != INVALID_LONG_LONG_VALUE) {
@@ -34,11 +34,18 @@ const std::string REMINDER_DB_NAME = "reminder.db";
 const std::string REMINDER_DB_TABLE = "reminder";
 const uint32_t REMINDER_RDB_VERSION = 1;
 const int32_t STATE_FAIL = -1;
+const int64_t FLUSH_DELAY_MILLISECONDS = 500;
+const uint8_t MAX_FLUSH_RETRY_TIMES = 3;
 std::vector<std::string> columns;
 }
 
 const int32_t ReminderStore::STATE_OK = 0;
 
+ReminderStore::~ReminderStore()
+{
+    Flush();
+}
+
 int32_t ReminderStore::ReminderStoreDataCallBack::OnCreate(NativeRdb::RdbStore &store)
 {
     ANSR_LOGD("Create table.");
@@ -55,14 +62,19 @@ int32_t ReminderStore::ReminderStoreDataCallBack::OnUpgrade(
 }
 
 int32_t ReminderStore::Init()
+{
+    return Init(REMINDER_DB_DIR, REMINDER_DB_NAME);
+}
+
+int32_t ReminderStore::Init(const std::string &dbDir, const std::string &dbName)
 {
     ANSR_LOGD("Reminder store init.");
     int32_t errCode(STATE_FAIL);
 
-    if (access(REMINDER_DB_DIR.c_str(), F_OK) != 0) {
-        int createDir = mkdir(REMINDER_DB_DIR.c_str(), S_IRWXU);
+    if (access(dbDir.c_str(), F_OK) != 0) {
+        int createDir = mkdir(dbDir.c_str(), S_IRWXU);
         if (createDir != 0) {
-            ANSR_LOGE("Failed to create directory %{public}s", REMINDER_DB_DIR.c_str());
+            ANSR_LOGE("Failed to create directory %{public}s", dbDir.c_str());
             return errCode;
         }
     }
@@ -73,7 +85,7 @@ int32_t ReminderStore::Init()
     columns.insert(columns.begin(),
         ReminderRequest::columns.begin(), ReminderRequest::columns.end());
 
-    std::string dbConfig = REMINDER_DB_DIR + REMINDER_DB_NAME;
+    std::string dbConfig = dbDir + dbName;
     NativeRdb::RdbStoreConfig config_(dbConfig);
     ReminderStoreDataCallBack rdbDataCallBack_;
     rdbStore_ = NativeRdb::RdbHelper::GetRdbStore(config_, REMINDER_RDB_VERSION, rdbDataCallBack_, errCode);
@@ -81,6 +93,10 @@ int32_t ReminderStore::Init()
         ANSR_LOGE("ReminderStore init fail, errCode %{public}d.", errCode);
         return errCode;
     }
+    if (handler_ == nullptr) {
+        runner_ = AppExecFwk::EventRunner::Create();
+        handler_ = std::make_shared<AppExecFwk::EventHandler>(runner_);
+    }
     return ReminderStore::InitData();
 }
 
@@ -92,7 +108,7 @@ int32_t ReminderStore::InitData()
         return STATE_FAIL;
     }
     std::string deleteCondition = ReminderRequest::IS_EXPIRED + " is true";
-    ReminderStore::Delete(deleteCondition);
+    ReminderStore::Delete(deleteCondition, nullptr);
 
     int32_t statusChangedRows = STATE_FAIL;
     NativeRdb::ValuesBucket statusValues;
@@ -134,30 +150,42 @@ int32_t ReminderStore::InitData()
 
 int32_t ReminderStore::Delete(int32_t reminderId)
 {
-    std::string deleteCondition = ReminderRequest::REMINDER_ID
-        + " = " + std::to_string(reminderId);
-    return ReminderStore::Delete(deleteCondition);
+    {
+        // The queued change need not be written, the row is deleted right after the journal is.
+        std::lock_guard<std::mutex> lock(journalMutex_);
+        journal_.erase(reminderId);
+    }
+    std::string deleteCondition = ReminderRequest::REMINDER_ID + " = " + std::to_string(reminderId);
+    return ReminderStore::Delete(deleteCondition, [reminderId](int32_t id, const JournalEntry &) {
+        return id == reminderId;
+    });
 }
 
 int32_t ReminderStore::DeleteUser(int32_t userId)
 {
     std::string deleteCondition = ReminderRequest::USER_ID + " = " + std::to_string(userId);
-    return ReminderStore::Delete(deleteCondition);
+    return ReminderStore::Delete(deleteCondition, [userId](int32_t, const JournalEntry &entry) {
+        return entry.userId == userId;
+    });
 }
 
 int32_t ReminderStore::Delete(const std::string &pkg, int32_t userId)
 {
     std::string deleteCondition = ReminderRequest::PKG_NAME + " = \"" + pkg + "\" and "
         + ReminderRequest::USER_ID + " = " + std::to_string(userId);
-    return ReminderStore::Delete(deleteCondition);
+    return ReminderStore::Delete(deleteCondition, [&pkg, userId](int32_t, const JournalEntry &entry) {
+        return (entry.pkg == pkg) && (entry.userId == userId);
+    });
 }
 
-int32_t ReminderStore::Delete(const std::string &deleteCondition)
+int32_t ReminderStore::Delete(const std::string &deleteCondition, const DeletedFilter &isDeleted)
 {
     if (rdbStore_ == nullptr) {
         ANSR_LOGE("Rdb store is not initialized.");
         return STATE_FAIL;
     }
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    FlushLocked(isDeleted);
     int32_t deletedRows = STATE_FAIL;
     std::vector<std::string> whereArgs;
     int32_t result = rdbStore_->Delete(deletedRows, REMINDER_DB_TABLE, deleteCondition, whereArgs);
@@ -186,75 +214,129 @@ int64_t ReminderStore::UpdateOrInsert(
         ANSR_LOGE("BundleOption is null.");
         return isSuccess;
     }
-    if (IsReminderExist(reminder)) {
-        isSuccess = Update(reminder, bundleOption);
-    } else {
-        isSuccess = Insert(reminder, bundleOption);
+    // Every column is written, so the row is replaced as a whole and whether it exists need not be queried.
+    JournalEntry entry;
+    entry.pkg = bundleOption->GetBundleName();
+    entry.userId = reminder->GetUserId();
+    ReminderStore::GenerateData(reminder, bundleOption, entry.values);
+    Enqueue(reminder->GetReminderId(), std::move(entry));
+    return STATE_OK;
+}
+
+void ReminderStore::Enqueue(int32_t reminderId, JournalEntry &&entry)
+{
+    {
+        std::lock_guard<std::mutex> lock(journalMutex_);
+        journal_[reminderId] = std::move(entry);
+    }
+    if (!ScheduleFlush()) {
+        ANSR_LOGW("Failed to schedule the flush, flush now.");
+        Flush();
     }
-    return isSuccess;
 }
 
-int64_t ReminderStore::Insert(
-    const sptr<ReminderRequest> &reminder, const sptr<NotificationBundleOption> &bundleOption)
+bool ReminderStore::ScheduleFlush()
 {
-    if (rdbStore_ == nullptr) {
-        ANSR_LOGE("Rdb store is not initialized.");
-        return STATE_FAIL;
+    {
+        std::lock_guard<std::mutex> lock(journalMutex_);
+        if (isFlushScheduled_) {
+            return true;
+        }
+        isFlushScheduled_ = true;
     }
-    int64_t rowId = STATE_FAIL;
-    NativeRdb::ValuesBucket values;
-    ReminderStore::GenerateData(reminder, bundleOption, values);
-    int32_t result = rdbStore_->Insert(rowId, REMINDER_DB_TABLE, values);
-    if (result != NativeRdb::E_OK) {
-        ANSR_LOGE("Insert operation failed, result: %{public}d, reminderId=%{public}d.",
-            result, reminder->GetReminderId());
-        return result;
+    std::weak_ptr<ReminderStore> weakStore = weak_from_this();
+    auto flushTask = [weakStore]() {
+        std::shared_ptr<ReminderStore> store = weakStore.lock();
+        if (store != nullptr) {
+            store->Flush();
+        }
+    };
+    if ((handler_ == nullptr) || weakStore.expired() || !handler_->PostTask(flushTask, FLUSH_DELAY_MILLISECONDS)) {
+        std::lock_guard<std::mutex> lock(journalMutex_);
+        isFlushScheduled_ = false;
+        return false;
     }
-    ANSR_LOGD("Insert successfully, reminderId=%{public}d.", reminder->GetReminderId());
-    return result;
+    return true;
 }
 
-int64_t ReminderStore::Update(
-    const sptr<ReminderRequest> &reminder, const sptr<NotificationBundleOption> &bundleOption)
+int32_t ReminderStore::Flush()
+{
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    return FlushLocked();
+}
+
+int32_t ReminderStore::FlushLocked(const DeletedFilter &isDeleted)
 {
+    std::map<int32_t, JournalEntry> journal;
+    {
+        std::lock_guard<std::mutex> lock(journalMutex_);
+        journal.swap(journal_);
+        isFlushScheduled_ = false;
+    }
+    if (journal.empty()) {
+        return STATE_OK;
+    }
     if (rdbStore_ == nullptr) {
         ANSR_LOGE("Rdb store is not initialized.");
         return STATE_FAIL;
     }
-    int32_t changedRows = STATE_FAIL;
-    NativeRdb::ValuesBucket values;
-    ReminderStore::GenerateData(reminder, bundleOption, values);
-    std::string updateCondition = ReminderRequest::REMINDER_ID
-        + " = " + std::to_string(reminder->GetReminderId());
-    std::vector<std::string> whereArgs;
-    int32_t result = rdbStore_->Update(changedRows, REMINDER_DB_TABLE, values, updateCondition, whereArgs);
-    if ((result != NativeRdb::E_OK) || (changedRows <= 0)) {
-        ANSR_LOGE("Update operation failed, result: %{public}d, updated rows: %{public}d, reminderId=%{public}d.",
-            result, changedRows, reminder->GetReminderId());
-        return result;
-    }
-    ANSR_LOGD("Update successfully, updated rows: %{public}d, reminderId=%{public}d.",
-        changedRows, reminder->GetReminderId());
+
+    int32_t result = rdbStore_->BeginTransaction();
+    for (auto it = journal.begin(); (result == NativeRdb::E_OK) && (it != journal.end()); ++it) {
+        result = WriteEntry(it->first, it->second);
+    }
+    if (result == NativeRdb::E_OK) {
+        result = rdbStore_->Commit();
+    } else {
+        rdbStore_->RollBack();
+    }
+    if (result == NativeRdb::E_OK) {
+        ANSR_LOGD("Flush successfully, changes: %{public}zu.", journal.size());
+        return STATE_OK;
+    }
+
+    // One bad change must not roll the others back on every retry, so they are written one by one.
+    ANSR_LOGE("Flush failed, result: %{public}d, changes: %{public}zu.", result, journal.size());
+    std::map<int32_t, JournalEntry> failed;
+    for (auto &item : journal) {
+        // The row is deleted right after, so a change which fails must not write it back on the retry.
+        if ((isDeleted != nullptr) && isDeleted(item.first, item.second)) {
+            continue;
+        }
+        if (WriteEntry(item.first, item.second) == NativeRdb::E_OK) {
+            continue;
+        }
+        if (++item.second.failedTimes >= MAX_FLUSH_RETRY_TIMES) {
+            ANSR_LOGE("Drop the change after %{public}d failed writes, reminderId=%{public}d.",
+                static_cast<int32_t>(item.second.failedTimes), item.first);
+            continue;
+        }
+        failed.emplace(item.first, std::move(item.second));
+    }
+    if (failed.empty()) {
+        return STATE_OK;
+    }
+    {
+        std::lock_guard<std::mutex> lock(journalMutex_);
+        // emplace keeps the changes queued meanwhile, they are newer.
+        for (auto &item : failed) {
+            journal_.emplace(item.first, std::move(item.second));
+        }
+    }
+    if (!ScheduleFlush()) {
+        ANSR_LOGW("Failed to schedule the retry, it is written with the next change.");
+    }
     return result;
 }
 
-bool ReminderStore::IsReminderExist(const sptr<ReminderRequest> &reminder)
+int32_t ReminderStore::WriteEntry(int32_t reminderId, const JournalEntry &entry)
 {
-    std::string queryCondition = "select " + ReminderRequest::REMINDER_ID
-        + " from " + REMINDER_DB_TABLE + " where "
-        + ReminderRequest::REMINDER_ID + " = " + std::to_string(reminder->GetReminderId());
-    std::vector<std::string> whereArgs;
-    std::unique_ptr<NativeRdb::AbsSharedResultSet> queryResultSet = rdbStore_->QuerySql(queryCondition, whereArgs);
-    if (queryResultSet == nullptr) {
-        ANSR_LOGE("QueryResultSet is null.");
-        return false;
-    }
-    int32_t resultNum;
-    queryResultSet->GetRowCount(resultNum);
-    if (resultNum == 0) {
-        return false;
+    int64_t rowId = STATE_FAIL;
+    int32_t result = rdbStore_->Replace(rowId, REMINDER_DB_TABLE, entry.values);
+    if (result != NativeRdb::E_OK) {
+        ANSR_LOGE("Write operation failed, result: %{public}d, reminderId=%{public}d.", result, reminderId);
     }
-    return true;
+    return result;
 }
 
 std::shared_ptr<NativeRdb::AbsSharedResultSet> ReminderStore::Query(const std::string &queryCondition) const
@@ -287,6 +369,7 @@ int32_t ReminderStore::GetMaxId()
         ANSR_LOGE("Rdb store is not initialized.");
         return STATE_FAIL;
     }
+    Flush();
     std::string queryCondition = "select " + ReminderRequest::REMINDER_ID
         + " from " + REMINDER_DB_TABLE + " order by "
         + ReminderRequest::REMINDER_ID + " desc";
@@ -320,7 +403,87 @@ std::vector<sptr<ReminderRequest>> ReminderStore::GetAllValidReminders()
     return GetReminders(queryCondition);
 }
 
+bool ReminderStore::GetAllValidSchedule(ReminderSchedule &schedule)
+{
+    if (rdbStore_ == nullptr) {
+        ANSR_LOGE("Rdb store is not initialized.");
+        return false;
+    }
+    Flush();
+    std::string queryCondition = "select " + ReminderRequest::REMINDER_ID + ", "
+        + ReminderRequest::TRIGGER_TIME + ", " + ReminderRequest::PKG_NAME + ", "
+        + ReminderRequest::UID + " from " + REMINDER_DB_TABLE + " where "
+        + ReminderRequest::IS_EXPIRED + " is false order by "
+        + ReminderRequest::TRIGGER_TIME + " asc";
+    std::shared_ptr<NativeRdb::AbsSharedResultSet> queryResultSet = Query(queryCondition);
+    if (queryResultSet == nullptr) {
+        ANSR_LOGE("QueryResultSet is null.");
+        return false;
+    }
+    int32_t rowCount = 0;
+    queryResultSet->GetRowCount(rowCount);
+    if (rowCount > 0) {
+        size_t size = static_cast<size_t>(rowCount);
+        schedule.reminderIds.reserve(size);
+        schedule.triggerTimes.reserve(size);
+        schedule.bundleNames.reserve(size);
+        schedule.uids.reserve(size);
+    }
+    // The column indexes follow the order of the select.
+    const int32_t reminderIdIndex = 0;
+    const int32_t triggerTimeIndex = 1;
+    const int32_t bundleNameIndex = 2;
+    const int32_t uidIndex = 3;
+    while (queryResultSet->GoToNextRow() == NativeRdb::E_OK) {
+        int32_t reminderId = 0;
+        int64_t triggerTime = 0;
+        std::string bundleName;
+        int32_t uid = 0;
+        queryResultSet->GetInt(reminderIdIndex, reminderId);
+        queryResultSet->GetLong(triggerTimeIndex, triggerTime);
+        queryResultSet->GetString(bundleNameIndex, bundleName);
+        queryResultSet->GetInt(uidIndex, uid);
+        schedule.reminderIds.push_back(reminderId);
+        schedule.triggerTimes.push_back(static_cast<uint64_t>(triggerTime));
+        schedule.bundleNames.push_back(std::move(bundleName));
+        schedule.uids.push_back(uid);
+    }
+    ANSR_LOGD("Size=%{public}zu", schedule.reminderIds.size());
+    return true;
+}
+
+sptr<ReminderRequest> ReminderStore::GetReminder(int32_t reminderId)
+{
+    std::string queryCondition = "select * from " + REMINDER_DB_TABLE + " where "
+        + ReminderRequest::REMINDER_ID + " = " + std::to_string(reminderId);
+    std::vector<sptr<ReminderRequest>> reminders;
+    {
+        // Only a change queued for this reminder needs to be written before it is read.
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        bool isQueued = false;
+        {
+            std::lock_guard<std::mutex> journalLock(journalMutex_);
+            isQueued = (journal_.find(reminderId) != journal_.end());
+        }
+        if (isQueued) {
+            FlushLocked();
+        }
+        reminders = QueryReminders(queryCondition);
+    }
+    if (reminders.empty() || (reminders.front() == nullptr)) {
+        ANSR_LOGW("Reminder not found, reminderId=%{public}d.", reminderId);
+        return nullptr;
+    }
+    return reminders.front();
+}
+
 std::vector<sptr<ReminderRequest>> ReminderStore::GetReminders(const std::string &queryCondition)
+{
+    Flush();
+    return QueryReminders(queryCondition);
+}
+
+std::vector<sptr<ReminderRequest>> ReminderStore::QueryReminders(const std::string &queryCondition)
 {
     std::vector<sptr<ReminderRequest>> reminders;
     if (rdbStore_ == nullptr) {
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <gtest/gtest.h>
+
+#include "notification_binary_convert.h"
+#include "notification_conversational_content.h"
+#include "notification_json_convert.h"
+#include "notification_long_text_content.h"
+#include "notification_multiline_content.h"
+#include "notification_request.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace Notification {
+namespace {
+sptr<NotificationRequest> CreateLongTextRequest()
+{
+    auto longTextContent = std::make_shared<NotificationLongTextContent>("long text");
+    longTextContent->SetTitle("title");
+    longTextContent->SetText("text");
+    longTextContent->SetBriefText("brief text");
+    longTextContent->SetExpandedTitle("expanded title");
+
+    sptr<NotificationRequest> request = new NotificationRequest(-1);
+    request->SetContent(std::make_shared<NotificationContent>(longTextContent));
+    request->SetSlotType(NotificationConstant::SlotType::SOCIAL_COMMUNICATION);
+    request->SetLabel("label");
+    request->SetCreatorBundleName("creator");
+    request->SetOwnerBundleName("owner");
+    request->SetCreatorUid(20010001);
+    request->SetReceiverUserId(100);
+    request->SetColor(0xff00ff00);
+    request->SetBadgeNumber(9);
+    request->SetDeliveryTime(1650000000000);
+    request->SetInProgress(true);
+    request->SetTapDismissed(false);
+    request->SetDistributed(true);
+
+    auto flags = std::make_shared<NotificationFlags>();
+    flags->SetSoundEnabled(NotificationConstant::FlagStatus::OPEN);
+    flags->SetVibrationEnabled(NotificationConstant::FlagStatus::CLOSE);
+    request->SetFlags(flags);
+    request->AddActionButton(NotificationActionButton::Create(nullptr, "button", nullptr));
+    return request;
+}
+
+std::string ConvertToBinaryString(const NotificationBinaryConvertionBase *convertionBase)
+{
+    std::string binaryString;
+    EXPECT_TRUE(NotificationBinaryConverter::ConvertToBinaryString(convertionBase, binaryString));
+    return binaryString;
+}
+}  // namespace
+
+class NotificationBinaryConvertTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/**
+ * @tc.name: ConvertFromBinaryString_00100
+ * @tc.desc: the fields of a request and its content are kept by the binary format, which is smaller than the json.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NotificationBinaryConvertTest, ConvertFromBinaryString_00100, Function | SmallTest | Level1)
+{
+    sptr<NotificationRequest> request = CreateLongTextRequest();
+    std::string binaryString = ConvertToBinaryString(request);
+    EXPECT_TRUE(NotificationBinaryConverter::IsBinaryString(binaryString));
+
+    std::string jsonString;
+    EXPECT_TRUE(NotificationJsonConverter::ConvertToJsonString(request, jsonString));
+    EXPECT_FALSE(NotificationBinaryConverter::IsBinaryString(jsonString));
+    EXPECT_LT(binaryString.size(), jsonString.size());
+
+    std::unique_ptr<NotificationRequest> result(
+        NotificationBinaryConverter::ConvertFromBinaryString<NotificationRequest>(binaryString));
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->GetNotificationId(), -1);
+    EXPECT_EQ(result->GetSlotType(), NotificationConstant::SlotType::SOCIAL_COMMUNICATION);
+    EXPECT_EQ(result->GetLabel(), "label");
+    EXPECT_EQ(result->GetCreatorBundleName(), "creator");
+    EXPECT_EQ(result->GetOwnerBundleName(), "owner");
+    EXPECT_EQ(result->GetCreatorUid(), 20010001);
+    EXPECT_EQ(result->GetReceiverUserId(), 100);
+    EXPECT_EQ(result->GetColor(), 0xff00ff00);
+    EXPECT_EQ(result->GetBadgeNumber(), 9);
+    EXPECT_EQ(result->GetDeliveryTime(), 1650000000000);
+    EXPECT_TRUE(result->IsInProgress());
+    EXPECT_FALSE(result->IsTapDismissed());
+    EXPECT_TRUE(result->GetNotificationDistributedOptions().IsDistributed());
+    ASSERT_NE(result->GetFlags(), nullptr);
+    EXPECT_EQ(result->GetFlags()->IsSoundEnabled(), NotificationConstant::FlagStatus::OPEN);
+    EXPECT_EQ(result->GetFlags()->IsVibrationEnabled(), NotificationConstant::FlagStatus::CLOSE);
+    ASSERT_EQ(result->GetActionButtons().size(), 1);
+    EXPECT_EQ(result->GetActionButtons()[0]->GetTitle(), "button");
+
+    ASSERT_NE(result->GetContent(), nullptr);
+    EXPECT_EQ(result->GetContent()->GetContentType(), NotificationContent::Type::LONG_TEXT);
+    auto longTextContent = std::static_pointer_cast<NotificationLongTextContent>(
+        result->GetContent()->GetNotificationContent());
+    EXPECT_EQ(longTextContent->GetTitle(), "title");
+    EXPECT_EQ(longTextContent->GetText(), "text");
+    EXPECT_EQ(longTextContent->GetLongText(), "long text");
+    EXPECT_EQ(longTextContent->GetBriefText(), "brief text");
+    EXPECT_EQ(longTextContent->GetExpandedTitle(), "expanded title");
+}
+
+/**
+ * @tc.name: ConvertFromBinaryString_00200
+ * @tc.desc: the nested objects and the repeated fields of a conversation are kept by the binary format.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NotificationBinaryConvertTest, ConvertFromBinaryString_00200, Function | SmallTest | Level1)
+{
+    MessageUser user;
+    user.SetKey("key");
+    user.SetName("user");
+    user.SetMachine(true);
+    auto conversationalContent = std::make_shared<NotificationConversationalContent>(user);
+    conversationalContent->SetConversationTitle("conversation");
+    conversationalContent->SetConversationGroup(true);
+    conversationalContent->AddConversationalMessage("first", 1, user);
+    conversationalContent->AddConversationalMessage("second", 2, user);
+    NotificationContent content(conversationalContent);
+
+    std::unique_ptr<NotificationContent> result(
+        NotificationBinaryConverter::ConvertFromBinaryString<NotificationContent>(ConvertToBinaryString(&content)));
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->GetContentType(), NotificationContent::Type::CONVERSATION);
+    auto resultContent = std::static_pointer_cast<NotificationConversationalContent>(
+        result->GetNotificationContent());
+    EXPECT_EQ(resultContent->GetMessageUser().GetKey(), "key");
+    EXPECT_TRUE(resultContent->GetMessageUser().IsMachine());
+    EXPECT_EQ(resultContent->GetConversationTitle(), "conversation");
+    EXPECT_TRUE(resultContent->IsConversationGroup());
+    auto messages = resultContent->GetAllConversationalMessages();
+    ASSERT_EQ(messages.size(), 2);
+    EXPECT_EQ(messages[0]->GetText(), "first");
+    EXPECT_EQ(messages[1]->GetArrivedTime(), 2);
+    EXPECT_EQ(messages[1]->GetSender().GetName(), "user");
+
+    auto multiLineContent = std::make_shared<NotificationMultiLineContent>();
+    multiLineContent->AddSingleLine("line1");
+    multiLineContent->AddSingleLine("");
+    multiLineContent->AddSingleLine("line3");
+    NotificationContent multiLine(multiLineContent);
+    result.reset(
+        NotificationBinaryConverter::ConvertFromBinaryString<NotificationContent>(ConvertToBinaryString(&multiLine)));
+    ASSERT_NE(result, nullptr);
+    auto lines = std::static_pointer_cast<NotificationMultiLineContent>(
+        result->GetNotificationContent())->GetAllLines();
+    EXPECT_EQ(lines, std::vector<std::string>({"line1", "", "line3"}));
+}
+
+/**
+ * @tc.name: ConvertFromBinaryString_00300
+ * @tc.desc: the fields of a later version are skipped, a malformed or a json string is rejected.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NotificationBinaryConvertTest, ConvertFromBinaryString_00300, Function | SmallTest | Level1)
+{
+    NotificationFlags flags;
+    flags.SetSoundEnabled(NotificationConstant::FlagStatus::OPEN);
+    std::string binaryString = ConvertToBinaryString(&flags);
+
+    const uint32_t unknownTag = 100;
+    NotificationBinaryWriter writer;
+    writer.Append(binaryString);
+    writer.WriteString(unknownTag, "field of a later version");
+    writer.WriteInt(unknownTag + 1, -1);
+    std::unique_ptr<NotificationFlags> result(
+        NotificationBinaryConverter::ConvertFromBinaryString<NotificationFlags>(writer.GetData()));
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->IsSoundEnabled(), NotificationConstant::FlagStatus::OPEN);
+
+    std::string truncated = writer.GetData().substr(0, writer.GetData().size() - 1);
+    EXPECT_EQ(NotificationBinaryConverter::ConvertFromBinaryString<NotificationFlags>(truncated), nullptr);
+
+    std::string jsonString;
+    EXPECT_TRUE(NotificationJsonConverter::ConvertToJsonString(&flags, jsonString));
+    EXPECT_EQ(NotificationBinaryConverter::ConvertFromBinaryString<NotificationFlags>(jsonString), nullptr);
+    EXPECT_EQ(NotificationBinaryConverter::ConvertFromBinaryString<NotificationFlags>(""), nullptr);
+}
+}  // namespace Notification
+}  // namespace OHOS
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <vector>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include "ans_const_define.h"
+#include "ans_image_util.h"
+#include "ashmem.h"
+#include "message_parcel.h"
+#include "notification_picture_content.h"
+#include "notification_request.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace Notification {
+namespace {
+constexpr int32_t PICTURE_SIZE = 256;
+constexpr int32_t ICON_SIZE = 16;
+
+std::shared_ptr<Media::PixelMap> CreatePixelMap(int32_t size, uint32_t color)
+{
+    std::vector<uint32_t> colors(size * size, color);
+    Media::InitializationOptions opts;
+    opts.size.width = size;
+    opts.size.height = size;
+    opts.pixelFormat = Media::PixelFormat::RGBA_8888;
+    return Media::PixelMap::Create(colors.data(), colors.size(), opts);
+}
+
+sptr<NotificationRequest> CreatePictureRequest()
+{
+    auto pictureContent = std::make_shared<NotificationPictureContent>();
+    pictureContent->SetTitle("title");
+    pictureContent->SetText("text");
+    pictureContent->SetBigPicture(CreatePixelMap(PICTURE_SIZE, 0xff0000ff));
+    sptr<NotificationRequest> request = new NotificationRequest(1);
+    request->SetContent(std::make_shared<NotificationContent>(pictureContent));
+    request->SetLittleIcon(CreatePixelMap(ICON_SIZE, 0xff00ff00));
+    return request;
+}
+
+std::shared_ptr<Media::PixelMap> GetBigPicture(const sptr<NotificationRequest> &request)
+{
+    auto pictureContent = std::static_pointer_cast<NotificationPictureContent>(
+        request->GetContent()->GetNotificationContent());
+    return pictureContent->GetBigPicture();
+}
+
+bool IsSamePixels(const std::shared_ptr<Media::PixelMap> &left, const std::shared_ptr<Media::PixelMap> &right)
+{
+    return (left != nullptr) && (right != nullptr) && (left->GetByteCount() == right->GetByteCount()) &&
+        (memcmp(left->GetPixels(), right->GetPixels(), left->GetByteCount()) == 0);
+}
+}  // namespace
+
+class NotificationRequestParcelTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/**
+ * @tc.name: SharedImage_00100
+ * @tc.desc: the big picture is passed as shared memory and the small icon in the parcel.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NotificationRequestParcelTest, SharedImage_00100, Function | SmallTest | Level1)
+{
+    sptr<NotificationRequest> request = CreatePictureRequest();
+    MessageParcel parcel;
+    {
+        AnsImageUtil::SharedImageScope scope(parcel);
+        EXPECT_TRUE(parcel.WriteParcelable(request));
+    }
+    EXPECT_LT(parcel.GetDataSize(), static_cast<size_t>(AnsImageUtil::SHARED_IMAGE_MIN_SIZE));
+
+    sptr<NotificationRequest> result;
+    {
+        AnsImageUtil::SharedImageScope scope(parcel);
+        result = parcel.ReadParcelable<NotificationRequest>();
+    }
+    ASSERT_NE(result, nullptr);
+    EXPECT_TRUE(IsSamePixels(GetBigPicture(result), GetBigPicture(request)));
+    EXPECT_TRUE(IsSamePixels(result->GetLittleIcon(), request->GetLittleIcon()));
+    EXPECT_EQ(GetBigPicture(result)->GetWidth(), PICTURE_SIZE);
+}
+
+/**
+ * @tc.name: SharedImage_00200
+ * @tc.desc: a received shared image is passed on with the memory it was received in.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NotificationRequestParcelTest, SharedImage_00200, Function | SmallTest | Level1)
+{
+    sptr<NotificationRequest> request = CreatePictureRequest();
+    MessageParcel parcel;
+    {
+        AnsImageUtil::SharedImageScope scope(parcel);
+        EXPECT_TRUE(parcel.WriteParcelable(request));
+    }
+    sptr<NotificationRequest> received;
+    {
+        AnsImageUtil::SharedImageScope scope(parcel);
+        received = parcel.ReadParcelable<NotificationRequest>();
+    }
+    ASSERT_NE(received, nullptr);
+
+    MessageParcel forward;
+    {
+        AnsImageUtil::SharedImageScope scope(forward);
+        EXPECT_TRUE(forward.WriteParcelable(received));
+    }
+    sptr<NotificationRequest> result;
+    {
+        AnsImageUtil::SharedImageScope scope(forward);
+        result = forward.ReadParcelable<NotificationRequest>();
+    }
+    ASSERT_NE(result, nullptr);
+    EXPECT_TRUE(IsSamePixels(GetBigPicture(result), GetBigPicture(request)));
+}
+
+/**
+ * @tc.name: SharedImage_00400
+ * @tc.desc: a shared image of an untrusted sender is copied into read-only memory of the receiver and passed on.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NotificationRequestParcelTest, SharedImage_00400, Function | SmallTest | Level1)
+{
+    sptr<NotificationRequest> request = CreatePictureRequest();
+    MessageParcel parcel;
+    {
+        AnsImageUtil::SharedImageScope scope(parcel);
+        EXPECT_TRUE(parcel.WriteParcelable(request));
+    }
+    sptr<NotificationRequest> received;
+    {
+        AnsImageUtil::SharedImageScope scope(parcel, true);
+        received = parcel.ReadParcelable<NotificationRequest>();
+    }
+    ASSERT_NE(received, nullptr);
+    EXPECT_TRUE(AnsImageUtil::IsSharedImage(GetBigPicture(received)));
+    EXPECT_FALSE(AnsImageUtil::IsSharedImage(received->GetLittleIcon()));
+    EXPECT_TRUE(IsSamePixels(GetBigPicture(received), GetBigPicture(request)));
+
+    MessageParcel forward;
+    {
+        AnsImageUtil::SharedImageScope scope(forward);
+        EXPECT_TRUE(forward.WriteParcelable(received));
+    }
+    sptr<NotificationRequest> result;
+    {
+        AnsImageUtil::SharedImageScope scope(forward);
+        result = forward.ReadParcelable<NotificationRequest>();
+    }
+    ASSERT_NE(result, nullptr);
+    EXPECT_TRUE(IsSamePixels(GetBigPicture(result), GetBigPicture(request)));
+}
+
+/**
+ * @tc.name: SharedImage_00500
+ * @tc.desc: a shared image larger than the max picture size is rejected before being mapped.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NotificationRequestParcelTest, SharedImage_00500, Function | SmallTest | Level1)
+{
+    const int32_t bytesPerPixel = 4;
+    const int32_t width = 1024;
+    const int32_t height = MAX_SHARED_PICTURE_SIZE / (width * bytesPerPixel) + 1;
+    const int32_t byteCount = width * height * bytesPerPixel;
+    int fd = AshmemCreate("test image", byteCount);
+    ASSERT_GE(fd, 0);
+
+    MessageParcel parcel;
+    AnsImageUtil::SharedImageScope scope(parcel, true);
+    EXPECT_TRUE(parcel.WriteBool(true));
+    EXPECT_TRUE(parcel.WriteInt32(width));
+    EXPECT_TRUE(parcel.WriteInt32(height));
+    EXPECT_TRUE(parcel.WriteInt32(static_cast<int32_t>(Media::PixelFormat::RGBA_8888)));
+    EXPECT_TRUE(parcel.WriteInt32(static_cast<int32_t>(Media::ColorSpace::SRGB)));
+    EXPECT_TRUE(parcel.WriteInt32(static_cast<int32_t>(Media::AlphaType::IMAGE_ALPHATYPE_PREMUL)));
+    EXPECT_TRUE(parcel.WriteInt32(0));
+    EXPECT_TRUE(parcel.WriteInt32(byteCount));
+    EXPECT_TRUE(parcel.WriteFileDescriptor(fd));
+    ::close(fd);
+
+    EXPECT_EQ(AnsImageUtil::ReadImage(parcel), nullptr);
+}
+
+/**
+ * @tc.name: SharedImage_00300
+ * @tc.desc: without a scope the images are written in the parcel.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NotificationRequestParcelTest, SharedImage_00300, Function | SmallTest | Level1)
+{
+    sptr<NotificationRequest> request = CreatePictureRequest();
+    MessageParcel parcel;
+    EXPECT_TRUE(parcel.WriteParcelable(request));
+
+    sptr<NotificationRequest> result = parcel.ReadParcelable<NotificationRequest>();
+    ASSERT_NE(result, nullptr);
+    EXPECT_TRUE(IsSamePixels(GetBigPicture(result), GetBigPicture(request)));
+}
+}  // namespace Notification
+}  // namespace OHOS
@@ -15,9 +15,11 @@
 
 #include <gtest/gtest.h>
 
+#define private public
 #include "ans_log_wrapper.h"
 #include "reminder_request_calendar.h"
 #include "reminder_helper.h"
+#undef private
 
 using namespace testing::ext;
 namespace OHOS {
@@ -76,6 +78,18 @@ public:
         }
         return true;
     }
+
+    uint64_t GetTimeInMilli(int year, int month, int day, int hour, int minute)
+    {
+        struct tm time = {};
+        time.tm_year = year - 1900;
+        time.tm_mon = month - 1;
+        time.tm_mday = day;
+        time.tm_hour = hour;
+        time.tm_min = minute;
+        time.tm_isdst = -1;
+        return ReminderRequest::GetDurationSinceEpochInMilli(mktime(&time));
+    }
 };
 
 /**
@@ -329,5 +343,59 @@ HWTEST_F(ReminderRequestCalendarTest, initDateTime_00900, Function | SmallTest |
     EXPECT_TRUE(1 == calendar->GetMinute()) << "Set minute error.";
     EXPECT_TRUE(0 == calendar->GetSecond()) << "Set seconds error.";
 }
+/**
+ * @tc.name: GetNextTriggerTimeAsRepeatReminder_00100
+ * @tc.desc: Check the next trigger time skips the repeat months without the repeat day.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ReminderRequestCalendarTest, GetNextTriggerTimeAsRepeatReminder_00100, Function | SmallTest | Level1)
+{
+    struct tm nowTime;
+    auto calendar = ReminderRequestCalendarTest::CreateCalendar(nowTime);
+    ASSERT_NE(calendar, nullptr);
+    calendar->SetRepeatMonths({2, 4});
+    calendar->SetRepeatDaysOfMonth({30});
+    calendar->hour_ = 9;
+    calendar->minute_ = 0;
+
+    struct tm now = {};
+    now.tm_year = 2022 - 1900;
+    now.tm_mon = 10;
+    now.tm_mday = 15;
+    now.tm_hour = 10;
+    struct tm target = {};
+    target.tm_hour = 9;
+    EXPECT_EQ(calendar->GetNextTriggerTimeAsRepeatReminder(now, target), GetTimeInMilli(2023, 4, 30, 9, 0));
+}
+
+/**
+ * @tc.name: GetNextTriggerTimeAsRepeatReminder_00200
+ * @tc.desc: Check today is the next trigger day only if the time of the day is still to come.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ReminderRequestCalendarTest, GetNextTriggerTimeAsRepeatReminder_00200, Function | SmallTest | Level1)
+{
+    struct tm nowTime;
+    auto calendar = ReminderRequestCalendarTest::CreateCalendar(nowTime);
+    ASSERT_NE(calendar, nullptr);
+    calendar->SetRepeatMonths({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+    calendar->SetRepeatDaysOfMonth({1});
+    calendar->minute_ = 0;
+
+    struct tm now = {};
+    now.tm_year = 2022 - 1900;
+    now.tm_mon = 2;
+    now.tm_mday = 1;
+    now.tm_hour = 9;
+    struct tm target = {};
+    target.tm_hour = 8;
+    calendar->hour_ = 8;
+    EXPECT_EQ(calendar->GetNextTriggerTimeAsRepeatReminder(now, target), GetTimeInMilli(2022, 4, 1, 8, 0));
+    target.tm_hour = 10;
+    calendar->hour_ = 10;
+    EXPECT_EQ(calendar->GetNextTriggerTimeAsRepeatReminder(now, target), GetTimeInMilli(2022, 3, 1, 10, 0));
+}
+}
 }
-}
\ No newline at end of file
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#include "reminder_store.h"
+#include "reminder_request_alarm.h"
+#include "reminder_request_calendar.h"
+#include "rdb_helper.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace Notification {
+namespace {
+const std::string TEST_DB_PATH = "/data/test/reminder_store_test.db";
+const std::string TEST_BUNDLE_NAME = "bundleName";
+const int32_t TEST_UID = 1000;
+
+sptr<ReminderRequest> CreateReminder(int32_t reminderId, const std::string &title)
+{
+    std::vector<uint8_t> daysOfWeek;
+    sptr<ReminderRequest> reminder = new ReminderRequestAlarm(0, 0, daysOfWeek);
+    reminder->SetReminderId(reminderId);
+    reminder->SetTitle(title);
+    return reminder;
+}
+}  // namespace
+
+class ReminderStoreTest : public testing::Test {
+public:
+    static void SetUpTestCase()
+    {
+        ReminderRequest::InitDbColumns();
+        ReminderRequestCalendar::InitDbColumns();
+        ReminderRequestAlarm::InitDbColumns();
+    }
+    static void TearDownTestCase() {};
+
+    void SetUp()
+    {
+        NativeRdb::RdbHelper::DeleteRdbStore(TEST_DB_PATH);
+        store_ = std::make_shared<ReminderStore>();
+        NativeRdb::RdbStoreConfig config(TEST_DB_PATH);
+        ReminderStore::ReminderStoreDataCallBack callBack;
+        int32_t errCode = NativeRdb::E_OK;
+        store_->rdbStore_ = NativeRdb::RdbHelper::GetRdbStore(config, 1, callBack, errCode);
+        ASSERT_NE(store_->rdbStore_, nullptr);
+        // The runner is not started, so the scheduled flushes only run when the test calls Flush().
+        store_->runner_ = AppExecFwk::EventRunner::Create(false);
+        store_->handler_ = std::make_shared<AppExecFwk::EventHandler>(store_->runner_);
+    }
+
+    void TearDown()
+    {
+        store_ = nullptr;
+        NativeRdb::RdbHelper::DeleteRdbStore(TEST_DB_PATH);
+    }
+
+    int32_t GetRowCount(int32_t reminderId, const std::string &title = "")
+    {
+        std::string queryCondition = "select * from reminder where " + ReminderRequest::REMINDER_ID + " = "
+            + std::to_string(reminderId);
+        if (!title.empty()) {
+            queryCondition += " and " + ReminderRequest::TITLE + " = '" + title + "'";
+        }
+        int32_t count = 0;
+        auto resultSet = store_->Query(queryCondition);
+        if (resultSet != nullptr) {
+            resultSet->GetRowCount(count);
+            resultSet->Close();
+        }
+        return count;
+    }
+
+    std::shared_ptr<ReminderStore> store_ = nullptr;
+    sptr<NotificationBundleOption> bundleOption_ = new NotificationBundleOption(TEST_BUNDLE_NAME, TEST_UID);
+};
+
+/**
+ * @tc.number    : ReminderStoreTest_00100
+ * @tc.name      : Journal_0100
+ * @tc.desc      : Test the changes of one reminder are coalesced and written by one scheduled flush
+ */
+HWTEST_F(ReminderStoreTest, ReminderStoreTest_00100, Function | SmallTest | Level1)
+{
+    EXPECT_EQ(store_->UpdateOrInsert(CreateReminder(1, "first"), bundleOption_), ReminderStore::STATE_OK);
+    EXPECT_EQ(store_->UpdateOrInsert(CreateReminder(1, "second"), bundleOption_), ReminderStore::STATE_OK);
+    EXPECT_EQ(store_->UpdateOrInsert(CreateReminder(2, "other"), bundleOption_), ReminderStore::STATE_OK);
+    EXPECT_EQ(store_->journal_.size(), 2);
+    EXPECT_TRUE(store_->isFlushScheduled_);
+    EXPECT_EQ(GetRowCount(1), 0);
+
+    EXPECT_EQ(store_->Flush(), ReminderStore::STATE_OK);
+    EXPECT_TRUE(store_->journal_.empty());
+    EXPECT_FALSE(store_->isFlushScheduled_);
+    EXPECT_EQ(GetRowCount(1, "second"), 1);
+    EXPECT_EQ(GetRowCount(2), 1);
+}
+
+/**
+ * @tc.number    : ReminderStoreTest_00200
+ * @tc.name      : Journal_0200
+ * @tc.desc      : Test a delete drops the queued update of the reminder and deletes the written row at once
+ */
+HWTEST_F(ReminderStoreTest, ReminderStoreTest_00200, Function | SmallTest | Level1)
+{
+    store_->UpdateOrInsert(CreateReminder(1, "first"), bundleOption_);
+    store_->UpdateOrInsert(CreateReminder(2, "other"), bundleOption_);
+    store_->Delete(1);
+    EXPECT_TRUE(store_->journal_.empty());
+    EXPECT_EQ(GetRowCount(1), 0);
+    EXPECT_EQ(GetRowCount(2), 1);
+
+    store_->UpdateOrInsert(CreateReminder(2, "updated"), bundleOption_);
+    EXPECT_EQ(store_->Delete(2), 1);
+    EXPECT_TRUE(store_->journal_.empty());
+    EXPECT_EQ(GetRowCount(2), 0);
+}
+
+/**
+ * @tc.number    : ReminderStoreTest_00300
+ * @tc.name      : Journal_0300
+ * @tc.desc      : Test a failed change does not hold the others back, is retried by a scheduled flush
+ *                 and is dropped after the retries
+ */
+HWTEST_F(ReminderStoreTest, ReminderStoreTest_00300, Function | SmallTest | Level1)
+{
+    store_->UpdateOrInsert(CreateReminder(1, "first"), bundleOption_);
+    ReminderStore::JournalEntry badEntry;
+    badEntry.values.PutInt("no_such_column", 0);
+    store_->Enqueue(2, std::move(badEntry));
+
+    EXPECT_NE(store_->Flush(), ReminderStore::STATE_OK);
+    EXPECT_EQ(GetRowCount(1), 1);
+    ASSERT_EQ(store_->journal_.size(), 1);
+    EXPECT_EQ(store_->journal_.begin()->first, 2);
+    EXPECT_EQ(store_->journal_.begin()->second.failedTimes, 1);
+    EXPECT_TRUE(store_->isFlushScheduled_);
+
+    EXPECT_NE(store_->Flush(), ReminderStore::STATE_OK);
+    EXPECT_EQ(store_->journal_.size(), 1);
+    EXPECT_EQ(store_->Flush(), ReminderStore::STATE_OK);
+    EXPECT_TRUE(store_->journal_.empty());
+    EXPECT_FALSE(store_->isFlushScheduled_);
+}
+}  // namespace Notification
+}  // namespace OHOS
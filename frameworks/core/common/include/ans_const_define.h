@@ -28,10 +28,14 @@ namespace Notification {
 constexpr size_t MAX_ACTIVE_NUM = 1000;
 constexpr uint32_t MAX_ACTIVE_NUM_PERAPP = 100;
 constexpr uint32_t MAX_ACTIVE_NUM_PERSECOND = 10;
+// Max number of notifications published or canceled in one batch
+constexpr size_t MAX_NOTIFICATION_BATCH_NUM = 100;
 constexpr size_t MAX_SLOT_NUM = 5;
 constexpr size_t MAX_SLOT_GROUP_NUM = 4;
 constexpr uint32_t MAX_ICON_SIZE = 50 * 1024;
 constexpr uint32_t MAX_PICTURE_SIZE = 2 * 1024 * 1024;
+// Max size of a picture passed as shared memory, not copied through the binder buffer.
+constexpr uint32_t MAX_SHARED_PICTURE_SIZE = 4 * 1024 * 1024;
 constexpr bool SUPPORT_DO_NOT_DISTRUB = true;
 constexpr uint32_t SYSTEM_SERVICE_UID = 1000;
 
@@ -15,11 +15,16 @@
 #ifndef BASE_NOTIFICATION_ANS_STANDARD_FRAMEWORKS_ANS_CORE_INCLUDE_ANS_IMAGE_UTIL_H
 #define BASE_NOTIFICATION_ANS_STANDARD_FRAMEWORKS_ANS_CORE_INCLUDE_ANS_IMAGE_UTIL_H
 
+#include <functional>
+#include <map>
 #include <memory>
 #include <string>
+#include "parcel.h"
 #include "pixel_map.h"
 
 namespace OHOS {
+class MessageParcel;
+
 namespace Notification {
 class AnsImageUtil {
 public:
@@ -28,13 +33,84 @@ public:
     static const uint8_t SHIFT_FOUR;
     static const uint8_t NUM_TEN;
     static const size_t  TWO_TIMES;
+    static const std::string IMAGE_REFERENCE_PREFIX;
+    static const int32_t SHARED_IMAGE_MIN_SIZE;
+
+    /**
+     * Images of an object being converted to or from json, carried beside the json instead of inside it.
+     */
+    struct ImageAttachments {
+        std::map<std::string, std::string> images;  // content hash -> packed image
+        // Finds an image referenced by the json that is not in the images yet.
+        std::function<bool(const std::string &hash, std::string &image)> resolver;
+    };
+
+    /**
+     * While a scope is open on a thread, PackImage adds the images to the attachments and returns references
+     * to them, and UnPackImage resolves the references from the attachments.
+     */
+    class AttachmentScope {
+    public:
+        explicit AttachmentScope(ImageAttachments &attachments);
+        ~AttachmentScope();
+
+        AttachmentScope(const AttachmentScope &) = delete;
+        AttachmentScope &operator=(const AttachmentScope &) = delete;
+
+    private:
+        ImageAttachments *previous_ {nullptr};
+    };
+
+    /**
+     * While a scope is open on a thread for a message parcel, WriteImage passes the large images written to the
+     * parcel as read-only shared memory, and ReadImage maps the shared images read from it. With copyOnRead, used for
+     * the parcels of untrusted senders which may keep their memory writable, ReadImage copies the shared images into
+     * read-only memory owned by this process.
+     */
+    class SharedImageScope {
+    public:
+        explicit SharedImageScope(MessageParcel &parcel, bool copyOnRead = false);
+        ~SharedImageScope();
+
+        SharedImageScope(const SharedImageScope &) = delete;
+        SharedImageScope &operator=(const SharedImageScope &) = delete;
+
+    private:
+        MessageParcel *previous_ {nullptr};
+        bool previousCopyOnRead_ {false};
+    };
+
+    /**
+     * @brief Writes an image to a parcel.
+     *
+     * @param parcel Indicates the parcel.
+     * @param pixelMap Indicates the image, not null.
+     * @return Returns true if succeed; returns false otherwise.
+     */
+    static bool WriteImage(Parcel &parcel, const std::shared_ptr<Media::PixelMap> &pixelMap);
+
+    /**
+     * @brief Reads an image written by WriteImage from a parcel.
+     *
+     * @param parcel Indicates the parcel.
+     * @return Returns the image, the pixels of a shared image are mapped read-only.
+     */
+    static std::shared_ptr<Media::PixelMap> ReadImage(Parcel &parcel);
+
+    /**
+     * @brief Checks whether the pixels of an image are in shared memory mapped by ReadImage.
+     *
+     * @param pixelMap Indicates the image.
+     * @return Returns true if the image was received as shared memory; returns false otherwise.
+     */
+    static bool IsSharedImage(const std::shared_ptr<Media::PixelMap> &pixelMap);
 
     /**
      * @brief Packs an image to a string.
      *
      * @param pixelMap Indicates the image to be packaged.
      * @param format Indicates the format of the image.
-     * @return Returns a string.
+     * @return Returns a hexadecimal string, or a reference to the image if an AttachmentScope is open.
      */
     static std::string PackImage(
         const std::shared_ptr<Media::PixelMap> &pixelMap, const std::string &format = IMAGE_FORMAT_JPEG);
@@ -42,11 +118,37 @@ public:
     /**
      * @brief Unpacks the string to an image.
      *
-     * @param pixelMapStr Indicates the string of image.
+     * @param pixelMapStr Indicates the string of image, a hexadecimal string or a reference to the image.
      * @return Returns an image object.
      */
     static std::shared_ptr<Media::PixelMap> UnPackImage(const std::string &pixelMapStr);
 
+    /**
+     * @brief Packs an image to a binary string.
+     *
+     * @param pixelMap Indicates the image to be packaged.
+     * @param format Indicates the format of the image.
+     * @return Returns a binary string.
+     */
+    static std::string PackImageToBinary(
+        const std::shared_ptr<Media::PixelMap> &pixelMap, const std::string &format = IMAGE_FORMAT_JPEG);
+
+    /**
+     * @brief Unpacks the binary string to an image.
+     *
+     * @param image Indicates the binary string of image.
+     * @return Returns an image object.
+     */
+    static std::shared_ptr<Media::PixelMap> UnPackBinaryImage(const std::string &image);
+
+    /**
+     * @brief Obtains the SHA-256 hash of a packed image, the same images have the same hash on all devices.
+     *
+     * @param image Indicates the binary string of image.
+     * @return Returns the hash, a hexadecimal string.
+     */
+    static std::string ContentHash(const std::string &image);
+
     /**
      * @brief Packs an image to a file.
      *
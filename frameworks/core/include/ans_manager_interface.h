@@ -74,6 +74,30 @@ public:
      */
     virtual ErrCode Cancel(int notificationId, const std::string &label) = 0;
 
+    /**
+     * @brief Publishes notifications with a specified label in one batch. The notifications are applied in order
+     * in one service task, each new one counts against the per-second publish limit, and each subscriber gets them
+     * in one callback.
+     *
+     * @param label Indicates the label of the notifications to publish.
+     * @param notifications Indicates the NotificationRequest objects, at most MAX_NOTIFICATION_BATCH_NUM.
+     * @param results Indicates the result of each notification, in the order of the requests.
+     * @return Returns ERR_OK if every notification is published, otherwise the first failure.
+     */
+    virtual ErrCode PublishBatch(const std::string &label, const std::vector<sptr<NotificationRequest>> &notifications,
+        std::vector<ErrCode> &results) = 0;
+
+    /**
+     * @brief Cancels published notifications matching the specified label and notification ids in one batch.
+     *
+     * @param label Indicates the label of the notifications to cancel.
+     * @param notificationIds Indicates the IDs of the notifications to cancel, at most MAX_NOTIFICATION_BATCH_NUM.
+     * @param results Indicates the result of each notification, in the order of the IDs.
+     * @return Returns ERR_OK if every notification is canceled, otherwise the first failure.
+     */
+    virtual ErrCode CancelBatch(
+        const std::string &label, const std::vector<int32_t> &notificationIds, std::vector<ErrCode> &results) = 0;
+
     /**
      * @brief Cancels all the published notifications.
      *
@@ -466,6 +490,14 @@ public:
     virtual ErrCode Unsubscribe(
         const sptr<AnsSubscriberInterface> &subscriber, const sptr<NotificationSubscribeInfo> &info) = 0;
 
+    /**
+     * @brief Requests the full sorting map for a subscriber that receives sorting map deltas.
+     *
+     * @param subscriber Indicates the subscriber.
+     * @return Returns ERR_OK on success, others on failure.
+     */
+    virtual ErrCode ResyncSortingMap(const sptr<AnsSubscriberInterface> &subscriber) = 0;
+
     /**
      * @brief Obtains whether notifications are suspended.
      *
@@ -795,7 +827,10 @@ protected:
         SET_DO_NOT_DISTURB_DATE_BY_USER,
         GET_DO_NOT_DISTURB_DATE_BY_USER,
         SET_ENABLED_FOR_BUNDLE_SLOT,
-        GET_ENABLED_FOR_BUNDLE_SLOT
+        GET_ENABLED_FOR_BUNDLE_SLOT,
+        RESYNC_SORTING_MAP,
+        PUBLISH_NOTIFICATION_BATCH,
+        CANCEL_NOTIFICATION_BATCH
     };
 };
 }  // namespace Notification
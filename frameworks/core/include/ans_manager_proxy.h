@@ -62,6 +62,30 @@ public:
      */
     ErrCode Cancel(int32_t notificationId, const std::string &label) override;
 
+    /**
+     * @brief Publishes notifications with a specified label in one batch. The notifications are applied in order
+     * in one service task, each new one counts against the per-second publish limit, and each subscriber gets them
+     * in one callback.
+     *
+     * @param label Indicates the label of the notifications to publish.
+     * @param notifications Indicates the NotificationRequest objects, at most MAX_NOTIFICATION_BATCH_NUM.
+     * @param results Indicates the result of each notification, in the order of the requests.
+     * @return Returns ERR_OK if every notification is published, otherwise the first failure.
+     */
+    ErrCode PublishBatch(const std::string &label, const std::vector<sptr<NotificationRequest>> &notifications,
+        std::vector<ErrCode> &results) override;
+
+    /**
+     * @brief Cancels published notifications matching the specified label and notification ids in one batch.
+     *
+     * @param label Indicates the label of the notifications to cancel.
+     * @param notificationIds Indicates the IDs of the notifications to cancel, at most MAX_NOTIFICATION_BATCH_NUM.
+     * @param results Indicates the result of each notification, in the order of the IDs.
+     * @return Returns ERR_OK if every notification is canceled, otherwise the first failure.
+     */
+    ErrCode CancelBatch(const std::string &label, const std::vector<int32_t> &notificationIds,
+        std::vector<ErrCode> &results) override;
+
     /**
      * @brief Cancels all the published notifications.
      *
@@ -453,6 +477,14 @@ public:
     ErrCode Unsubscribe(const sptr<AnsSubscriberInterface> &subscriber,
         const sptr<NotificationSubscribeInfo> &info) override;
 
+    /**
+     * @brief Requests the full sorting map for a subscriber that receives sorting map deltas.
+     *
+     * @param subscriber Indicates the subscriber.
+     * @return Returns ERR_OK on success, others on failure.
+     */
+    ErrCode ResyncSortingMap(const sptr<AnsSubscriberInterface> &subscriber) override;
+
     /**
      * @brief Obtains whether notifications are suspended.
      *
@@ -205,6 +205,31 @@ public:
      */
     ErrCode CancelNotification(const std::string &label, int32_t notificationId);
 
+    /**
+     * @brief Publishes notifications with a specified label in one batch.
+     * @note The notifications are published in order. A notification with the same ID as a published one updates it.
+     *       Each new notification counts against the per-second publish limit as if published alone, and each
+     *       subscriber receives the batch in one callback.
+     *
+     * @param label Indicates the label of the notifications to publish.
+     * @param requests Indicates the NotificationRequest objects, at most MAX_NOTIFICATION_BATCH_NUM.
+     * @param results Indicates the publish result of each request, in the order of the requests.
+     * @return Returns ERR_OK if every notification is published, otherwise the first failure.
+     */
+    ErrCode PublishNotificationBatch(const std::string &label, const std::vector<NotificationRequest> &requests,
+        std::vector<ErrCode> &results);
+
+    /**
+     * @brief Cancels published notifications matching the specified label and notification ids in one batch.
+     *
+     * @param label Indicates the label of the notifications to cancel.
+     * @param notificationIds Indicates the IDs of the notifications to cancel, at most MAX_NOTIFICATION_BATCH_NUM.
+     * @param results Indicates the cancel result of each ID, in the order of the IDs.
+     * @return Returns ERR_OK if every notification is canceled, otherwise the first failure.
+     */
+    ErrCode CancelNotificationBatch(
+        const std::string &label, const std::vector<int32_t> &notificationIds, std::vector<ErrCode> &results);
+
     /**
      * @brief Cancels all the published notifications.
      * @note To cancel a specified notification, see CancelNotification(int_32).
@@ -864,6 +889,14 @@ private:
      */
     bool CanPublishMediaContent(const NotificationRequest &request) const;
 
+    /**
+     * @brief Checks whether the request can be published on the local device.
+     *
+     * @param request Indicates the specified request.
+     * @return Returns ERR_OK if the request can be published; returns the reason otherwise.
+     */
+    ErrCode CheckPublishRequest(const NotificationRequest &request);
+
     /**
      * @brief Checks whether the picture size exceeds the limit in PixelMap.
      *
@@ -79,6 +79,46 @@ public:
     virtual void OnCanceled(const sptr<Notification> &notification, const sptr<NotificationSortingMap> &notificationMap,
         int32_t deleteReason) = 0;
 
+    /**
+     * @brief The callback function on a notification published, which carries the notification once and is
+     * delivered to the subscriber as OnConsumed with the sorting map and then OnConsumed without it.
+     *
+     * @param notification Indicates the consumed notification.
+     * @param notificationMap Indicates the NotificationSortingMap object, or nullptr if there is none.
+     */
+    virtual void OnConsumedCombined(
+        const sptr<Notification> &notification, const sptr<NotificationSortingMap> &notificationMap) = 0;
+
+    /**
+     * @brief The callback function on a notification canceled, which carries the notification once and is
+     * delivered to the subscriber as OnCanceled with the sorting map and then OnCanceled without it.
+     *
+     * @param notification Indicates the canceled notification.
+     * @param notificationMap Indicates the NotificationSortingMap object, or nullptr if there is none.
+     * @param deleteReason Indicates the delete reason.
+     */
+    virtual void OnCanceledCombined(const sptr<Notification> &notification,
+        const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason) = 0;
+
+    /**
+     * @brief The callback function on notifications published in one batch.
+     *
+     * @param notifications Indicates the consumed notifications, in publish order.
+     * @param notificationMap Indicates the NotificationSortingMap object after the batch, or nullptr if there is none.
+     */
+    virtual void OnConsumedList(
+        const std::vector<sptr<Notification>> &notifications, const sptr<NotificationSortingMap> &notificationMap) = 0;
+
+    /**
+     * @brief The callback function on notifications canceled in one batch.
+     *
+     * @param notifications Indicates the canceled notifications, in cancel order.
+     * @param notificationMap Indicates the NotificationSortingMap object after the batch, or nullptr if there is none.
+     * @param deleteReason Indicates the delete reason.
+     */
+    virtual void OnCanceledList(const std::vector<sptr<Notification>> &notifications,
+        const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason) = 0;
+
     /**
      * @brief The callback function on the notifications updated.
      *
@@ -111,6 +151,10 @@ protected:
         ON_UPDATED,
         ON_DND_DATE_CHANGED,
         ON_ENABLED_NOTIFICATION_CHANGED,
+        ON_CONSUMED_COMBINED,
+        ON_CANCELED_COMBINED,
+        ON_CONSUMED_LIST,
+        ON_CANCELED_LIST,
     };
 };
 }  // namespace Notification
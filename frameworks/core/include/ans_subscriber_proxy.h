@@ -71,6 +71,44 @@ public:
     void OnCanceled(const sptr<Notification> &notification, const sptr<NotificationSortingMap> &notificationMap,
         int32_t deleteReason) override;
 
+    /**
+     * @brief The callback function on a notification published, sent in one transaction.
+     *
+     * @param notification Indicates the consumed notification.
+     * @param notificationMap Indicates the NotificationSortingMap object, or nullptr if there is none.
+     */
+    void OnConsumedCombined(
+        const sptr<Notification> &notification, const sptr<NotificationSortingMap> &notificationMap) override;
+
+    /**
+     * @brief The callback function on a notification canceled, sent in one transaction.
+     *
+     * @param notification Indicates the canceled notification.
+     * @param notificationMap Indicates the NotificationSortingMap object, or nullptr if there is none.
+     * @param deleteReason Indicates the delete reason.
+     */
+    void OnCanceledCombined(const sptr<Notification> &notification,
+        const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason) override;
+
+    /**
+     * @brief The callback function on notifications published in one batch, sent in one transaction.
+     *
+     * @param notifications Indicates the consumed notifications, in publish order.
+     * @param notificationMap Indicates the NotificationSortingMap object after the batch, or nullptr if there is none.
+     */
+    void OnConsumedList(const std::vector<sptr<Notification>> &notifications,
+        const sptr<NotificationSortingMap> &notificationMap) override;
+
+    /**
+     * @brief The callback function on notifications canceled in one batch, sent in one transaction.
+     *
+     * @param notifications Indicates the canceled notifications, in cancel order.
+     * @param notificationMap Indicates the NotificationSortingMap object after the batch, or nullptr if there is none.
+     * @param deleteReason Indicates the delete reason.
+     */
+    void OnCanceledList(const std::vector<sptr<Notification>> &notifications,
+        const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason) override;
+
     /**
      * @brief The callback function on the notifications updated.
      *
@@ -94,6 +132,8 @@ public:
 
 private:
     ErrCode InnerTransact(uint32_t code, MessageOption &flags, MessageParcel &data, MessageParcel &reply);
+    bool WriteNotificationList(const std::vector<sptr<Notification>> &notifications,
+        const sptr<NotificationSortingMap> &notificationMap, MessageParcel &data);
     static inline BrokerDelegator<AnsSubscriberProxy> delegator_;
 };
 }  // namespace Notification
@@ -81,6 +81,48 @@ public:
     void OnCanceled(const sptr<Notification> &notification, const sptr<NotificationSortingMap> &notificationMap,
         int32_t deleteReason) override;
 
+    /**
+     * @brief The callback function on a notification published, which calls OnConsumed with the sorting map
+     * and then OnConsumed without it.
+     *
+     * @param notification Indicates the consumed notification.
+     * @param notificationMap Indicates the NotificationSortingMap object, or nullptr if there is none.
+     */
+    void OnConsumedCombined(
+        const sptr<Notification> &notification, const sptr<NotificationSortingMap> &notificationMap) override;
+
+    /**
+     * @brief The callback function on a notification canceled, which calls OnCanceled with the sorting map
+     * and then OnCanceled without it.
+     *
+     * @param notification Indicates the canceled notification.
+     * @param notificationMap Indicates the NotificationSortingMap object, or nullptr if there is none.
+     * @param deleteReason Indicates the delete reason.
+     */
+    void OnCanceledCombined(const sptr<Notification> &notification,
+        const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason) override;
+
+    /**
+     * @brief The callback function on notifications published in one batch, which calls OnConsumedCombined
+     * for each notification.
+     *
+     * @param notifications Indicates the consumed notifications, in publish order.
+     * @param notificationMap Indicates the NotificationSortingMap object after the batch, or nullptr if there is none.
+     */
+    void OnConsumedList(const std::vector<sptr<Notification>> &notifications,
+        const sptr<NotificationSortingMap> &notificationMap) override;
+
+    /**
+     * @brief The callback function on notifications canceled in one batch, which calls OnCanceledCombined
+     * for each notification.
+     *
+     * @param notifications Indicates the canceled notifications, in cancel order.
+     * @param notificationMap Indicates the NotificationSortingMap object after the batch, or nullptr if there is none.
+     * @param deleteReason Indicates the delete reason.
+     */
+    void OnCanceledList(const std::vector<sptr<Notification>> &notifications,
+        const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason) override;
+
     /**
      * @brief The callback function on the notifications updated.
      *
@@ -111,6 +153,12 @@ private:
     ErrCode HandleOnConsumedMap(MessageParcel &data, MessageParcel &reply);
     ErrCode HandleOnCanceled(MessageParcel &data, MessageParcel &reply);
     ErrCode HandleOnCanceledMap(MessageParcel &data, MessageParcel &reply);
+    ErrCode HandleOnConsumedCombined(MessageParcel &data, MessageParcel &reply);
+    ErrCode HandleOnCanceledCombined(MessageParcel &data, MessageParcel &reply);
+    ErrCode HandleOnConsumedList(MessageParcel &data, MessageParcel &reply);
+    ErrCode HandleOnCanceledList(MessageParcel &data, MessageParcel &reply);
+    bool ReadNotificationList(std::vector<sptr<Notification>> &notifications,
+        sptr<NotificationSortingMap> &notificationMap, MessageParcel &data);
     ErrCode HandleOnUpdated(MessageParcel &data, MessageParcel &reply);
     ErrCode HandleOnDoNotDisturbDateChange(MessageParcel &data, MessageParcel &reply);
     ErrCode HandleOnEnabledNotificationChanged(MessageParcel &data, MessageParcel &reply);
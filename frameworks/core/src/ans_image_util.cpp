@@ -13,9 +13,21 @@
  * limitations under the License.
  */
 #include "ans_image_util.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "ans_const_define.h"
 #include "ans_log_wrapper.h"
+#include "ashmem.h"
 #include "image_packer.h"
 #include "image_source.h"
+#include "media_errors.h"
+#include "message_parcel.h"
+#include "openssl/sha.h"
+#include "securec.h"
 
 namespace OHOS {
 namespace Notification {
@@ -24,8 +36,272 @@ const uint8_t AnsImageUtil::IMAGE_QUALITY {100};
 const uint8_t AnsImageUtil::SHIFT_FOUR {4};
 const uint8_t AnsImageUtil::NUM_TEN {10};
 const size_t  AnsImageUtil::TWO_TIMES {2};
+const std::string AnsImageUtil::IMAGE_REFERENCE_PREFIX {"@image:"};
+const int32_t AnsImageUtil::SHARED_IMAGE_MIN_SIZE {32 * 1024};
+
+namespace {
+thread_local AnsImageUtil::ImageAttachments *g_attachments = nullptr;
+thread_local MessageParcel *g_sharedParcel = nullptr;
+thread_local bool g_copySharedImages = false;
+
+constexpr char SHARED_IMAGE_NAME[] = "notification image";
+// Max number of shared images keeping their memory open to be passed on, the others are passed on in a new memory.
+constexpr size_t MAX_OPEN_SHARED_IMAGE_NUM = 128;
+
+// The shared memory of the images mapped by ReadImage, by the address of the pixels. The memory is -1 once closed.
+std::mutex g_sharedImagesMutex;
+std::unordered_map<const void *, int> g_sharedImages;
+size_t g_openSharedImageNum = 0;
+
+void ReleaseSharedImage(void *addr, void *context, uint32_t size)
+{
+    int fd = -1;
+    {
+        std::lock_guard<std::mutex> lock(g_sharedImagesMutex);
+        auto iter = g_sharedImages.find(addr);
+        if (iter != g_sharedImages.end()) {
+            fd = iter->second;
+            g_sharedImages.erase(iter);
+            if (fd >= 0) {
+                g_openSharedImageNum--;
+            }
+        }
+    }
+    ::munmap(addr, size);
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+void AddSharedImage(const void *addr, int fd)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_sharedImagesMutex);
+        if (g_openSharedImageNum < MAX_OPEN_SHARED_IMAGE_NUM) {
+            g_sharedImages[addr] = fd;
+            g_openSharedImageNum++;
+            return;
+        }
+        // The mapping stays valid without the descriptor.
+        g_sharedImages[addr] = -1;
+    }
+    ::close(fd);
+}
+
+bool FindSharedImage(const void *addr)
+{
+    std::lock_guard<std::mutex> lock(g_sharedImagesMutex);
+    return g_sharedImages.find(addr) != g_sharedImages.end();
+}
+
+int GetSharedImageFd(const void *addr)
+{
+    std::lock_guard<std::mutex> lock(g_sharedImagesMutex);
+    auto iter = g_sharedImages.find(addr);
+    return (iter == g_sharedImages.end()) ? -1 : iter->second;
+}
+
+// Copies the pixels into a new shared memory, which is then restricted to PROT_READ so that no one writes it.
+int CreateSharedImage(const void *pixels, size_t size)
+{
+    int fd = AshmemCreate(SHARED_IMAGE_NAME, size);
+    if (fd < 0) {
+        ANS_LOGE("create shared memory failed");
+        return -1;
+    }
+    void *addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        ANS_LOGE("map shared memory failed");
+        ::close(fd);
+        return -1;
+    }
+    bool result = (memcpy_s(addr, size, pixels, size) == EOK);
+    ::munmap(addr, size);
+    if (!result || (AshmemSetProt(fd, PROT_READ) < 0)) {
+        ANS_LOGE("fill shared memory failed");
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+}  // namespace
+
+AnsImageUtil::AttachmentScope::AttachmentScope(ImageAttachments &attachments) : previous_(g_attachments)
+{
+    g_attachments = &attachments;
+}
+
+AnsImageUtil::AttachmentScope::~AttachmentScope()
+{
+    g_attachments = previous_;
+}
+
+AnsImageUtil::SharedImageScope::SharedImageScope(MessageParcel &parcel, bool copyOnRead)
+    : previous_(g_sharedParcel), previousCopyOnRead_(g_copySharedImages)
+{
+    g_sharedParcel = &parcel;
+    g_copySharedImages = copyOnRead;
+}
+
+AnsImageUtil::SharedImageScope::~SharedImageScope()
+{
+    g_sharedParcel = previous_;
+    g_copySharedImages = previousCopyOnRead_;
+}
+
+bool AnsImageUtil::WriteImage(Parcel &parcel, const std::shared_ptr<Media::PixelMap> &pixelMap)
+{
+    bool shared = (g_sharedParcel != nullptr) && (&parcel == g_sharedParcel) && (pixelMap->GetPixels() != nullptr) &&
+        (pixelMap->GetByteCount() >= SHARED_IMAGE_MIN_SIZE);
+    if (!parcel.WriteBool(shared)) {
+        return false;
+    }
+    if (!shared) {
+        return parcel.WriteParcelable(pixelMap.get());
+    }
+
+    Media::ImageInfo info;
+    pixelMap->GetImageInfo(info);
+    if (!parcel.WriteInt32(info.size.width) || !parcel.WriteInt32(info.size.height) ||
+        !parcel.WriteInt32(static_cast<int32_t>(info.pixelFormat)) ||
+        !parcel.WriteInt32(static_cast<int32_t>(info.colorSpace)) ||
+        !parcel.WriteInt32(static_cast<int32_t>(info.alphaType)) || !parcel.WriteInt32(info.baseDensity) ||
+        !parcel.WriteInt32(pixelMap->GetByteCount())) {
+        return false;
+    }
+
+    // An image mapped by ReadImage is passed on with the memory it was received in.
+    int fd = GetSharedImageFd(pixelMap->GetPixels());
+    if (fd >= 0) {
+        return g_sharedParcel->WriteFileDescriptor(fd);
+    }
+
+    // The receivers only get to map the image read-only.
+    fd = CreateSharedImage(pixelMap->GetPixels(), static_cast<size_t>(pixelMap->GetByteCount()));
+    if (fd < 0) {
+        return false;
+    }
+    bool result = g_sharedParcel->WriteFileDescriptor(fd);
+    ::close(fd);
+    return result;
+}
+
+std::shared_ptr<Media::PixelMap> AnsImageUtil::ReadImage(Parcel &parcel)
+{
+    if (!parcel.ReadBool()) {
+        return std::shared_ptr<Media::PixelMap>(parcel.ReadParcelable<Media::PixelMap>());
+    }
+    if ((g_sharedParcel == nullptr) || (&parcel != g_sharedParcel)) {
+        ANS_LOGW("no shared memory for the image");
+        return {};
+    }
+
+    Media::ImageInfo info;
+    info.size.width = parcel.ReadInt32();
+    info.size.height = parcel.ReadInt32();
+    info.pixelFormat = static_cast<Media::PixelFormat>(parcel.ReadInt32());
+    info.colorSpace = static_cast<Media::ColorSpace>(parcel.ReadInt32());
+    info.alphaType = static_cast<Media::AlphaType>(parcel.ReadInt32());
+    info.baseDensity = parcel.ReadInt32();
+    int32_t byteCount = parcel.ReadInt32();
+    int fd = g_sharedParcel->ReadFileDescriptor();
+    if (fd < 0) {
+        ANS_LOGE("read shared memory failed");
+        return {};
+    }
+    int regionSize = AshmemGetSize(fd);
+    // Bounded before anything is mapped or copied, the sender chooses the size.
+    if ((byteCount < SHARED_IMAGE_MIN_SIZE) || (static_cast<uint32_t>(byteCount) > MAX_SHARED_PICTURE_SIZE) ||
+        (regionSize < byteCount)) {
+        ANS_LOGE("invalid shared image size %{public}d", byteCount);
+        ::close(fd);
+        return {};
+    }
+
+    auto pixelMap = std::make_shared<Media::PixelMap>();
+    if ((pixelMap->SetImageInfo(info) != Media::SUCCESS) || (pixelMap->GetByteCount() != byteCount)) {
+        ANS_LOGE("invalid shared image info");
+        ::close(fd);
+        return {};
+    }
+    uint32_t size = static_cast<uint32_t>(byteCount);
+    void *addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        ANS_LOGE("map shared memory failed");
+        ::close(fd);
+        return {};
+    }
+    if (g_copySharedImages) {
+        // The sender may still write its memory, the image is copied once into memory of this process, which is
+        // the one passed on.
+        int copyFd = CreateSharedImage(addr, size);
+        ::munmap(addr, size);
+        ::close(fd);
+        if (copyFd < 0) {
+            return {};
+        }
+        fd = copyFd;
+        addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (addr == MAP_FAILED) {
+            ANS_LOGE("map shared memory failed");
+            ::close(fd);
+            return {};
+        }
+    }
+    AddSharedImage(addr, fd);
+    pixelMap->SetPixelsAddr(addr, nullptr, size, Media::AllocatorType::CUSTOM_ALLOC, ReleaseSharedImage);
+    return pixelMap;
+}
+
+bool AnsImageUtil::IsSharedImage(const std::shared_ptr<Media::PixelMap> &pixelMap)
+{
+    return (pixelMap != nullptr) && (pixelMap->GetPixels() != nullptr) && FindSharedImage(pixelMap->GetPixels());
+}
 
 std::string AnsImageUtil::PackImage(const std::shared_ptr<Media::PixelMap> &pixelMap, const std::string &format)
+{
+    std::string pixelMapStr = PackImageToBinary(pixelMap, format);
+    if (pixelMapStr.empty()) {
+        return {};
+    }
+
+    if (g_attachments != nullptr) {
+        std::string hash = ContentHash(pixelMapStr);
+        g_attachments->images.emplace(hash, std::move(pixelMapStr));
+        return IMAGE_REFERENCE_PREFIX + hash;
+    }
+    return BinToHex(pixelMapStr);
+}
+
+std::shared_ptr<Media::PixelMap> AnsImageUtil::UnPackImage(const std::string &pixelMapStr)
+{
+    if (pixelMapStr.empty()) {
+        return {};
+    }
+
+    if (pixelMapStr.compare(0, IMAGE_REFERENCE_PREFIX.size(), IMAGE_REFERENCE_PREFIX) != 0) {
+        return UnPackBinaryImage(HexToBin(pixelMapStr));
+    }
+
+    if (g_attachments == nullptr) {
+        ANS_LOGW("no attachments for the image reference");
+        return {};
+    }
+    std::string hash = pixelMapStr.substr(IMAGE_REFERENCE_PREFIX.size());
+    auto iter = g_attachments->images.find(hash);
+    if (iter == g_attachments->images.end()) {
+        std::string image;
+        if (!g_attachments->resolver || !g_attachments->resolver(hash, image)) {
+            ANS_LOGW("image %{public}s not found", hash.c_str());
+            return {};
+        }
+        iter = g_attachments->images.emplace(hash, std::move(image)).first;
+    }
+    return UnPackBinaryImage(iter->second);
+}
+
+std::string AnsImageUtil::PackImageToBinary(
+    const std::shared_ptr<Media::PixelMap> &pixelMap, const std::string &format)
 {
     if (!pixelMap || format.empty()) {
         ANS_LOGW("invalid parameters");
@@ -63,17 +339,15 @@ std::string AnsImageUtil::PackImage(const std::shared_ptr<Media::PixelMap> &pixe
     delete [] pbuf;
     pbuf = nullptr;
 
-    return BinToHex(pixelMapStr);
+    return pixelMapStr;
 }
 
-std::shared_ptr<Media::PixelMap> AnsImageUtil::UnPackImage(const std::string &pixelMapStr)
+std::shared_ptr<Media::PixelMap> AnsImageUtil::UnPackBinaryImage(const std::string &binStr)
 {
-    if (pixelMapStr.empty()) {
+    if (binStr.empty()) {
         return {};
     }
 
-    auto binStr = HexToBin(pixelMapStr);
-
     uint32_t errorCode {0};
     Media::SourceOptions opts;
     auto imageSource = Media::ImageSource::CreateImageSource(
@@ -159,6 +433,14 @@ std::shared_ptr<Media::PixelMap> AnsImageUtil::CreatePixelMap(const std::string
     return pixelMap;
 }
 
+std::string AnsImageUtil::ContentHash(const std::string &image)
+{
+    // A collision would show the image of another notification, so the hash has to be a cryptographic one.
+    unsigned char digest[SHA256_DIGEST_LENGTH] = {0};
+    SHA256(reinterpret_cast<const unsigned char *>(image.data()), image.size(), digest);
+    return BinToHex(std::string(reinterpret_cast<const char *>(digest), SHA256_DIGEST_LENGTH));
+}
+
 std::string AnsImageUtil::BinToHex(const std::string &strBin)
 {
     if (strBin.empty()) {
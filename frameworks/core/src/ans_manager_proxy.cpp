@@ -15,6 +15,7 @@
 
 #include "ans_manager_proxy.h"
 #include "ans_const_define.h"
+#include "ans_image_util.h"
 #include "ans_inner_errors.h"
 #include "ans_log_wrapper.h"
 #include "message_option.h"
@@ -40,6 +41,7 @@ ErrCode AnsManagerProxy::Publish(const std::string &label, const sptr<Notificati
     }
 
     MessageParcel data;
+    AnsImageUtil::SharedImageScope imageScope(data);
     if (!data.WriteInterfaceToken(AnsManagerProxy::GetDescriptor())) {
         ANS_LOGE("[Publish] fail: write interface token failed.");
         return ERR_ANS_PARCELABLE_FAILED;
@@ -79,6 +81,7 @@ ErrCode AnsManagerProxy::PublishToDevice(const sptr<NotificationRequest> &notifi
     }
 
     MessageParcel data;
+    AnsImageUtil::SharedImageScope imageScope(data);
     if (!data.WriteInterfaceToken(AnsManagerProxy::GetDescriptor())) {
         ANS_LOGE("[PublishToDevice] fail: write interface token failed.");
         return ERR_ANS_PARCELABLE_FAILED;
@@ -144,6 +147,97 @@ ErrCode AnsManagerProxy::Cancel(int32_t notificationId, const std::string &label
     return result;
 }
 
+ErrCode AnsManagerProxy::PublishBatch(const std::string &label,
+    const std::vector<sptr<NotificationRequest>> &notifications, std::vector<ErrCode> &results)
+{
+    if (notifications.empty() || (notifications.size() > MAX_NOTIFICATION_BATCH_NUM)) {
+        ANS_LOGE("[PublishBatch] fail: notifications is empty or too many.");
+        return ERR_ANS_INVALID_PARAM;
+    }
+
+    MessageParcel data;
+    AnsImageUtil::SharedImageScope imageScope(data);
+    if (!data.WriteInterfaceToken(AnsManagerProxy::GetDescriptor())) {
+        ANS_LOGE("[PublishBatch] fail: write interface token failed.");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    if (!data.WriteString(label)) {
+        ANS_LOGE("[PublishBatch] fail: write label failed.");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    if (!WriteParcelableVector(notifications, data)) {
+        ANS_LOGE("[PublishBatch] fail: write notifications failed");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    MessageParcel reply;
+    MessageOption option = {MessageOption::TF_SYNC};
+    ErrCode result = InnerTransact(PUBLISH_NOTIFICATION_BATCH, option, data, reply);
+    if (result != ERR_OK) {
+        ANS_LOGE("[PublishBatch] fail: transact ErrCode=%{public}d", result);
+        return ERR_ANS_TRANSACT_FAILED;
+    }
+
+    if (!reply.ReadInt32(result)) {
+        ANS_LOGE("[PublishBatch] fail: read result failed.");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    if (!reply.ReadInt32Vector(&results)) {
+        ANS_LOGE("[PublishBatch] fail: read results failed.");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    return result;
+}
+
+ErrCode AnsManagerProxy::CancelBatch(
+    const std::string &label, const std::vector<int32_t> &notificationIds, std::vector<ErrCode> &results)
+{
+    if (notificationIds.empty() || (notificationIds.size() > MAX_NOTIFICATION_BATCH_NUM)) {
+        ANS_LOGE("[CancelBatch] fail: notificationIds is empty or too many.");
+        return ERR_ANS_INVALID_PARAM;
+    }
+
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(AnsManagerProxy::GetDescriptor())) {
+        ANS_LOGE("[CancelBatch] fail: write interface token failed.");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    if (!data.WriteString(label)) {
+        ANS_LOGE("[CancelBatch] fail: write label failed");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    if (!data.WriteInt32Vector(notificationIds)) {
+        ANS_LOGE("[CancelBatch] fail: write notificationIds failed");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    MessageParcel reply;
+    MessageOption option = {MessageOption::TF_SYNC};
+    ErrCode result = InnerTransact(CANCEL_NOTIFICATION_BATCH, option, data, reply);
+    if (result != ERR_OK) {
+        ANS_LOGE("[CancelBatch] fail: transact ErrCode=%{public}d", result);
+        return ERR_ANS_TRANSACT_FAILED;
+    }
+
+    if (!reply.ReadInt32(result)) {
+        ANS_LOGE("[CancelBatch] fail: read result failed.");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    if (!reply.ReadInt32Vector(&results)) {
+        ANS_LOGE("[CancelBatch] fail: read results failed.");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    return result;
+}
+
 ErrCode AnsManagerProxy::CancelAll()
 {
     MessageParcel data;
@@ -798,6 +892,7 @@ ErrCode AnsManagerProxy::PublishAsBundle(
     }
 
     MessageParcel data;
+    AnsImageUtil::SharedImageScope imageScope(data);
     if (!data.WriteInterfaceToken(AnsManagerProxy::GetDescriptor())) {
         ANS_LOGE("[PublishAsBundle] fail: write interface token failed.");
         return ERR_ANS_PARCELABLE_FAILED;
@@ -1627,6 +1722,40 @@ ErrCode AnsManagerProxy::Unsubscribe(
     return result;
 }
 
+ErrCode AnsManagerProxy::ResyncSortingMap(const sptr<AnsSubscriberInterface> &subscriber)
+{
+    if (subscriber == nullptr) {
+        ANS_LOGE("[ResyncSortingMap] fail: subscriber is empty.");
+        return ERR_ANS_INVALID_PARAM;
+    }
+
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(AnsManagerProxy::GetDescriptor())) {
+        ANS_LOGE("[ResyncSortingMap] fail: write interface token failed.");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    if (!data.WriteRemoteObject(subscriber->AsObject())) {
+        ANS_LOGE("[ResyncSortingMap] fail: write subscriber failed.");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    MessageParcel reply;
+    MessageOption option = {MessageOption::TF_SYNC};
+    ErrCode result = InnerTransact(RESYNC_SORTING_MAP, option, data, reply);
+    if (result != ERR_OK) {
+        ANS_LOGE("[ResyncSortingMap] fail: transact ErrCode=%{public}d", result);
+        return ERR_ANS_TRANSACT_FAILED;
+    }
+
+    if (!reply.ReadInt32(result)) {
+        ANS_LOGE("[ResyncSortingMap] fail: read result failed.");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    return result;
+}
+
 ErrCode AnsManagerProxy::AreNotificationsSuspended(bool &suspended)
 {
     MessageParcel data;
@@ -2183,6 +2312,7 @@ ErrCode AnsManagerProxy::PublishContinuousTaskNotification(const sptr<Notificati
     }
 
     MessageParcel data;
+    AnsImageUtil::SharedImageScope imageScope(data);
     if (!data.WriteInterfaceToken(AnsManagerProxy::GetDescriptor())) {
         ANS_LOGE("[PublishContinuousTaskNotification] fail: write interface token failed.");
         return ERR_ANS_PARCELABLE_FAILED;
@@ -15,6 +15,7 @@
 
 #include "ans_manager_stub.h"
 #include "ans_const_define.h"
+#include "ans_image_util.h"
 #include "ans_inner_errors.h"
 #include "ans_log_wrapper.h"
 #include "message_option.h"
@@ -37,6 +38,12 @@ const std::map<uint32_t, std::function<ErrCode(AnsManagerStub *, MessageParcel &
         {AnsManagerStub::CANCEL_NOTIFICATION,
             std::bind(
                 &AnsManagerStub::HandleCancel, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3)},
+        {AnsManagerStub::PUBLISH_NOTIFICATION_BATCH,
+            std::bind(&AnsManagerStub::HandlePublishBatch, std::placeholders::_1, std::placeholders::_2,
+                std::placeholders::_3)},
+        {AnsManagerStub::CANCEL_NOTIFICATION_BATCH,
+            std::bind(&AnsManagerStub::HandleCancelBatch, std::placeholders::_1, std::placeholders::_2,
+                std::placeholders::_3)},
         {AnsManagerStub::CANCEL_ALL_NOTIFICATIONS,
             std::bind(
                 &AnsManagerStub::HandleCancelAll, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3)},
@@ -166,6 +173,9 @@ const std::map<uint32_t, std::function<ErrCode(AnsManagerStub *, MessageParcel &
         {AnsManagerStub::UNSUBSCRIBE_NOTIFICATION,
             std::bind(&AnsManagerStub::HandleUnsubscribe, std::placeholders::_1, std::placeholders::_2,
                 std::placeholders::_3)},
+        {AnsManagerStub::RESYNC_SORTING_MAP,
+            std::bind(&AnsManagerStub::HandleResyncSortingMap, std::placeholders::_1, std::placeholders::_2,
+                std::placeholders::_3)},
         {AnsManagerStub::ARE_NOTIFICATION_SUSPENDED,
             std::bind(&AnsManagerStub::HandleAreNotificationsSuspended, std::placeholders::_1, std::placeholders::_2,
                 std::placeholders::_3)},
@@ -292,6 +302,8 @@ int32_t AnsManagerStub::OnRemoteRequest(uint32_t code, MessageParcel &data, Mess
         return IRemoteStub<AnsManagerInterface>::OnRemoteRequest(code, data, reply, flags);
     }
 
+    // The images of the applications are copied, the applications may keep writing the memory they pass.
+    AnsImageUtil::SharedImageScope imageScope(data, true);
     ErrCode result = fun(this, data, reply);
     if (SUCCEEDED(result)) {
         return NO_ERROR;
@@ -367,6 +379,62 @@ ErrCode AnsManagerStub::HandleCancel(MessageParcel &data, MessageParcel &reply)
     return ERR_OK;
 }
 
+ErrCode AnsManagerStub::HandlePublishBatch(MessageParcel &data, MessageParcel &reply)
+{
+    std::string label;
+    if (!data.ReadString(label)) {
+        ANS_LOGE("[HandlePublishBatch] fail: read label failed");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    std::vector<sptr<NotificationRequest>> notifications;
+    if (!ReadParcelableVector(notifications, data)) {
+        ANS_LOGE("[HandlePublishBatch] fail: read notifications failed");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    std::vector<ErrCode> results;
+    ErrCode result = PublishBatch(label, notifications, results);
+    if (!reply.WriteInt32(result)) {
+        ANS_LOGE("[HandlePublishBatch] fail: write result failed, ErrCode=%{public}d", result);
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    if (!reply.WriteInt32Vector(results)) {
+        ANS_LOGE("[HandlePublishBatch] fail: write results failed");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+    return ERR_OK;
+}
+
+ErrCode AnsManagerStub::HandleCancelBatch(MessageParcel &data, MessageParcel &reply)
+{
+    std::string label;
+    if (!data.ReadString(label)) {
+        ANS_LOGE("[HandleCancelBatch] fail: read label failed");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    std::vector<int32_t> notificationIds;
+    if (!data.ReadInt32Vector(&notificationIds)) {
+        ANS_LOGE("[HandleCancelBatch] fail: read notificationIds failed");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    std::vector<ErrCode> results;
+    ErrCode result = CancelBatch(label, notificationIds, results);
+    if (!reply.WriteInt32(result)) {
+        ANS_LOGE("[HandleCancelBatch] fail: write result failed, ErrCode=%{public}d", result);
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    if (!reply.WriteInt32Vector(results)) {
+        ANS_LOGE("[HandleCancelBatch] fail: write results failed");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+    return ERR_OK;
+}
+
 ErrCode AnsManagerStub::HandleCancelAll(MessageParcel &data, MessageParcel &reply)
 {
     ErrCode result = CancelAll();
@@ -1230,6 +1298,22 @@ ErrCode AnsManagerStub::HandleUnsubscribe(MessageParcel &data, MessageParcel &re
     return ERR_OK;
 }
 
+ErrCode AnsManagerStub::HandleResyncSortingMap(MessageParcel &data, MessageParcel &reply)
+{
+    sptr<IRemoteObject> subscriber = data.ReadRemoteObject();
+    if (subscriber == nullptr) {
+        ANS_LOGE("[HandleResyncSortingMap] fail: read subscriber failed");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    ErrCode result = ResyncSortingMap(iface_cast<AnsSubscriberInterface>(subscriber));
+    if (!reply.WriteInt32(result)) {
+        ANS_LOGE("[HandleResyncSortingMap] fail: write result failed, ErrCode=%{public}d", result);
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+    return ERR_OK;
+}
+
 ErrCode AnsManagerStub::HandleAreNotificationsSuspended(MessageParcel &data, MessageParcel &reply)
 {
     bool suspended = false;
@@ -1823,6 +1907,20 @@ ErrCode AnsManagerStub::Cancel(int notificationId, const std::string &label)
     return ERR_INVALID_OPERATION;
 }
 
+ErrCode AnsManagerStub::PublishBatch(const std::string &label,
+    const std::vector<sptr<NotificationRequest>> &notifications, std::vector<ErrCode> &results)
+{
+    ANS_LOGE("AnsManagerStub::PublishBatch called!");
+    return ERR_INVALID_OPERATION;
+}
+
+ErrCode AnsManagerStub::CancelBatch(
+    const std::string &label, const std::vector<int32_t> &notificationIds, std::vector<ErrCode> &results)
+{
+    ANS_LOGE("AnsManagerStub::CancelBatch called!");
+    return ERR_INVALID_OPERATION;
+}
+
 ErrCode AnsManagerStub::CancelAll()
 {
     ANS_LOGE("AnsManagerStub::CancelAll called!");
@@ -2090,6 +2188,12 @@ ErrCode AnsManagerStub::Unsubscribe(const sptr<AnsSubscriberInterface> &subscrib
     return ERR_INVALID_OPERATION;
 }
 
+ErrCode AnsManagerStub::ResyncSortingMap(const sptr<AnsSubscriberInterface> &subscriber)
+{
+    ANS_LOGE("AnsManagerStub::ResyncSortingMap called!");
+    return ERR_INVALID_OPERATION;
+}
+
 ErrCode AnsManagerStub::AreNotificationsSuspended(bool &suspended)
 {
     ANS_LOGE("AnsManagerStub::AreNotificationsSuspended called!");
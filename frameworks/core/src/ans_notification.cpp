@@ -184,20 +184,8 @@ ErrCode AnsNotification::PublishNotification(const std::string &label, const Not
 {
     ANS_LOGI("enter");
 
-    if (request.GetContent() == nullptr || request.GetNotificationType() == NotificationContent::Type::NONE) {
-        ANS_LOGE("Refuse to publish the notification without valid content");
-        return ERR_ANS_INVALID_PARAM;
-    }
-
-    if (!CanPublishMediaContent(request)) {
-        ANS_LOGE("Refuse to publish the notification because the sequence numbers actions not match those assigned to "
-                 "added action buttons.");
-        return ERR_ANS_INVALID_PARAM;
-    }
-
-    ErrCode checkErr = CheckImageSize(request);
+    ErrCode checkErr = CheckPublishRequest(request);
     if (checkErr != ERR_OK) {
-        ANS_LOGE("The size of one picture exceeds the limit");
         return checkErr;
     }
 
@@ -269,6 +257,79 @@ ErrCode AnsNotification::CancelNotification(const std::string &label, int32_t no
     return ansManagerProxy_->Cancel(notificationId, label);
 }
 
+ErrCode AnsNotification::PublishNotificationBatch(
+    const std::string &label, const std::vector<NotificationRequest> &requests, std::vector<ErrCode> &results)
+{
+    ANS_LOGI("enter");
+
+    if (requests.empty() || (requests.size() > MAX_NOTIFICATION_BATCH_NUM)) {
+        ANS_LOGE("Refuse to publish an empty batch or a batch of more than %{public}zu notifications",
+            MAX_NOTIFICATION_BATCH_NUM);
+        return ERR_ANS_INVALID_PARAM;
+    }
+
+    // Requests rejected here are not sent, the results of the others are put back in place.
+    results.assign(requests.size(), ERR_OK);
+    std::vector<size_t> indexes;
+    std::vector<sptr<NotificationRequest>> reqPtrs;
+    for (size_t index = 0; index < requests.size(); index++) {
+        results[index] = CheckPublishRequest(requests[index]);
+        if (results[index] != ERR_OK) {
+            continue;
+        }
+        sptr<NotificationRequest> reqPtr = new (std::nothrow) NotificationRequest(requests[index]);
+        if (reqPtr == nullptr) {
+            ANS_LOGE("Failed to create NotificationRequest ptr");
+            results[index] = ERR_ANS_NO_MEMORY;
+            continue;
+        }
+        if (IsNonDistributedNotificationType(reqPtr->GetNotificationType())) {
+            reqPtr->SetDistributed(false);
+        }
+        indexes.push_back(index);
+        reqPtrs.push_back(reqPtr);
+    }
+
+    if (!reqPtrs.empty()) {
+        if (!GetAnsManagerProxy()) {
+            ANS_LOGE("GetAnsManagerProxy fail.");
+            return ERR_ANS_SERVICE_NOT_CONNECTED;
+        }
+
+        std::vector<ErrCode> sentResults;
+        ErrCode result = ansManagerProxy_->PublishBatch(label, reqPtrs, sentResults);
+        if (sentResults.size() != reqPtrs.size()) {
+            return (result != ERR_OK) ? result : ERR_ANS_PARCELABLE_FAILED;
+        }
+        for (size_t i = 0; i < indexes.size(); i++) {
+            results[indexes[i]] = sentResults[i];
+        }
+    }
+
+    for (auto result : results) {
+        if (result != ERR_OK) {
+            return result;
+        }
+    }
+    return ERR_OK;
+}
+
+ErrCode AnsNotification::CancelNotificationBatch(
+    const std::string &label, const std::vector<int32_t> &notificationIds, std::vector<ErrCode> &results)
+{
+    if (notificationIds.empty() || (notificationIds.size() > MAX_NOTIFICATION_BATCH_NUM)) {
+        ANS_LOGE("Refuse to cancel an empty batch or a batch of more than %{public}zu notifications",
+            MAX_NOTIFICATION_BATCH_NUM);
+        return ERR_ANS_INVALID_PARAM;
+    }
+
+    if (!GetAnsManagerProxy()) {
+        ANS_LOGE("GetAnsManagerProxy fail.");
+        return ERR_ANS_SERVICE_NOT_CONNECTED;
+    }
+    return ansManagerProxy_->CancelBatch(label, notificationIds, results);
+}
+
 ErrCode AnsNotification::CancelAllNotifications()
 {
     if (!GetAnsManagerProxy()) {
@@ -1174,8 +1235,9 @@ ErrCode AnsNotification::CheckImageSizeForContent(const NotificationRequest &req
         case NotificationContent::Type::PICTURE: {
             auto pictureContent = std::static_pointer_cast<NotificationPictureContent>(basicContent);
 
+            // Passed to the service as shared memory by the publishing transactions.
             auto bigPicture = pictureContent->GetBigPicture();
-            if (CheckImageOverSizeForPixelMap(bigPicture, MAX_PICTURE_SIZE)) {
+            if (CheckImageOverSizeForPixelMap(bigPicture, MAX_SHARED_PICTURE_SIZE)) {
                 ANS_LOGE("The size of big picture in PictureContent exceeds limit");
                 return ERR_ANS_PICTURE_OVER_SIZE;
             }
@@ -1188,6 +1250,27 @@ ErrCode AnsNotification::CheckImageSizeForContent(const NotificationRequest &req
     return ERR_OK;
 }
 
+ErrCode AnsNotification::CheckPublishRequest(const NotificationRequest &request)
+{
+    if (request.GetContent() == nullptr || request.GetNotificationType() == NotificationContent::Type::NONE) {
+        ANS_LOGE("Refuse to publish the notification without valid content");
+        return ERR_ANS_INVALID_PARAM;
+    }
+
+    if (!CanPublishMediaContent(request)) {
+        ANS_LOGE("Refuse to publish the notification because the sequence numbers actions not match those assigned to "
+                 "added action buttons.");
+        return ERR_ANS_INVALID_PARAM;
+    }
+
+    ErrCode checkErr = CheckImageSize(request);
+    if (checkErr != ERR_OK) {
+        ANS_LOGE("The size of one picture exceeds the limit");
+        return checkErr;
+    }
+    return ERR_OK;
+}
+
 ErrCode AnsNotification::CheckImageSize(const NotificationRequest &request)
 {
     auto littleIcon = request.GetLittleIcon();
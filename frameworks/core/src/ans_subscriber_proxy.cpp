@@ -15,6 +15,7 @@
 
 #include "ans_subscriber_proxy.h"
 
+#include "ans_image_util.h"
 #include "ans_inner_errors.h"
 #include "ans_log_wrapper.h"
 #include "message_option.h"
@@ -95,6 +96,7 @@ void AnsSubscriberProxy::OnConsumed(const sptr<Notification> &notification)
     }
 
     MessageParcel data;
+    AnsImageUtil::SharedImageScope imageScope(data);
     if (!data.WriteInterfaceToken(AnsSubscriberProxy::GetDescriptor())) {
         ANS_LOGE("[OnConsumed] fail: write interface token failed.");
         return;
@@ -123,6 +125,7 @@ void AnsSubscriberProxy::OnConsumed(
     }
 
     MessageParcel data;
+    AnsImageUtil::SharedImageScope imageScope(data);
     if (!data.WriteInterfaceToken(AnsSubscriberProxy::GetDescriptor())) {
         ANS_LOGE("[OnConsumed] fail: write interface token failed.");
         return;
@@ -162,6 +165,7 @@ void AnsSubscriberProxy::OnCanceled(const sptr<Notification> &notification)
     }
 
     MessageParcel data;
+    AnsImageUtil::SharedImageScope imageScope(data);
     if (!data.WriteInterfaceToken(AnsSubscriberProxy::GetDescriptor())) {
         ANS_LOGE("[OnCanceled] fail: write interface token failed.");
         return;
@@ -190,6 +194,7 @@ void AnsSubscriberProxy::OnCanceled(
     }
 
     MessageParcel data;
+    AnsImageUtil::SharedImageScope imageScope(data);
     if (!data.WriteInterfaceToken(AnsSubscriberProxy::GetDescriptor())) {
         ANS_LOGE("[OnCanceled] fail: write interface token failed.");
         return;
@@ -226,6 +231,183 @@ void AnsSubscriberProxy::OnCanceled(
     }
 }
 
+void AnsSubscriberProxy::OnConsumedCombined(
+    const sptr<Notification> &notification, const sptr<NotificationSortingMap> &notificationMap)
+{
+    if (notification == nullptr) {
+        ANS_LOGE("[OnConsumedCombined] fail: notification is nullptr.");
+        return;
+    }
+
+    MessageParcel data;
+    AnsImageUtil::SharedImageScope imageScope(data);
+    if (!data.WriteInterfaceToken(AnsSubscriberProxy::GetDescriptor())) {
+        ANS_LOGE("[OnConsumedCombined] fail: write interface token failed.");
+        return;
+    }
+
+    if (!data.WriteParcelable(notification)) {
+        ANS_LOGE("[OnConsumedCombined] fail: write notification failed.");
+        return;
+    }
+
+    if (!data.WriteBool(notificationMap != nullptr)) {
+        ANS_LOGE("[OnConsumedCombined] fail: write existMap failed");
+        return;
+    }
+
+    if (notificationMap != nullptr) {
+        if (!data.WriteParcelable(notificationMap)) {
+            ANS_LOGE("[OnConsumedCombined] fail: write notificationMap failed");
+            return;
+        }
+    }
+
+    MessageParcel reply;
+    MessageOption option = {MessageOption::TF_ASYNC};
+    ErrCode result = InnerTransact(ON_CONSUMED_COMBINED, option, data, reply);
+    if (result != ERR_OK) {
+        ANS_LOGE("[OnConsumedCombined] fail: transact ErrCode=ERR_ANS_TRANSACT_FAILED");
+        return;
+    }
+}
+
+void AnsSubscriberProxy::OnCanceledCombined(
+    const sptr<Notification> &notification, const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason)
+{
+    if (notification == nullptr) {
+        ANS_LOGE("[OnCanceledCombined] fail: notification is nullptr.");
+        return;
+    }
+
+    MessageParcel data;
+    AnsImageUtil::SharedImageScope imageScope(data);
+    if (!data.WriteInterfaceToken(AnsSubscriberProxy::GetDescriptor())) {
+        ANS_LOGE("[OnCanceledCombined] fail: write interface token failed.");
+        return;
+    }
+
+    if (!data.WriteParcelable(notification)) {
+        ANS_LOGE("[OnCanceledCombined] fail: write notification failed.");
+        return;
+    }
+
+    if (!data.WriteBool(notificationMap != nullptr)) {
+        ANS_LOGE("[OnCanceledCombined] fail: write existMap failed");
+        return;
+    }
+
+    if (notificationMap != nullptr) {
+        if (!data.WriteParcelable(notificationMap)) {
+            ANS_LOGE("[OnCanceledCombined] fail: write notificationMap failed");
+            return;
+        }
+    }
+
+    if (!data.WriteInt32(deleteReason)) {
+        ANS_LOGE("[OnCanceledCombined] fail: write deleteReason failed.");
+        return;
+    }
+
+    MessageParcel reply;
+    MessageOption option = {MessageOption::TF_ASYNC};
+    ErrCode result = InnerTransact(ON_CANCELED_COMBINED, option, data, reply);
+    if (result != ERR_OK) {
+        ANS_LOGE("[OnCanceledCombined] fail: transact ErrCode=ERR_ANS_TRANSACT_FAILED");
+        return;
+    }
+}
+
+bool AnsSubscriberProxy::WriteNotificationList(const std::vector<sptr<Notification>> &notifications,
+    const sptr<NotificationSortingMap> &notificationMap, MessageParcel &data)
+{
+    if (!data.WriteInt32(notifications.size())) {
+        ANS_LOGE("[WriteNotificationList] fail: write size failed.");
+        return false;
+    }
+
+    for (auto &notification : notifications) {
+        if (!data.WriteParcelable(notification)) {
+            ANS_LOGE("[WriteNotificationList] fail: write notification failed.");
+            return false;
+        }
+    }
+
+    if (!data.WriteBool(notificationMap != nullptr)) {
+        ANS_LOGE("[WriteNotificationList] fail: write existMap failed");
+        return false;
+    }
+
+    if (notificationMap != nullptr) {
+        if (!data.WriteParcelable(notificationMap)) {
+            ANS_LOGE("[WriteNotificationList] fail: write notificationMap failed");
+            return false;
+        }
+    }
+    return true;
+}
+
+void AnsSubscriberProxy::OnConsumedList(
+    const std::vector<sptr<Notification>> &notifications, const sptr<NotificationSortingMap> &notificationMap)
+{
+    if (notifications.empty()) {
+        ANS_LOGE("[OnConsumedList] fail: notifications is empty.");
+        return;
+    }
+
+    MessageParcel data;
+    AnsImageUtil::SharedImageScope imageScope(data);
+    if (!data.WriteInterfaceToken(AnsSubscriberProxy::GetDescriptor())) {
+        ANS_LOGE("[OnConsumedList] fail: write interface token failed.");
+        return;
+    }
+
+    if (!WriteNotificationList(notifications, notificationMap, data)) {
+        return;
+    }
+
+    MessageParcel reply;
+    MessageOption option = {MessageOption::TF_ASYNC};
+    ErrCode result = InnerTransact(ON_CONSUMED_LIST, option, data, reply);
+    if (result != ERR_OK) {
+        ANS_LOGE("[OnConsumedList] fail: transact ErrCode=ERR_ANS_TRANSACT_FAILED");
+        return;
+    }
+}
+
+void AnsSubscriberProxy::OnCanceledList(const std::vector<sptr<Notification>> &notifications,
+    const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason)
+{
+    if (notifications.empty()) {
+        ANS_LOGE("[OnCanceledList] fail: notifications is empty.");
+        return;
+    }
+
+    MessageParcel data;
+    AnsImageUtil::SharedImageScope imageScope(data);
+    if (!data.WriteInterfaceToken(AnsSubscriberProxy::GetDescriptor())) {
+        ANS_LOGE("[OnCanceledList] fail: write interface token failed.");
+        return;
+    }
+
+    if (!WriteNotificationList(notifications, notificationMap, data)) {
+        return;
+    }
+
+    if (!data.WriteInt32(deleteReason)) {
+        ANS_LOGE("[OnCanceledList] fail: write deleteReason failed.");
+        return;
+    }
+
+    MessageParcel reply;
+    MessageOption option = {MessageOption::TF_ASYNC};
+    ErrCode result = InnerTransact(ON_CANCELED_LIST, option, data, reply);
+    if (result != ERR_OK) {
+        ANS_LOGE("[OnCanceledList] fail: transact ErrCode=ERR_ANS_TRANSACT_FAILED");
+        return;
+    }
+}
+
 void AnsSubscriberProxy::OnUpdated(const sptr<NotificationSortingMap> &notificationMap)
 {
     if (notificationMap == nullptr) {
@@ -16,6 +16,7 @@
 #include "ans_subscriber_stub.h"
 
 #include "ans_const_define.h"
+#include "ans_image_util.h"
 #include "ans_inner_errors.h"
 #include "ans_log_wrapper.h"
 #include "message_option.h"
@@ -38,6 +39,14 @@ AnsSubscriberStub::AnsSubscriberStub()
         std::bind(&AnsSubscriberStub::HandleOnCanceled, this, std::placeholders::_1, std::placeholders::_2));
     interfaces_.emplace(ON_CANCELED_MAP,
         std::bind(&AnsSubscriberStub::HandleOnCanceledMap, this, std::placeholders::_1, std::placeholders::_2));
+    interfaces_.emplace(ON_CONSUMED_COMBINED,
+        std::bind(&AnsSubscriberStub::HandleOnConsumedCombined, this, std::placeholders::_1, std::placeholders::_2));
+    interfaces_.emplace(ON_CANCELED_COMBINED,
+        std::bind(&AnsSubscriberStub::HandleOnCanceledCombined, this, std::placeholders::_1, std::placeholders::_2));
+    interfaces_.emplace(ON_CONSUMED_LIST,
+        std::bind(&AnsSubscriberStub::HandleOnConsumedList, this, std::placeholders::_1, std::placeholders::_2));
+    interfaces_.emplace(ON_CANCELED_LIST,
+        std::bind(&AnsSubscriberStub::HandleOnCanceledList, this, std::placeholders::_1, std::placeholders::_2));
     interfaces_.emplace(
         ON_UPDATED, std::bind(&AnsSubscriberStub::HandleOnUpdated, this, std::placeholders::_1, std::placeholders::_2));
     interfaces_.emplace(ON_DND_DATE_CHANGED,
@@ -73,6 +82,7 @@ int32_t AnsSubscriberStub::OnRemoteRequest(
         return IRemoteStub<AnsSubscriberInterface>::OnRemoteRequest(code, data, reply, flags);
     }
 
+    AnsImageUtil::SharedImageScope imageScope(data);
     fun(data, reply);
     return NO_ERROR;
 }
@@ -173,6 +183,136 @@ ErrCode AnsSubscriberStub::HandleOnCanceledMap(MessageParcel &data, MessageParce
     return ERR_OK;
 }
 
+ErrCode AnsSubscriberStub::HandleOnConsumedCombined(MessageParcel &data, MessageParcel &reply)
+{
+    sptr<Notification> notification = data.ReadParcelable<Notification>();
+    if (!notification) {
+        ANS_LOGW("[HandleOnConsumedCombined] fail: notification ReadParcelable failed");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    bool existMap = false;
+    if (!data.ReadBool(existMap)) {
+        ANS_LOGW("[HandleOnConsumedCombined] fail: read existMap failed");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    sptr<NotificationSortingMap> notificationMap = nullptr;
+    if (existMap) {
+        notificationMap = data.ReadParcelable<NotificationSortingMap>();
+        if (notificationMap == nullptr) {
+            ANS_LOGW("[HandleOnConsumedCombined] fail: read NotificationSortingMap failed");
+            return ERR_ANS_PARCELABLE_FAILED;
+        }
+    }
+
+    OnConsumedCombined(notification, notificationMap);
+    return ERR_OK;
+}
+
+ErrCode AnsSubscriberStub::HandleOnCanceledCombined(MessageParcel &data, MessageParcel &reply)
+{
+    sptr<Notification> notification = data.ReadParcelable<Notification>();
+    if (!notification) {
+        ANS_LOGW("[HandleOnCanceledCombined] fail: notification ReadParcelable failed");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    bool existMap = false;
+    if (!data.ReadBool(existMap)) {
+        ANS_LOGW("[HandleOnCanceledCombined] fail: read existMap failed");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    sptr<NotificationSortingMap> notificationMap = nullptr;
+    if (existMap) {
+        notificationMap = data.ReadParcelable<NotificationSortingMap>();
+        if (notificationMap == nullptr) {
+            ANS_LOGW("[HandleOnCanceledCombined] fail: read NotificationSortingMap failed");
+            return ERR_ANS_PARCELABLE_FAILED;
+        }
+    }
+
+    int32_t reason = 0;
+    if (!data.ReadInt32(reason)) {
+        ANS_LOGW("[HandleOnCanceledCombined] fail: read reason failed");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    OnCanceledCombined(notification, notificationMap, reason);
+    return ERR_OK;
+}
+
+bool AnsSubscriberStub::ReadNotificationList(std::vector<sptr<Notification>> &notifications,
+    sptr<NotificationSortingMap> &notificationMap, MessageParcel &data)
+{
+    int32_t size = 0;
+    if (!data.ReadInt32(size)) {
+        ANS_LOGW("[ReadNotificationList] fail: read size failed");
+        return false;
+    }
+    if ((size <= 0) || (static_cast<size_t>(size) > MAX_NOTIFICATION_BATCH_NUM)) {
+        ANS_LOGW("[ReadNotificationList] fail: invalid size %{public}d", size);
+        return false;
+    }
+
+    notifications.clear();
+    for (int32_t index = 0; index < size; index++) {
+        sptr<Notification> notification = data.ReadParcelable<Notification>();
+        if (notification == nullptr) {
+            ANS_LOGW("[ReadNotificationList] fail: notification ReadParcelable failed");
+            return false;
+        }
+        notifications.emplace_back(notification);
+    }
+
+    bool existMap = false;
+    if (!data.ReadBool(existMap)) {
+        ANS_LOGW("[ReadNotificationList] fail: read existMap failed");
+        return false;
+    }
+
+    notificationMap = nullptr;
+    if (existMap) {
+        notificationMap = data.ReadParcelable<NotificationSortingMap>();
+        if (notificationMap == nullptr) {
+            ANS_LOGW("[ReadNotificationList] fail: read NotificationSortingMap failed");
+            return false;
+        }
+    }
+    return true;
+}
+
+ErrCode AnsSubscriberStub::HandleOnConsumedList(MessageParcel &data, MessageParcel &reply)
+{
+    std::vector<sptr<Notification>> notifications;
+    sptr<NotificationSortingMap> notificationMap = nullptr;
+    if (!ReadNotificationList(notifications, notificationMap, data)) {
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    OnConsumedList(notifications, notificationMap);
+    return ERR_OK;
+}
+
+ErrCode AnsSubscriberStub::HandleOnCanceledList(MessageParcel &data, MessageParcel &reply)
+{
+    std::vector<sptr<Notification>> notifications;
+    sptr<NotificationSortingMap> notificationMap = nullptr;
+    if (!ReadNotificationList(notifications, notificationMap, data)) {
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    int32_t reason = 0;
+    if (!data.ReadInt32(reason)) {
+        ANS_LOGW("[HandleOnCanceledList] fail: read reason failed");
+        return ERR_ANS_PARCELABLE_FAILED;
+    }
+
+    OnCanceledList(notifications, notificationMap, reason);
+    return ERR_OK;
+}
+
 ErrCode AnsSubscriberStub::HandleOnUpdated(MessageParcel &data, MessageParcel &reply)
 {
     sptr<NotificationSortingMap> notificationMap = data.ReadParcelable<NotificationSortingMap>();
@@ -227,6 +367,36 @@ void AnsSubscriberStub::OnCanceled(
     const sptr<Notification> &notification, const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason)
 {}
 
+void AnsSubscriberStub::OnConsumedCombined(
+    const sptr<Notification> &notification, const sptr<NotificationSortingMap> &notificationMap)
+{
+    OnConsumed(notification, notificationMap);
+    OnConsumed(notification);
+}
+
+void AnsSubscriberStub::OnCanceledCombined(
+    const sptr<Notification> &notification, const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason)
+{
+    OnCanceled(notification, notificationMap, deleteReason);
+    OnCanceled(notification);
+}
+
+void AnsSubscriberStub::OnConsumedList(
+    const std::vector<sptr<Notification>> &notifications, const sptr<NotificationSortingMap> &notificationMap)
+{
+    for (auto &notification : notifications) {
+        OnConsumedCombined(notification, notificationMap);
+    }
+}
+
+void AnsSubscriberStub::OnCanceledList(const std::vector<sptr<Notification>> &notifications,
+    const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason)
+{
+    for (auto &notification : notifications) {
+        OnCanceledCombined(notification, notificationMap, deleteReason);
+    }
+}
+
 void AnsSubscriberStub::OnUpdated(const sptr<NotificationSortingMap> &notificationMap)
 {}
 
@@ -15,6 +15,7 @@
 #ifndef BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_INTERFACES_INNER_API_MESSAGE_USER_H
 #define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_INTERFACES_INNER_API_MESSAGE_USER_H
 
+#include "notification_binary_convert.h"
 #include "notification_json_convert.h"
 #include "pixel_map.h"
 #include "parcel.h"
@@ -22,7 +23,8 @@
 
 namespace OHOS {
 namespace Notification {
-class MessageUser final : public Parcelable, public NotificationJsonConvertionBase {
+class MessageUser final : public Parcelable, public NotificationJsonConvertionBase,
+    public NotificationBinaryConvertionBase {
 public:
     MessageUser();
 
@@ -139,6 +141,22 @@ public:
      */
     static MessageUser *FromJson(const nlohmann::json &jsonObject);
 
+    /**
+     * @brief Converts a MessageUser object into binary fields.
+     *
+     * @param writer Indicates the writer of the fields.
+     * @return Returns true if succeed; returns false otherwise.
+     */
+    bool ToBinary(NotificationBinaryWriter &writer) const override;
+
+    /**
+     * @brief Creates a MessageUser object from binary fields.
+     *
+     * @param reader Indicates the reader of the fields.
+     * @return Returns the MessageUser object.
+     */
+    static MessageUser *FromBinary(NotificationBinaryReader &reader);
+
     /**
      * @brief Marshals a MessageUser object into a Parcel.
      *
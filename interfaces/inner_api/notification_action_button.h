@@ -16,6 +16,7 @@
 #ifndef BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_INTERFACES_INNER_API_NOTIFICATION_ACTION_BUTTON_H
 #define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_INTERFACES_INNER_API_NOTIFICATION_ACTION_BUTTON_H
 
+#include "notification_binary_convert.h"
 #include "notification_constant.h"
 #include "notification_json_convert.h"
 #include "notification_user_input.h"
@@ -25,7 +26,8 @@
 
 namespace OHOS {
 namespace Notification {
-class NotificationActionButton : public Parcelable, public NotificationJsonConvertionBase {
+class NotificationActionButton : public Parcelable, public NotificationJsonConvertionBase,
+    public NotificationBinaryConvertionBase {
 public:
     /**
      * @brief A static function used to create a NotificationActionButton instance with the input parameters passed.
@@ -204,6 +206,22 @@ public:
      */
     static NotificationActionButton *FromJson(const nlohmann::json &jsonObject);
 
+    /**
+     * @brief Converts a NotificationActionButton object into binary fields.
+     *
+     * @param writer Indicates the writer of the fields.
+     * @return Returns true if succeed; returns false otherwise.
+     */
+    bool ToBinary(NotificationBinaryWriter &writer) const override;
+
+    /**
+     * @brief Creates a NotificationActionButton object from binary fields.
+     *
+     * @param reader Indicates the reader of the fields.
+     * @return Returns the NotificationActionButton.
+     */
+    static NotificationActionButton *FromBinary(NotificationBinaryReader &reader);
+
     /**
      * @brief Marshal a object into a Parcel.
      *
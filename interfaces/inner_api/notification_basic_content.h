@@ -16,12 +16,14 @@
 #ifndef BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_INTERFACES_INNER_API_NOTIFICATION_BASIC_CONTENT_H
 #define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_INTERFACES_INNER_API_NOTIFICATION_BASIC_CONTENT_H
 
+#include "notification_binary_convert.h"
 #include "notification_json_convert.h"
 #include "parcel.h"
 
 namespace OHOS {
 namespace Notification {
-class NotificationBasicContent : public Parcelable, public NotificationJsonConvertionBase {
+class NotificationBasicContent : public Parcelable, public NotificationJsonConvertionBase,
+    public NotificationBinaryConvertionBase {
 public:
     virtual ~NotificationBasicContent();
 
@@ -84,6 +86,14 @@ public:
      */
     virtual bool ToJson(nlohmann::json &jsonObject) const override;
 
+    /**
+     * @brief Converts a NotificationBasicContent object into binary fields, whose tags are below 16.
+     *
+     * @param writer Indicates the writer of the fields.
+     * @return Returns true if succeed; returns false otherwise.
+     */
+    virtual bool ToBinary(NotificationBinaryWriter &writer) const override;
+
     /**
      * @brief Marshal a object into a Parcel.
      *
@@ -110,6 +120,15 @@ protected:
      */
     void ReadFromJson(const nlohmann::json &jsonObject);
 
+    /**
+     * @brief Reads a field of a NotificationBasicContent object.
+     *
+     * @param tag Indicates the tag of the field.
+     * @param reader Indicates the reader of the fields.
+     * @return Returns true if the field belongs to the NotificationBasicContent; returns false otherwise.
+     */
+    bool ReadFromBinary(uint32_t tag, NotificationBinaryReader &reader);
+
 protected:
     std::string text_ {};
     std::string title_ {};
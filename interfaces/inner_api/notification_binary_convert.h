@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_INTERFACES_INNER_API_NOTIFICATION_BINARY_CONVERT_H
+#define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_INTERFACES_INNER_API_NOTIFICATION_BINARY_CONVERT_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ans_log_wrapper.h"
+
+namespace OHOS {
+namespace Notification {
+class NotificationBinaryWriter;
+
+class NotificationBinaryConvertionBase {
+public:
+    virtual ~NotificationBinaryConvertionBase() = default;
+
+    /**
+     * @brief Converts NotificationBinaryConvertionBase object to binary fields.
+     *
+     * @param writer Indicates the writer of the fields.
+     */
+    virtual bool ToBinary(NotificationBinaryWriter &writer) const = 0;
+};
+
+/**
+ * Writes tag-length-value fields.
+ *
+ * Each field starts with a varint key made of its tag and wire type, a varint field is followed by its zigzag
+ * value and a length-delimited field by its length and its bytes. A nested object is a length-delimited field.
+ */
+class NotificationBinaryWriter {
+public:
+    NotificationBinaryWriter() = default;
+    ~NotificationBinaryWriter() = default;
+
+    void WriteInt(uint32_t tag, int64_t value);
+    void WriteBool(uint32_t tag, bool value);
+    void WriteString(uint32_t tag, std::string_view value);
+
+    /**
+     * @brief Writes the strings as one field per string.
+     */
+    void WriteStrings(uint32_t tag, const std::vector<std::string> &values);
+
+    /**
+     * @brief Writes a nested object, nothing is written if the object is null.
+     *
+     * @return Returns true if the object is null or written; returns false otherwise.
+     */
+    bool WriteObject(uint32_t tag, const NotificationBinaryConvertionBase *object);
+
+    const std::string &GetData() const;
+    void Append(std::string_view data);
+
+private:
+    void WriteKey(uint32_t tag, uint32_t wireType);
+    void WriteVarint(uint64_t value);
+
+    std::string data_;
+};
+
+/**
+ * Reads the fields written by NotificationBinaryWriter without copying them.
+ *
+ * The reader refers to the data it is created from, which must outlive it. A field with an unknown tag is skipped
+ * with Skip, so that a field added by a later version is ignored by an earlier one.
+ */
+class NotificationBinaryReader {
+public:
+    NotificationBinaryReader() = default;
+    explicit NotificationBinaryReader(std::string_view data);
+    ~NotificationBinaryReader() = default;
+
+    /**
+     * @brief Reads the key of the next field.
+     *
+     * @param tag Indicates the tag of the field.
+     * @return Returns true if there is a next field; returns false at the end or on an error.
+     */
+    bool Next(uint32_t &tag);
+
+    bool ReadInt(int64_t &value);
+    bool ReadBool(bool &value);
+    bool ReadString(std::string &value);
+    bool ReadString(std::string_view &value);
+
+    /**
+     * @brief Appends a field of the strings written by WriteStrings.
+     */
+    bool ReadStrings(std::vector<std::string> &values);
+
+    /**
+     * @brief Reads a nested object.
+     *
+     * @param reader Indicates the reader of the fields of the object.
+     */
+    bool ReadObject(NotificationBinaryReader &reader);
+
+    template <typename T>
+    bool ReadInt(T &value)
+    {
+        int64_t intValue = 0;
+        if (!ReadInt(intValue)) {
+            return false;
+        }
+        value = static_cast<T>(intValue);
+        return true;
+    }
+
+    /**
+     * @brief Skips the field whose key is read by Next.
+     */
+    bool Skip();
+
+    /**
+     * @brief Checks whether the data is malformed.
+     *
+     * @return Returns true if a field is truncated or read as another wire type; returns false otherwise.
+     */
+    bool HasError() const;
+
+private:
+    bool ReadVarint(uint64_t &value);
+    bool ReadBytes(std::string_view &value);
+    bool Fail();
+
+    std::string_view data_;
+    size_t offset_ {0};
+    uint32_t wireType_ {0};
+    bool hasError_ {false};
+};
+
+class NotificationBinaryConverter {
+public:
+    /**
+     * The first byte of a binary string, a JSON string starts with '{' instead.
+     */
+    static constexpr uint8_t BINARY_MAGIC = 0xB1;
+
+    /**
+     * The version of the binary format, bumped when the meaning of an existing tag changes.
+     */
+    static constexpr uint32_t BINARY_VERSION = 1;
+
+    /**
+     * @brief Converts NotificationBinaryConvertionBase object to binary string.
+     *
+     * @param convertionBase Indicates the NotificationBinaryConvertionBase object.
+     * @param binaryString Indicates the binary string.
+     * @return Returns true if the conversion is successful; returns false otherwise.
+     */
+    static bool ConvertToBinaryString(
+        const NotificationBinaryConvertionBase *convertionBase, std::string &binaryString);
+
+    /**
+     * @brief Checks whether a string is a binary string rather than a json string.
+     *
+     * @param str Indicates the string.
+     * @return Returns true if the string is a binary string; returns false otherwise.
+     */
+    static bool IsBinaryString(std::string_view str);
+
+    /**
+     * @brief Converts binary string to a subclass object whose base class is NotificationBinaryConvertionBase.
+     *
+     * @param binaryString Indicates the binary string.
+     * @return Returns the subclass object.
+     */
+    template <typename T>
+    static T *ConvertFromBinaryString(std::string_view binaryString)
+    {
+        NotificationBinaryReader reader;
+        if (!OpenBinaryString(binaryString, reader)) {
+            ANS_LOGE("Converter : Invalid binary string");
+            return nullptr;
+        }
+
+        return T::FromBinary(reader);
+    }
+
+private:
+    static bool OpenBinaryString(std::string_view binaryString, NotificationBinaryReader &reader);
+};
+}  // namespace Notification
+}  // namespace OHOS
+
+#endif  // BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_INTERFACES_INNER_API_NOTIFICATION_BINARY_CONVERT_H
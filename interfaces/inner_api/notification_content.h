@@ -17,6 +17,7 @@
 #define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_INTERFACES_INNER_API_NOTIFICATION_CONTENT_H
 
 #include "notification_basic_content.h"
+#include "notification_binary_convert.h"
 #include "notification_conversational_content.h"
 #include "notification_json_convert.h"
 #include "notification_long_text_content.h"
@@ -28,7 +29,8 @@
 
 namespace OHOS {
 namespace Notification {
-class NotificationContent : public Parcelable, public NotificationJsonConvertionBase {
+class NotificationContent : public Parcelable, public NotificationJsonConvertionBase,
+    public NotificationBinaryConvertionBase {
 public:
     enum class Type {
         /**
@@ -170,6 +172,22 @@ public:
      */
     static NotificationContent *FromJson(const nlohmann::json &jsonObject);
 
+    /**
+     * @brief Converts a NotificationContent object into binary fields.
+     *
+     * @param writer Indicates the writer of the fields.
+     * @return Returns true if succeed; returns false otherwise.
+     */
+    bool ToBinary(NotificationBinaryWriter &writer) const override;
+
+    /**
+     * @brief Creates a NotificationContent object from binary fields.
+     *
+     * @param reader Indicates the reader of the fields.
+     * @return Returns the NotificationContent.
+     */
+    static NotificationContent *FromBinary(NotificationBinaryReader &reader);
+
     /**
      * @brief Marshal a object into a Parcel.
      *
@@ -206,6 +224,15 @@ private:
      */
     static bool ConvertJsonToContent(NotificationContent *target, const nlohmann::json &jsonObject);
 
+    /**
+     * @brief Convert binary fields to NotificationContent object.
+     *
+     * @param target Indicates the NotificationContent object.
+     * @param reader Indicates the reader of the fields of the content.
+     * @return Returns true if the conversion is successful; returns false otherwise.
+     */
+    static bool ConvertBinaryToContent(NotificationContent *target, NotificationBinaryReader &reader);
+
 private:
     NotificationContent::Type contentType_ {NotificationContent::Type::NONE};
     std::shared_ptr<NotificationBasicContent> content_ {};
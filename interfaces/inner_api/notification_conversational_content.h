@@ -127,6 +127,22 @@ public:
      */
     static NotificationConversationalContent *FromJson(const nlohmann::json &jsonObject);
 
+    /**
+     * @brief Converts a NotificationConversationalContent object into binary fields.
+     *
+     * @param writer Indicates the writer of the fields.
+     * @return Returns true if succeed; returns false otherwise.
+     */
+    virtual bool ToBinary(NotificationBinaryWriter &writer) const override;
+
+    /**
+     * @brief Creates a NotificationConversationalContent object from binary fields.
+     *
+     * @param reader Indicates the reader of the fields.
+     * @return Returns the NotificationConversationalContent.
+     */
+    static NotificationConversationalContent *FromBinary(NotificationBinaryReader &reader);
+
     /**
      * @brief Marshal a object into a Parcel.
      *
@@ -17,13 +17,15 @@
 #define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_INTERFACES_INNER_API_CONVERSATIONAL_MESSAGE_H
 
 #include "message_user.h"
+#include "notification_binary_convert.h"
 #include "notification_json_convert.h"
 #include "parcel.h"
 #include "uri.h"
 
 namespace OHOS {
 namespace Notification {
-class NotificationConversationalMessage : public Parcelable, public NotificationJsonConvertionBase {
+class NotificationConversationalMessage : public Parcelable, public NotificationJsonConvertionBase,
+    public NotificationBinaryConvertionBase {
 public:
     /**
      * @brief A constructor used to create a NotificationConversationalMessage instance with the input parameters
@@ -104,6 +106,22 @@ public:
      */
     static NotificationConversationalMessage *FromJson(const nlohmann::json &jsonObject);
 
+    /**
+     * @brief Converts a NotificationConversationalMessage object into binary fields.
+     *
+     * @param writer Indicates the writer of the fields.
+     * @return Returns true if succeed; returns false otherwise.
+     */
+    bool ToBinary(NotificationBinaryWriter &writer) const override;
+
+    /**
+     * @brief Creates a NotificationConversationalMessage object from binary fields.
+     *
+     * @param reader Indicates the reader of the fields.
+     * @return Returns the NotificationConversationalMessage.
+     */
+    static NotificationConversationalMessage *FromBinary(NotificationBinaryReader &reader);
+
     /**
      * @brief Marshal a object into a Parcel.
      *
@@ -16,12 +16,14 @@
 #ifndef BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_INTERFACES_INNER_API_NOTIFICATION_DISTRIBUTED_OPTIONS_H
 #define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_INTERFACES_INNER_API_NOTIFICATION_DISTRIBUTED_OPTIONS_H
 
+#include "notification_binary_convert.h"
 #include "notification_json_convert.h"
 #include "parcel.h"
 
 namespace OHOS {
 namespace Notification {
-class NotificationDistributedOptions : public Parcelable, public NotificationJsonConvertionBase {
+class NotificationDistributedOptions : public Parcelable, public NotificationJsonConvertionBase,
+    public NotificationBinaryConvertionBase {
 public:
     NotificationDistributedOptions() = default;
 
@@ -102,6 +104,22 @@ public:
      */
     static NotificationDistributedOptions *FromJson(const nlohmann::json &jsonObject);
 
+    /**
+     * @brief Converts a NotificationDistributedOptions object into binary fields.
+     *
+     * @param writer Indicates the writer of the fields.
+     * @return Returns true if succeed; returns false otherwise.
+     */
+    bool ToBinary(NotificationBinaryWriter &writer) const override;
+
+    /**
+     * @brief Creates a NotificationDistributedOptions object from binary fields.
+     *
+     * @param reader Indicates the reader of the fields.
+     * @return Returns the NotificationDistributedOptions.
+     */
+    static NotificationDistributedOptions *FromBinary(NotificationBinaryReader &reader);
+
     /**
      * @brief Marshal a object into a Parcel.
      *
@@ -19,12 +19,14 @@
 #include <memory>
 #include "parcel.h"
 
+#include "notification_binary_convert.h"
 #include "notification_constant.h"
 #include "notification_json_convert.h"
 
 namespace OHOS {
 namespace Notification {
-class NotificationFlags : public Parcelable, public NotificationJsonConvertionBase {
+class NotificationFlags : public Parcelable, public NotificationJsonConvertionBase,
+    public NotificationBinaryConvertionBase {
 public:
     /**
      * Default constructor used to create an empty NotificationFlags instance.
@@ -79,6 +81,19 @@ public:
      */
     static NotificationFlags *FromJson(const nlohmann::json &jsonObject);
 
+    /**
+     * Converts a NotificationFlags object into binary fields.
+     * @param writer Indicates the writer of the fields.
+     */
+    bool ToBinary(NotificationBinaryWriter &writer) const override;
+
+    /**
+     * Creates a NotificationFlags object from binary fields.
+     * @param reader Indicates the reader of the fields.
+     * @return the NotificationFlags.
+     */
+    static NotificationFlags *FromBinary(NotificationBinaryReader &reader);
+
     /**
      * Marshal a object into a Parcel.
      * @param parcel the object into the parcel
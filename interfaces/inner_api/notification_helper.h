@@ -207,6 +207,31 @@ public:
      */
     static ErrCode CancelNotification(const std::string &label, int32_t notificationId);
 
+    /**
+     * @brief Publishes notifications with a specified label in one batch.
+     * @note The notifications are published in order. A notification with the same ID as a published one updates it.
+     *       Each new notification counts against the per-second publish limit as if published alone, and each
+     *       subscriber receives the batch in one callback.
+     *
+     * @param label Indicates the label of the notifications to publish.
+     * @param requests Indicates the NotificationRequest objects, at most MAX_NOTIFICATION_BATCH_NUM.
+     * @param results Indicates the publish result of each request, in the order of the requests.
+     * @return Returns ERR_OK if every notification is published, otherwise the first failure.
+     */
+    static ErrCode PublishNotificationBatch(const std::string &label,
+        const std::vector<NotificationRequest> &requests, std::vector<ErrCode> &results);
+
+    /**
+     * @brief Cancels published notifications matching the specified label and notification ids in one batch.
+     *
+     * @param label Indicates the label of the notifications to cancel.
+     * @param notificationIds Indicates the IDs of the notifications to cancel, at most MAX_NOTIFICATION_BATCH_NUM.
+     * @param results Indicates the cancel result of each ID, in the order of the IDs.
+     * @return Returns ERR_OK if every notification is canceled, otherwise the first failure.
+     */
+    static ErrCode CancelNotificationBatch(
+        const std::string &label, const std::vector<int32_t> &notificationIds, std::vector<ErrCode> &results);
+
     /**
      * @brief Cancels all the published notifications.
      *
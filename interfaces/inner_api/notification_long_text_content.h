@@ -105,6 +105,22 @@ public:
      */
     static NotificationLongTextContent *FromJson(const nlohmann::json &jsonObject);
 
+    /**
+     * @brief Converts a NotificationLongTextContent object into binary fields.
+     *
+     * @param writer Indicates the writer of the fields.
+     * @return Returns true if succeed; returns false otherwise.
+     */
+    virtual bool ToBinary(NotificationBinaryWriter &writer) const override;
+
+    /**
+     * @brief Creates a NotificationLongTextContent object from binary fields.
+     *
+     * @param reader Indicates the reader of the fields.
+     * @return Returns the NotificationLongTextContent.
+     */
+    static NotificationLongTextContent *FromBinary(NotificationBinaryReader &reader);
+
     /**
      * @brief Marshal a object into a Parcel.
      *
@@ -91,6 +91,22 @@ public:
      */
     static NotificationMediaContent *FromJson(const nlohmann::json &jsonObject);
 
+    /**
+     * @brief Converts a NotificationMediaContent object into binary fields.
+     *
+     * @param writer Indicates the writer of the fields.
+     * @return Returns true if succeed; returns false otherwise.
+     */
+    virtual bool ToBinary(NotificationBinaryWriter &writer) const override;
+
+    /**
+     * @brief Creates a NotificationMediaContent object from binary fields.
+     *
+     * @param reader Indicates the reader of the fields.
+     * @return Returns the NotificationMediaContent object.
+     */
+    static NotificationMediaContent *FromBinary(NotificationBinaryReader &reader);
+
     /**
      * @brief Marshal a object into a Parcel.
      * @param parcel the object into the parcel.
@@ -100,6 +100,22 @@ public:
      */
     static NotificationMultiLineContent *FromJson(const nlohmann::json &jsonObject);
 
+    /**
+     * @brief Converts a NotificationMultiLineContent object into binary fields.
+     *
+     * @param writer Indicates the writer of the fields.
+     * @return Returns true if succeed; returns false otherwise.
+     */
+    virtual bool ToBinary(NotificationBinaryWriter &writer) const override;
+
+    /**
+     * @brief Creates a NotificationMultiLineContent object from binary fields.
+     *
+     * @param reader Indicates the reader of the fields.
+     * @return Returns the NotificationMultiLineContent object.
+     */
+    static NotificationMultiLineContent *FromBinary(NotificationBinaryReader &reader);
+
     /**
      * @brief Marshal a object into a Parcel.
      *
@@ -19,6 +19,7 @@
 #include "ans_const_define.h"
 #include "message_user.h"
 #include "notification_action_button.h"
+#include "notification_binary_convert.h"
 #include "notification_content.h"
 #include "notification_distributed_options.h"
 #include "notification_flags.h"
@@ -31,7 +32,8 @@
 
 namespace OHOS {
 namespace Notification {
-class NotificationRequest : public Parcelable, public NotificationJsonConvertionBase {
+class NotificationRequest : public Parcelable, public NotificationJsonConvertionBase,
+    public NotificationBinaryConvertionBase {
 public:
     enum class BadgeStyle {
         /**
@@ -1027,6 +1029,22 @@ public:
      */
     static NotificationRequest *FromJson(const nlohmann::json &jsonObject);
 
+    /**
+     * @brief Converts a NotificationRequest object into binary fields.
+     *
+     * @param writer Indicates the writer of the fields.
+     * @return Returns true if succeed; returns false otherwise.
+     */
+    bool ToBinary(NotificationBinaryWriter &writer) const override;
+
+    /**
+     * @brief Creates a NotificationRequest object from binary fields.
+     *
+     * @param reader Indicates the reader of the fields.
+     * @return Returns the NotificationRequest.
+     */
+    static NotificationRequest *FromBinary(NotificationBinaryReader &reader);
+
     /**
      * @brief Marshal a NotificationRequest object into a Parcel.
      *
@@ -1133,6 +1151,14 @@ private:
         NotificationRequest *target, const nlohmann::json &jsonObject);
     static bool ConvertJsonToNotificationFlags(NotificationRequest *target, const nlohmann::json &jsonObject);
 
+    bool ConvertObjectsToBinary(NotificationBinaryWriter &writer) const;
+
+    static bool ConvertBinaryToNum(NotificationRequest *target, uint32_t tag, NotificationBinaryReader &reader);
+    static bool ConvertBinaryToString(NotificationRequest *target, uint32_t tag, NotificationBinaryReader &reader);
+    static bool ConvertBinaryToBool(NotificationRequest *target, uint32_t tag, NotificationBinaryReader &reader);
+    static bool ConvertBinaryToObject(NotificationRequest *target, uint32_t tag, NotificationBinaryReader &reader);
+    static bool ConvertBinaryToOptions(NotificationRequest *target, uint32_t tag, NotificationBinaryReader &reader);
+
 private:
     int32_t notificationId_ {0};
     uint32_t color_ {NotificationRequest::COLOR_DEFAULT};
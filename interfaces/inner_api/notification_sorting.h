@@ -166,6 +166,8 @@ private:
     sptr<NotificationSlot> slot_ = new (std::nothrow) NotificationSlot(NotificationConstant::SlotType::OTHER);
 
     friend class AdvancedNotificationService;
+    friend class NotificationSortingMap;
+    friend class NotificationSubscriberManager;
 };
 }  // namespace Notification
 }  // namespace OHOS
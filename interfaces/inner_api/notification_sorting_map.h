@@ -53,6 +53,57 @@ public:
      */
     bool GetNotificationSorting(const std::string &key, NotificationSorting &sorting) const;
 
+    /**
+     * @brief Sets the version of the sorting map. Versions increase every time the active notifications change.
+     *
+     * @param version Indicates the version of the sorting map.
+     */
+    void SetVersion(uint64_t version);
+
+    /**
+     * @brief Obtains the version of the sorting map.
+     *
+     * @return Returns the version of the sorting map, 0 if the sorting map is not versioned.
+     */
+    uint64_t GetVersion() const;
+
+    /**
+     * @brief Marks the sorting map as a delta that only carries the sortings changed since the base version.
+     *
+     * @param baseVersion Indicates the version the delta applies to.
+     * @param removedKeys Indicates the keys of the notifications removed since the base version.
+     */
+    void SetDelta(uint64_t baseVersion, const std::vector<std::string> &removedKeys);
+
+    /**
+     * @brief Checks whether the sorting map is a delta.
+     *
+     * @return Returns true if the sorting map is a delta; returns false if it carries all sortings.
+     */
+    bool IsDelta() const;
+
+    /**
+     * @brief Obtains the version a delta applies to.
+     *
+     * @return Returns the base version of the delta.
+     */
+    uint64_t GetBaseVersion() const;
+
+    /**
+     * @brief Obtains the keys of the notifications removed since the base version of a delta.
+     *
+     * @return Returns the removed keys.
+     */
+    std::vector<std::string> GetRemovedKeys() const;
+
+    /**
+     * @brief Applies a delta to a full sorting map of the base version of the delta.
+     *
+     * @param delta Indicates the delta to apply.
+     * @return Returns true if succeed; returns false if the delta does not apply to this sorting map.
+     */
+    bool ApplyDelta(const NotificationSortingMap &delta);
+
     /**
      * @brief Marshals a NotificationSortingMap object into a Parcel.
      *
@@ -83,6 +134,10 @@ private:
 private:
     std::vector<std::string> sortedKey_ {};
     std::map<std::string, NotificationSorting> sortings_ {};
+    uint64_t version_ {0};
+    uint64_t baseVersion_ {0};
+    bool isDelta_ {false};
+    std::vector<std::string> removedKeys_ {};
 };
 }  // namespace Notification
 }  // namespace OHOS
@@ -72,6 +72,21 @@ public:
      **/
     int32_t GetAppUserId() const;
 
+    /**
+     * @brief Sets whether the subscriber receives sorting map deltas instead of full sorting maps.
+     * A delta only carries the rankings changed since the previous callback of the subscriber.
+     *
+     * @param enabled Specifies whether sorting map deltas are enabled.
+     **/
+    void SetSortingMapDeltaEnabled(bool enabled);
+
+    /**
+     * @brief Checks whether the subscriber receives sorting map deltas.
+     *
+     * @return Returns true if sorting map deltas are enabled; returns false otherwise.
+     **/
+    bool IsSortingMapDeltaEnabled() const;
+
     /**
      * @brief Marshals a NotificationSubscribeInfo object into a Parcel.
      *
@@ -101,6 +116,7 @@ private:
 private:
     std::vector<std::string> appNames_ {};
     int32_t userId_ {-1};
+    bool sortingMapDelta_ {false};
 };
 }  // namespace Notification
 }  // namespace OHOS
@@ -16,6 +16,9 @@
 #ifndef BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_INTERFACES_INNER_API_NOTIFICATION_SUBSCRIBER_H
 #define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_INTERFACES_INNER_API_NOTIFICATION_SUBSCRIBER_H
 
+#include <functional>
+#include <vector>
+
 #include "ans_manager_interface.h"
 #include "ans_subscriber_stub.h"
 #include "notification_request.h"
@@ -23,6 +26,10 @@
 #include "notification_sorting_map.h"
 
 namespace OHOS {
+namespace AppExecFwk {
+class EventHandler;
+}  // namespace AppExecFwk
+
 namespace Notification {
 class NotificationSubscriber {
 public:
@@ -101,6 +108,27 @@ public:
      **/
     virtual void OnEnabledNotificationChanged(const std::shared_ptr<EnabledNotificationCallbackData> &callbackData) = 0;
 
+    /**
+     * @brief Called back when the subscriber receives notifications published in one batch.
+     * By default, both OnConsumed callbacks are called for each notification.
+     *
+     * @param requests Indicates the received Notification objects, in publish order.
+     * @param sortingMap Indicates the sorting map after the batch.
+     **/
+    virtual void OnBatchConsumed(const std::vector<std::shared_ptr<Notification>> &requests,
+        const std::shared_ptr<NotificationSortingMap> &sortingMap);
+
+    /**
+     * @brief Called back when notifications are canceled in one batch.
+     * By default, both OnCanceled callbacks are called for each notification.
+     *
+     * @param requests Indicates the canceled Notification objects, in cancel order.
+     * @param sortingMap Indicates the sorting map after the batch.
+     * @param deleteReason Indicates the reason for the deletion. For details, see NotificationConstant.
+     **/
+    virtual void OnBatchCanceled(const std::vector<std::shared_ptr<Notification>> &requests,
+        const std::shared_ptr<NotificationSortingMap> &sortingMap, int32_t deleteReason);
+
 private:
     class SubscriberImpl final : public AnsSubscriberStub {
     public:
@@ -140,13 +168,48 @@ private:
 
         void OnEnabledNotificationChanged(const sptr<EnabledNotificationCallbackData> &callbackData) override;
 
+        void OnConsumedList(const std::vector<sptr<Notification>> &notifications,
+            const sptr<NotificationSortingMap> &notificationMap) override;
+
+        void OnCanceledList(const std::vector<sptr<Notification>> &notifications,
+            const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason) override;
+
         bool GetAnsManagerProxy();
 
+        using SortingMapCallback = std::function<void(const std::shared_ptr<NotificationSortingMap> &sortingMap)>;
+
+        /**
+         * @brief Merges a received sorting map into the full sorting map kept by the subscriber, then calls the
+         * callback with a copy of the full sorting map.
+         * A delta that does not apply to the kept sorting map triggers a full resync, which is requested off the
+         * binder thread. Until the full sorting map arrives, the callbacks are held back, so that none of them gets
+         * a stale sorting map.
+         *
+         * @param notificationMap Indicates the received sorting map, either full or a delta.
+         * @param callback Indicates the callback, it gets nullptr if there is no sorting map.
+         */
+        void MergeSortingMap(const sptr<NotificationSortingMap> &notificationMap, const SortingMapCallback &callback);
+
+        /**
+         * @brief Requests the full sorting map, the held back callbacks are called when it arrives.
+         */
+        void ResyncSortingMap();
+
+        /**
+         * @brief Calls the held back callbacks with the kept sorting map when the full one cannot be requested.
+         */
+        void OnResyncSortingMapFailed();
+
     public:
         NotificationSubscriber &subscriber_;
         sptr<DeathRecipient> recipient_ {nullptr};
         sptr<AnsManagerInterface> proxy_ {nullptr};
         std::mutex mutex_ {};
+        sptr<NotificationSortingMap> sortingMap_ {nullptr};
+        bool isResyncing_ {false};
+        std::vector<SortingMapCallback> pendingCallbacks_ {};
+        std::shared_ptr<AppExecFwk::EventHandler> resyncHandler_ {nullptr};
+        std::mutex sortingMapMutex_ {};
     };
 
 private:
@@ -139,6 +139,28 @@ public:
      */
     bool ReadFromParcel(Parcel &parcel) override;
 
+    /**
+     * @brief Reads the local time once for the calendar reminders refreshed on the current thread while the
+     * object lives, instead of once per reminder. Used when all the reminders are refreshed after the date, the
+     * time or the time zone changes.
+     */
+    class RefreshPass {
+    public:
+        RefreshPass();
+        ~RefreshPass();
+
+    private:
+        RefreshPass(const RefreshPass &) = delete;
+        RefreshPass &operator=(const RefreshPass &) = delete;
+
+        time_t now_ {0};
+        tm nowTime_ {};
+        const RefreshPass *previous_ {nullptr};
+        static thread_local const RefreshPass *current_;
+
+        friend class ReminderRequestCalendar;
+    };
+
     static const uint8_t MAX_MONTHS_OF_YEAR;
     static const uint8_t MAX_DAYS_OF_MONTH;
     virtual void RecoverFromDb(const std::shared_ptr<NativeRdb::AbsSharedResultSet> &resultSet) override;
@@ -155,8 +177,18 @@ protected:
 private:
     ReminderRequestCalendar() : ReminderRequest() {}
 
+    /**
+     * @brief Gets the first repeat day of the month at which the target time is after now.
+     *
+     * @return the day, or INVALID_U8_VALUE if there is none.
+     */
     uint8_t GetNextDay(const uint16_t &settedYear, const uint8_t &settedMonth, const tm &now, const tm &target) const;
     uint64_t GetNextTriggerTime() const;
+
+    /**
+     * @brief Gets the next trigger time of a repeat reminder. The repeat months and days are looked up in their
+     * bitmasks, so only the time found is converted by mktime.
+     */
     uint64_t GetNextTriggerTimeAsRepeatReminder(const tm &nowTime, const tm &tarTime) const;
     uint32_t GetRepeatDay() const
     {
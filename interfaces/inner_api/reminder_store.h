@@ -16,8 +16,13 @@
 #ifndef BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_INTERFACES_INNER_API_REMINDER_STORE_H
 #define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_INTERFACES_INNER_API_REMINDER_STORE_H
 
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
+#include "event_handler.h"
 #include "notification_bundle_option.h"
 #include "reminder_request.h"
 #include "rdb_errno.h"
@@ -27,23 +32,103 @@
 
 namespace OHOS {
 namespace Notification {
-class ReminderStore {
+/**
+ * Persists the reminders.
+ *
+ * Changes of single reminders are written behind: they are queued in a journal which keeps the latest change of
+ * each reminder, and the journal is written in one transaction a short time after its first change, on Flush(),
+ * or when the store is destroyed. Deletes are written at once, after the journal, and drop the queued changes of
+ * the deleted reminders. Reads write the journal first, so they see the changes made before them.
+ */
+class ReminderStore : public std::enable_shared_from_this<ReminderStore> {
 public:
+    /**
+     * The columns needed to schedule the reminders, the elements of the same index belong to one reminder.
+     */
+    struct ReminderSchedule {
+        std::vector<int32_t> reminderIds;
+        std::vector<uint64_t> triggerTimes;
+        std::vector<std::string> bundleNames;
+        std::vector<int32_t> uids;
+    };
+
     ReminderStore() {};
-    virtual ~ReminderStore() {};
+    virtual ~ReminderStore();
     int32_t Init();
+
+    /**
+     * @brief Inits the store on the database at the given place instead of the reminder database.
+     *
+     * @param dbDir Indicates the directory of the database, it is created if it does not exist.
+     * @param dbName Indicates the file name of the database.
+     * @return Returns STATE_OK on success, an error code otherwise.
+     */
+    int32_t Init(const std::string &dbDir, const std::string &dbName);
+
+    /**
+     * @brief Deletes the reminder, its queued change is dropped and the rest of the journal is written first.
+     *
+     * @param reminderId Indicates the reminder id.
+     * @return int32_t the number of the deleted rows.
+     */
     int32_t Delete(int32_t reminderId);
     int32_t Delete(const std::string &pkg, int32_t userId);
     int32_t DeleteUser(int32_t userId);
     std::vector<sptr<ReminderRequest>> GetAllValidReminders();
+
+    /**
+     * @brief Obtains the schedule of all the reminders which are not expired, ordered by trigger time.
+     *
+     * Only the columns in ReminderSchedule are read, the reminders are not built.
+     *
+     * @param schedule Indicates the schedule.
+     * @return true if succeed.
+     */
+    bool GetAllValidSchedule(ReminderSchedule &schedule);
+
+    /**
+     * @brief Builds the reminder from the database, the journal is written first only if the reminder has a change
+     * queued.
+     *
+     * @param reminderId Indicates the reminder id.
+     * @return pointer of the reminder, nullptr if it is not found.
+     */
+    sptr<ReminderRequest> GetReminder(int32_t reminderId);
     bool GetBundleOption(const int32_t &reminderId, sptr<NotificationBundleOption> &bundleOption) const;
     int32_t GetMaxId();
+
+    /**
+     * @brief Queues the insert or the update of the reminder. The values are taken when it is called.
+     *
+     * @param reminder Indicates the reminder.
+     * @param bundleOption Indicates the bundle option of the reminder.
+     * @return int64_t result code.
+     */
     int64_t UpdateOrInsert(const sptr<ReminderRequest> &reminder, const sptr<NotificationBundleOption> &bundleOption);
+
+    /**
+     * @brief Writes the queued changes to the database in one transaction.
+     *
+     * @return int32_t result code.
+     */
+    int32_t Flush();
     static uint8_t GetColumnIndex(const std::string& name);
 
     static const int32_t STATE_OK;
 
 private:
+    struct JournalEntry {
+        uint8_t failedTimes {0};
+        std::string pkg;
+        int32_t userId {0};
+        NativeRdb::ValuesBucket values;
+    };
+
+    /**
+     * Tells whether the queued change of the reminder belongs to the deleted reminders.
+     */
+    using DeletedFilter = std::function<bool(int32_t reminderId, const JournalEntry &entry)>;
+
     /**
      * @brief Inits the data in database when system boot on or proxy process reboot on.
      *
@@ -56,18 +141,57 @@ private:
      */
     int32_t InitData();
     sptr<ReminderRequest> BuildReminder(const std::shared_ptr<NativeRdb::AbsSharedResultSet> &resultSet);
-    int32_t Delete(const std::string &deleteCondition);
+
+    /**
+     * @brief Writes the journal, then deletes the reminders matching the condition.
+     *
+     * @param deleteCondition Indicates the condition of the deleted rows.
+     * @param isDeleted Indicates the changes of the deleted reminders, they are dropped instead of queued again
+     * if they fail to be written. nullptr if no change is queued for them.
+     * @return int32_t the number of the deleted rows.
+     */
+    int32_t Delete(const std::string &deleteCondition, const DeletedFilter &isDeleted);
     void GetInt32Val(std::shared_ptr<NativeRdb::AbsSharedResultSet> &resultSet,
         const std::string &name, int32_t &value) const;
     void GetStringVal(std::shared_ptr<NativeRdb::AbsSharedResultSet> &resultSet,
         const std::string &name, std::string &value) const;
     std::vector<sptr<ReminderRequest>> GetReminders(const std::string &queryCondition);
+
+    /**
+     * @brief Builds the reminders from the database without writing the journal.
+     */
+    std::vector<sptr<ReminderRequest>> QueryReminders(const std::string &queryCondition);
     void GenerateData(const sptr<ReminderRequest> &reminder,
         const sptr<NotificationBundleOption> &bundleOption, NativeRdb::ValuesBucket &values) const;
-    bool IsReminderExist(const sptr<ReminderRequest> &reminder);
-    int64_t Insert(const sptr<ReminderRequest> &reminder, const sptr<NotificationBundleOption> &bundleOption);
     std::shared_ptr<NativeRdb::AbsSharedResultSet> Query(const std::string &queryCondition) const;
-    int64_t Update(const sptr<ReminderRequest> &reminder, const sptr<NotificationBundleOption> &bundleOption);
+
+    /**
+     * @brief Replaces the queued change of the reminder and schedules the flush if it is the first change.
+     */
+    void Enqueue(int32_t reminderId, JournalEntry &&entry);
+
+    /**
+     * @brief Schedules the flush unless it is scheduled already.
+     *
+     * @return false if the flush cannot be scheduled.
+     */
+    bool ScheduleFlush();
+
+    /**
+     * @brief Writes the queued changes in one transaction, writeMutex_ must be held.
+     *
+     * If the transaction fails, the changes are written one by one. The ones which still fail are given back to
+     * the journal, unless they are replaced meanwhile, and the flush is scheduled again. A change is dropped after
+     * it fails MAX_FLUSH_RETRY_TIMES, or if it belongs to a reminder deleted right after the flush.
+     *
+     * @param isDeleted Indicates the changes of the reminders deleted after the flush, nullptr if there are none.
+     */
+    int32_t FlushLocked(const DeletedFilter &isDeleted = nullptr);
+
+    /**
+     * @brief Writes the change of the reminder, writeMutex_ must be held.
+     */
+    int32_t WriteEntry(int32_t reminderId, const JournalEntry &entry);
 
 class ReminderStoreDataCallBack : public NativeRdb::RdbOpenCallback {
 public:
@@ -77,6 +201,20 @@ public:
 
 private:
     std::shared_ptr<NativeRdb::RdbStore> rdbStore_ = nullptr;
+    std::shared_ptr<AppExecFwk::EventRunner> runner_ = nullptr;
+    std::shared_ptr<AppExecFwk::EventHandler> handler_ = nullptr;
+
+    /**
+     * Protects journal_ and isFlushScheduled_.
+     */
+    std::mutex journalMutex_;
+    std::map<int32_t, JournalEntry> journal_;
+    bool isFlushScheduled_ = false;
+
+    /**
+     * Serializes the writes, so that a delete by condition is not overtaken by the journal.
+     */
+    std::mutex writeMutex_;
 };
 }  // namespace Notification
 }  // namespace OHOS
@@ -16,6 +16,7 @@
 #ifndef BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_ANS_INCLUDE_ADVANCED_NOTIFICATION_SERVICE_H
 #define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_ANS_INCLUDE_ADVANCED_NOTIFICATION_SERVICE_H
 
+#include <array>
 #include <ctime>
 #include <list>
 #include <memory>
@@ -31,9 +32,14 @@
 #include "distributed_kvstore_death_recipient.h"
 #include "notification.h"
 #include "notification_bundle_option.h"
+#include "notification_image_cache.h"
 #include "notification_record.h"
+#include "notification_record_store.h"
 #include "notification_sorting_map.h"
 #include "system_event_observer.h"
+#ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
+#include "distributed_notification_manager.h"
+#endif
 
 namespace OHOS {
 namespace Notification {
@@ -73,6 +79,30 @@ public:
      */
     ErrCode Cancel(int32_t notificationId, const std::string &label) override;
 
+    /**
+     * @brief Publishes notifications with a specified label in one batch. The notifications are applied in order
+     * in one service task, each new one counts against the per-second publish limit, and each subscriber gets them
+     * in one callback.
+     *
+     * @param label Indicates the label of the notifications to publish.
+     * @param notifications Indicates the NotificationRequest objects, at most MAX_NOTIFICATION_BATCH_NUM.
+     * @param results Indicates the result of each notification, in the order of the requests.
+     * @return Returns ERR_OK if every notification is published, otherwise the first failure.
+     */
+    ErrCode PublishBatch(const std::string &label, const std::vector<sptr<NotificationRequest>> &notifications,
+        std::vector<ErrCode> &results) override;
+
+    /**
+     * @brief Cancels published notifications matching the specified label and notification ids in one batch.
+     *
+     * @param label Indicates the label of the notifications to cancel.
+     * @param notificationIds Indicates the IDs of the notifications to cancel, at most MAX_NOTIFICATION_BATCH_NUM.
+     * @param results Indicates the result of each notification, in the order of the IDs.
+     * @return Returns ERR_OK if every notification is canceled, otherwise the first failure.
+     */
+    ErrCode CancelBatch(const std::string &label, const std::vector<int32_t> &notificationIds,
+        std::vector<ErrCode> &results) override;
+
     /**
      * @brief Cancels all the published notifications.
      *
@@ -465,6 +495,14 @@ public:
     ErrCode Unsubscribe(const sptr<AnsSubscriberInterface> &subscriber,
         const sptr<NotificationSubscribeInfo> &info) override;
 
+    /**
+     * @brief Requests the full sorting map for a subscriber that receives sorting map deltas.
+     *
+     * @param subscriber Indicates the subscriber.
+     * @return Returns ERR_OK on success, others on failure.
+     */
+    ErrCode ResyncSortingMap(const sptr<AnsSubscriberInterface> &subscriber) override;
+
     /**
      * @brief Checks whether this device is allowed to publish notifications.
      *
@@ -748,17 +786,20 @@ private:
     void AddToNotificationList(const std::shared_ptr<NotificationRecord> &record);
     void UpdateInNotificationList(const std::shared_ptr<NotificationRecord> &record);
     ErrCode AssignToNotificationList(const std::shared_ptr<NotificationRecord> &record);
+    std::shared_ptr<NotificationRecord> MakeNotificationRecord(
+        const sptr<NotificationRequest> &request, const sptr<NotificationBundleOption> &bundleOption);
+    void ShareImages(const sptr<NotificationRequest> &request);
+    ErrCode AddPreparedRecord(const std::shared_ptr<NotificationRecord> &record);
     ErrCode RemoveFromNotificationList(const sptr<NotificationBundleOption> &bundleOption, const std::string &label,
         int32_t notificationId, sptr<Notification> &notification, bool isCancel = false);
     ErrCode RemoveFromNotificationList(const std::string &key, sptr<Notification> &notification, bool isCancel = false);
     ErrCode RemoveFromNotificationListForDeleteAll(const std::string &key,
         const int32_t &userId, sptr<Notification> &notification);
     std::vector<std::string> GetNotificationKeys(const sptr<NotificationBundleOption> &bundleOption);
+    std::vector<std::string> GetNotificationKeysByUser(int32_t userId);
     bool IsNotificationExists(const std::string &key);
-    void SortNotificationList();
-    static bool NotificationCompare(
-        const std::shared_ptr<NotificationRecord> &first, const std::shared_ptr<NotificationRecord> &second);
     ErrCode FlowControl(const std::shared_ptr<NotificationRecord> &record);
+    ErrCode CheckPublishRate();
 
     sptr<NotificationSortingMap> GenerateSortingMap();
     sptr<NotificationBundleOption> GenerateBundleOption();
@@ -772,6 +813,9 @@ private:
     ErrCode DistributedNotificationDump(std::vector<std::string> &dumpInfo);
 #endif
     ErrCode SetRecentNotificationCount(const std::string arg);
+    ErrCode SubscriberDump(std::vector<std::string> &dumpInfo);
+    ErrCode SetSubscriberQueuePolicy(const std::string arg);
+    ErrCode ImageCacheDump(std::vector<std::string> &dumpInfo);
     void UpdateRecentNotification(sptr<Notification> &notification, bool isDelete, int32_t reason);
 
     void AdjustDateForDndTypeOnce(int64_t &beginDate, int64_t &endDate);
@@ -793,8 +837,11 @@ private:
     ErrCode DoDistributedDelete(const std::string deviceId, const sptr<Notification> notification);
     std::string GetNotificationDeviceId(const std::string &key);
     bool CheckDistributedNotificationType(const sptr<NotificationRequest> &request);
+    std::shared_ptr<NotificationRecord> MakeDistributedRecord(
+        const std::string &deviceId, const std::string &bundleName, const sptr<NotificationRequest> &request);
     void OnDistributedPublish(
         const std::string &deviceId, const std::string &bundleName, sptr<NotificationRequest> &request);
+    void OnDistributedPublishBatch(std::vector<DistributedNotificationManager::DistributedRequest> &requests);
     void OnDistributedUpdate(
         const std::string &deviceId, const std::string &bundleName, sptr<NotificationRequest> &request);
     void OnDistributedDelete(
@@ -818,9 +865,14 @@ private:
 
     std::shared_ptr<OHOS::AppExecFwk::EventRunner> runner_ = nullptr;
     std::shared_ptr<OHOS::AppExecFwk::EventHandler> handler_ = nullptr;
-    std::list<std::shared_ptr<NotificationRecord>> notificationList_;
-    std::list<std::chrono::system_clock::time_point> flowControlTimestampList_;
+    NotificationRecordStore notificationList_;
+    sptr<NotificationSortingMap> sortingMap_ = nullptr;
+    uint64_t sortingMapVersion_ = 0;
+    std::array<std::chrono::system_clock::time_point, MAX_ACTIVE_NUM_PERSECOND> flowControlTimestamps_ {};
+    size_t flowControlTimestampCount_ = 0;
+    size_t flowControlTimestampIndex_ = 0;
     std::shared_ptr<RecentInfo> recentInfo_ = nullptr;
+    NotificationImageCache imageCache_;
     std::shared_ptr<DistributedKvStoreDeathRecipient> distributedKvStoreDeathRecipient_ = nullptr;
     std::shared_ptr<SystemEventObserver> systemEventObserver_ = nullptr;
     DistributedKv::DistributedKvDataManager dataManager_;
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_ANS_INCLUDE_NOTIFICATION_DELIVERY_QUEUE_H
+#define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_ANS_INCLUDE_NOTIFICATION_DELIVERY_QUEUE_H
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "event_handler.h"
+
+namespace OHOS {
+namespace Notification {
+/**
+ * Bounded queue of the callbacks to one subscriber, drained in order on a worker handler.
+ *
+ * Callbacks are pushed by the subscriber manager and run on the worker, so a slow subscriber only delays its
+ * own queue. When the queue is full the overflow policy decides what is given up.
+ */
+class NotificationDeliveryQueue : public std::enable_shared_from_this<NotificationDeliveryQueue> {
+public:
+    enum class OverflowPolicy {
+        COALESCE,     // replace the latest callback of the same key at the tail, or drop the oldest if there is none
+        DROP_OLDEST,  // drop the oldest queued callback
+        DISCONNECT,   // reject the callback, the subscriber should be disconnected
+    };
+
+    /**
+     * The sorting map a callback carries. A delta applies only to the sorting map of the callback before it, so when
+     * a callback carrying a sorting map is given up, the next delta is replaced by the full sorting map.
+     */
+    enum class SortingMapType {
+        NONE,
+        FULL,
+        DELTA,
+    };
+
+    enum class PushResult {
+        QUEUED,
+        COALESCED,
+        DROPPED_OLDEST,
+        REJECTED,
+        CLOSED,
+    };
+
+    struct Stats {
+        size_t depth {0};
+        size_t maxDepth {0};
+        uint64_t delivered {0};
+        uint64_t coalesced {0};
+        uint64_t dropped {0};
+        int64_t averageLatency {0};  // microseconds
+        int64_t maxLatency {0};      // microseconds
+    };
+
+    using Task = std::function<void()>;
+
+    NotificationDeliveryQueue(
+        const std::shared_ptr<AppExecFwk::EventHandler> &handler, size_t capacity, OverflowPolicy policy);
+    ~NotificationDeliveryQueue() = default;
+
+    /**
+     * @brief Pushes a callback to the queue.
+     *
+     * @param key Indicates the key callbacks are coalesced by, empty if the callback is never coalesced.
+     * @param task Indicates the callback.
+     * @param type Indicates the sorting map the callback carries.
+     * @param fullTask Indicates the same callback with the full sorting map, only if the callback carries a delta.
+     * @return Returns how the callback is queued, REJECTED if the queue is full and the policy is DISCONNECT.
+     */
+    PushResult Push(const std::string &key, const Task &task, SortingMapType type = SortingMapType::NONE,
+        const Task &fullTask = nullptr);
+
+    /**
+     * @brief Queues a last callback regardless of the capacity, then rejects further callbacks.
+     *
+     * @param task Indicates the last callback.
+     */
+    void Close(const Task &task);
+
+    /**
+     * @brief Drops the queued callbacks and rejects further callbacks.
+     */
+    void Stop();
+
+    /**
+     * @brief Changes the capacity and the overflow policy. Queued callbacks over the capacity are kept.
+     *
+     * @param capacity Indicates the max number of queued callbacks.
+     * @param policy Indicates the overflow policy.
+     */
+    void SetPolicy(size_t capacity, OverflowPolicy policy);
+
+    Stats GetStats();
+
+    static std::string PolicyToString(OverflowPolicy policy);
+    static bool StringToPolicy(const std::string &str, OverflowPolicy &policy);
+
+private:
+    struct Item {
+        std::string key;
+        Task task;
+        std::chrono::steady_clock::time_point pushTime;
+        SortingMapType type {SortingMapType::NONE};
+        Task fullTask {};
+    };
+
+    /**
+     * @brief Replaces the first delta queued from the index by its full sorting map, unless a full sorting map comes
+     * first. Called after a callback carrying a sorting map is given up, mutex_ must be held.
+     */
+    void RebaseSortingMap(size_t index);
+    void ScheduleDrain();
+    void Drain();
+
+    std::weak_ptr<AppExecFwk::EventHandler> handler_;
+    std::mutex mutex_;
+    std::deque<Item> items_;
+    size_t capacity_ {0};
+    OverflowPolicy policy_ {OverflowPolicy::COALESCE};
+    bool draining_ {false};
+    bool closed_ {false};
+    Stats stats_;
+    int64_t totalLatency_ {0};
+};
+}  // namespace Notification
+}  // namespace OHOS
+
+#endif  // BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_ANS_INCLUDE_NOTIFICATION_DELIVERY_QUEUE_H
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_ANS_INCLUDE_NOTIFICATION_IMAGE_CACHE_H
+#define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_ANS_INCLUDE_NOTIFICATION_IMAGE_CACHE_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "pixel_map.h"
+
+namespace OHOS {
+namespace Notification {
+/**
+ * Images of the notifications in the service, deduplicated by content.
+ *
+ * The records of the same image share one pixel map, so the service holds one copy of an icon whatever the
+ * number of notifications using it. The cache keeps the images it has seen up to a memory budget, evicting the
+ * least recently used ones. An evicted image stays alive as long as records use it, it is only no longer shared
+ * with the images that come after.
+ */
+class NotificationImageCache {
+public:
+    struct Stats {
+        size_t entries {0};
+        size_t bytes {0};
+        size_t budget {0};
+        size_t inUseEntries {0};  // entries also referenced out of the cache
+        size_t savedBytes {0};    // bytes the references beyond the first would have taken as copies
+        uint64_t hits {0};
+        uint64_t misses {0};
+        uint64_t evictions {0};
+    };
+
+    explicit NotificationImageCache(size_t budget);
+    ~NotificationImageCache() = default;
+
+    /**
+     * @brief Obtains the shared image with the same content as an image, the image itself becomes the shared one
+     * if the cache has none.
+     *
+     * @param pixelMap Indicates the image.
+     * @return Returns the shared image, or the image itself if it is not cached.
+     */
+    std::shared_ptr<Media::PixelMap> Share(const std::shared_ptr<Media::PixelMap> &pixelMap);
+
+    /**
+     * @brief Changes the memory budget, evicting images over it.
+     *
+     * @param budget Indicates the max number of bytes of the cached images.
+     */
+    void SetBudget(size_t budget);
+
+    Stats GetStats();
+    void Dump(std::vector<std::string> &dumpInfo);
+
+private:
+    struct Entry {
+        size_t hash {0};
+        size_t bytes {0};
+        std::shared_ptr<Media::PixelMap> pixelMap;
+    };
+
+    static bool IsSameImage(const Media::PixelMap &left, const Media::PixelMap &right);
+    void EvictLocked();
+
+    std::mutex mutex_;
+    std::list<Entry> entries_;  // the most recently used first
+    std::unordered_multimap<size_t, std::list<Entry>::iterator> index_;
+    size_t bytes_ {0};
+    size_t budget_ {0};
+    uint64_t hits_ {0};
+    uint64_t misses_ {0};
+    uint64_t evictions_ {0};
+};
+}  // namespace Notification
+}  // namespace OHOS
+
+#endif  // BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_ANS_INCLUDE_NOTIFICATION_IMAGE_CACHE_H
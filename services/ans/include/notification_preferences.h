@@ -16,6 +16,9 @@
 #ifndef BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_NOTIFICATION_PREFERENCES_H
 #define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_NOTIFICATION_PREFERENCES_H
 
+#include <mutex>
+#include <shared_mutex>
+
 #include "refbase.h"
 #include "singleton.h"
 
@@ -324,20 +327,23 @@ public:
     void RemoveSettings(int32_t userId);
 
 private:
+    void GetOrCreateBundleInfo(
+        const sptr<NotificationBundleOption> &bundleOption, NotificationPreferencesInfo::BundleInfo &bundleInfo) const;
+    void CommitBundleInfo(NotificationPreferencesInfo::BundleInfo &&bundleInfo);
     ErrCode CheckSlotForCreateSlot(const sptr<NotificationBundleOption> &bundleOption,
-        const sptr<NotificationSlot> &slot, NotificationPreferencesInfo &preferencesInfo) const;
+        const sptr<NotificationSlot> &slot, NotificationPreferencesInfo::BundleInfo &bundleInfo) const;
     ErrCode CheckGroupForCreateSlotGroup(const sptr<NotificationBundleOption> &bundleOption,
-        const sptr<NotificationSlotGroup> &group, NotificationPreferencesInfo &preferencesInfo) const;
+        const sptr<NotificationSlotGroup> &group, NotificationPreferencesInfo::BundleInfo &bundleInfo) const;
     ErrCode CheckSlotForRemoveSlot(const sptr<NotificationBundleOption> &bundleOption,
-        const NotificationConstant::SlotType &slotType, NotificationPreferencesInfo &preferencesInfo) const;
+        const NotificationConstant::SlotType &slotType, NotificationPreferencesInfo::BundleInfo &bundleInfo) const;
     ErrCode CheckGroupForRemoveSlotGroup(const sptr<NotificationBundleOption> &bundleOption, const std::string &groupId,
-        NotificationPreferencesInfo &preferencesInfo) const;
+        NotificationPreferencesInfo::BundleInfo &bundleInfo) const;
     ErrCode CheckSlotForUpdateSlot(const sptr<NotificationBundleOption> &bundleOption,
-        const sptr<NotificationSlot> &slot, NotificationPreferencesInfo &preferencesInfo) const;
+        const sptr<NotificationSlot> &slot, NotificationPreferencesInfo::BundleInfo &bundleInfo) const;
     ErrCode CheckGroupForUpdateSlotGroup(const sptr<NotificationBundleOption> &bundleOption,
-        const sptr<NotificationSlotGroup> &group, NotificationPreferencesInfo &preferencesInfo) const;
+        const sptr<NotificationSlotGroup> &group, NotificationPreferencesInfo::BundleInfo &bundleInfo) const;
     template <typename T>
-    ErrCode SetBundleProperty(NotificationPreferencesInfo &preferencesInfo,
+    ErrCode SetBundleProperty(
         const sptr<NotificationBundleOption> &bundleOption, const BundleType &type, const T &value);
     template <typename T>
     ErrCode SaveBundleProperty(NotificationPreferencesInfo::BundleInfo &bundleInfo,
@@ -349,6 +355,11 @@ private:
     bool CheckApiCompatibility(const sptr<NotificationBundleOption> &bundleOption) const;
 
 private:
+    // Changes may come from any thread, writeMutex_ serializes them from the read of the bundle they modify to the
+    // write of the database. Readers only wait on preferenceMutex_ while a change is installed.
+    // A change copies only the bundle it modifies and installs it under the lock once the database is written.
+    std::mutex writeMutex_;
+    mutable std::shared_mutex preferenceMutex_;
     NotificationPreferencesInfo preferencesInfo_ {};
     std::unique_ptr<NotificationPreferencesDatabase> preferncesDB_ = nullptr;
     DECLARE_DELAYED_REF_SINGLETON(NotificationPreferences);
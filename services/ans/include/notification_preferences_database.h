@@ -17,7 +17,10 @@
 #define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_NOTIFICATION_PREFERENCES_DATABASE_H
 
 #include <functional>
+#include <map>
 #include <memory>
+#include <set>
+#include <string_view>
 
 #include "distributed_kv_data_manager.h"
 #include "notification_preferences_info.h"
@@ -194,7 +197,7 @@ private:
     bool PutBundlePropertyValueToDisturbeDB(const NotificationPreferencesInfo::BundleInfo &bundleInfo);
     template <typename T>
     DistributedKv::Status PutBundlePropertyToDisturbeDB(
-        const std::string &bundleKey, const BundleType &type, const T &t);
+        const NotificationPreferencesInfo::BundleInfo &bundleInfo, const BundleType &type, const T &t);
     bool PutBundleToDisturbeDB(
         const std::string &bundleKey, const NotificationPreferencesInfo::BundleInfo &bundleInfo);
 
@@ -212,36 +215,69 @@ private:
         std::vector<DistributedKv::Entry> &entries) const;
     void GenerateSlotEntry(const std::string &bundleKey, const sptr<NotificationSlot> &slot,
         std::vector<DistributedKv::Entry> &entries) const;
-    void GenerateEntry(
-        const std::string &key, const std::string &value, std::vector<DistributedKv::Entry> &entry) const;
 
-    std::string FindLastString(const std::string &findString, const std::string &inputString) const;
-    std::string SubUniqueIdentifyFromString(const std::string &findString, const std::string &keyStr) const;
-    std::string VectorToString(const std::vector<int64_t> &data) const;
     void StringToVector(const std::string &str, std::vector<int64_t> &data) const;
     int32_t StringToInt(const std::string &str) const;
     int64_t StringToInt64(const std::string &str) const;
-    bool IsSlotKey(const std::string &bundleKey, const std::string &key) const;
-    bool IsGroupKey(const std::string &bundleKey, const std::string &key) const;
     std::string GenerateSlotKey(
         const std::string &bundleKey, const std::string &type = "", const std::string &subType = "") const;
     std::string GenerateGroupKey(const std::string &bundleKey, const std::string &subType = "") const;
     std::string GenerateBundleKey(const std::string &bundleKey, const std::string &type = "") const;
+    std::string GenerateSlotRecordKey(const std::string &bundleKey, const std::string &type) const;
+    std::string GenerateGroupRecordKey(const std::string &bundleKey, const std::string &groupId) const;
 
-    void ParseBundleFromDistureDB(
-        NotificationPreferencesInfo &info, const std::vector<DistributedKv::Entry> &entries);
-    void ParseSlotFromDisturbeDB(NotificationPreferencesInfo::BundleInfo &bundleInfo, const std::string &bundleKey,
-        const DistributedKv::Entry &entry);
-    void ParseGroupFromDisturbeDB(NotificationPreferencesInfo::BundleInfo &bundleInfo, const std::string &bundleKey,
-        const DistributedKv::Entry &entry);
-    void ParseBundlePropertyFromDisturbeDB(NotificationPreferencesInfo::BundleInfo &bundleInfo,
-        const std::string &bundleKey, const DistributedKv::Entry &entry);
+    /**
+     * A bundle being loaded, with what can only be applied once all of its entries are read.
+     */
+    struct LoadingBundle {
+        NotificationPreferencesInfo::BundleInfo bundleInfo;
+        bool hasBundleRecord {false};
+        std::set<NotificationConstant::SlotType> slotRecords;
+        std::set<std::string> groupRecords;
+        // Entries of the layout with one entry per property, keyed after the bundle key.
+        std::vector<std::pair<std::string_view, const DistributedKv::Entry *>> legacyEntries;
+        std::map<std::string, std::pair<std::string, std::string>> groups;  // group id -> (name, description)
+        std::map<NotificationConstant::SlotType, std::string> enableVibrations;
+    };
+
+    /**
+     * @brief Builds the bundles from the entries of all the bundles, read in one scan.
+     *
+     * @param info Indicates the preferences the bundles are added to.
+     * @param labelEntries Indicates the label entries, their values are the bundle keys.
+     * @param bundleEntries Indicates the entries of all the bundles.
+     * @param recordEntries Indicates the records the legacy entries are migrated to.
+     * @param legacyKeys Indicates the keys of the legacy entries, to be deleted once the records are stored.
+     */
+    void ParseBundleFromDistureDB(NotificationPreferencesInfo &info,
+        const std::vector<DistributedKv::Entry> &labelEntries, const std::vector<DistributedKv::Entry> &bundleEntries,
+        std::vector<DistributedKv::Entry> &recordEntries, std::vector<DistributedKv::Key> &legacyKeys);
+
+    /**
+     * @brief Parses a record of a bundle, its bundle properties, a slot or a group.
+     *
+     * @param bundle Indicates the bundle being loaded.
+     * @param key Indicates the key of the entry after the bundle key and its separator.
+     * @param value Indicates the value of the entry.
+     * @return Returns false if the entry is not a record.
+     */
+    bool ParseRecordEntry(LoadingBundle &bundle, const std::string_view &key, const DistributedKv::Value &value);
+
+    /**
+     * @brief Parses an entry of the layout with one entry per property, unless a record of the bundle holds it.
+     *
+     * @param bundle Indicates the bundle being loaded.
+     * @param key Indicates the key of the entry after the bundle key and its separator.
+     * @param value Indicates the value of the entry.
+     */
+    void ParseLegacyEntry(LoadingBundle &bundle, const std::string_view &key, const DistributedKv::Value &value);
+    void ApplyLegacyEntries(LoadingBundle &bundle);
+    void GenerateRecordEntries(const std::string &bundleKey, NotificationPreferencesInfo::BundleInfo &bundleInfo,
+        std::vector<DistributedKv::Entry> &entries) const;
     void ParseDoNotDisturbType(NotificationPreferencesInfo &info);
     void ParseDoNotDisturbBeginDate(NotificationPreferencesInfo &info);
     void ParseDoNotDisturbEndDate(NotificationPreferencesInfo &info);
     void ParseEnableAllNotification(NotificationPreferencesInfo &info);
-    void ParseGroupDescription(
-        const std::string &bundleKey, sptr<NotificationSlotGroup> &group, const DistributedKv::Entry &entry);
     void ParseBundleName(NotificationPreferencesInfo::BundleInfo &bundleInfo, const std::string &value) const;
     void ParseBundleImportance(NotificationPreferencesInfo::BundleInfo &bundleInfo, const std::string &value) const;
     void ParseBundleShowBadge(NotificationPreferencesInfo::BundleInfo &bundleInfo, const std::string &value) const;
@@ -253,8 +289,6 @@ private:
     void ParseBundlePoppedDialog(
         NotificationPreferencesInfo::BundleInfo &bundleInfo, const std::string &value) const;
     void ParseBundleUid(NotificationPreferencesInfo::BundleInfo &bundleInfo, const std::string &value) const;
-    void ParseSlot(
-        const std::string &findString, sptr<NotificationSlot> &slot, const DistributedKv::Entry &entry);
     void ParseSlotGroupId(sptr<NotificationSlot> &slot, const std::string &value) const;
     void ParseSlotDescription(sptr<NotificationSlot> &slot, const std::string &value) const;
     void ParseSlotLevel(sptr<NotificationSlot> &slot, const std::string &value) const;
@@ -275,10 +309,10 @@ private:
     void GetEnableAllNotification(NotificationPreferencesInfo &info, int32_t userId);
 
     static const std::map<std::string,
-        std::function<void(NotificationPreferencesDatabase *, sptr<NotificationSlot> &, std::string &)>>
+        std::function<void(NotificationPreferencesDatabase *, sptr<NotificationSlot> &, std::string &)>, std::less<>>
         slotMap_;
     static const std::map<std::string, std::function<void(NotificationPreferencesDatabase *,
-                                           NotificationPreferencesInfo::BundleInfo &, std::string &)>>
+                                           NotificationPreferencesInfo::BundleInfo &, std::string &)>, std::less<>>
         bundleMap_;
 
     const DistributedKv::AppId appId_ {APP_ID};
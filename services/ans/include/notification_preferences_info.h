@@ -273,6 +273,7 @@ public:
      * @param info Indicates the bundle.
      */
     void SetBundleInfo(const BundleInfo &info);
+    void SetBundleInfo(BundleInfo &&info);
 
     /**
      * get bundle info from preferences info.
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_ANS_INCLUDE_NOTIFICATION_RECORD_STORE_H
+#define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_ANS_INCLUDE_NOTIFICATION_RECORD_STORE_H
+
+#include <iterator>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "notification_record.h"
+
+namespace OHOS {
+namespace Notification {
+/**
+ * Active notification records kept in display order, indexed by notification key and by the
+ * attributes the publish, cancel and delete paths look records up with.
+ *
+ * Records are ordered by the create time of their requests. Records with the same create time keep
+ * the order in which they were added, which is the order a stable sort of the whole list would give.
+ *
+ * The store has a single writer, the service handler thread. Lookups and queries may be called from any
+ * thread and run concurrently with each other. Iterating with begin() and end() is only safe on the writer
+ * thread; other threads use GetAll().
+ */
+class NotificationRecordStore {
+private:
+    struct OrderKey {
+        int64_t createTime {0};
+        int64_t sequence {0};
+
+        bool operator<(const OrderKey &other) const
+        {
+            return (createTime < other.createTime) || ((createTime == other.createTime) && (sequence < other.sequence));
+        }
+    };
+    using RecordMap = std::map<OrderKey, std::shared_ptr<NotificationRecord>>;
+
+    struct EvictionKey {
+        int32_t level {0};
+        OrderKey orderKey;
+
+        bool operator<(const EvictionKey &other) const
+        {
+            return (level < other.level) || ((level == other.level) && (orderKey < other.orderKey));
+        }
+    };
+    using EvictionMap = std::map<EvictionKey, std::shared_ptr<NotificationRecord>>;
+
+public:
+    using RecordPtr = std::shared_ptr<NotificationRecord>;
+
+    /**
+     * Iterates the records of the store in display order.
+     */
+    class ConstIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = RecordPtr;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const RecordPtr *;
+        using reference = const RecordPtr &;
+
+        ConstIterator() = default;
+        explicit ConstIterator(RecordMap::const_iterator iter) : iter_(iter)
+        {}
+
+        reference operator*() const
+        {
+            return iter_->second;
+        }
+        pointer operator->() const
+        {
+            return &iter_->second;
+        }
+        ConstIterator &operator++()
+        {
+            ++iter_;
+            return *this;
+        }
+        ConstIterator operator++(int)
+        {
+            ConstIterator old = *this;
+            ++iter_;
+            return old;
+        }
+        bool operator==(const ConstIterator &other) const
+        {
+            return iter_ == other.iter_;
+        }
+        bool operator!=(const ConstIterator &other) const
+        {
+            return iter_ != other.iter_;
+        }
+
+    private:
+        RecordMap::const_iterator iter_;
+    };
+
+    NotificationRecordStore() = default;
+    ~NotificationRecordStore() = default;
+
+    /**
+     * @brief Adds a record in create time order, after the records with the same create time.
+     * The key of the record must not exist in the store.
+     *
+     * @param record Indicates the record to add.
+     * @return Returns true if the record is added; returns false if the key already exists.
+     */
+    bool Add(const RecordPtr &record);
+
+    /**
+     * @brief Replaces the record that has the same key. The record is moved if its create time changed.
+     *
+     * @param record Indicates the new record.
+     * @return Returns true if a record is replaced; returns false if the key does not exist.
+     */
+    bool Update(const RecordPtr &record);
+
+    /**
+     * @brief Removes a record.
+     *
+     * @param record Indicates the record to remove.
+     * @return Returns true if the record is removed; returns false otherwise.
+     */
+    bool Remove(const RecordPtr &record);
+
+    /**
+     * @brief Finds a record by notification key.
+     *
+     * @param key Indicates the notification key.
+     * @return Returns the record if found; returns nullptr otherwise.
+     */
+    RecordPtr Find(const std::string &key) const;
+
+    /**
+     * @brief Checks whether a record with the notification key exists.
+     *
+     * @param key Indicates the notification key.
+     * @return Returns true if the record exists; returns false otherwise.
+     */
+    bool Exists(const std::string &key) const;
+
+    /**
+     * @brief Finds a record by the owner bundle, label and id of the notification.
+     *
+     * @param bundleName Indicates the bundle name of the record.
+     * @param uid Indicates the uid of the record.
+     * @param label Indicates the notification label.
+     * @param notificationId Indicates the notification id.
+     * @param deviceId Indicates the source device id, empty for local notifications.
+     * @return Returns the record if found; returns nullptr otherwise.
+     */
+    RecordPtr FindById(const std::string &bundleName, int32_t uid, const std::string &label, int32_t notificationId,
+        const std::string &deviceId) const;
+
+    /**
+     * @brief Obtains the records whose bundle name and uid both match, in store order.
+     *
+     * @param bundleName Indicates the bundle name.
+     * @param uid Indicates the uid.
+     * @return Returns the matched records.
+     */
+    std::vector<RecordPtr> GetByBundle(const std::string &bundleName, int32_t uid) const;
+
+    /**
+     * @brief Obtains the records whose bundle name or uid matches, in store order.
+     *
+     * @param bundleName Indicates the bundle name.
+     * @param uid Indicates the uid.
+     * @param includeRemote Specifies whether all records of remote devices are included as well.
+     * @return Returns the matched records.
+     */
+    std::vector<RecordPtr> GetByBundleNameOrUid(const std::string &bundleName, int32_t uid, bool includeRemote) const;
+
+    /**
+     * @brief Obtains the records published by the user, in store order.
+     *
+     * @param userId Indicates the user id.
+     * @return Returns the matched records.
+     */
+    std::vector<RecordPtr> GetByUser(int32_t userId) const;
+
+    /**
+     * @brief Obtains the records of a bundle that belong to the group, in store order.
+     *
+     * @param bundleName Indicates the bundle name.
+     * @param uid Indicates the uid.
+     * @param groupName Indicates the group name.
+     * @return Returns the matched records.
+     */
+    std::vector<RecordPtr> GetByGroup(const std::string &bundleName, int32_t uid, const std::string &groupName) const;
+
+    /**
+     * @brief Obtains the number of records whose bundle name matches.
+     *
+     * @param bundleName Indicates the bundle name.
+     * @return Returns the number of records.
+     */
+    size_t GetCountByBundleName(const std::string &bundleName) const;
+
+    /**
+     * @brief Obtains the records of the bundle name, in store order.
+     *
+     * @param bundleName Indicates the bundle name.
+     * @return Returns the matched records.
+     */
+    std::vector<RecordPtr> GetByBundleName(const std::string &bundleName) const;
+
+    /**
+     * @brief Obtains the number of records whose notification bundle name matches. The notification bundle name is
+     * the owner bundle, which differs from the bundle option of an agent notification.
+     *
+     * @param bundleName Indicates the notification bundle name.
+     * @return Returns the number of records.
+     */
+    size_t GetCountByOwnerBundleName(const std::string &bundleName) const;
+
+    /**
+     * @brief Obtains the record to evict first: the one with the lowest slot level, then the oldest.
+     *
+     * @return Returns the record to evict, or nullptr if the store is empty.
+     */
+    RecordPtr GetEvictionCandidate() const;
+
+    /**
+     * @brief Obtains the record of the notification bundle name to evict first: the one with the lowest slot level,
+     * then the oldest.
+     *
+     * @param bundleName Indicates the notification bundle name, see GetCountByOwnerBundleName.
+     * @return Returns the record to evict, or nullptr if the bundle name has no record.
+     */
+    RecordPtr GetEvictionCandidate(const std::string &bundleName) const;
+
+    /**
+     * @brief Obtains the number of records whose bundle name and uid both match.
+     *
+     * @param bundleName Indicates the bundle name.
+     * @param uid Indicates the uid.
+     * @return Returns the number of records.
+     */
+    size_t GetCountByBundle(const std::string &bundleName, int32_t uid) const;
+
+    /**
+     * @brief Obtains a snapshot of all records, in store order.
+     *
+     * @return Returns the records.
+     */
+    std::vector<RecordPtr> GetAll() const;
+
+    /**
+     * @brief Obtains the version of the store, which increases every time a record is added, replaced or removed.
+     *
+     * @return Returns the version of the store.
+     */
+    uint64_t GetVersion() const;
+
+    size_t Size() const;
+    bool Empty() const;
+    void Clear();
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+
+private:
+    template<typename K>
+    using Index = std::unordered_map<K, RecordMap>;
+
+    struct IndexKeys {
+        std::string bundleKey;
+        std::string bundleName;
+        std::string ownerBundleName;
+        int32_t uid {0};
+        int32_t userId {0};
+        int32_t level {0};
+        std::string groupKey;
+        std::string idKey;
+        std::string deviceId;
+    };
+
+    struct Entry {
+        OrderKey orderKey;
+        IndexKeys indexKeys;
+    };
+
+    static IndexKeys GenerateIndexKeys(const RecordPtr &record);
+    static std::string GenerateBundleKey(const std::string &bundleName, int32_t uid);
+    static std::string GenerateIdKey(const std::string &bundleName, int32_t uid, const std::string &label,
+        int32_t notificationId, const std::string &deviceId);
+    void AddToIndexes(const OrderKey &orderKey, const RecordPtr &record, const IndexKeys &indexKeys);
+    void RemoveFromIndexes(const OrderKey &orderKey, const IndexKeys &indexKeys);
+    static std::vector<RecordPtr> Collect(const std::vector<const RecordMap *> &maps);
+
+    template<typename K>
+    static void AddToIndex(Index<K> &index, const K &key, const OrderKey &orderKey, const RecordPtr &record);
+    template<typename K>
+    static void RemoveFromIndex(Index<K> &index, const K &key, const OrderKey &orderKey);
+    template<typename K>
+    static const RecordMap *FindInIndex(const Index<K> &index, const K &key);
+
+    RecordMap records_;
+    int64_t firstSequence_ {0};
+    int64_t lastSequence_ {0};
+    uint64_t version_ {0};
+    std::unordered_map<std::string, Entry> entries_;
+    Index<std::string> bundleIndex_;
+    Index<std::string> bundleNameIndex_;
+    Index<int32_t> uidIndex_;
+    Index<int32_t> userIndex_;
+    Index<std::string> groupIndex_;
+    Index<std::string> idIndex_;
+    Index<std::string> deviceIndex_;
+    EvictionMap evictionIndex_;
+    std::unordered_map<std::string, EvictionMap> bundleEvictionIndex_;  // by owner bundle name
+    mutable std::shared_mutex mutex_;
+};
+}  // namespace Notification
+}  // namespace OHOS
+
+#endif  // BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_ANS_INCLUDE_NOTIFICATION_RECORD_STORE_H
@@ -16,9 +16,16 @@
 #ifndef BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_INCLUDE_NOTIFICATION_SUBSCRIBER_MANAGER_H
 #define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_INCLUDE_NOTIFICATION_SUBSCRIBER_MANAGER_H
 
+#include <deque>
+#include <functional>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "errors.h"
 #include "event_handler.h"
@@ -30,6 +37,7 @@
 #include "ans_subscriber_interface.h"
 #include "notification_bundle_option.h"
 #include "notification_constant.h"
+#include "notification_delivery_queue.h"
 #include "notification_request.h"
 #include "notification_sorting_map.h"
 #include "notification_subscribe_info.h"
@@ -76,6 +84,27 @@ public:
     void NotifyCanceled(const sptr<Notification> &notification,
         const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason);
 
+    /**
+     * @brief Notify the subscribers on consumed of a batch of notifications, each subscriber receives the
+     * notifications routed to it in one callback.
+     *
+     * @param notifications Indicates the Notification objects.
+     * @param notificationMap Indicates the NotificationSortingMap object after the whole batch.
+     */
+    void NotifyConsumedBatch(
+        const std::vector<sptr<Notification>> &notifications, const sptr<NotificationSortingMap> &notificationMap);
+
+    /**
+     * @brief Notify the subscribers on canceled of a batch of notifications, each subscriber receives the
+     * notifications routed to it in one callback.
+     *
+     * @param notifications Indicates the Notification objects.
+     * @param notificationMap Indicates the NotificationSortingMap object after the whole batch.
+     * @param deleteReason Indicates the delete reason.
+     */
+    void NotifyCanceledBatch(const std::vector<sptr<Notification>> &notifications,
+        const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason);
+
     /**
      * @brief Notify all subscribers on updated.
      *
@@ -92,6 +121,16 @@ public:
 
     void NotifyEnabledNotificationChanged(const sptr<EnabledNotificationCallbackData> &callbackData);
 
+    /**
+     * @brief Sends the full sorting map to a subscriber, which then receives deltas based on it.
+     *
+     * @param subscriber Indicates the AnsSubscriberInterface object.
+     * @param notificationMap Indicates the current NotificationSortingMap object.
+     * @return Indicates the result code.
+     */
+    ErrCode ResyncSortingMap(
+        const sptr<AnsSubscriberInterface> &subscriber, const sptr<NotificationSortingMap> &notificationMap);
+
     /**
      * @brief Obtains the death event.
      *
@@ -99,8 +138,33 @@ public:
      */
     void OnRemoteDied(const wptr<IRemoteObject> &object);
 
+    /**
+     * @brief Sets the capacity and the overflow policy of the delivery queues of all subscribers.
+     *
+     * @param capacity Indicates the max number of callbacks queued for one subscriber.
+     * @param policy Indicates what is given up when a queue is full.
+     * @return Returns ERR_OK on success, others on failure.
+     */
+    ErrCode SetDeliveryQueuePolicy(size_t capacity, NotificationDeliveryQueue::OverflowPolicy policy);
+
+    /**
+     * @brief Dumps the subscribers and the state of their delivery queues.
+     *
+     * @param dumpInfo Indicates the dump information.
+     */
+    void Dump(std::vector<std::string> &dumpInfo);
+
 private:
     struct SubscriberRecord;
+    struct SortingMapChange {
+        uint64_t version {0};
+        std::set<std::string> changedKeys {};
+    };
+    using SubscriberRecordMap = std::map<uint64_t, std::shared_ptr<SubscriberRecord>>;
+    struct SubscriberRoute {
+        SubscriberRecordMap allBundles {};
+        std::unordered_map<std::string, SubscriberRecordMap> bundles {};
+    };
 
     std::shared_ptr<SubscriberRecord> FindSubscriberRecord(const wptr<IRemoteObject> &object);
     std::shared_ptr<SubscriberRecord> FindSubscriberRecord(const sptr<AnsSubscriberInterface> &subscriber);
@@ -118,17 +182,52 @@ private:
         const sptr<Notification> &notification, const sptr<NotificationSortingMap> &notificationMap);
     void NotifyCanceledInner(const sptr<Notification> &notification,
         const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason);
+    void NotifyConsumedBatchInner(
+        const std::vector<sptr<Notification>> &notifications, const sptr<NotificationSortingMap> &notificationMap);
+    void NotifyCanceledBatchInner(const std::vector<sptr<Notification>> &notifications,
+        const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason);
+    std::map<uint64_t, std::pair<std::shared_ptr<SubscriberRecord>, std::vector<sptr<Notification>>>>
+        GroupBySubscriber(const std::vector<sptr<Notification>> &notifications);
     void NotifyUpdatedInner(const sptr<NotificationSortingMap> &notificationMap);
     void NotifyDoNotDisturbDateChangedInner(const sptr<NotificationDoNotDisturbDate> &date);
     void NotifyEnabledNotificationChangedInner(const sptr<EnabledNotificationCallbackData> &callbackData);
     bool IsSystemUser(int32_t userId);
+    int32_t GetRouteUserId(int32_t userId);
+    void AddToRoutes(const std::shared_ptr<SubscriberRecord> &record);
+    void RemoveFromRoutes(const std::shared_ptr<SubscriberRecord> &record);
+    std::vector<std::shared_ptr<SubscriberRecord>> GetRoutedSubscribers(const sptr<Notification> &notification);
+    void Deliver(const std::shared_ptr<SubscriberRecord> &record, const std::string &key,
+        const NotificationDeliveryQueue::Task &task,
+        NotificationDeliveryQueue::SortingMapType type = NotificationDeliveryQueue::SortingMapType::NONE,
+        const NotificationDeliveryQueue::Task &fullTask = nullptr);
+    using SortingMapTask = std::function<void(const sptr<NotificationSortingMap> &sortingMap)>;
+    void DeliverWithSortingMap(const std::shared_ptr<SubscriberRecord> &record, const std::string &key,
+        const sptr<NotificationSortingMap> &notificationMap, const SortingMapTask &task);
+    void DisconnectSubscriber(const std::shared_ptr<SubscriberRecord> &record);
+    void UpdateSortingMap(const sptr<NotificationSortingMap> &notificationMap);
+    std::set<std::string> GetChangedKeys(
+        const sptr<NotificationSortingMap> &previous, const sptr<NotificationSortingMap> &current);
+    sptr<NotificationSortingMap> GetSortingMapForSubscriber(
+        const std::shared_ptr<SubscriberRecord> &record, const sptr<NotificationSortingMap> &notificationMap);
 
 private:
     std::list<std::shared_ptr<SubscriberRecord>> subscriberRecordList_ {};
+    std::unordered_map<int32_t, SubscriberRoute> subscriberRoutes_ {};
+    uint64_t subscriberSequence_ {0};
     std::shared_ptr<OHOS::AppExecFwk::EventRunner> runner_ {};
     std::shared_ptr<OHOS::AppExecFwk::EventHandler> handler_ {};
+    std::vector<std::shared_ptr<OHOS::AppExecFwk::EventRunner>> deliveryRunners_ {};
+    std::vector<std::shared_ptr<OHOS::AppExecFwk::EventHandler>> deliveryHandlers_ {};
+    size_t deliveryQueueCapacity_ {0};
+    NotificationDeliveryQueue::OverflowPolicy deliveryQueuePolicy_ {
+        NotificationDeliveryQueue::OverflowPolicy::COALESCE};
     sptr<AnsSubscriberInterface> ansSubscriberProxy_ {};
     sptr<IRemoteObject::DeathRecipient> recipient_ {};
+    // The map given by the service is shared by its callbacks, so the version is set on a copy of it.
+    sptr<NotificationSortingMap> sortingMapSource_ {};
+    sptr<NotificationSortingMap> sortingMap_ {};
+    uint64_t sortingMapVersion_ {0};
+    std::deque<SortingMapChange> sortingMapChanges_ {};
 
     DECLARE_DELAYED_SINGLETON(NotificationSubscriberManager);
     DISALLOW_COPY_AND_MOVE(NotificationSubscriberManager);
@@ -198,6 +198,26 @@ const static std::string KEY_SLOT_ENABLE_BYPASS_DND = "enableBypassDnd";
  */
 const static std::string KEY_SLOT_ENABLED = "enabled";
 
+/**
+ * Indicates that disturbe key which bundle record, holding all the properties of the bundle.
+ */
+const static std::string KEY_BUNDLE_RECORD = "record";
+
+/**
+ * Indicates that disturbe key which slot record, holding all the properties of a slot.
+ */
+const static std::string KEY_SLOT_RECORD = "slotRecord";
+
+/**
+ * Indicates that disturbe key which group record, holding all the properties of a group.
+ */
+const static std::string KEY_GROUP_RECORD = "groupRecord";
+
+/**
+ * Indicates the version of the record format, the first byte of a record.
+ */
+const static uint8_t PREFERENCES_RECORD_VERSION = 1;
+
 /**
  * Indicates distributed database app id.
  */
@@ -17,6 +17,9 @@
 #define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_FRAMEWORKS_ANS_CORE_INCLUDE_REMINDER_DATA_MANAGER_H
 
 #include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "advanced_notification_service.h"
@@ -33,7 +36,7 @@ public:
     {
         Init(false);
     };
-    ~ReminderDataManager() {};
+    ~ReminderDataManager();
 
     ReminderDataManager(ReminderDataManager &other) = delete;
     ReminderDataManager& operator = (const ReminderDataManager &other) = delete;
@@ -135,10 +138,11 @@ public:
     bool ShouldAlert(const sptr<ReminderRequest> &reminder) const;
 
     /**
-     * @brief Show the reminder.
+     * @brief Handles the deadlines due when the system timer fires.
      *
-     * @param isSysTimeChanged Indicates it is triggered as dateTime changed by user or not.
-     * @param want Which contains the given reminder.
+     * Terminates the alerting reminder whose ring duration is over and shows the reminders due in the same tick.
+     *
+     * @param want Indicates the want of the timer.
      */
     void ShowActiveReminder(const EventFwk::Want &want);
 
@@ -158,18 +162,6 @@ public:
      */
     void StartRecentReminder();
 
-    /**
-     * @brief Terminate the alerting reminder.
-     *
-     * 1. Stop sound and vibrate.
-     * 2. Stop the alerting timer.
-     * 3. Update the reminder state.
-     * 4. Update the display content of the notification.
-     *
-     * @param want Which contains the given reminder.
-     */
-    void TerminateAlerting(const OHOS::EventFwk::Want &want);
-
     static const uint8_t TIME_ZONE_CHANGE;
     static const uint8_t DATE_TIME_CHANGE;
 
@@ -220,19 +212,19 @@ private:
     void CloseReminder(const sptr<ReminderRequest> &reminder, bool cancelNotification);
 
     /**
-     * Create a information for timer, such as timer type, repeat policy, interval and want agent.
+     * Create a information for the system timer all the deadlines are multiplexed onto, such as timer type,
+     * repeat policy, interval and want agent.
      *
-     * @param type Indicates the timer type.
      * @return pointer of ReminderTimerInfo.
      */
-    std::shared_ptr<ReminderTimerInfo> CreateTimerInfo(TimerType type) const;
+    std::shared_ptr<ReminderTimerInfo> CreateTimerInfo() const;
 
-    void GetImmediatelyShowRemindersLocked(std::vector<sptr<ReminderRequest>> &reminders) const;
+    void GetImmediatelyShowRemindersLocked(std::vector<sptr<ReminderRequest>> &reminders);
 
     std::string GetSoundUri(const sptr<ReminderRequest> &reminder);
 
     /**
-     * Find the reminder from reminderVector_ by reminder id.
+     * Find the reminder from reminderMap_ by reminder id.
      *
      * @param reminderId Indicates the reminder id.
      * @return pointer of reminder request or nullptr.
@@ -240,7 +232,7 @@ private:
     sptr<ReminderRequest> FindReminderRequestLocked(const int32_t &reminderId);
 
     /**
-     * Find the reminder from {@link reminderVector_} and
+     * Find the reminder from {@link reminderMap_} and
      * {@link notificationBundleOptionMap_} by reminder id and pkgName.
      *
      * @param reminderId Indicates the reminder id.
@@ -258,9 +250,9 @@ private:
     sptr<NotificationBundleOption> FindNotificationBundleOption(const int32_t &reminderId) const;
 
     /**
-     * Obtains the recent reminder which is not expired from reminder vector.
+     * Obtains the recent reminder which is not expired from the trigger queue.
      *
-     * The expired reminders will be removed from reminderVector_ and notificationBundleOptionMap_.
+     * The expired reminders will be removed from the indexes and notificationBundleOptionMap_.
      *
      * @return pointer of reminder object.
      */
@@ -300,12 +292,12 @@ private:
     /**
      * @brief Judges whether the reminder is matched with the bundleOption or userId.
      *
-     * @param reminder Indicates the target reminder.
+     * @param reminderId Indicates the target reminder id.
      * @param packageName Indicates the package name.
      * @param userId Indicates the user id.
      * @return true If the reminder is matched with the bundleOption or userId.
      */
-    bool IsMatched(const sptr<ReminderRequest> &reminder, const std::string &packageName, const int32_t &userId) const;
+    bool IsMatched(const int32_t &reminderId, const std::string &packageName, const int32_t &userId) const;
 
     bool IsAllowedNotify(const sptr<ReminderRequest> &reminder) const;
 
@@ -335,7 +327,7 @@ private:
 
     /**
      * Removes the reminder.
-     * 1. removes the reminder from reminderVector_ and notificationBundleOptionMap_.
+     * 1. removes the reminder from the indexes and notificationBundleOptionMap_.
      * 2. cancels the notification.
      *
      * @param reminderId Indicates the reminder id.
@@ -344,13 +336,19 @@ private:
 
     /**
      * Resets timer status.
-     * 1. Sets timerId_ or timerIdAlerting_ with 0.
+     * 1. Sets triggerDeadline_ or alertingDeadline_ with 0.
      * 2. Sets activeReminderId_ or alertingReminderId with -1.
      *
      * @param type Indicates the timer type.
      */
     void ResetStates(TimerType type);
 
+    /**
+     * Arms the system timer at the earliest of triggerDeadline_ and alertingDeadline_, or stops it if there is
+     * no deadline. Nothing is sent to the time service if the deadline is already armed.
+     */
+    void RearmTimer();
+
     void SetActiveReminder(const sptr<ReminderRequest> &reminder);
     void SetAlertingReminder(const sptr<ReminderRequest> &reminder);
     void ShowActiveReminderExtendLocked(sptr<ReminderRequest> &reminder);
@@ -421,7 +419,54 @@ private:
 
     void UpdateNotification(const sptr<ReminderRequest> &reminder);
 
-    static bool cmp(sptr<ReminderRequest> &reminderRequest, sptr<ReminderRequest> &other);
+    /**
+     * Adds the reminder to reminderMap_, triggerQueue_ and appReminders_. MUTEX must be held.
+     *
+     * @param reminder Indicates the reminder.
+     * @param bundleOption Indicates the bundle option of the reminder, nullptr if it is unknown.
+     */
+    void AddToIndexes(const sptr<ReminderRequest> &reminder, const sptr<NotificationBundleOption> &bundleOption);
+
+    /**
+     * Adds the reminder which is not loaded yet to the indexes. MUTEX must be held.
+     *
+     * @param reminderId Indicates the reminder id.
+     * @param triggerTime Indicates the trigger time of the reminder.
+     * @param bundleOption Indicates the bundle option of the reminder, nullptr if it is unknown.
+     */
+    void AddToIndexes(const int32_t &reminderId, const uint64_t &triggerTime,
+        const sptr<NotificationBundleOption> &bundleOption);
+
+    /**
+     * Removes the reminder from reminderMap_, triggerQueue_ and appReminders_. MUTEX must be held.
+     *
+     * @param reminderId Indicates the reminder id.
+     * @return true if the reminder is indexed.
+     */
+    bool RemoveFromIndexes(const int32_t &reminderId);
+
+    /**
+     * Moves the reminder in triggerQueue_ to its current trigger time. MUTEX must be held.
+     *
+     * @param reminderId Indicates the reminder id.
+     * @return the iterator of the reminder in triggerQueue_.
+     */
+    std::set<std::pair<uint64_t, int32_t>>::iterator RequeueReminder(const int32_t &reminderId);
+
+    /**
+     * Rebuilds triggerQueue_ from the current trigger times of all reminders. MUTEX must be held.
+     */
+    void RebuildTriggerQueue();
+
+    /**
+     * Generates the key of appReminders_.
+     *
+     * @param bundleName Indicates the bundle name.
+     * @param userId Indicates the user id.
+     * @return the key of the application.
+     */
+    static std::string GenerateAppKey(const std::string &bundleName, const int32_t &userId);
+
 
    /**
     * Single instance.
@@ -449,9 +494,41 @@ private:
     bool isReminderAgentReady_ = false;
 
     /**
-     * Vector used to record all the reminders in system.
+     * The reminder is nullptr until it is loaded: at boot only the schedule of the reminders is read, and a reminder
+     * is built when it is about to be shown or is requested. A reminder not loaded yet is neither expired nor shown,
+     * and its trigger time is queuedTriggerTime.
+     */
+    struct ReminderEntry {
+        sptr<ReminderRequest> reminder;
+        uint64_t queuedTriggerTime {0};
+        std::string appKey;
+    };
+
+    /**
+     * Builds the reminder of the entry from the database if it is not loaded yet. MUTEX must be held.
+     *
+     * @param entry Indicates the entry of the reminder.
+     * @param reminderId Indicates the reminder id.
+     * @return pointer of the reminder, nullptr if it fails to be loaded.
+     */
+    sptr<ReminderRequest> LoadReminder(ReminderEntry &entry, const int32_t &reminderId);
+
+    /**
+     * Map used to record all the reminders in system by reminder id.
+     */
+    std::unordered_map<int32_t, ReminderEntry> reminderMap_;
+
+    /**
+     * Reminders ordered by (trigger time, reminder id). The trigger time is the one the reminder had when it was
+     * queued: a reminder only moves later on its own (shown, snoozed or closed), so a stale entry is found before
+     * the recent reminder and is requeued there. Changes of the system time rebuild the queue.
+     */
+    std::set<std::pair<uint64_t, int32_t>> triggerQueue_;
+
+    /**
+     * Map used to record the ids of the reminders of each application (bundle name and user id).
      */
-    std::vector<sptr<ReminderRequest>> reminderVector_;
+    std::unordered_map<std::string, std::set<int32_t>> appReminders_;
 
     /**
      * Vector used to record all the reminders which has been shown on panel.
@@ -464,14 +541,25 @@ private:
     std::map<int32_t, sptr<NotificationBundleOption>> notificationBundleOptionMap_;
 
     /**
-     * This timer is used to control the triggerTime of next reminder.
+     * The system timer the deadlines below are multiplexed onto. It is created once and armed at the earliest
+     * deadline.
      */
     uint64_t timerId_ {0};
 
     /**
-     * This timer is used to control the ringDuration of the alerting reminder.
+     * The deadline the system timer is armed at, 0 if it is not armed.
      */
-    uint64_t timerIdAlerting_ {0};
+    uint64_t armedTime_ {0};
+
+    /**
+     * The deadline used to control the triggerTime of next reminder, 0 if there is no active reminder.
+     */
+    uint64_t triggerDeadline_ {0};
+
+    /**
+     * The deadline used to control the ringDuration of the alerting reminder, 0 if there is none.
+     */
+    uint64_t alertingDeadline_ {0};
 
     /**
      * Indicates the active reminder that timing is taking effect.
@@ -487,10 +575,6 @@ private:
 
     std::shared_ptr<Media::Player> soundPlayer_ = nullptr;
 
-    /**
-     * Indicates the total count of reminders in system.
-     */
-    int16_t totalCount_ {0};
     int currentUserId_ {0};
     sptr<AdvancedNotificationService> advancedNotificationService_ = nullptr;
     std::shared_ptr<ReminderStore> store_ = nullptr;
@@ -15,8 +15,11 @@
 
 #include "advanced_notification_service.h"
 
+#include <algorithm>
 #include <functional>
 #include <iomanip>
+#include <map>
+#include <set>
 #include <sstream>
 
 #include "ability_context.h"
@@ -24,6 +27,7 @@
 #include "access_token_helper.h"
 #include "accesstoken_kit.h"
 #include "ans_const_define.h"
+#include "ans_image_util.h"
 #include "ans_inner_errors.h"
 #include "ans_log_wrapper.h"
 #include "ans_watchdog.h"
@@ -63,6 +67,11 @@ constexpr char RECENT_NOTIFICATION_OPTION[] = "recent";
 constexpr char DISTRIBUTED_NOTIFICATION_OPTION[] = "distributed";
 #endif
 constexpr char SET_RECENT_COUNT_OPTION[] = "setRecentCount";
+constexpr char SUBSCRIBER_OPTION[] = "subscriber";
+constexpr char SET_SUBSCRIBER_QUEUE_OPTION[] = "setSubscriberQueue";
+constexpr size_t SUBSCRIBER_QUEUE_MAX_CAPACITY = 65536;
+constexpr char IMAGE_CACHE_OPTION[] = "imageCache";
+constexpr size_t IMAGE_CACHE_BUDGET = 8 * 1024 * 1024;
 constexpr char FOUNDATION_BUNDLE_NAME[] = "ohos.global.systemres";
 
 constexpr int32_t NOTIFICATION_MIN_COUNT = 0;
@@ -183,7 +192,9 @@ inline ErrCode CheckPictureSize(const sptr<NotificationRequest> &request)
             std::static_pointer_cast<NotificationPictureContent>(content->GetNotificationContent());
         if (pictureContent != nullptr) {
             auto picture = pictureContent->GetBigPicture();
-            if (picture != nullptr && static_cast<uint32_t>(picture->GetByteCount()) > MAX_PICTURE_SIZE) {
+            // Only the pictures received as shared memory may be larger, the others went through the binder buffer.
+            uint32_t maxSize = AnsImageUtil::IsSharedImage(picture) ? MAX_SHARED_PICTURE_SIZE : MAX_PICTURE_SIZE;
+            if (picture != nullptr && static_cast<uint32_t>(picture->GetByteCount()) > maxSize) {
                 result = ERR_ANS_PICTURE_OVER_SIZE;
             }
         }
@@ -262,7 +273,7 @@ sptr<AdvancedNotificationService> AdvancedNotificationService::GetInstance()
     return instance_;
 }
 
-AdvancedNotificationService::AdvancedNotificationService()
+AdvancedNotificationService::AdvancedNotificationService() : imageCache_(IMAGE_CACHE_BUDGET)
 {
     runner_ = OHOS::AppExecFwk::EventRunner::Create();
     handler_ = std::make_shared<OHOS::AppExecFwk::EventHandler>(runner_);
@@ -304,6 +315,8 @@ AdvancedNotificationService::AdvancedNotificationService()
             std::placeholders::_2,
             std::placeholders::_3,
             std::placeholders::_4),
+        .OnPublishBatch = std::bind(
+            &AdvancedNotificationService::OnDistributedPublishBatch, this, std::placeholders::_1),
     };
     DistributedNotificationManager::GetInstance()->RegisterCallback(distributedCallback);
 #endif
@@ -423,39 +436,72 @@ ErrCode AdvancedNotificationService::PrepareNotificationInfo(
     return ERR_OK;
 }
 
-ErrCode AdvancedNotificationService::PublishPreparedNotification(
+std::shared_ptr<NotificationRecord> AdvancedNotificationService::MakeNotificationRecord(
     const sptr<NotificationRequest> &request, const sptr<NotificationBundleOption> &bundleOption)
 {
-    ANS_LOGI("PublishPreparedNotification");
     auto record = std::make_shared<NotificationRecord>();
+    ShareImages(request);
     record->request = request;
     record->notification = new (std::nothrow) Notification(request);
     if (record->notification == nullptr) {
         ANS_LOGE("Failed to create notification.");
-        return ERR_ANS_NO_MEMORY;
+        return nullptr;
     }
     record->bundleOption = bundleOption;
     SetNotificationRemindType(record->notification, true);
+    return record;
+}
 
-    ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        result = AssignValidNotificationSlot(record);
-        if (result != ERR_OK) {
-            ANS_LOGE("Can not assign valid slot!");
-            return;
-        }
+void AdvancedNotificationService::ShareImages(const sptr<NotificationRequest> &request)
+{
+    // The icons are unmarshalled to new pixel maps, the records of the same icon share the cached one.
+    std::shared_ptr<Media::PixelMap> littleIcon = request->GetLittleIcon();
+    if (littleIcon != nullptr) {
+        request->SetLittleIcon(imageCache_.Share(littleIcon));
+    }
+    std::shared_ptr<Media::PixelMap> bigIcon = request->GetBigIcon();
+    if (bigIcon != nullptr) {
+        request->SetBigIcon(imageCache_.Share(bigIcon));
+    }
+}
 
-        result = Filter(record);
-        if (result != ERR_OK) {
-            ANS_LOGE("Reject by filters: %{public}d", result);
-            return;
-        }
+ErrCode AdvancedNotificationService::AddPreparedRecord(const std::shared_ptr<NotificationRecord> &record)
+{
+    ErrCode result = AssignValidNotificationSlot(record);
+    if (result != ERR_OK) {
+        ANS_LOGE("Can not assign valid slot!");
+        return result;
+    }
+
+    result = Filter(record);
+    if (result != ERR_OK) {
+        ANS_LOGE("Reject by filters: %{public}d", result);
+        return result;
+    }
+
+    result = AssignToNotificationList(record);
+    if (result != ERR_OK) {
+        return result;
+    }
+    UpdateRecentNotification(record->notification, false, 0);
+    return ERR_OK;
+}
 
-        result = AssignToNotificationList(record);
+ErrCode AdvancedNotificationService::PublishPreparedNotification(
+    const sptr<NotificationRequest> &request, const sptr<NotificationBundleOption> &bundleOption)
+{
+    ANS_LOGI("PublishPreparedNotification");
+    std::shared_ptr<NotificationRecord> record = MakeNotificationRecord(request, bundleOption);
+    if (record == nullptr) {
+        return ERR_ANS_NO_MEMORY;
+    }
+
+    ErrCode result = ERR_OK;
+    handler_->PostSyncTask(std::bind([&]() {
+        result = AddPreparedRecord(record);
         if (result != ERR_OK) {
             return;
         }
-        UpdateRecentNotification(record->notification, false, 0);
         sptr<NotificationSortingMap> sortingMap = GenerateSortingMap();
         NotificationSubscriberManager::GetInstance()->NotifyConsumed(record->notification, sortingMap);
 #ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
@@ -482,75 +528,171 @@ ErrCode AdvancedNotificationService::Publish(const std::string &label, const spt
     return PublishPreparedNotification(request, bundleOption);
 }
 
-void AdvancedNotificationService::ReportHasSeenEvent(const int32_t userId, const std::string &bundleName)
+ErrCode AdvancedNotificationService::PublishBatch(const std::string &label,
+    const std::vector<sptr<NotificationRequest>> &notifications, std::vector<ErrCode> &results)
 {
-    DeviceUsageStats::BundleActiveEvent event(DeviceUsageStats::BundleActiveEvent::NOTIFICATION_SEEN, bundleName);
-    DeviceUsageStats::BundleActiveClient::GetInstance().ReportEvent(event, userId);
-}
+    ANS_LOGD("%{public}s", __FUNCTION__);
 
-bool AdvancedNotificationService::IsNotificationExists(const std::string &key)
-{
-    bool isExists = false;
+    if (notifications.empty() || (notifications.size() > MAX_NOTIFICATION_BATCH_NUM)) {
+        return ERR_ANS_INVALID_PARAM;
+    }
 
-    for (auto item : notificationList_) {
-        if (item->notification->GetKey() == key) {
-            isExists = true;
-            break;
+    results.assign(notifications.size(), ERR_OK);
+    std::vector<std::shared_ptr<NotificationRecord>> records(notifications.size(), nullptr);
+    std::set<std::pair<int32_t, std::string>> reportedBundles;
+    for (size_t index = 0; index < notifications.size(); index++) {
+        const sptr<NotificationRequest> &request = notifications[index];
+        if (request == nullptr) {
+            results[index] = ERR_ANS_INVALID_PARAM;
+            continue;
+        }
+        if (request->GetReceiverUserId() != SUBSCRIBE_USER_INIT && !IsSystemApp()) {
+            results[index] = ERR_ANS_NON_SYSTEM_APP;
+            continue;
+        }
+
+        sptr<NotificationBundleOption> bundleOption;
+        results[index] = PrepareNotificationInfo(request, bundleOption);
+        if (results[index] != ERR_OK) {
+            continue;
+        }
+        if (reportedBundles.emplace(request->GetCreatorUserId(), bundleOption->GetBundleName()).second) {
+            ReportHasSeenEvent(request->GetCreatorUserId(), bundleOption->GetBundleName());
+        }
+        records[index] = MakeNotificationRecord(request, bundleOption);
+        if (records[index] == nullptr) {
+            results[index] = ERR_ANS_NO_MEMORY;
         }
     }
 
-    return isExists;
+    handler_->PostSyncTask(std::bind([&]() {
+        // Each new notification takes a slot of the per-second publish limit, as if it were published alone.
+        std::vector<sptr<Notification>> published;
+        std::vector<std::shared_ptr<NotificationRecord>> publishedRecords;
+        for (size_t index = 0; index < records.size(); index++) {
+            const std::shared_ptr<NotificationRecord> &record = records[index];
+            if (record == nullptr) {
+                continue;
+            }
+            results[index] = AddPreparedRecord(record);
+            if (results[index] == ERR_OK) {
+                published.push_back(record->notification);
+                publishedRecords.push_back(record);
+            }
+        }
+        if (published.empty()) {
+            return;
+        }
+
+        sptr<NotificationSortingMap> sortingMap = GenerateSortingMap();
+        NotificationSubscriberManager::GetInstance()->NotifyConsumedBatch(published, sortingMap);
+#ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
+        for (auto &record : publishedRecords) {
+            DoDistributedPublish(record->bundleOption, record);
+        }
+#endif
+    }));
+
+    for (auto result : results) {
+        if (result != ERR_OK) {
+            return result;
+        }
+    }
+    return ERR_OK;
 }
 
-ErrCode AdvancedNotificationService::Filter(const std::shared_ptr<NotificationRecord> &record)
+ErrCode AdvancedNotificationService::CancelBatch(
+    const std::string &label, const std::vector<int32_t> &notificationIds, std::vector<ErrCode> &results)
 {
-    ErrCode result = ERR_OK;
+    ANS_LOGD("%{public}s", __FUNCTION__);
 
-    for (auto filter : NOTIFICATION_FILTERS) {
-        result = filter->OnPublish(record);
+    if (notificationIds.empty() || (notificationIds.size() > MAX_NOTIFICATION_BATCH_NUM)) {
+        return ERR_ANS_INVALID_PARAM;
+    }
+
+    sptr<NotificationBundleOption> bundleOption = GenerateBundleOption();
+    if (bundleOption == nullptr) {
+        return ERR_ANS_INVALID_BUNDLE;
+    }
+
+    results.assign(notificationIds.size(), ERR_OK);
+    handler_->PostSyncTask(std::bind([&]() {
+        int32_t reason = NotificationConstant::APP_CANCEL_REASON_DELETE;
+        std::vector<sptr<Notification>> canceled;
+        for (size_t index = 0; index < notificationIds.size(); index++) {
+            sptr<Notification> notification = nullptr;
+            results[index] =
+                RemoveFromNotificationList(bundleOption, label, notificationIds[index], notification, true);
+            if ((results[index] == ERR_OK) && (notification != nullptr)) {
+                UpdateRecentNotification(notification, true, reason);
+                canceled.push_back(notification);
+            }
+        }
+        if (canceled.empty()) {
+            return;
+        }
+
+        sptr<NotificationSortingMap> sortingMap = GenerateSortingMap();
+        NotificationSubscriberManager::GetInstance()->NotifyCanceledBatch(canceled, sortingMap, reason);
+#ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
+        for (auto &notification : canceled) {
+            DoDistributedDelete("", notification);
+        }
+#endif
+    }));
+
+    for (auto result : results) {
         if (result != ERR_OK) {
-            break;
+            return result;
         }
     }
+    return ERR_OK;
+}
 
-    return result;
+void AdvancedNotificationService::ReportHasSeenEvent(const int32_t userId, const std::string &bundleName)
+{
+    DeviceUsageStats::BundleActiveEvent event(DeviceUsageStats::BundleActiveEvent::NOTIFICATION_SEEN, bundleName);
+    DeviceUsageStats::BundleActiveClient::GetInstance().ReportEvent(event, userId);
 }
 
-void AdvancedNotificationService::AddToNotificationList(const std::shared_ptr<NotificationRecord> &record)
+bool AdvancedNotificationService::IsNotificationExists(const std::string &key)
 {
-    notificationList_.push_back(record);
-    SortNotificationList();
+    return notificationList_.Exists(key);
 }
 
-void AdvancedNotificationService::UpdateInNotificationList(const std::shared_ptr<NotificationRecord> &record)
+ErrCode AdvancedNotificationService::Filter(const std::shared_ptr<NotificationRecord> &record)
 {
-    auto iter = notificationList_.begin();
-    while (iter != notificationList_.end()) {
-        if ((*iter)->notification->GetKey() == record->notification->GetKey()) {
-            *iter = record;
+    ErrCode result = ERR_OK;
+
+    for (auto filter : NOTIFICATION_FILTERS) {
+        result = filter->OnPublish(record);
+        if (result != ERR_OK) {
             break;
         }
-        iter++;
     }
 
-    SortNotificationList();
+    return result;
 }
 
-void AdvancedNotificationService::SortNotificationList()
+void AdvancedNotificationService::AddToNotificationList(const std::shared_ptr<NotificationRecord> &record)
 {
-    notificationList_.sort(AdvancedNotificationService::NotificationCompare);
+    notificationList_.Add(record);
 }
 
-bool AdvancedNotificationService::NotificationCompare(
-    const std::shared_ptr<NotificationRecord> &first, const std::shared_ptr<NotificationRecord> &second)
+void AdvancedNotificationService::UpdateInNotificationList(const std::shared_ptr<NotificationRecord> &record)
 {
-    // sorting notifications by create time
-    return (first->request->GetCreateTime() < second->request->GetCreateTime());
+    notificationList_.Update(record);
 }
 
 sptr<NotificationSortingMap> AdvancedNotificationService::GenerateSortingMap()
 {
+    // The sorting map is shared by every callback until the active notifications change again.
+    if ((sortingMap_ != nullptr) && (sortingMapVersion_ == notificationList_.GetVersion())) {
+        return sortingMap_;
+    }
+
     std::vector<NotificationSorting> sortingList;
+    sortingList.reserve(notificationList_.Size());
     for (auto record : notificationList_) {
         NotificationSorting sorting;
         sorting.SetRanking(static_cast<uint64_t>(sortingList.size()));
@@ -559,9 +701,10 @@ sptr<NotificationSortingMap> AdvancedNotificationService::GenerateSortingMap()
         sortingList.push_back(sorting);
     }
 
-    sptr<NotificationSortingMap> sortingMap = new NotificationSortingMap(sortingList);
+    sortingMap_ = new NotificationSortingMap(sortingList);
+    sortingMapVersion_ = notificationList_.GetVersion();
 
-    return sortingMap;
+    return sortingMap_;
 }
 
 void AdvancedNotificationService::StartFilters()
@@ -721,14 +864,11 @@ ErrCode AdvancedNotificationService::GetSlots(std::vector<sptr<NotificationSlot>
         return ERR_ANS_INVALID_BUNDLE;
     }
 
-    ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        result = NotificationPreferences::GetInstance().GetNotificationAllSlots(bundleOption, slots);
-        if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
-            result = ERR_OK;
-            slots.clear();
-        }
-    }));
+    ErrCode result = NotificationPreferences::GetInstance().GetNotificationAllSlots(bundleOption, slots);
+    if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
+        result = ERR_OK;
+        slots.clear();
+    }
     return result;
 }
 
@@ -741,13 +881,10 @@ ErrCode AdvancedNotificationService::GetSlotGroup(const std::string &groupId, sp
         return ERR_ANS_INVALID_BUNDLE;
     }
 
-    ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        result = NotificationPreferences::GetInstance().GetNotificationSlotGroup(bundleOption, groupId, group);
-        if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
-            result = ERR_ANS_PREFERENCES_NOTIFICATION_SLOTGROUP_NOT_EXIST;
-        }
-    }));
+    ErrCode result = NotificationPreferences::GetInstance().GetNotificationSlotGroup(bundleOption, groupId, group);
+    if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
+        result = ERR_ANS_PREFERENCES_NOTIFICATION_SLOTGROUP_NOT_EXIST;
+    }
     return result;
 }
 
@@ -760,14 +897,11 @@ ErrCode AdvancedNotificationService::GetSlotGroups(std::vector<sptr<Notification
         return ERR_ANS_INVALID_BUNDLE;
     }
 
-    ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        result = NotificationPreferences::GetInstance().GetNotificationAllSlotGroups(bundleOption, groups);
-        if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
-            result = ERR_OK;
-            groups.clear();
-        }
-    }));
+    ErrCode result = NotificationPreferences::GetInstance().GetNotificationAllSlotGroups(bundleOption, groups);
+    if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
+        result = ERR_OK;
+        groups.clear();
+    }
     return result;
 }
 
@@ -798,15 +932,10 @@ ErrCode AdvancedNotificationService::GetActiveNotifications(std::vector<sptr<Not
     }
 
     ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        notifications.clear();
-        for (auto record : notificationList_) {
-            if ((record->bundleOption->GetBundleName() == bundleOption->GetBundleName()) &&
-                (record->bundleOption->GetUid() == bundleOption->GetUid())) {
-                notifications.push_back(record->request);
-            }
-        }
-    }));
+    notifications.clear();
+    for (auto record : notificationList_.GetByBundle(bundleOption->GetBundleName(), bundleOption->GetUid())) {
+        notifications.push_back(record->request);
+    }
     return result;
 }
 
@@ -820,16 +949,8 @@ ErrCode AdvancedNotificationService::GetActiveNotificationNums(uint64_t &num)
     }
 
     ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        size_t count = 0;
-        for (auto record : notificationList_) {
-            if ((record->bundleOption->GetBundleName() == bundleOption->GetBundleName()) &&
-                (record->bundleOption->GetUid() == bundleOption->GetUid())) {
-                count += 1;
-            }
-        }
-        num = static_cast<uint64_t>(count);
-    }));
+    size_t count = notificationList_.GetCountByBundle(bundleOption->GetBundleName(), bundleOption->GetUid());
+    num = static_cast<uint64_t>(count);
     return result;
 }
 
@@ -878,9 +999,7 @@ ErrCode AdvancedNotificationService::GetBundleImportance(int32_t &importance)
         return ERR_ANS_INVALID_BUNDLE;
     }
 
-    ErrCode result = ERR_OK;
-    handler_->PostSyncTask(
-        std::bind([&]() { result = NotificationPreferences::GetInstance().GetImportance(bundleOption, importance); }));
+    ErrCode result = NotificationPreferences::GetInstance().GetImportance(bundleOption, importance);
     return result;
 }
 
@@ -914,14 +1033,11 @@ ErrCode AdvancedNotificationService::GetPrivateNotificationsAllowed(bool &allow)
         return ERR_ANS_INVALID_BUNDLE;
     }
 
-    ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        result = NotificationPreferences::GetInstance().GetPrivateNotificationsAllowed(bundleOption, allow);
-        if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
-            result = ERR_OK;
-            allow = false;
-        }
-    }));
+    ErrCode result = NotificationPreferences::GetInstance().GetPrivateNotificationsAllowed(bundleOption, allow);
+    if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
+        result = ERR_OK;
+        allow = false;
+    }
     return result;
 }
 
@@ -1027,7 +1143,7 @@ ErrCode AdvancedNotificationService::DeleteAll()
     handler_->PostSyncTask(std::bind([&]() {
         int32_t activeUserId = SUBSCRIBE_USER_INIT;
         (void)GetActiveUserId(activeUserId);
-        std::vector<std::string> keys = GetNotificationKeys(nullptr);
+        std::vector<std::string> keys = GetNotificationKeysByUser(activeUserId);
         for (auto key : keys) {
 #ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
             std::string deviceId = GetNotificationDeviceId(key);
@@ -1061,11 +1177,26 @@ std::vector<std::string> AdvancedNotificationService::GetNotificationKeys(
 {
     std::vector<std::string> keys;
 
-    for (auto record : notificationList_) {
-        if ((bundleOption != nullptr) && (record->bundleOption->GetBundleName() != bundleOption->GetBundleName()) &&
-            (record->bundleOption->GetUid() != bundleOption->GetUid())) {
-            continue;
+    if (bundleOption == nullptr) {
+        for (auto record : notificationList_) {
+            keys.push_back(record->notification->GetKey());
         }
+        return keys;
+    }
+
+    for (auto record :
+        notificationList_.GetByBundleNameOrUid(bundleOption->GetBundleName(), bundleOption->GetUid(), false)) {
+        keys.push_back(record->notification->GetKey());
+    }
+
+    return keys;
+}
+
+std::vector<std::string> AdvancedNotificationService::GetNotificationKeysByUser(int32_t userId)
+{
+    std::vector<std::string> keys;
+
+    for (auto record : notificationList_.GetByUser(userId)) {
         keys.push_back(record->notification->GetKey());
     }
 
@@ -1090,14 +1221,11 @@ ErrCode AdvancedNotificationService::GetSlotsByBundle(
         return ERR_ANS_INVALID_BUNDLE;
     }
 
-    ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        result = NotificationPreferences::GetInstance().GetNotificationAllSlots(bundle, slots);
-        if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
-            result = ERR_OK;
-            slots.clear();
-        }
-    }));
+    ErrCode result = NotificationPreferences::GetInstance().GetNotificationAllSlots(bundle, slots);
+    if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
+        result = ERR_OK;
+        slots.clear();
+    }
     return result;
 }
 
@@ -1199,14 +1327,11 @@ ErrCode AdvancedNotificationService::GetShowBadgeEnabledForBundle(
         return ERR_ANS_INVALID_BUNDLE;
     }
 
-    ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        result = NotificationPreferences::GetInstance().IsShowBadge(bundle, enabled);
-        if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
-            result = ERR_OK;
-            enabled = false;
-        }
-    }));
+    ErrCode result = NotificationPreferences::GetInstance().IsShowBadge(bundle, enabled);
+    if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
+        result = ERR_OK;
+        enabled = false;
+    }
     return result;
 }
 
@@ -1219,84 +1344,72 @@ ErrCode AdvancedNotificationService::GetShowBadgeEnabled(bool &enabled)
         return ERR_ANS_INVALID_BUNDLE;
     }
 
-    ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        result = NotificationPreferences::GetInstance().IsShowBadge(bundleOption, enabled);
-        if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
-            result = ERR_OK;
-            enabled = false;
-        }
-    }));
+    ErrCode result = NotificationPreferences::GetInstance().IsShowBadge(bundleOption, enabled);
+    if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
+        result = ERR_OK;
+        enabled = false;
+    }
     return result;
 }
 
 ErrCode AdvancedNotificationService::RemoveFromNotificationList(const sptr<NotificationBundleOption> &bundleOption,
     const std::string &label, int32_t notificationId, sptr<Notification> &notification, bool isCancel)
 {
-    for (auto record : notificationList_) {
-        if ((record->bundleOption->GetBundleName() == bundleOption->GetBundleName()) &&
-            (record->bundleOption->GetUid() == bundleOption->GetUid()) &&
-            (record->notification->GetLabel() == label) &&
-            (record->notification->GetId() == notificationId)
-#ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
-            && record->deviceId.empty()
-#endif
-        ) {
-            if (!isCancel && !record->notification->IsRemoveAllowed()) {
-                return ERR_ANS_NOTIFICATION_IS_UNALLOWED_REMOVEALLOWED;
-            }
-            notification = record->notification;
-            // delete or delete all, call the function
-            if (!isCancel) {
-                TriggerRemoveWantAgent(record->request);
-            }
-            notificationList_.remove(record);
-            return ERR_OK;
-        }
+    auto record = notificationList_.FindById(
+        bundleOption->GetBundleName(), bundleOption->GetUid(), label, notificationId, std::string());
+    if (record == nullptr) {
+        return ERR_ANS_NOTIFICATION_NOT_EXISTS;
     }
 
-    return ERR_ANS_NOTIFICATION_NOT_EXISTS;
+    if (!isCancel && !record->notification->IsRemoveAllowed()) {
+        return ERR_ANS_NOTIFICATION_IS_UNALLOWED_REMOVEALLOWED;
+    }
+    notification = record->notification;
+    // delete or delete all, call the function
+    if (!isCancel) {
+        TriggerRemoveWantAgent(record->request);
+    }
+    notificationList_.Remove(record);
+    return ERR_OK;
 }
 
 ErrCode AdvancedNotificationService::RemoveFromNotificationList(
     const std::string &key, sptr<Notification> &notification, bool isCancel)
 {
-    for (auto record : notificationList_) {
-        if (record->notification->GetKey() == key) {
-            if (!isCancel && !record->notification->IsRemoveAllowed()) {
-                return ERR_ANS_NOTIFICATION_IS_UNALLOWED_REMOVEALLOWED;
-            }
-            notification = record->notification;
-            // delete or delete all, call the function
-            if (!isCancel) {
-                TriggerRemoveWantAgent(record->request);
-            }
-            notificationList_.remove(record);
-            return ERR_OK;
-        }
+    auto record = notificationList_.Find(key);
+    if (record == nullptr) {
+        return ERR_ANS_NOTIFICATION_NOT_EXISTS;
     }
 
-    return ERR_ANS_NOTIFICATION_NOT_EXISTS;
+    if (!isCancel && !record->notification->IsRemoveAllowed()) {
+        return ERR_ANS_NOTIFICATION_IS_UNALLOWED_REMOVEALLOWED;
+    }
+    notification = record->notification;
+    // delete or delete all, call the function
+    if (!isCancel) {
+        TriggerRemoveWantAgent(record->request);
+    }
+    notificationList_.Remove(record);
+    return ERR_OK;
 }
 
 ErrCode AdvancedNotificationService::RemoveFromNotificationListForDeleteAll(
     const std::string &key, const int32_t &userId, sptr<Notification> &notification)
 {
-    for (auto record : notificationList_) {
-        if ((record->notification->GetKey() == key) && (record->notification->GetUserId() == userId)) {
-            if (!record->notification->IsRemoveAllowed()) {
-                return ERR_ANS_NOTIFICATION_IS_UNALLOWED_REMOVEALLOWED;
-            }
-            if (record->request->IsUnremovable()) {
-                return ERR_ANS_NOTIFICATION_IS_UNREMOVABLE;
-            }
-            notification = record->notification;
-            notificationList_.remove(record);
-            return ERR_OK;
-        }
+    auto record = notificationList_.Find(key);
+    if ((record == nullptr) || (record->notification->GetUserId() != userId)) {
+        return ERR_ANS_NOTIFICATION_NOT_EXISTS;
     }
 
-    return ERR_ANS_NOTIFICATION_NOT_EXISTS;
+    if (!record->notification->IsRemoveAllowed()) {
+        return ERR_ANS_NOTIFICATION_IS_UNALLOWED_REMOVEALLOWED;
+    }
+    if (record->request->IsUnremovable()) {
+        return ERR_ANS_NOTIFICATION_IS_UNREMOVABLE;
+    }
+    notification = record->notification;
+    notificationList_.Remove(record);
+    return ERR_OK;
 }
 
 ErrCode AdvancedNotificationService::Subscribe(
@@ -1343,6 +1456,29 @@ ErrCode AdvancedNotificationService::Unsubscribe(
     return NotificationSubscriberManager::GetInstance()->RemoveSubscriber(subscriber, info);
 }
 
+ErrCode AdvancedNotificationService::ResyncSortingMap(const sptr<AnsSubscriberInterface> &subscriber)
+{
+    ANS_LOGD("%{public}s", __FUNCTION__);
+
+    bool isSubsystem = AccessTokenHelper::VerifyNativeToken(IPCSkeleton::GetCallingTokenID());
+    if (!IsSystemApp() && !isSubsystem) {
+        ANS_LOGE("Client is not a system app or subsystem");
+        return ERR_ANS_NON_SYSTEM_APP;
+    }
+
+    if (!CheckPermission(OHOS_PERMISSION_NOTIFICATION_CONTROLLER)) {
+        return ERR_ANS_PERMISSION_DENIED;
+    }
+
+    if (subscriber == nullptr) {
+        return ERR_ANS_INVALID_PARAM;
+    }
+
+    sptr<NotificationSortingMap> sortingMap = nullptr;
+    handler_->PostSyncTask(std::bind([&]() { sortingMap = GenerateSortingMap(); }));
+    return NotificationSubscriberManager::GetInstance()->ResyncSortingMap(subscriber, sortingMap);
+}
+
 ErrCode AdvancedNotificationService::GetSlotByType(
     const NotificationConstant::SlotType &slotType, sptr<NotificationSlot> &slot)
 {
@@ -1353,13 +1489,10 @@ ErrCode AdvancedNotificationService::GetSlotByType(
         return ERR_ANS_INVALID_BUNDLE;
     }
 
-    ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        result = NotificationPreferences::GetInstance().GetNotificationSlot(bundleOption, slotType, slot);
-        if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
-            result = ERR_ANS_PREFERENCES_NOTIFICATION_SLOT_TYPE_NOT_EXIST;
-        }
-    }));
+    ErrCode result = NotificationPreferences::GetInstance().GetNotificationSlot(bundleOption, slotType, slot);
+    if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
+        result = ERR_ANS_PREFERENCES_NOTIFICATION_SLOT_TYPE_NOT_EXIST;
+    }
     return result;
 }
 
@@ -1396,14 +1529,12 @@ ErrCode AdvancedNotificationService::GetAllActiveNotifications(std::vector<sptr<
     }
 
     ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        notifications.clear();
-        for (auto record : notificationList_) {
-            if (record->notification != nullptr) {
-                notifications.push_back(record->notification);
-            }
+    notifications.clear();
+    for (auto record : notificationList_.GetAll()) {
+        if (record->notification != nullptr) {
+            notifications.push_back(record->notification);
         }
-    }));
+    }
     return result;
 }
 
@@ -1437,13 +1568,11 @@ ErrCode AdvancedNotificationService::GetSpecialActiveNotifications(
     }
 
     ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        for (auto record : notificationList_) {
-            if (IsContained(key, record->notification->GetKey())) {
-                notifications.push_back(record->notification);
-            }
+    for (auto record : notificationList_.GetAll()) {
+        if (IsContained(key, record->notification->GetKey())) {
+            notifications.push_back(record->notification);
         }
-    }));
+    }
     return result;
 }
 
@@ -1602,10 +1731,8 @@ ErrCode AdvancedNotificationService::IsAllowedNotify(bool &allowed)
     }
 
     ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        allowed = false;
-        result = NotificationPreferences::GetInstance().GetNotificationsEnabled(userId, allowed);
-    }));
+    allowed = false;
+    result = NotificationPreferences::GetInstance().GetNotificationsEnabled(userId, allowed);
     return result;
 }
 
@@ -1633,18 +1760,16 @@ ErrCode AdvancedNotificationService::IsAllowedNotifySelf(const sptr<Notification
     }
 
     ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        allowed = false;
-        result = NotificationPreferences::GetInstance().GetNotificationsEnabled(userId, allowed);
-        if (result == ERR_OK && allowed) {
-            result = NotificationPreferences::GetInstance().GetNotificationsEnabledForBundle(bundleOption, allowed);
-            if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
-                result = ERR_OK;
-                allowed = CheckApiCompatibility(bundleOption);
-                SetNotificationsEnabledForSpecialBundle("", bundleOption, allowed);
-            }
+    allowed = false;
+    result = NotificationPreferences::GetInstance().GetNotificationsEnabled(userId, allowed);
+    if (result == ERR_OK && allowed) {
+        result = NotificationPreferences::GetInstance().GetNotificationsEnabledForBundle(bundleOption, allowed);
+        if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
+            result = ERR_OK;
+            allowed = CheckApiCompatibility(bundleOption);
+            SetNotificationsEnabledForSpecialBundle("", bundleOption, allowed);
         }
-    }));
+    }
     return result;
 }
 
@@ -1704,18 +1829,16 @@ ErrCode AdvancedNotificationService::IsSpecialBundleAllowedNotify(
     }
 
     ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        allowed = false;
-        result = NotificationPreferences::GetInstance().GetNotificationsEnabled(userId, allowed);
-        if (result == ERR_OK && allowed) {
-            result = NotificationPreferences::GetInstance().GetNotificationsEnabledForBundle(targetBundle, allowed);
-            if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
-                result = ERR_OK;
-                allowed = CheckApiCompatibility(targetBundle);
-                SetNotificationsEnabledForSpecialBundle("", bundleOption, allowed);
-            }
+    allowed = false;
+    result = NotificationPreferences::GetInstance().GetNotificationsEnabled(userId, allowed);
+    if (result == ERR_OK && allowed) {
+        result = NotificationPreferences::GetInstance().GetNotificationsEnabledForBundle(targetBundle, allowed);
+        if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
+            result = ERR_OK;
+            allowed = CheckApiCompatibility(targetBundle);
+            SetNotificationsEnabledForSpecialBundle("", bundleOption, allowed);
         }
-    }));
+    }
     return result;
 }
 
@@ -1724,6 +1847,17 @@ ErrCode AdvancedNotificationService::ShellDump(const std::string &dumpOption, st
     ANS_LOGD("%{public}s", __FUNCTION__);
     ErrCode result = ERR_ANS_NOT_ALLOWED;
 
+    // The subscribers are owned by the subscriber manager, which dumps them on its own handler.
+    if (dumpOption == SUBSCRIBER_OPTION) {
+        return SubscriberDump(dumpInfo);
+    }
+    if (dumpOption.substr(0, dumpOption.find_first_of(" ", 0)) == SET_SUBSCRIBER_QUEUE_OPTION) {
+        return SetSubscriberQueuePolicy(dumpOption.substr(dumpOption.find_first_of(" ", 0) + 1));
+    }
+    if (dumpOption == IMAGE_CACHE_OPTION) {
+        return ImageCacheDump(dumpInfo);
+    }
+
     handler_->PostSyncTask(std::bind([&]() {
         if (dumpOption == ACTIVE_NOTIFICATION_OPTION) {
             result = ActiveNotificationDump(dumpInfo);
@@ -1777,6 +1911,7 @@ ErrCode AdvancedNotificationService::PublishContinuousTaskNotification(const spt
         return result;
     }
     request->SetUnremovable(true);
+    ShareImages(request);
     std::shared_ptr<NotificationRecord> record = std::make_shared<NotificationRecord>();
     record->request = request;
     record->bundleOption = bundleOption;
@@ -1818,14 +1953,11 @@ ErrCode AdvancedNotificationService::CancelContinuousTaskNotification(const std:
     ErrCode result = ERR_OK;
     handler_->PostSyncTask(std::bind([&]() {
         sptr<Notification> notification = nullptr;
-        for (auto record : notificationList_) {
-            if ((record->bundleOption->GetBundleName().empty()) && (record->bundleOption->GetUid() == uid) &&
-                (record->notification->GetId() == notificationId) && (record->notification->GetLabel() == label)) {
-                notification = record->notification;
-                notificationList_.remove(record);
-                result = ERR_OK;
-                break;
-            }
+        auto record = notificationList_.FindById(std::string(), uid, label, notificationId, std::string());
+        if (record != nullptr) {
+            notification = record->notification;
+            notificationList_.Remove(record);
+            result = ERR_OK;
         }
         if (notification != nullptr) {
             int32_t reason = NotificationConstant::APP_CANCEL_REASON_DELETE;
@@ -2009,6 +2141,39 @@ ErrCode AdvancedNotificationService::SetRecentNotificationCount(const std::strin
     return ERR_OK;
 }
 
+ErrCode AdvancedNotificationService::SubscriberDump(std::vector<std::string> &dumpInfo)
+{
+    ANS_LOGD("%{public}s", __FUNCTION__);
+    NotificationSubscriberManager::GetInstance()->Dump(dumpInfo);
+    return ERR_OK;
+}
+
+ErrCode AdvancedNotificationService::SetSubscriberQueuePolicy(const std::string arg)
+{
+    ANS_LOGD("%{public}s arg = %{public}s", __FUNCTION__, arg.c_str());
+    // The argument is "<capacity>,<policy>", the policy is one of coalesce, dropOldest and disconnect.
+    size_t pos = arg.find_first_of(",", 0);
+    if (pos == std::string::npos) {
+        return ERR_ANS_INVALID_PARAM;
+    }
+    int32_t capacity = atoi(arg.substr(0, pos).c_str());
+    if ((capacity <= 0) || (static_cast<size_t>(capacity) > SUBSCRIBER_QUEUE_MAX_CAPACITY)) {
+        return ERR_ANS_INVALID_PARAM;
+    }
+    NotificationDeliveryQueue::OverflowPolicy policy;
+    if (!NotificationDeliveryQueue::StringToPolicy(arg.substr(pos + 1), policy)) {
+        return ERR_ANS_INVALID_PARAM;
+    }
+    return NotificationSubscriberManager::GetInstance()->SetDeliveryQueuePolicy(static_cast<size_t>(capacity), policy);
+}
+
+ErrCode AdvancedNotificationService::ImageCacheDump(std::vector<std::string> &dumpInfo)
+{
+    ANS_LOGD("%{public}s", __FUNCTION__);
+    imageCache_.Dump(dumpInfo);
+    return ERR_OK;
+}
+
 std::string AdvancedNotificationService::TimeToString(int64_t time)
 {
     auto timePoint = std::chrono::time_point<std::chrono::system_clock>(std::chrono::milliseconds(time));
@@ -2060,58 +2225,43 @@ void AdvancedNotificationService::UpdateRecentNotification(sptr<Notification> &n
     }
 }
 
-inline void RemoveExpired(
-    std::list<std::chrono::system_clock::time_point> &list, const std::chrono::system_clock::time_point &now)
+ErrCode AdvancedNotificationService::CheckPublishRate()
 {
-    auto iter = list.begin();
-    while (iter != list.end()) {
-        if (now - *iter > std::chrono::seconds(1)) {
-            iter = list.erase(iter);
-        } else {
-            break;
-        }
+    // flowControlTimestamps_ is a ring of the last publish times, flowControlTimestampIndex_ points to the oldest.
+    std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+    if ((flowControlTimestampCount_ >= MAX_ACTIVE_NUM_PERSECOND) &&
+        (now - flowControlTimestamps_[flowControlTimestampIndex_] <= std::chrono::seconds(1))) {
+        return ERR_ANS_OVER_MAX_ACTIVE_PERSECOND;
     }
-}
 
-static bool SortNotificationsByLevelAndTime(
-    const std::shared_ptr<NotificationRecord> &first, const std::shared_ptr<NotificationRecord> &second)
-{
-    if (first->slot->GetLevel() != second->slot->GetLevel()) {
-        return (first->slot->GetLevel() < second->slot->GetLevel());
+    flowControlTimestamps_[flowControlTimestampIndex_] = now;
+    flowControlTimestampIndex_ = (flowControlTimestampIndex_ + 1) % MAX_ACTIVE_NUM_PERSECOND;
+    if (flowControlTimestampCount_ < MAX_ACTIVE_NUM_PERSECOND) {
+        flowControlTimestampCount_++;
     }
-    return (first->request->GetCreateTime() < second->request->GetCreateTime());
+    return ERR_OK;
 }
 
 ErrCode AdvancedNotificationService::FlowControl(const std::shared_ptr<NotificationRecord> &record)
 {
-    std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
-    RemoveExpired(flowControlTimestampList_, now);
-    if (flowControlTimestampList_.size() >= MAX_ACTIVE_NUM_PERSECOND) {
-        return ERR_ANS_OVER_MAX_ACTIVE_PERSECOND;
+    ErrCode result = CheckPublishRate();
+    if (result != ERR_OK) {
+        return result;
     }
 
-    flowControlTimestampList_.push_back(now);
+    // Agent notifications count against the owner bundle, not the bundle which published them.
+    std::string bundleName = record->notification->GetBundleName();
+    size_t bundleCount = notificationList_.GetCountByOwnerBundleName(bundleName);
 
-    std::list<std::shared_ptr<NotificationRecord>> bundleList;
-    for (auto item : notificationList_) {
-        if (record->notification->GetBundleName() == item->notification->GetBundleName()) {
-            bundleList.push_back(item);
-        }
+    if (bundleCount >= MAX_ACTIVE_NUM_PERAPP) {
+        notificationList_.Remove(notificationList_.GetEvictionCandidate(bundleName));
     }
 
-    if (bundleList.size() >= MAX_ACTIVE_NUM_PERAPP) {
-        bundleList.sort(SortNotificationsByLevelAndTime);
-        notificationList_.remove(bundleList.front());
-    }
-
-    if (notificationList_.size() >= MAX_ACTIVE_NUM) {
-        if (bundleList.size() > 0) {
-            bundleList.sort(SortNotificationsByLevelAndTime);
-            notificationList_.remove(bundleList.front());
-        } else {
-            std::list<std::shared_ptr<NotificationRecord>> sorted = notificationList_;
-            sorted.sort(SortNotificationsByLevelAndTime);
-            notificationList_.remove(sorted.front());
+    if (notificationList_.Size() >= MAX_ACTIVE_NUM) {
+        if (bundleCount == 0) {
+            notificationList_.Remove(notificationList_.GetEvictionCandidate());
+        } else if (bundleCount < MAX_ACTIVE_NUM_PERAPP) {
+            notificationList_.Remove(notificationList_.GetEvictionCandidate(bundleName));
         }
     }
 
@@ -2253,25 +2403,19 @@ ErrCode AdvancedNotificationService::RemoveNotification(
 #ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
         std::string deviceId;
 #endif
-        for (auto record : notificationList_) {
-            if ((record->bundleOption->GetBundleName() == bundle->GetBundleName()) &&
-                (record->bundleOption->GetUid() == bundleOption->GetUid()) &&
-#ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
-                (record->deviceId.empty()) &&
-#endif
-                (record->notification->GetId() == notificationId) && (record->notification->GetLabel() == label)) {
-                if (!record->notification->IsRemoveAllowed()) {
-                    result = ERR_ANS_NOTIFICATION_IS_UNALLOWED_REMOVEALLOWED;
-                    break;
-                }
+        auto record = notificationList_.FindById(
+            bundle->GetBundleName(), bundleOption->GetUid(), label, notificationId, std::string());
+        if (record != nullptr) {
+            if (!record->notification->IsRemoveAllowed()) {
+                result = ERR_ANS_NOTIFICATION_IS_UNALLOWED_REMOVEALLOWED;
+            } else {
 #ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
                 deviceId = record->deviceId;
 #endif
                 notification = record->notification;
                 notificationRequest = record->request;
-                notificationList_.remove(record);
+                notificationList_.Remove(record);
                 result = ERR_OK;
-                break;
             }
         }
 
@@ -2310,23 +2454,22 @@ ErrCode AdvancedNotificationService::RemoveAllNotifications(const sptr<Notificat
 
     handler_->PostSyncTask(std::bind([&]() {
         std::vector<std::shared_ptr<NotificationRecord>> removeList;
-        for (auto record : notificationList_) {
+        for (auto record : notificationList_.GetByBundle(bundleOption->GetBundleName(), bundleOption->GetUid())) {
             if (!record->notification->IsRemoveAllowed()) {
                 continue;
             }
 
-            if ((record->bundleOption->GetBundleName() == bundleOption->GetBundleName()) &&
-                (record->bundleOption->GetUid() == bundleOption->GetUid()) &&
+            if (!record->request->IsUnremovable()
 #ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
-                record->deviceId.empty() &&
+                && record->deviceId.empty()
 #endif
-                !record->request->IsUnremovable()) {
+            ) {
                 removeList.push_back(record);
             }
         }
 
         for (auto record : removeList) {
-            notificationList_.remove(record);
+            notificationList_.Remove(record);
             if (record->notification != nullptr) {
                 int32_t reason = NotificationConstant::CANCEL_REASON_DELETE;
                 UpdateRecentNotification(record->notification, true, reason);
@@ -2362,15 +2505,11 @@ ErrCode AdvancedNotificationService::GetSlotNumAsBundle(
         return ERR_ANS_INVALID_BUNDLE;
     }
 
-    ErrCode result = ERR_OK;
-
-    handler_->PostSyncTask(std::bind([&]() {
-        result = NotificationPreferences::GetInstance().GetNotificationSlotsNumForBundle(bundle, num);
-        if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
-            result = ERR_OK;
-            num = 0;
-        }
-    }));
+    ErrCode result = NotificationPreferences::GetInstance().GetNotificationSlotsNumForBundle(bundle, num);
+    if (result == ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST) {
+        result = ERR_OK;
+        num = 0;
+    }
 
     return result;
 }
@@ -2390,19 +2529,18 @@ ErrCode AdvancedNotificationService::CancelGroup(const std::string &groupName)
 
     handler_->PostSyncTask(std::bind([&]() {
         std::vector<std::shared_ptr<NotificationRecord>> removeList;
-        for (auto record : notificationList_) {
-            if ((record->bundleOption->GetBundleName() == bundleOption->GetBundleName()) &&
-                (record->bundleOption->GetUid() == bundleOption->GetUid()) &&
+        for (auto record :
+            notificationList_.GetByGroup(bundleOption->GetBundleName(), bundleOption->GetUid(), groupName)) {
 #ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
-                record->deviceId.empty() &&
-#endif
-                (record->request->GetGroupName() == groupName)) {
-                removeList.push_back(record);
+            if (!record->deviceId.empty()) {
+                continue;
             }
+#endif
+            removeList.push_back(record);
         }
 
         for (auto record : removeList) {
-            notificationList_.remove(record);
+            notificationList_.Remove(record);
 
             if (record->notification != nullptr) {
                 int32_t reason = NotificationConstant::APP_CANCEL_REASON_DELETE;
@@ -2443,22 +2581,21 @@ ErrCode AdvancedNotificationService::RemoveGroupByBundle(
 
     handler_->PostSyncTask(std::bind([&]() {
         std::vector<std::shared_ptr<NotificationRecord>> removeList;
-        for (auto record : notificationList_) {
+        for (auto record : notificationList_.GetByGroup(bundle->GetBundleName(), bundle->GetUid(), groupName)) {
             if (!record->notification->IsRemoveAllowed()) {
                 continue;
             }
-            if ((record->bundleOption->GetBundleName() == bundle->GetBundleName()) &&
-                (record->bundleOption->GetUid() == bundle->GetUid()) && !record->request->IsUnremovable() &&
+            if (!record->request->IsUnremovable()
 #ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
-                record->deviceId.empty() &&
+                && record->deviceId.empty()
 #endif
-                (record->request->GetGroupName() == groupName)) {
+            ) {
                 removeList.push_back(record);
             }
         }
 
         for (auto record : removeList) {
-            notificationList_.remove(record);
+            notificationList_.Remove(record);
 
             if (record->notification != nullptr) {
                 int32_t reason = NotificationConstant::CANCEL_REASON_DELETE;
@@ -2788,11 +2925,15 @@ std::vector<std::string> AdvancedNotificationService::GetLocalNotificationKeys(
 {
     std::vector<std::string> keys;
 
-    for (auto record : notificationList_) {
-        if ((bundleOption != nullptr) && (record->bundleOption->GetBundleName() != bundleOption->GetBundleName()) &&
-            (record->bundleOption->GetUid() != bundleOption->GetUid()) && record->deviceId.empty()) {
-            continue;
+    if (bundleOption == nullptr) {
+        for (auto record : notificationList_) {
+            keys.push_back(record->notification->GetKey());
         }
+        return keys;
+    }
+
+    for (auto record :
+        notificationList_.GetByBundleNameOrUid(bundleOption->GetBundleName(), bundleOption->GetUid(), true)) {
         keys.push_back(record->notification->GetKey());
     }
 
@@ -2834,10 +2975,9 @@ NotificationConstant::RemindType AdvancedNotificationService::GetRemindType()
 
 std::string AdvancedNotificationService::GetNotificationDeviceId(const std::string &key)
 {
-    for (auto record : notificationList_) {
-        if (record->notification->GetKey() == key) {
-            return record->deviceId;
-        }
+    auto record = notificationList_.Find(key);
+    if (record != nullptr) {
+        return record->deviceId;
     }
     return std::string();
 }
@@ -2908,6 +3048,44 @@ bool AdvancedNotificationService::CheckDistributedNotificationType(const sptr<No
     return false;
 }
 
+std::shared_ptr<NotificationRecord> AdvancedNotificationService::MakeDistributedRecord(
+    const std::string &deviceId, const std::string &bundleName, const sptr<NotificationRequest> &request)
+{
+    if (!CheckDistributedNotificationType(request)) {
+        ANS_LOGD("device type not support display.");
+        return nullptr;
+    }
+
+    sptr<NotificationBundleOption> bundleOption =
+        GenerateValidBundleOption(new NotificationBundleOption(bundleName, 0));
+    if (bundleOption == nullptr) {
+        return nullptr;
+    }
+    std::shared_ptr<NotificationRecord> record = std::make_shared<NotificationRecord>();
+    if (record == nullptr) {
+        return nullptr;
+    }
+    ShareImages(request);
+    record->request = request;
+    record->notification = new Notification(deviceId, request);
+    record->bundleOption = bundleOption;
+    record->deviceId = deviceId;
+    SetNotificationRemindType(record->notification, false);
+
+    ErrCode result = AssignValidNotificationSlot(record);
+    if (result != ERR_OK) {
+        ANS_LOGE("Can not assign valid slot!");
+        return nullptr;
+    }
+
+    result = Filter(record);
+    if (result != ERR_OK) {
+        ANS_LOGE("Reject by filters: %{public}d", result);
+        return nullptr;
+    }
+    return record;
+}
+
 void AdvancedNotificationService::OnDistributedPublish(
     const std::string &deviceId, const std::string &bundleName, sptr<NotificationRequest> &request)
 {
@@ -2920,46 +3098,67 @@ void AdvancedNotificationService::OnDistributedPublish(
     request->SetCreatorUid(BundleManagerHelper::GetInstance()->GetDefaultUidByBundleName(bundleName, activeUserId));
 
     handler_->PostTask(std::bind([this, deviceId, bundleName, request]() {
-        if (!CheckDistributedNotificationType(request)) {
-            ANS_LOGD("device type not support display.");
-            return;
-        }
-
-        sptr<NotificationBundleOption> bundleOption =
-            GenerateValidBundleOption(new NotificationBundleOption(bundleName, 0));
-        if (bundleOption == nullptr) {
-            return;
-        }
-        std::shared_ptr<NotificationRecord> record = std::make_shared<NotificationRecord>();
+        std::shared_ptr<NotificationRecord> record = MakeDistributedRecord(deviceId, bundleName, request);
         if (record == nullptr) {
             return;
         }
-        record->request = request;
-        record->notification = new Notification(deviceId, request);
-        record->bundleOption = bundleOption;
-        record->deviceId = deviceId;
-        SetNotificationRemindType(record->notification, false);
 
-        ErrCode result = AssignValidNotificationSlot(record);
+        ErrCode result = FlowControl(record);
         if (result != ERR_OK) {
-            ANS_LOGE("Can not assign valid slot!");
             return;
         }
 
-        result = Filter(record);
-        if (result != ERR_OK) {
-            ANS_LOGE("Reject by filters: %{public}d", result);
-            return;
-        }
+        UpdateRecentNotification(record->notification, false, 0);
+        sptr<NotificationSortingMap> sortingMap = GenerateSortingMap();
+        NotificationSubscriberManager::GetInstance()->NotifyConsumed(record->notification, sortingMap);
+    }));
+}
 
-        result = FlowControl(record);
-        if (result != ERR_OK) {
+void AdvancedNotificationService::OnDistributedPublishBatch(
+    std::vector<DistributedNotificationManager::DistributedRequest> &requests)
+{
+    ANS_LOGD("%{public}s", __FUNCTION__);
+    int32_t activeUserId = -1;
+    if (!GetActiveUserId(activeUserId)) {
+        ANS_LOGE("Failed to get active user id!");
+        return;
+    }
+    // The uid is queried once per bundle, the notifications of a bundle usually come together.
+    std::map<std::string, int32_t> bundleUids;
+    for (auto &distributedRequest : requests) {
+        auto iter = bundleUids.find(distributedRequest.bundleName);
+        if (iter == bundleUids.end()) {
+            int32_t uid = BundleManagerHelper::GetInstance()->GetDefaultUidByBundleName(
+                distributedRequest.bundleName, activeUserId);
+            iter = bundleUids.emplace(distributedRequest.bundleName, uid).first;
+        }
+        distributedRequest.request->SetCreatorUid(iter->second);
+    }
+
+    handler_->PostTask(std::bind([this, requests]() {
+        std::vector<std::shared_ptr<NotificationRecord>> records;
+        for (auto &distributedRequest : requests) {
+            std::shared_ptr<NotificationRecord> record = MakeDistributedRecord(
+                distributedRequest.deviceId, distributedRequest.bundleName, distributedRequest.request);
+            if (record != nullptr) {
+                records.push_back(record);
+            }
+        }
+        // Each notification takes a slot of the per-second publish limit, as if it were published alone.
+        std::vector<sptr<Notification>> published;
+        for (auto &record : records) {
+            if (FlowControl(record) != ERR_OK) {
+                continue;
+            }
+            UpdateRecentNotification(record->notification, false, 0);
+            published.push_back(record->notification);
+        }
+        if (published.empty()) {
             return;
         }
 
-        UpdateRecentNotification(record->notification, false, 0);
         sptr<NotificationSortingMap> sortingMap = GenerateSortingMap();
-        NotificationSubscriberManager::GetInstance()->NotifyConsumed(record->notification, sortingMap);
+        NotificationSubscriberManager::GetInstance()->NotifyConsumedBatch(published, sortingMap);
     }));
 }
 
@@ -2975,36 +3174,10 @@ void AdvancedNotificationService::OnDistributedUpdate(
     request->SetCreatorUid(BundleManagerHelper::GetInstance()->GetDefaultUidByBundleName(bundleName, activeUserId));
 
     handler_->PostTask(std::bind([this, deviceId, bundleName, request]() {
-        if (!CheckDistributedNotificationType(request)) {
-            ANS_LOGD("device type not support display.");
-            return;
-        }
-        sptr<NotificationBundleOption> bundleOption =
-            GenerateValidBundleOption(new NotificationBundleOption(bundleName, 0));
-        if (bundleOption == nullptr) {
-            return;
-        }
-        std::shared_ptr<NotificationRecord> record = std::make_shared<NotificationRecord>();
+        std::shared_ptr<NotificationRecord> record = MakeDistributedRecord(deviceId, bundleName, request);
         if (record == nullptr) {
             return;
         }
-        record->request = request;
-        record->notification = new Notification(deviceId, request);
-        record->bundleOption = bundleOption;
-        record->deviceId = deviceId;
-        SetNotificationRemindType(record->notification, false);
-
-        ErrCode result = AssignValidNotificationSlot(record);
-        if (result != ERR_OK) {
-            ANS_LOGE("Can not assign valid slot!");
-            return;
-        }
-
-        result = Filter(record);
-        if (result != ERR_OK) {
-            ANS_LOGE("Reject by filters: %{public}d", result);
-            return;
-        }
 
         if (IsNotificationExists(record->notification->GetKey())) {
             if (record->request->IsAlertOneTime()) {
@@ -3042,15 +3215,11 @@ void AdvancedNotificationService::OnDistributedDelete(
         }
 
         sptr<Notification> notification = nullptr;
-        for (auto record : notificationList_) {
-            if ((record->deviceId == recordDeviceId) &&
-                (record->bundleOption->GetBundleName() == bundleOption->GetBundleName()) &&
-                (record->bundleOption->GetUid() == bundleOption->GetUid()) &&
-                (record->notification->GetLabel() == label) && (record->notification->GetId() == id)) {
-                notification = record->notification;
-                notificationList_.remove(record);
-                break;
-            }
+        auto record = notificationList_.FindById(
+            bundleOption->GetBundleName(), bundleOption->GetUid(), label, id, recordDeviceId);
+        if (record != nullptr) {
+            notification = record->notification;
+            notificationList_.Remove(record);
         }
 
         if (notification != nullptr) {
@@ -3094,10 +3263,8 @@ ErrCode AdvancedNotificationService::IsSupportTemplate(const std::string& templa
 {
     ANS_LOGD("%{public}s", __FUNCTION__);
     ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        support = false;
-        result = NotificationPreferences::GetInstance().GetTemplateSupported(templateName, support);
-    }));
+    support = false;
+    result = NotificationPreferences::GetInstance().GetTemplateSupported(templateName, support);
     return result;
 }
 
@@ -3138,10 +3305,8 @@ ErrCode AdvancedNotificationService::IsSpecialUserAllowedNotify(const int32_t &u
     }
 
     ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        allowed = false;
-        result = NotificationPreferences::GetInstance().GetNotificationsEnabled(userId, allowed);
-    }));
+    allowed = false;
+    result = NotificationPreferences::GetInstance().GetNotificationsEnabled(userId, allowed);
     return result;
 }
 
@@ -3179,7 +3344,7 @@ ErrCode AdvancedNotificationService::DeleteAllByUser(const int32_t &userId)
 
     ErrCode result = ERR_OK;
     handler_->PostSyncTask(std::bind([&]() {
-        std::vector<std::string> keys = GetNotificationKeys(nullptr);
+        std::vector<std::string> keys = GetNotificationKeysByUser(userId);
         for (auto key : keys) {
 #ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
             std::string deviceId = GetNotificationDeviceId(key);
@@ -3348,10 +3513,7 @@ ErrCode AdvancedNotificationService::GetHasPoppedDialog(
     const sptr<NotificationBundleOption> bundleOption, bool &hasPopped)
 {
     ANS_LOGD("%{public}s", __FUNCTION__);
-    ErrCode result = ERR_OK;
-    handler_->PostSyncTask(std::bind([&]() {
-        result = NotificationPreferences::GetInstance().GetHasPoppedDialog(bundleOption, hasPopped);
-    }));
+    ErrCode result = NotificationPreferences::GetInstance().GetHasPoppedDialog(bundleOption, hasPopped);
     return result;
 }
 
@@ -3474,6 +3636,13 @@ ErrCode AdvancedNotificationService::SetEnabledForBundleSlot(
             if (slot->GetEnable() == enabled) {
                 return;
             }
+            // The stored slot is read by other threads without the handler, it is replaced by a changed copy.
+            slot = new (std::nothrow) NotificationSlot(*slot);
+            if (slot == nullptr) {
+                ANS_LOGE("Failed to create NotificationSlot ptr.");
+                result = ERR_ANS_NO_MEMORY;
+                return;
+            }
             NotificationPreferences::GetInstance().RemoveNotificationSlot(bundle, slotType);
         } else {
             ANS_LOGE("Set enable slot: GetNotificationSlot failed");
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "notification_delivery_queue.h"
+
+#include <iterator>
+
+#include "ans_log_wrapper.h"
+
+namespace OHOS {
+namespace Notification {
+namespace {
+constexpr size_t MAX_DRAIN_NUM_PER_TASK = 32;
+constexpr char POLICY_COALESCE[] = "coalesce";
+constexpr char POLICY_DROP_OLDEST[] = "dropOldest";
+constexpr char POLICY_DISCONNECT[] = "disconnect";
+}  // namespace
+
+NotificationDeliveryQueue::NotificationDeliveryQueue(
+    const std::shared_ptr<AppExecFwk::EventHandler> &handler, size_t capacity, OverflowPolicy policy)
+    : handler_(handler), capacity_(capacity), policy_(policy)
+{}
+
+NotificationDeliveryQueue::PushResult NotificationDeliveryQueue::Push(
+    const std::string &key, const Task &task, SortingMapType type, const Task &fullTask)
+{
+    Item item = {key, task, std::chrono::steady_clock::now(), type, fullTask};
+    PushResult result = PushResult::QUEUED;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) {
+            return PushResult::CLOSED;
+        }
+
+        if (items_.size() >= capacity_) {
+            if (policy_ == OverflowPolicy::DISCONNECT) {
+                stats_.dropped++;
+                return PushResult::REJECTED;
+            }
+            if ((policy_ == OverflowPolicy::COALESCE) && !key.empty()) {
+                // The latest callback of the key is the one the new callback supersedes. The new callback is
+                // queued at the tail, after the callbacks queued since, so that their sorting maps are not newer.
+                for (auto iter = items_.rbegin(); iter != items_.rend(); iter++) {
+                    if (iter->key == key) {
+                        item.pushTime = iter->pushTime;
+                        SortingMapType erasedType = iter->type;
+                        size_t index = static_cast<size_t>(std::distance(iter, items_.rend())) - 1;
+                        items_.erase(std::next(iter).base());
+                        items_.push_back(std::move(item));
+                        if (erasedType != SortingMapType::NONE) {
+                            RebaseSortingMap(index);
+                        }
+                        stats_.coalesced++;
+                        return PushResult::COALESCED;
+                    }
+                }
+            }
+            if (!items_.empty()) {
+                SortingMapType droppedType = items_.front().type;
+                items_.pop_front();
+                items_.push_back(std::move(item));
+                if (droppedType != SortingMapType::NONE) {
+                    RebaseSortingMap(0);
+                }
+                stats_.dropped++;
+                result = PushResult::DROPPED_OLDEST;
+            }
+        }
+
+        if (result != PushResult::DROPPED_OLDEST) {
+            items_.push_back(std::move(item));
+        }
+        if (items_.size() > stats_.maxDepth) {
+            stats_.maxDepth = items_.size();
+        }
+        if (draining_) {
+            return result;
+        }
+        draining_ = true;
+    }
+    ScheduleDrain();
+    return result;
+}
+
+void NotificationDeliveryQueue::Close(const Task &task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) {
+            return;
+        }
+        closed_ = true;
+        items_.push_back({"", task, std::chrono::steady_clock::now()});
+        if (draining_) {
+            return;
+        }
+        draining_ = true;
+    }
+    ScheduleDrain();
+}
+
+void NotificationDeliveryQueue::Stop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    stats_.dropped += items_.size();
+    items_.clear();
+}
+
+void NotificationDeliveryQueue::SetPolicy(size_t capacity, OverflowPolicy policy)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    policy_ = policy;
+}
+
+NotificationDeliveryQueue::Stats NotificationDeliveryQueue::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.depth = items_.size();
+    stats.averageLatency = (stats_.delivered == 0) ? 0 : (totalLatency_ / static_cast<int64_t>(stats_.delivered));
+    return stats;
+}
+
+std::string NotificationDeliveryQueue::PolicyToString(OverflowPolicy policy)
+{
+    switch (policy) {
+        case OverflowPolicy::DROP_OLDEST:
+            return POLICY_DROP_OLDEST;
+        case OverflowPolicy::DISCONNECT:
+            return POLICY_DISCONNECT;
+        case OverflowPolicy::COALESCE:
+        default:
+            return POLICY_COALESCE;
+    }
+}
+
+bool NotificationDeliveryQueue::StringToPolicy(const std::string &str, OverflowPolicy &policy)
+{
+    if (str == POLICY_COALESCE) {
+        policy = OverflowPolicy::COALESCE;
+    } else if (str == POLICY_DROP_OLDEST) {
+        policy = OverflowPolicy::DROP_OLDEST;
+    } else if (str == POLICY_DISCONNECT) {
+        policy = OverflowPolicy::DISCONNECT;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void NotificationDeliveryQueue::RebaseSortingMap(size_t index)
+{
+    for (; index < items_.size(); index++) {
+        Item &item = items_[index];
+        if (item.type == SortingMapType::NONE) {
+            continue;
+        }
+        if ((item.type == SortingMapType::DELTA) && item.fullTask) {
+            item.task = std::move(item.fullTask);
+            item.fullTask = nullptr;
+            item.type = SortingMapType::FULL;
+        }
+        return;
+    }
+}
+
+void NotificationDeliveryQueue::ScheduleDrain()
+{
+    // Posted without holding the lock, the handler may run the task before PostTask returns.
+    std::shared_ptr<AppExecFwk::EventHandler> handler = handler_.lock();
+    if ((handler == nullptr) ||
+        !handler->PostTask(std::bind(&NotificationDeliveryQueue::Drain, shared_from_this()))) {
+        ANS_LOGE("Failed to schedule the delivery.");
+        std::lock_guard<std::mutex> lock(mutex_);
+        draining_ = false;
+    }
+}
+
+void NotificationDeliveryQueue::Drain()
+{
+    // Drain a limited number of callbacks per task, so that the other queues of the worker get their turn.
+    for (size_t i = 0; i < MAX_DRAIN_NUM_PER_TASK; i++) {
+        Item item;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (items_.empty()) {
+                draining_ = false;
+                return;
+            }
+            item = std::move(items_.front());
+            items_.pop_front();
+        }
+
+        item.task();
+
+        int64_t latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - item.pushTime).count();
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.delivered++;
+        totalLatency_ += latency;
+        if (latency > stats_.maxLatency) {
+            stats_.maxLatency = latency;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (items_.empty()) {
+            draining_ = false;
+            return;
+        }
+    }
+    ScheduleDrain();
+}
+}  // namespace Notification
+}  // namespace OHOS
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "notification_image_cache.h"
+
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <string_view>
+
+#include "ans_log_wrapper.h"
+
+namespace OHOS {
+namespace Notification {
+NotificationImageCache::NotificationImageCache(size_t budget) : budget_(budget)
+{}
+
+std::shared_ptr<Media::PixelMap> NotificationImageCache::Share(const std::shared_ptr<Media::PixelMap> &pixelMap)
+{
+    if ((pixelMap == nullptr) || (pixelMap->GetPixels() == nullptr) || (pixelMap->GetByteCount() <= 0)) {
+        return pixelMap;
+    }
+    size_t bytes = static_cast<size_t>(pixelMap->GetByteCount());
+    // Hashed without the lock, the hash is only compared within the process.
+    size_t hash = std::hash<std::string_view>()(
+        std::string_view(reinterpret_cast<const char *>(pixelMap->GetPixels()), bytes));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (bytes > budget_) {
+        misses_++;
+        return pixelMap;
+    }
+    auto range = index_.equal_range(hash);
+    for (auto iter = range.first; iter != range.second; iter++) {
+        if (IsSameImage(*iter->second->pixelMap, *pixelMap)) {
+            entries_.splice(entries_.begin(), entries_, iter->second);
+            hits_++;
+            return iter->second->pixelMap;
+        }
+    }
+
+    misses_++;
+    entries_.push_front({hash, bytes, pixelMap});
+    index_.emplace(hash, entries_.begin());
+    bytes_ += bytes;
+    EvictLocked();
+    return pixelMap;
+}
+
+void NotificationImageCache::SetBudget(size_t budget)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    budget_ = budget;
+    EvictLocked();
+}
+
+NotificationImageCache::Stats NotificationImageCache::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.entries = entries_.size();
+    stats.bytes = bytes_;
+    stats.budget = budget_;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.evictions = evictions_;
+    for (auto &entry : entries_) {
+        // One reference is the cache's own.
+        long references = entry.pixelMap.use_count() - 1;
+        if (references > 0) {
+            stats.inUseEntries++;
+            stats.savedBytes += static_cast<size_t>(references - 1) * entry.bytes;
+        }
+    }
+    return stats;
+}
+
+void NotificationImageCache::Dump(std::vector<std::string> &dumpInfo)
+{
+    Stats stats = GetStats();
+    std::stringstream stream;
+    stream << "\tImageCache:\n";
+    stream << "\t\tEntries: " << stats.entries << ", InUse: " << stats.inUseEntries << "\n";
+    stream << "\t\tBytes: " << stats.bytes << ", Budget: " << stats.budget << ", Saved: " << stats.savedBytes << "\n";
+    stream << "\t\tHits: " << stats.hits << ", Misses: " << stats.misses << ", Evictions: " << stats.evictions
+           << "\n";
+    dumpInfo.push_back(stream.str());
+}
+
+bool NotificationImageCache::IsSameImage(const Media::PixelMap &left, const Media::PixelMap &right)
+{
+    if ((left.GetWidth() != right.GetWidth()) || (left.GetHeight() != right.GetHeight()) ||
+        (left.GetPixelFormat() != right.GetPixelFormat()) || (left.GetRowBytes() != right.GetRowBytes()) ||
+        (left.GetByteCount() != right.GetByteCount())) {
+        return false;
+    }
+    if (left.GetPixels() == right.GetPixels()) {
+        return true;
+    }
+    return memcmp(left.GetPixels(), right.GetPixels(), static_cast<size_t>(left.GetByteCount())) == 0;
+}
+
+void NotificationImageCache::EvictLocked()
+{
+    while ((bytes_ > budget_) && !entries_.empty()) {
+        Entry &entry = entries_.back();
+        auto range = index_.equal_range(entry.hash);
+        for (auto iter = range.first; iter != range.second; iter++) {
+            if (iter->second == std::prev(entries_.end())) {
+                index_.erase(iter);
+                break;
+            }
+        }
+        bytes_ -= entry.bytes;
+        entries_.pop_back();
+        evictions_++;
+    }
+}
+}  // namespace Notification
+}  // namespace OHOS
@@ -16,6 +16,7 @@
 #include "notification_preferences.h"
 
 #include <fstream>
+#include <utility>
 
 #include "ans_const_define.h"
 #include "ans_inner_errors.h"
@@ -44,13 +45,15 @@ ErrCode NotificationPreferences::AddNotificationSlots(
     const sptr<NotificationBundleOption> &bundleOption, const std::vector<sptr<NotificationSlot>> &slots)
 {
     ANS_LOGD("%{public}s", __FUNCTION__);
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
     if (bundleOption == nullptr || bundleOption->GetBundleName().empty() || slots.empty()) {
         return ERR_ANS_INVALID_PARAM;
     }
-    NotificationPreferencesInfo preferencesInfo = preferencesInfo_;
+    NotificationPreferencesInfo::BundleInfo bundleInfo;
+    GetOrCreateBundleInfo(bundleOption, bundleInfo);
     ErrCode result = ERR_OK;
     for (auto slot : slots) {
-        result = CheckSlotForCreateSlot(bundleOption, slot, preferencesInfo);
+        result = CheckSlotForCreateSlot(bundleOption, slot, bundleInfo);
         if (result != ERR_OK) {
             return result;
         }
@@ -62,7 +65,7 @@ ErrCode NotificationPreferences::AddNotificationSlots(
     }
 
     if (result == ERR_OK) {
-        preferencesInfo_ = preferencesInfo;
+        CommitBundleInfo(std::move(bundleInfo));
     }
     return result;
 }
@@ -71,14 +74,16 @@ ErrCode NotificationPreferences::AddNotificationSlotGroups(
     const sptr<NotificationBundleOption> &bundleOption, const std::vector<sptr<NotificationSlotGroup>> &groups)
 {
     ANS_LOGD("%{public}s", __FUNCTION__);
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
     if (bundleOption == nullptr || bundleOption->GetBundleName().empty() || groups.empty()) {
         return ERR_ANS_INVALID_PARAM;
     }
 
-    NotificationPreferencesInfo preferencesInfo = preferencesInfo_;
+    NotificationPreferencesInfo::BundleInfo bundleInfo;
+    GetOrCreateBundleInfo(bundleOption, bundleInfo);
     ErrCode result = ERR_OK;
     for (auto group : groups) {
-        result = CheckGroupForCreateSlotGroup(bundleOption, group, preferencesInfo);
+        result = CheckGroupForCreateSlotGroup(bundleOption, group, bundleInfo);
         if (result != ERR_OK) {
             return result;
         }
@@ -90,23 +95,22 @@ ErrCode NotificationPreferences::AddNotificationSlotGroups(
     }
 
     if (result == ERR_OK) {
-        preferencesInfo_ = preferencesInfo;
+        CommitBundleInfo(std::move(bundleInfo));
     }
     return result;
 }
 
 ErrCode NotificationPreferences::AddNotificationBundleProperty(const sptr<NotificationBundleOption> &bundleOption)
 {
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
     if (bundleOption == nullptr || bundleOption->GetBundleName().empty()) {
         return ERR_ANS_INVALID_PARAM;
     }
 
-    NotificationPreferencesInfo preferencesInfo = preferencesInfo_;
     NotificationPreferencesInfo::BundleInfo bundleInfo;
-    preferencesInfo.SetBundleInfo(bundleInfo);
     ErrCode result = ERR_OK;
     if (preferncesDB_->PutBundlePropertyToDisturbeDB(bundleInfo)) {
-        preferencesInfo_ = preferencesInfo;
+        CommitBundleInfo(std::move(bundleInfo));
     } else {
         result = ERR_ANS_PREFERENCES_NOTIFICATION_DB_OPERATION_FAILED;
     }
@@ -118,18 +122,23 @@ ErrCode NotificationPreferences::RemoveNotificationSlot(
     const sptr<NotificationBundleOption> &bundleOption, const NotificationConstant::SlotType &slotType)
 {
     ANS_LOGD("%{public}s", __FUNCTION__);
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
     if (bundleOption == nullptr || bundleOption->GetBundleName().empty()) {
         return ERR_ANS_INVALID_PARAM;
     }
-    NotificationPreferencesInfo preferencesInfo = preferencesInfo_;
+    NotificationPreferencesInfo::BundleInfo bundleInfo;
+    if (!preferencesInfo_.GetBundleInfo(bundleOption, bundleInfo)) {
+        ANS_LOGW("Notification bundle does not exsit.");
+        return ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST;
+    }
     ErrCode result = ERR_OK;
-    result = CheckSlotForRemoveSlot(bundleOption, slotType, preferencesInfo);
+    result = CheckSlotForRemoveSlot(bundleOption, slotType, bundleInfo);
     if (result == ERR_OK && (!preferncesDB_->RemoveSlotFromDisturbeDB(GenerateBundleKey(bundleOption), slotType))) {
         return ERR_ANS_PREFERENCES_NOTIFICATION_DB_OPERATION_FAILED;
     }
 
     if (result == ERR_OK) {
-        preferencesInfo_ = preferencesInfo;
+        CommitBundleInfo(std::move(bundleInfo));
     }
     return result;
 }
@@ -137,15 +146,14 @@ ErrCode NotificationPreferences::RemoveNotificationSlot(
 ErrCode NotificationPreferences::RemoveNotificationAllSlots(const sptr<NotificationBundleOption> &bundleOption)
 {
     ANS_LOGD("%{public}s", __FUNCTION__);
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
     if (bundleOption == nullptr || bundleOption->GetBundleName().empty()) {
         return ERR_ANS_INVALID_PARAM;
     }
-    NotificationPreferencesInfo preferencesInfo = preferencesInfo_;
     ErrCode result = ERR_OK;
     NotificationPreferencesInfo::BundleInfo bundleInfo;
-    if (preferencesInfo.GetBundleInfo(bundleOption, bundleInfo)) {
+    if (preferencesInfo_.GetBundleInfo(bundleOption, bundleInfo)) {
         bundleInfo.RemoveAllSlots();
-        preferencesInfo.SetBundleInfo(bundleInfo);
         if (!preferncesDB_->RemoveAllSlotsFromDisturbeDB(GenerateBundleKey(bundleOption))) {
             result = ERR_ANS_PREFERENCES_NOTIFICATION_DB_OPERATION_FAILED;
         }
@@ -154,7 +162,7 @@ ErrCode NotificationPreferences::RemoveNotificationAllSlots(const sptr<Notificat
     }
 
     if (result == ERR_OK) {
-        preferencesInfo_ = preferencesInfo;
+        CommitBundleInfo(std::move(bundleInfo));
     }
     return result;
 }
@@ -163,13 +171,18 @@ ErrCode NotificationPreferences::RemoveNotificationSlotGroups(
     const sptr<NotificationBundleOption> &bundleOption, const std::vector<std::string> &groupIds)
 {
     ANS_LOGD("%{public}s", __FUNCTION__);
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
     if (bundleOption == nullptr || bundleOption->GetBundleName().empty() || groupIds.empty()) {
         return ERR_ANS_INVALID_PARAM;
     }
-    NotificationPreferencesInfo preferencesInfo = preferencesInfo_;
+    NotificationPreferencesInfo::BundleInfo bundleInfo;
+    if (!preferencesInfo_.GetBundleInfo(bundleOption, bundleInfo)) {
+        ANS_LOGW("Notification bundle does not exsit.");
+        return ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST;
+    }
     ErrCode result = ERR_OK;
     for (auto groupId : groupIds) {
-        result = CheckGroupForRemoveSlotGroup(bundleOption, groupId, preferencesInfo);
+        result = CheckGroupForRemoveSlotGroup(bundleOption, groupId, bundleInfo);
         if (result != ERR_OK) {
             return result;
         }
@@ -179,7 +192,7 @@ ErrCode NotificationPreferences::RemoveNotificationSlotGroups(
     }
 
     if (result == ERR_OK) {
-        preferencesInfo_ = preferencesInfo;
+        CommitBundleInfo(std::move(bundleInfo));
     }
     return result;
 }
@@ -187,15 +200,13 @@ ErrCode NotificationPreferences::RemoveNotificationSlotGroups(
 ErrCode NotificationPreferences::RemoveNotificationForBundle(const sptr<NotificationBundleOption> &bundleOption)
 {
     ANS_LOGD("%{public}s", __FUNCTION__);
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
     if (bundleOption == nullptr || bundleOption->GetBundleName().empty()) {
         return ERR_ANS_INVALID_PARAM;
     }
 
-    NotificationPreferencesInfo preferencesInfo = preferencesInfo_;
-
     ErrCode result = ERR_OK;
-    if (preferencesInfo.IsExsitBundleInfo(bundleOption)) {
-        preferencesInfo.RemoveBundleInfo(bundleOption);
+    if (preferencesInfo_.IsExsitBundleInfo(bundleOption)) {
         if (!preferncesDB_->RemoveBundleFromDisturbeDB(GenerateBundleKey(bundleOption))) {
             result = ERR_ANS_PREFERENCES_NOTIFICATION_DB_OPERATION_FAILED;
         }
@@ -204,7 +215,8 @@ ErrCode NotificationPreferences::RemoveNotificationForBundle(const sptr<Notifica
     }
 
     if (result == ERR_OK) {
-        preferencesInfo_ = preferencesInfo;
+        std::lock_guard<std::shared_mutex> lock(preferenceMutex_);
+        preferencesInfo_.RemoveBundleInfo(bundleOption);
     }
 
     return result;
@@ -214,14 +226,19 @@ ErrCode NotificationPreferences::UpdateNotificationSlots(
     const sptr<NotificationBundleOption> &bundleOption, const std::vector<sptr<NotificationSlot>> &slots)
 {
     ANS_LOGD("%{public}s", __FUNCTION__);
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
     if (bundleOption == nullptr || bundleOption->GetBundleName().empty() || slots.empty()) {
         return ERR_ANS_INVALID_PARAM;
     }
 
-    NotificationPreferencesInfo preferencesInfo = preferencesInfo_;
+    NotificationPreferencesInfo::BundleInfo bundleInfo;
+    if (!preferencesInfo_.GetBundleInfo(bundleOption, bundleInfo)) {
+        ANS_LOGW("Notification bundle does not exsit.");
+        return ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST;
+    }
     ErrCode result = ERR_OK;
     for (auto slotIter : slots) {
-        result = CheckSlotForUpdateSlot(bundleOption, slotIter, preferencesInfo);
+        result = CheckSlotForUpdateSlot(bundleOption, slotIter, bundleInfo);
         if (result != ERR_OK) {
             return result;
         }
@@ -233,7 +250,7 @@ ErrCode NotificationPreferences::UpdateNotificationSlots(
     }
 
     if (result == ERR_OK) {
-        preferencesInfo_ = preferencesInfo;
+        CommitBundleInfo(std::move(bundleInfo));
     }
 
     return result;
@@ -243,14 +260,19 @@ ErrCode NotificationPreferences::UpdateNotificationSlotGroups(
     const sptr<NotificationBundleOption> &bundleOption, const std::vector<sptr<NotificationSlotGroup>> &groups)
 {
     ANS_LOGD("%{public}s", __FUNCTION__);
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
     if (bundleOption == nullptr || bundleOption->GetBundleName().empty() || groups.empty()) {
         return ERR_ANS_INVALID_PARAM;
     }
 
-    NotificationPreferencesInfo preferencesInfo = preferencesInfo_;
+    NotificationPreferencesInfo::BundleInfo bundleInfo;
+    if (!preferencesInfo_.GetBundleInfo(bundleOption, bundleInfo)) {
+        ANS_LOGW("Notification bundle does not exsit.");
+        return ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST;
+    }
     ErrCode result = ERR_OK;
     for (auto groupIter : groups) {
-        result = CheckGroupForUpdateSlotGroup(bundleOption, groupIter, preferencesInfo);
+        result = CheckGroupForUpdateSlotGroup(bundleOption, groupIter, bundleInfo);
         if (result != ERR_OK) {
             return result;
         }
@@ -262,7 +284,7 @@ ErrCode NotificationPreferences::UpdateNotificationSlotGroups(
     }
 
     if (result == ERR_OK) {
-        preferencesInfo_ = preferencesInfo;
+        CommitBundleInfo(std::move(bundleInfo));
     }
     return result;
 }
@@ -277,6 +299,7 @@ ErrCode NotificationPreferences::GetNotificationSlot(const sptr<NotificationBund
 
     ErrCode result = ERR_OK;
     NotificationPreferencesInfo::BundleInfo bundleInfo;
+    std::shared_lock<std::shared_mutex> lock(preferenceMutex_);
     if (preferencesInfo_.GetBundleInfo(bundleOption, bundleInfo)) {
         if (!bundleInfo.GetSlot(type, slot)) {
             result = ERR_ANS_PREFERENCES_NOTIFICATION_SLOT_TYPE_NOT_EXIST;
@@ -297,6 +320,7 @@ ErrCode NotificationPreferences::GetNotificationAllSlots(
 
     ErrCode result = ERR_OK;
     NotificationPreferencesInfo::BundleInfo bundleInfo;
+    std::shared_lock<std::shared_mutex> lock(preferenceMutex_);
     if (preferencesInfo_.GetBundleInfo(bundleOption, bundleInfo)) {
         bundleInfo.GetAllSlots(slots);
     } else {
@@ -316,6 +340,7 @@ ErrCode NotificationPreferences::GetNotificationSlotsNumForBundle(
 
     ErrCode result = ERR_OK;
     NotificationPreferencesInfo::BundleInfo bundleInfo;
+    std::shared_lock<std::shared_mutex> lock(preferenceMutex_);
     if (preferencesInfo_.GetBundleInfo(bundleOption, bundleInfo)) {
         num = static_cast<uint64_t>(bundleInfo.GetAllSlotsSize());
     } else {
@@ -333,6 +358,7 @@ ErrCode NotificationPreferences::GetNotificationSlotGroup(
 
     ErrCode result = ERR_OK;
     NotificationPreferencesInfo::BundleInfo bundleInfo;
+    std::shared_lock<std::shared_mutex> lock(preferenceMutex_);
     if (preferencesInfo_.GetBundleInfo(bundleOption, bundleInfo)) {
         if (!bundleInfo.GetGroup(groupId, group)) {
             result = ERR_ANS_PREFERENCES_NOTIFICATION_SLOTGROUP_NOT_EXIST;
@@ -353,6 +379,7 @@ ErrCode NotificationPreferences::GetNotificationAllSlotGroups(
 
     ErrCode result = ERR_OK;
     NotificationPreferencesInfo::BundleInfo bundleInfo;
+    std::shared_lock<std::shared_mutex> lock(preferenceMutex_);
     if (preferencesInfo_.GetBundleInfo(bundleOption, bundleInfo)) {
         bundleInfo.GetAllGroups(groups);
     } else {
@@ -371,6 +398,7 @@ ErrCode NotificationPreferences::GetNotificationAllSlotInSlotGroup(const sptr<No
 
     ErrCode result = ERR_OK;
     NotificationPreferencesInfo::BundleInfo bundleInfo;
+    std::shared_lock<std::shared_mutex> lock(preferenceMutex_);
     if (preferencesInfo_.GetBundleInfo(bundleOption, bundleInfo)) {
         bundleInfo.GetAllSlotsInGroup(groupId, slots);
     } else {
@@ -394,12 +422,7 @@ ErrCode NotificationPreferences::SetShowBadge(const sptr<NotificationBundleOptio
         return ERR_ANS_INVALID_PARAM;
     }
 
-    NotificationPreferencesInfo preferencesInfo = preferencesInfo_;
-    ErrCode result = SetBundleProperty(preferencesInfo, bundleOption, BundleType::BUNDLE_SHOW_BADGE_TYPE, enable);
-    if (result == ERR_OK) {
-        preferencesInfo_ = preferencesInfo;
-    }
-    return result;
+    return SetBundleProperty(bundleOption, BundleType::BUNDLE_SHOW_BADGE_TYPE, enable);
 }
 
 ErrCode NotificationPreferences::GetImportance(const sptr<NotificationBundleOption> &bundleOption, int32_t &importance)
@@ -417,12 +440,7 @@ ErrCode NotificationPreferences::SetImportance(
     if (bundleOption == nullptr || bundleOption->GetBundleName().empty()) {
         return ERR_ANS_INVALID_PARAM;
     }
-    NotificationPreferencesInfo preferencesInfo = preferencesInfo_;
-    ErrCode result = SetBundleProperty(preferencesInfo, bundleOption, BundleType::BUNDLE_IMPORTANCE_TYPE, importance);
-    if (result == ERR_OK) {
-        preferencesInfo_ = preferencesInfo;
-    }
-    return result;
+    return SetBundleProperty(bundleOption, BundleType::BUNDLE_IMPORTANCE_TYPE, importance);
 }
 
 ErrCode NotificationPreferences::GetTotalBadgeNums(
@@ -440,12 +458,7 @@ ErrCode NotificationPreferences::SetTotalBadgeNums(
     if (bundleOption == nullptr || bundleOption->GetBundleName().empty()) {
         return ERR_ANS_INVALID_PARAM;
     }
-    NotificationPreferencesInfo preferencesInfo = preferencesInfo_;
-    ErrCode result = SetBundleProperty(preferencesInfo, bundleOption, BundleType::BUNDLE_BADGE_TOTAL_NUM_TYPE, num);
-    if (result == ERR_OK) {
-        preferencesInfo_ = preferencesInfo;
-    }
-    return result;
+    return SetBundleProperty(bundleOption, BundleType::BUNDLE_BADGE_TOTAL_NUM_TYPE, num);
 }
 
 ErrCode NotificationPreferences::GetPrivateNotificationsAllowed(
@@ -463,12 +476,7 @@ ErrCode NotificationPreferences::SetPrivateNotificationsAllowed(
     if (bundleOption == nullptr || bundleOption->GetBundleName().empty()) {
         return ERR_ANS_INVALID_PARAM;
     }
-    NotificationPreferencesInfo preferencesInfo = preferencesInfo_;
-    ErrCode result = SetBundleProperty(preferencesInfo, bundleOption, BundleType::BUNDLE_PRIVATE_ALLOWED_TYPE, allow);
-    if (result == ERR_OK) {
-        preferencesInfo_ = preferencesInfo;
-    }
-    return result;
+    return SetBundleProperty(bundleOption, BundleType::BUNDLE_PRIVATE_ALLOWED_TYPE, allow);
 }
 
 ErrCode NotificationPreferences::GetNotificationsEnabledForBundle(
@@ -487,13 +495,7 @@ ErrCode NotificationPreferences::SetNotificationsEnabledForBundle(
         return ERR_ANS_INVALID_PARAM;
     }
 
-    NotificationPreferencesInfo preferencesInfo = preferencesInfo_;
-    ErrCode result =
-        SetBundleProperty(preferencesInfo, bundleOption, BundleType::BUNDLE_ENABLE_NOTIFICATION_TYPE, enabled);
-    if (result == ERR_OK) {
-        preferencesInfo_ = preferencesInfo;
-    }
-    return result;
+    return SetBundleProperty(bundleOption, BundleType::BUNDLE_ENABLE_NOTIFICATION_TYPE, enabled);
 }
 
 ErrCode NotificationPreferences::GetNotificationsEnabled(const int32_t &userId, bool &enabled)
@@ -503,6 +505,7 @@ ErrCode NotificationPreferences::GetNotificationsEnabled(const int32_t &userId,
     }
 
     ErrCode result = ERR_OK;
+    std::shared_lock<std::shared_mutex> lock(preferenceMutex_);
     if (!preferencesInfo_.GetEnabledAllNotification(userId, enabled)) {
         result = ERR_ANS_INVALID_PARAM;
     }
@@ -511,19 +514,19 @@ ErrCode NotificationPreferences::GetNotificationsEnabled(const int32_t &userId,
 
 ErrCode NotificationPreferences::SetNotificationsEnabled(const int32_t &userId, const bool &enabled)
 {
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
     if (userId <= SUBSCRIBE_USER_INIT) {
         return ERR_ANS_INVALID_PARAM;
     }
 
-    NotificationPreferencesInfo preferencesInfo = preferencesInfo_;
-    preferencesInfo.SetEnabledAllNotification(userId, enabled);
     ErrCode result = ERR_OK;
     if (!preferncesDB_->PutNotificationsEnabled(userId, enabled)) {
         result = ERR_ANS_PREFERENCES_NOTIFICATION_DB_OPERATION_FAILED;
     }
 
     if (result == ERR_OK) {
-        preferencesInfo_ = preferencesInfo;
+        std::lock_guard<std::shared_mutex> lock(preferenceMutex_);
+        preferencesInfo_.SetEnabledAllNotification(userId, enabled);
     }
     return result;
 }
@@ -542,13 +545,7 @@ ErrCode NotificationPreferences::SetHasPoppedDialog(const sptr<NotificationBundl
         return ERR_ANS_INVALID_PARAM;
     }
 
-    NotificationPreferencesInfo preferencesInfo = preferencesInfo_;
-    ErrCode result = ERR_OK;
-    result = SetBundleProperty(preferencesInfo, bundleOption, BundleType::BUNDLE_POPPED_DIALOG_TYPE, hasPopped);
-    if (result == ERR_OK) {
-        preferencesInfo_ = preferencesInfo;
-    }
-    return result;
+    return SetBundleProperty(bundleOption, BundleType::BUNDLE_POPPED_DIALOG_TYPE, hasPopped);
 }
 
 ErrCode NotificationPreferences::GetDoNotDisturbDate(const int32_t &userId,
@@ -559,8 +556,8 @@ ErrCode NotificationPreferences::GetDoNotDisturbDate(const int32_t &userId,
     }
 
     ErrCode result = ERR_OK;
-    NotificationPreferencesInfo preferencesInfo = preferencesInfo_;
-    if (!preferencesInfo.GetDoNotDisturbDate(userId, date)) {
+    std::shared_lock<std::shared_mutex> lock(preferenceMutex_);
+    if (!preferencesInfo_.GetDoNotDisturbDate(userId, date)) {
         result = ERR_ANS_INVALID_PARAM;
     }
     return result;
@@ -570,59 +567,69 @@ ErrCode NotificationPreferences::SetDoNotDisturbDate(const int32_t &userId,
     const sptr<NotificationDoNotDisturbDate> date)
 {
     ANS_LOGE("enter.");
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
     if (userId <= SUBSCRIBE_USER_INIT) {
         return ERR_ANS_INVALID_PARAM;
     }
 
-    NotificationPreferencesInfo preferencesInfo = preferencesInfo_;
-    preferencesInfo.SetDoNotDisturbDate(userId, date);
-
     ErrCode result = ERR_OK;
     if (!preferncesDB_->PutDoNotDisturbDate(userId, date)) {
         result = ERR_ANS_PREFERENCES_NOTIFICATION_DB_OPERATION_FAILED;
     }
 
     if (result == ERR_OK) {
-        preferencesInfo_ = preferencesInfo;
+        std::lock_guard<std::shared_mutex> lock(preferenceMutex_);
+        preferencesInfo_.SetDoNotDisturbDate(userId, date);
     }
     return result;
 }
 
 ErrCode NotificationPreferences::ClearNotificationInRestoreFactorySettings()
 {
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
     ErrCode result = ERR_OK;
     if (!preferncesDB_->RemoveAllDataFromDisturbeDB()) {
         result = ERR_ANS_PREFERENCES_NOTIFICATION_DB_OPERATION_FAILED;
     }
 
     if (result == ERR_OK) {
+        std::lock_guard<std::shared_mutex> lock(preferenceMutex_);
         preferencesInfo_ = NotificationPreferencesInfo();
     }
     return result;
 }
 
+void NotificationPreferences::GetOrCreateBundleInfo(
+    const sptr<NotificationBundleOption> &bundleOption, NotificationPreferencesInfo::BundleInfo &bundleInfo) const
+{
+    // writeMutex_ is held by the caller, so no change is made meanwhile and the bundle is read without the lock.
+    if (!preferencesInfo_.GetBundleInfo(bundleOption, bundleInfo)) {
+        bundleInfo.SetBundleName(bundleOption->GetBundleName());
+        bundleInfo.SetBundleUid(bundleOption->GetUid());
+        bundleInfo.SetEnableNotification(CheckApiCompatibility(bundleOption));
+    }
+}
+
+void NotificationPreferences::CommitBundleInfo(NotificationPreferencesInfo::BundleInfo &&bundleInfo)
+{
+    std::lock_guard<std::shared_mutex> lock(preferenceMutex_);
+    preferencesInfo_.SetBundleInfo(std::move(bundleInfo));
+}
+
 ErrCode NotificationPreferences::CheckSlotForCreateSlot(const sptr<NotificationBundleOption> &bundleOption,
-    const sptr<NotificationSlot> &slot, NotificationPreferencesInfo &preferencesInfo) const
+    const sptr<NotificationSlot> &slot, NotificationPreferencesInfo::BundleInfo &bundleInfo) const
 {
     if (slot == nullptr) {
         ANS_LOGE("Notification slot is nullptr.");
         return ERR_ANS_PREFERENCES_NOTIFICATION_SLOT_NOT_EXIST;
     }
 
-    NotificationPreferencesInfo::BundleInfo bundleInfo;
-    if (!preferencesInfo.GetBundleInfo(bundleOption, bundleInfo)) {
-        bundleInfo.SetBundleName(bundleOption->GetBundleName());
-        bundleInfo.SetBundleUid(bundleOption->GetUid());
-        bundleInfo.SetEnableNotification(CheckApiCompatibility(bundleOption));
-    }
     bundleInfo.SetSlot(slot);
-    preferencesInfo.SetBundleInfo(bundleInfo);
-
     return ERR_OK;
 }
 
 ErrCode NotificationPreferences::CheckGroupForCreateSlotGroup(const sptr<NotificationBundleOption> &bundleOption,
-    const sptr<NotificationSlotGroup> &group, NotificationPreferencesInfo &preferencesInfo) const
+    const sptr<NotificationSlotGroup> &group, NotificationPreferencesInfo::BundleInfo &bundleInfo) const
 {
     if (group == nullptr) {
         ANS_LOGE("Notification slot group is nullptr.");
@@ -634,127 +641,82 @@ ErrCode NotificationPreferences::CheckGroupForCreateSlotGroup(const sptr<Notific
         return ERR_ANS_PREFERENCES_NOTIFICATION_SLOTGROUP_ID_INVALID;
     }
 
-    NotificationPreferencesInfo::BundleInfo bundleInfo;
-    if (!preferencesInfo.GetBundleInfo(bundleOption, bundleInfo)) {
-        bundleInfo.SetBundleName(bundleOption->GetBundleName());
-        bundleInfo.SetBundleUid(bundleOption->GetUid());
-        bundleInfo.SetEnableNotification(CheckApiCompatibility(bundleOption));
-    } else {
-        if (bundleInfo.GetGroupSize() >= MAX_SLOT_GROUP_NUM) {
-            return ERR_ANS_PREFERENCES_NOTIFICATION_SLOTGROUP_EXCEED_MAX_NUM;
-        }
+    if (bundleInfo.GetGroupSize() >= MAX_SLOT_GROUP_NUM) {
+        return ERR_ANS_PREFERENCES_NOTIFICATION_SLOTGROUP_EXCEED_MAX_NUM;
     }
 
     bundleInfo.SetGroup(group);
-    preferencesInfo.SetBundleInfo(bundleInfo);
-
     return ERR_OK;
 }
 
 ErrCode NotificationPreferences::CheckSlotForRemoveSlot(const sptr<NotificationBundleOption> &bundleOption,
-    const NotificationConstant::SlotType &slotType, NotificationPreferencesInfo &preferencesInfo) const
+    const NotificationConstant::SlotType &slotType, NotificationPreferencesInfo::BundleInfo &bundleInfo) const
 {
-    ErrCode result = ERR_OK;
-    NotificationPreferencesInfo::BundleInfo bundleInfo;
-    if (preferencesInfo.GetBundleInfo(bundleOption, bundleInfo)) {
-        if (bundleInfo.IsExsitSlot(slotType)) {
-            bundleInfo.RemoveSlot(slotType);
-            preferencesInfo.SetBundleInfo(bundleInfo);
-        } else {
-            ANS_LOGE("Notification slot type does not exsited.");
-            result = ERR_ANS_PREFERENCES_NOTIFICATION_SLOT_TYPE_NOT_EXIST;
-        }
-    } else {
-        ANS_LOGW("Notification bundle does not exsit.");
-        result = ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST;
+    if (!bundleInfo.IsExsitSlot(slotType)) {
+        ANS_LOGE("Notification slot type does not exsited.");
+        return ERR_ANS_PREFERENCES_NOTIFICATION_SLOT_TYPE_NOT_EXIST;
     }
-    return result;
+
+    bundleInfo.RemoveSlot(slotType);
+    return ERR_OK;
 }
 
 ErrCode NotificationPreferences::CheckGroupForRemoveSlotGroup(const sptr<NotificationBundleOption> &bundleOption,
-    const std::string &groupId, NotificationPreferencesInfo &preferencesInfo) const
+    const std::string &groupId, NotificationPreferencesInfo::BundleInfo &bundleInfo) const
 {
-    ErrCode result = ERR_OK;
-    NotificationPreferencesInfo::BundleInfo bundleInfo;
-    if (preferencesInfo.GetBundleInfo(bundleOption, bundleInfo)) {
-        if (bundleInfo.IsExsitSlotGroup(groupId)) {
-            bundleInfo.RemoveSlotGroup(groupId);
-            preferencesInfo.SetBundleInfo(bundleInfo);
-        } else {
-            ANS_LOGE("Notification slot group id is invalid.");
-            result = ERR_ANS_PREFERENCES_NOTIFICATION_SLOTGROUP_ID_INVALID;
-        }
-    } else {
-        ANS_LOGW("Notification bundle does not exsit.");
-        result = ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST;
+    if (!bundleInfo.IsExsitSlotGroup(groupId)) {
+        ANS_LOGE("Notification slot group id is invalid.");
+        return ERR_ANS_PREFERENCES_NOTIFICATION_SLOTGROUP_ID_INVALID;
     }
-    return result;
+
+    bundleInfo.RemoveSlotGroup(groupId);
+    return ERR_OK;
 }
 
 ErrCode NotificationPreferences::CheckSlotForUpdateSlot(const sptr<NotificationBundleOption> &bundleOption,
-    const sptr<NotificationSlot> &slot, NotificationPreferencesInfo &preferencesInfo) const
+    const sptr<NotificationSlot> &slot, NotificationPreferencesInfo::BundleInfo &bundleInfo) const
 {
     if (slot == nullptr) {
         ANS_LOGE("Notification slot is nullptr.");
         return ERR_ANS_INVALID_PARAM;
     }
 
-    ErrCode result = ERR_OK;
-    NotificationPreferencesInfo::BundleInfo bundleInfo;
-    if (preferencesInfo.GetBundleInfo(bundleOption, bundleInfo)) {
-        if (bundleInfo.IsExsitSlot(slot->GetType())) {
-            bundleInfo.SetBundleName(bundleOption->GetBundleName());
-            bundleInfo.SetBundleUid(bundleOption->GetUid());
-            bundleInfo.SetSlot(slot);
-            preferencesInfo.SetBundleInfo(bundleInfo);
-        } else {
-            ANS_LOGE("Notification slot type does not exist.");
-            result = ERR_ANS_PREFERENCES_NOTIFICATION_SLOT_TYPE_NOT_EXIST;
-        }
-    } else {
-        ANS_LOGW("Notification bundle does not exsit.");
-        result = ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST;
+    if (!bundleInfo.IsExsitSlot(slot->GetType())) {
+        ANS_LOGE("Notification slot type does not exist.");
+        return ERR_ANS_PREFERENCES_NOTIFICATION_SLOT_TYPE_NOT_EXIST;
     }
 
-    return result;
+    bundleInfo.SetBundleName(bundleOption->GetBundleName());
+    bundleInfo.SetBundleUid(bundleOption->GetUid());
+    bundleInfo.SetSlot(slot);
+    return ERR_OK;
 }
 
 ErrCode NotificationPreferences::CheckGroupForUpdateSlotGroup(const sptr<NotificationBundleOption> &bundleOption,
-    const sptr<NotificationSlotGroup> &group, NotificationPreferencesInfo &preferencesInfo) const
+    const sptr<NotificationSlotGroup> &group, NotificationPreferencesInfo::BundleInfo &bundleInfo) const
 {
-    ErrCode result = ERR_OK;
-    NotificationPreferencesInfo::BundleInfo bundleInfo;
-    if (preferencesInfo.GetBundleInfo(bundleOption, bundleInfo)) {
-        if (bundleInfo.IsExsitSlotGroup(group->GetId())) {
-            bundleInfo.SetBundleName(bundleOption->GetBundleName());
-            bundleInfo.SetBundleUid(bundleOption->GetUid());
-            bundleInfo.SetGroup(group);
-            preferencesInfo.SetBundleInfo(bundleInfo);
-        } else {
-            result = ERR_ANS_PREFERENCES_NOTIFICATION_SLOTGROUP_NOT_EXIST;
-        }
-    } else {
-        ANS_LOGW("Notification slot is nullptr.");
-        result = ERR_ANS_PREFERENCES_NOTIFICATION_BUNDLE_NOT_EXIST;
+    if (!bundleInfo.IsExsitSlotGroup(group->GetId())) {
+        return ERR_ANS_PREFERENCES_NOTIFICATION_SLOTGROUP_NOT_EXIST;
     }
-    return result;
+
+    bundleInfo.SetBundleName(bundleOption->GetBundleName());
+    bundleInfo.SetBundleUid(bundleOption->GetUid());
+    bundleInfo.SetGroup(group);
+    return ERR_OK;
 }
 
 template <typename T>
-ErrCode NotificationPreferences::SetBundleProperty(NotificationPreferencesInfo &preferencesInfo,
+ErrCode NotificationPreferences::SetBundleProperty(
     const sptr<NotificationBundleOption> &bundleOption, const BundleType &type, const T &value)
 {
-    ErrCode result = ERR_OK;
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
     NotificationPreferencesInfo::BundleInfo bundleInfo;
-    if (!preferencesInfo_.GetBundleInfo(bundleOption, bundleInfo)) {
-        bundleInfo.SetBundleName(bundleOption->GetBundleName());
-        bundleInfo.SetBundleUid(bundleOption->GetUid());
-        bundleInfo.SetEnableNotification(CheckApiCompatibility(bundleOption));
-    }
-
-    result = SaveBundleProperty(bundleInfo, bundleOption, type, value);
-    preferencesInfo.SetBundleInfo(bundleInfo);
+    GetOrCreateBundleInfo(bundleOption, bundleInfo);
 
+    ErrCode result = SaveBundleProperty(bundleInfo, bundleOption, type, value);
+    if (result == ERR_OK) {
+        CommitBundleInfo(std::move(bundleInfo));
+    }
     return result;
 }
 
@@ -800,6 +762,7 @@ ErrCode NotificationPreferences::GetBundleProperty(
 {
     ErrCode result = ERR_OK;
     NotificationPreferencesInfo::BundleInfo bundleInfo;
+    std::shared_lock<std::shared_mutex> lock(preferenceMutex_);
     if (preferencesInfo_.GetBundleInfo(bundleOption, bundleInfo)) {
         switch (type) {
             case BundleType::BUNDLE_IMPORTANCE_TYPE:
@@ -878,7 +841,9 @@ ErrCode NotificationPreferences::GetTemplateSupported(const std::string& templat
 void NotificationPreferences::InitSettingFromDisturbDB()
 {
     ANS_LOGD("%{public}s", __FUNCTION__);
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
     if (preferncesDB_ != nullptr) {
+        std::lock_guard<std::shared_mutex> lock(preferenceMutex_);
         preferncesDB_->ParseFromDisturbeDB(preferencesInfo_);
     }
 }
@@ -886,9 +851,12 @@ void NotificationPreferences::InitSettingFromDisturbDB()
 void NotificationPreferences::RemoveSettings(int32_t userId)
 {
     ANS_LOGD("%{public}s", __FUNCTION__);
-
-    preferencesInfo_.RemoveNotificationEnable(userId);
-    preferencesInfo_.RemoveDoNotDisturbDate(userId);
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
+    {
+        std::lock_guard<std::shared_mutex> lock(preferenceMutex_);
+        preferencesInfo_.RemoveNotificationEnable(userId);
+        preferencesInfo_.RemoveDoNotDisturbDate(userId);
+    }
 
     if (preferncesDB_ != nullptr) {
         preferncesDB_->RemoveNotificationEnable(userId);
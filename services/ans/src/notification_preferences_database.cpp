@@ -22,8 +22,325 @@
 #include "uri.h"
 namespace OHOS {
 namespace Notification {
+namespace {
+std::string_view ToStringView(const DistributedKv::Blob &blob)
+{
+    return std::string_view(reinterpret_cast<const char *>(blob.Data().data()), blob.Size());
+}
+
+// Removes the token and the following separator from the front of the key.
+bool ConsumeToken(std::string_view &key, const std::string &token)
+{
+    if ((key.size() <= token.size()) || (key.compare(0, token.size(), token) != 0) ||
+        (key[token.size()] != KEY_UNDER_LINE[0])) {
+        return false;
+    }
+    key.remove_prefix(token.size() + 1);
+    return true;
+}
+
+// Splits "<id>_<property>" at the last separator, the ids may contain the separator.
+bool SplitLastToken(const std::string_view &key, std::string_view &id, std::string_view &property)
+{
+    size_t pos = key.find_last_of(KEY_UNDER_LINE[0]);
+    if ((pos == std::string_view::npos) || (pos == 0)) {
+        return false;
+    }
+    id = key.substr(0, pos);
+    property = key.substr(pos + 1);
+    return true;
+}
+
+/**
+ * Writes a record: the format version, then the fields in a fixed order. Integers are zigzag varints, strings and
+ * vectors are prefixed with their varint length.
+ */
+class RecordWriter {
+public:
+    RecordWriter()
+    {
+        data_.push_back(PREFERENCES_RECORD_VERSION);
+    }
+
+    void WriteInt(int64_t value)
+    {
+        WriteVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    void WriteBool(bool value)
+    {
+        data_.push_back(value ? 1 : 0);
+    }
+
+    void WriteString(const std::string &value)
+    {
+        WriteVarint(value.size());
+        data_.insert(data_.end(), value.begin(), value.end());
+    }
+
+    void WriteIntVector(const std::vector<int64_t> &values)
+    {
+        WriteVarint(values.size());
+        for (auto value : values) {
+            WriteInt(value);
+        }
+    }
+
+    DistributedKv::Value ToValue() const
+    {
+        return DistributedKv::Value(data_);
+    }
+
+private:
+    void WriteVarint(uint64_t value)
+    {
+        const uint8_t lowBits = 0x7f;
+        const uint8_t moreBit = 0x80;
+        const uint8_t bitsPerByte = 7;
+        while (value > lowBits) {
+            data_.push_back(static_cast<uint8_t>(value & lowBits) | moreBit);
+            value >>= bitsPerByte;
+        }
+        data_.push_back(static_cast<uint8_t>(value));
+    }
+
+    std::vector<uint8_t> data_;
+};
+
+/**
+ * Reads a record written by RecordWriter. Later versions only append fields, which are left unread.
+ */
+class RecordReader {
+public:
+    explicit RecordReader(const DistributedKv::Blob &blob) : data_(blob.Data()) {}
+
+    bool ReadVersion()
+    {
+        if (data_.empty() || (data_[0] == 0)) {
+            return false;
+        }
+        pos_ = 1;
+        return true;
+    }
+
+    bool ReadInt(int32_t &value)
+    {
+        int64_t value64 = 0;
+        if (!ReadInt(value64)) {
+            return false;
+        }
+        value = static_cast<int32_t>(value64);
+        return true;
+    }
+
+    bool ReadInt(int64_t &value)
+    {
+        uint64_t zigzag = 0;
+        if (!ReadVarint(zigzag)) {
+            return false;
+        }
+        value = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+        return true;
+    }
+
+    bool ReadBool(bool &value)
+    {
+        if (pos_ >= data_.size()) {
+            return false;
+        }
+        value = (data_[pos_++] != 0);
+        return true;
+    }
+
+    bool ReadString(std::string &value)
+    {
+        uint64_t size = 0;
+        if (!ReadVarint(size) || (size > data_.size() - pos_)) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char *>(data_.data() + pos_), size);
+        pos_ += size;
+        return true;
+    }
+
+    bool ReadIntVector(std::vector<int64_t> &values)
+    {
+        uint64_t size = 0;
+        if (!ReadVarint(size) || (size > data_.size() - pos_)) {
+            return false;
+        }
+        values.resize(size);
+        for (auto &value : values) {
+            if (!ReadInt(value)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    bool ReadVarint(uint64_t &value)
+    {
+        const uint8_t lowBits = 0x7f;
+        const uint8_t moreBit = 0x80;
+        const uint32_t bitsPerByte = 7;
+        const uint32_t maxShift = 63;
+        value = 0;
+        for (uint32_t shift = 0; (shift <= maxShift) && (pos_ < data_.size()); shift += bitsPerByte) {
+            uint8_t byte = data_[pos_++];
+            value |= static_cast<uint64_t>(byte & lowBits) << shift;
+            if ((byte & moreBit) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const std::vector<uint8_t> &data_;
+    size_t pos_ {0};
+};
+
+DistributedKv::Value EncodeBundleRecord(const NotificationPreferencesInfo::BundleInfo &bundleInfo)
+{
+    RecordWriter writer;
+    writer.WriteString(bundleInfo.GetBundleName());
+    writer.WriteInt(bundleInfo.GetBundleUid());
+    writer.WriteInt(bundleInfo.GetImportance());
+    writer.WriteBool(bundleInfo.GetIsShowBadge());
+    writer.WriteInt(bundleInfo.GetBadgeTotalNum());
+    writer.WriteBool(bundleInfo.GetIsPrivateAllowed());
+    writer.WriteBool(bundleInfo.GetEnableNotification());
+    writer.WriteBool(bundleInfo.GetHasPoppedDialog());
+    return writer.ToValue();
+}
+
+bool DecodeBundleRecord(const DistributedKv::Value &value, NotificationPreferencesInfo::BundleInfo &bundleInfo)
+{
+    RecordReader reader(value);
+    std::string name;
+    int32_t uid = 0;
+    int32_t importance = 0;
+    bool showBadge = false;
+    int32_t badgeTotalNum = 0;
+    bool privateAllowed = false;
+    bool enableNotification = false;
+    bool poppedDialog = false;
+    if (!reader.ReadVersion() || !reader.ReadString(name) || !reader.ReadInt(uid) || !reader.ReadInt(importance) ||
+        !reader.ReadBool(showBadge) || !reader.ReadInt(badgeTotalNum) || !reader.ReadBool(privateAllowed) ||
+        !reader.ReadBool(enableNotification) || !reader.ReadBool(poppedDialog)) {
+        return false;
+    }
+    bundleInfo.SetBundleName(name);
+    bundleInfo.SetBundleUid(uid);
+    bundleInfo.SetImportance(importance);
+    bundleInfo.SetIsShowBadge(showBadge);
+    bundleInfo.SetBadgeTotalNum(badgeTotalNum);
+    bundleInfo.SetIsPrivateAllowed(privateAllowed);
+    bundleInfo.SetEnableNotification(enableNotification);
+    bundleInfo.SetHasPoppedDialog(poppedDialog);
+    return true;
+}
+
+DistributedKv::Value EncodeSlotRecord(const sptr<NotificationSlot> &slot)
+{
+    // The type is in the key, the id and the name follow from the type.
+    RecordWriter writer;
+    writer.WriteString(slot->GetSlotGroup());
+    writer.WriteString(slot->GetDescription());
+    writer.WriteInt(static_cast<int64_t>(slot->GetLevel()));
+    writer.WriteBool(slot->IsShowBadge());
+    writer.WriteBool(slot->CanEnableLight());
+    writer.WriteBool(slot->CanVibrate());
+    writer.WriteInt(slot->GetLedLightColor());
+    writer.WriteInt(static_cast<int64_t>(slot->GetLockScreenVisibleness()));
+    writer.WriteString(slot->GetSound().ToString());
+    writer.WriteBool(slot->IsEnableBypassDnd());
+    writer.WriteIntVector(slot->GetVibrationStyle());
+    writer.WriteBool(slot->GetEnable());
+    return writer.ToValue();
+}
+
+bool DecodeSlotRecord(const DistributedKv::Value &value, sptr<NotificationSlot> &slot)
+{
+    RecordReader reader(value);
+    std::string groupId;
+    std::string description;
+    int32_t level = 0;
+    bool showBadge = false;
+    bool enableLight = false;
+    bool enableVibration = false;
+    int32_t ledLightColor = 0;
+    int32_t visibleness = 0;
+    std::string sound;
+    bool enableBypassDnd = false;
+    std::vector<int64_t> vibrationStyle;
+    bool enabled = false;
+    if (!reader.ReadVersion() || !reader.ReadString(groupId) || !reader.ReadString(description) ||
+        !reader.ReadInt(level) || !reader.ReadBool(showBadge) || !reader.ReadBool(enableLight) ||
+        !reader.ReadBool(enableVibration) || !reader.ReadInt(ledLightColor) || !reader.ReadInt(visibleness) ||
+        !reader.ReadString(sound) || !reader.ReadBool(enableBypassDnd) || !reader.ReadIntVector(vibrationStyle) ||
+        !reader.ReadBool(enabled)) {
+        return false;
+    }
+    slot->SetSlotGroup(groupId);
+    slot->SetDescription(description);
+    slot->SetLevel(static_cast<NotificationSlot::NotificationLevel>(level));
+    slot->EnableBadge(showBadge);
+    slot->SetEnableLight(enableLight);
+    slot->SetLedLightColor(ledLightColor);
+    slot->SetLockscreenVisibleness(static_cast<NotificationConstant::VisiblenessType>(visibleness));
+    slot->SetSound(Uri(sound));
+    slot->EnableBypassDnd(enableBypassDnd);
+    // The vibration style sets whether to vibrate, so the stored value is applied after it.
+    slot->SetVibrationStyle(vibrationStyle);
+    slot->SetEnableVibration(enableVibration);
+    slot->SetEnable(enabled);
+    return true;
+}
+
+DistributedKv::Value EncodeGroupRecord(const sptr<NotificationSlotGroup> &group)
+{
+    // The id is in the key.
+    RecordWriter writer;
+    writer.WriteString(group->GetName());
+    writer.WriteString(group->GetDescription());
+    return writer.ToValue();
+}
+
+sptr<NotificationSlotGroup> DecodeGroupRecord(const std::string &groupId, const DistributedKv::Value &value)
+{
+    RecordReader reader(value);
+    std::string name;
+    std::string description;
+    if (!reader.ReadVersion() || !reader.ReadString(name) || !reader.ReadString(description) || name.empty()) {
+        return nullptr;
+    }
+    sptr<NotificationSlotGroup> group = new (std::nothrow) NotificationSlotGroup(groupId, name);
+    if (group != nullptr) {
+        group->SetDescription(description);
+    }
+    return group;
+}
+
+bool ViewToInt(const std::string_view &str, int32_t &value)
+{
+    const int32_t decimal = 10;
+    if (str.empty()) {
+        return false;
+    }
+    value = 0;
+    for (char c : str) {
+        if ((c < '0') || (c > '9')) {
+            return false;
+        }
+        value = value * decimal + (c - '0');
+    }
+    return true;
+}
+}  // namespace
+
 const std::map<std::string,
-    std::function<void(NotificationPreferencesDatabase *, sptr<NotificationSlot> &, std::string &)>>
+    std::function<void(NotificationPreferencesDatabase *, sptr<NotificationSlot> &, std::string &)>, std::less<>>
     NotificationPreferencesDatabase::slotMap_ = {
         {
             KEY_SLOT_GROUPID,
@@ -88,7 +405,8 @@ const std::map<std::string,
 };
 
 const std::map<std::string,
-    std::function<void(NotificationPreferencesDatabase *, NotificationPreferencesInfo::BundleInfo &, std::string &)>>
+    std::function<void(NotificationPreferencesDatabase *, NotificationPreferencesInfo::BundleInfo &, std::string &)>,
+    std::less<>>
     NotificationPreferencesDatabase::bundleMap_ = {
         {
             KEY_BUNDLE_NAME,
@@ -288,9 +606,8 @@ bool NotificationPreferencesDatabase::PutShowBadge(
         return false;
     }
 
-    std::string bundleKey = GenerateBundleLablel(bundleInfo);
     DistributedKv::Status status =
-        PutBundlePropertyToDisturbeDB(bundleKey, BundleType::BUNDLE_SHOW_BADGE_TYPE, enable);
+        PutBundlePropertyToDisturbeDB(bundleInfo, BundleType::BUNDLE_SHOW_BADGE_TYPE, enable);
     return (status == DistributedKv::Status::SUCCESS);
 }
 
@@ -306,9 +623,8 @@ bool NotificationPreferencesDatabase::PutImportance(
         return false;
     }
 
-    std::string bundleKey = GenerateBundleLablel(bundleInfo);
     DistributedKv::Status status =
-        PutBundlePropertyToDisturbeDB(bundleKey, BundleType::BUNDLE_IMPORTANCE_TYPE, importance);
+        PutBundlePropertyToDisturbeDB(bundleInfo, BundleType::BUNDLE_IMPORTANCE_TYPE, importance);
     return (status == DistributedKv::Status::SUCCESS);
 }
 
@@ -323,9 +639,8 @@ bool NotificationPreferencesDatabase::PutTotalBadgeNums(
     if (!CheckBundle(bundleInfo.GetBundleName(), bundleInfo.GetBundleUid())) {
         return false;
     }
-    std::string bundleKey = GenerateBundleLablel(bundleInfo);
     DistributedKv::Status status =
-        PutBundlePropertyToDisturbeDB(bundleKey, BundleType::BUNDLE_BADGE_TOTAL_NUM_TYPE, totalBadgeNum);
+        PutBundlePropertyToDisturbeDB(bundleInfo, BundleType::BUNDLE_BADGE_TOTAL_NUM_TYPE, totalBadgeNum);
     return (status == DistributedKv::Status::SUCCESS);
 }
 
@@ -340,9 +655,8 @@ bool NotificationPreferencesDatabase::PutPrivateNotificationsAllowed(
     if (!CheckBundle(bundleInfo.GetBundleName(), bundleInfo.GetBundleUid())) {
         return false;
     }
-    std::string bundleKey = GenerateBundleLablel(bundleInfo);
     DistributedKv::Status status =
-        PutBundlePropertyToDisturbeDB(bundleKey, BundleType::BUNDLE_PRIVATE_ALLOWED_TYPE, allow);
+        PutBundlePropertyToDisturbeDB(bundleInfo, BundleType::BUNDLE_PRIVATE_ALLOWED_TYPE, allow);
 
     return (status == DistributedKv::Status::SUCCESS);
 }
@@ -359,9 +673,8 @@ bool NotificationPreferencesDatabase::PutNotificationsEnabledForBundle(
         return false;
     }
 
-    std::string bundleKey = GenerateBundleLablel(bundleInfo);
     DistributedKv::Status status =
-        PutBundlePropertyToDisturbeDB(bundleKey, BundleType::BUNDLE_ENABLE_NOTIFICATION_TYPE, enabled);
+        PutBundlePropertyToDisturbeDB(bundleInfo, BundleType::BUNDLE_ENABLE_NOTIFICATION_TYPE, enabled);
     return (status == DistributedKv::Status::SUCCESS);
 }
 
@@ -396,9 +709,8 @@ bool NotificationPreferencesDatabase::PutHasPoppedDialog(
         return false;
     }
 
-    std::string bundleKey = GenerateBundleLablel(bundleInfo);
     DistributedKv::Status status =
-        PutBundlePropertyToDisturbeDB(bundleKey, BundleType::BUNDLE_POPPED_DIALOG_TYPE, hasPopped);
+        PutBundlePropertyToDisturbeDB(bundleInfo, BundleType::BUNDLE_POPPED_DIALOG_TYPE, hasPopped);
     return (status == DistributedKv::Status::SUCCESS);
 }
 
@@ -516,31 +828,12 @@ bool NotificationPreferencesDatabase::CheckBundle(const std::string &bundleName,
 bool NotificationPreferencesDatabase::PutBundlePropertyValueToDisturbeDB(
     const NotificationPreferencesInfo::BundleInfo &bundleInfo)
 {
-    std::vector<DistributedKv::Entry> entries;
-    std::string bundleKey = bundleInfo.GetBundleName().append(std::to_string(bundleInfo.GetBundleUid()));
-    GenerateEntry(GenerateBundleKey(bundleKey, KEY_BUNDLE_NAME), bundleInfo.GetBundleName(), entries);
-    GenerateEntry(GenerateBundleKey(bundleKey, KEY_BUNDLE_BADGE_TOTAL_NUM),
-        std::to_string(bundleInfo.GetBadgeTotalNum()),
-        entries);
-    GenerateEntry(
-        GenerateBundleKey(bundleKey, KEY_BUNDLE_IMPORTANCE), std::to_string(bundleInfo.GetImportance()), entries);
-    GenerateEntry(
-        GenerateBundleKey(bundleKey, KEY_BUNDLE_SHOW_BADGE), std::to_string(bundleInfo.GetIsShowBadge()), entries);
-    GenerateEntry(GenerateBundleKey(bundleKey, KEY_BUNDLE_PRIVATE_ALLOWED),
-        std::to_string(bundleInfo.GetIsPrivateAllowed()),
-        entries);
-    GenerateEntry(GenerateBundleKey(bundleKey, KEY_BUNDLE_ENABLE_NOTIFICATION),
-        std::to_string(bundleInfo.GetEnableNotification()),
-        entries);
-    GenerateEntry(GenerateBundleKey(bundleKey, KEY_BUNDLE_POPPED_DIALOG),
-        std::to_string(bundleInfo.GetHasPoppedDialog()),
-        entries);
-    GenerateEntry(GenerateBundleKey(bundleKey, KEY_BUNDLE_UID), std::to_string(bundleInfo.GetBundleUid()), entries);
     if (!CheckKvStore()) {
         ANS_LOGE("KvStore is nullptr.");
         return false;
     }
-    DistributedKv::Status status = kvStorePtr_->PutBatch(entries);
+    DistributedKv::Key key(GenerateBundleKey(GenerateBundleLablel(bundleInfo), KEY_BUNDLE_RECORD));
+    DistributedKv::Status status = kvStorePtr_->Put(key, EncodeBundleRecord(bundleInfo));
     if (status != DistributedKv::Status::SUCCESS) {
         ANS_LOGE("Store bundle failed. %{public}d", status);
         return false;
@@ -561,13 +854,30 @@ bool NotificationPreferencesDatabase::ParseFromDisturbeDB(NotificationPreference
         return false;
     }
     DistributedKv::Status status;
-    std::vector<DistributedKv::Entry> entries;
-    status = kvStorePtr_->GetEntries(DistributedKv::Key(KEY_BUNDLE_LABEL), entries);
+    std::vector<DistributedKv::Entry> labelEntries;
+    status = kvStorePtr_->GetEntries(DistributedKv::Key(KEY_BUNDLE_LABEL), labelEntries);
+    if (status != DistributedKv::Status::SUCCESS) {
+        ANS_LOGE("Get Bundle Info failed.");
+        return false;
+    }
+    // All the bundles are read in one scan, instead of one scan per bundle.
+    std::vector<DistributedKv::Entry> bundleEntries;
+    status = kvStorePtr_->GetEntries(DistributedKv::Key(KEY_ANS_BUNDLE + KEY_UNDER_LINE), bundleEntries);
     if (status != DistributedKv::Status::SUCCESS) {
         ANS_LOGE("Get Bundle Info failed.");
         return false;
     }
-    ParseBundleFromDistureDB(info, entries);
+    std::vector<DistributedKv::Entry> recordEntries;
+    std::vector<DistributedKv::Key> legacyKeys;
+    ParseBundleFromDistureDB(info, labelEntries, bundleEntries, recordEntries, legacyKeys);
+    if (!legacyKeys.empty()) {
+        // Written before the legacy entries are deleted, the records win if both are loaded.
+        ANS_LOGI("Migrate %{public}zu entries to %{public}zu records.", legacyKeys.size(), recordEntries.size());
+        if ((kvStorePtr_->PutBatch(recordEntries) != DistributedKv::Status::SUCCESS) ||
+            (kvStorePtr_->DeleteBatch(legacyKeys) != DistributedKv::Status::SUCCESS)) {
+            ANS_LOGE("Migrate to records failed.");
+        }
+    }
     return true;
 }
 
@@ -641,6 +951,7 @@ bool NotificationPreferencesDatabase::RemoveSlotFromDisturbeDB(
     for (auto iter : slotentries) {
         keys.push_back(iter.key);
     }
+    keys.push_back(DistributedKv::Key(GenerateSlotRecordKey(bundleKey, slotType)));
 
     status = kvStorePtr_->DeleteBatch(keys);
     if (status != DistributedKv::Status::SUCCESS) {
@@ -671,6 +982,13 @@ bool NotificationPreferencesDatabase::RemoveAllSlotsFromDisturbeDB(const std::st
     if (status != DistributedKv::Status::SUCCESS) {
         return false;
     }
+    std::vector<DistributedKv::Entry> recordEntries;
+    status = kvStorePtr_->GetEntries(
+        DistributedKv::Key(GenerateBundleKey(bundleKey, KEY_SLOT_RECORD) + KEY_UNDER_LINE), recordEntries);
+    if (status != DistributedKv::Status::SUCCESS) {
+        return false;
+    }
+    slotsEntries.insert(slotsEntries.end(), recordEntries.begin(), recordEntries.end());
     std::vector<DistributedKv::Key> keys;
     for (auto iter : slotsEntries) {
         keys.push_back(iter.key);
@@ -731,6 +1049,7 @@ bool NotificationPreferencesDatabase::GetRemoveGroupKeysFromDisturbeDB(
     for (auto iter : groupentries) {
         keys.push_back(iter.key);
     }
+    keys.push_back(DistributedKv::Key(GenerateGroupRecordKey(bundleKey, groupId)));
 
     return true;
 }
@@ -746,38 +1065,46 @@ bool NotificationPreferencesDatabase::StoreDeathRecipient()
 
 template <typename T>
 DistributedKv::Status NotificationPreferencesDatabase::PutBundlePropertyToDisturbeDB(
-    const std::string &bundleKey, const BundleType &type, const T &t)
-{
-    std::string keyStr;
+    const NotificationPreferencesInfo::BundleInfo &bundleInfo, const BundleType &type, const T &t)
+{
+    // The properties of a bundle are stored in one record, rewritten with the new value.
+    NotificationPreferencesInfo::BundleInfo newInfo;
+    newInfo.SetBundleName(bundleInfo.GetBundleName());
+    newInfo.SetBundleUid(bundleInfo.GetBundleUid());
+    newInfo.SetImportance(bundleInfo.GetImportance());
+    newInfo.SetIsShowBadge(bundleInfo.GetIsShowBadge());
+    newInfo.SetBadgeTotalNum(bundleInfo.GetBadgeTotalNum());
+    newInfo.SetIsPrivateAllowed(bundleInfo.GetIsPrivateAllowed());
+    newInfo.SetEnableNotification(bundleInfo.GetEnableNotification());
+    newInfo.SetHasPoppedDialog(bundleInfo.GetHasPoppedDialog());
     switch (type) {
         case BundleType::BUNDLE_BADGE_TOTAL_NUM_TYPE:
-            keyStr = GenerateBundleKey(bundleKey, KEY_BUNDLE_BADGE_TOTAL_NUM);
+            newInfo.SetBadgeTotalNum(t);
             break;
         case BundleType::BUNDLE_IMPORTANCE_TYPE:
-            keyStr = GenerateBundleKey(bundleKey, KEY_BUNDLE_IMPORTANCE);
+            newInfo.SetImportance(t);
             break;
         case BundleType::BUNDLE_SHOW_BADGE_TYPE:
-            keyStr = GenerateBundleKey(bundleKey, KEY_BUNDLE_SHOW_BADGE);
+            newInfo.SetIsShowBadge(t);
             break;
         case BundleType::BUNDLE_PRIVATE_ALLOWED_TYPE:
-            keyStr = GenerateBundleKey(bundleKey, KEY_BUNDLE_PRIVATE_ALLOWED);
+            newInfo.SetIsPrivateAllowed(t);
             break;
         case BundleType::BUNDLE_ENABLE_NOTIFICATION_TYPE:
-            keyStr = GenerateBundleKey(bundleKey, KEY_BUNDLE_ENABLE_NOTIFICATION);
+            newInfo.SetEnableNotification(t);
             break;
         case BundleType::BUNDLE_POPPED_DIALOG_TYPE:
-            keyStr = GenerateBundleKey(bundleKey, KEY_BUNDLE_POPPED_DIALOG);
+            newInfo.SetHasPoppedDialog(t);
             break;
         default:
             break;
     }
-    DistributedKv::Key key(keyStr);
-    DistributedKv::Value value(std::to_string(t));
+    DistributedKv::Key key(GenerateBundleKey(GenerateBundleLablel(newInfo), KEY_BUNDLE_RECORD));
     if (!CheckKvStore()) {
         ANS_LOGE("KvStore is nullptr.");
         return DistributedKv::Status::ERROR;
     }
-    DistributedKv::Status status = kvStorePtr_->Put(key, value);
+    DistributedKv::Status status = kvStorePtr_->Put(key, EncodeBundleRecord(newInfo));
     return status;
 }
 
@@ -804,17 +1131,6 @@ bool NotificationPreferencesDatabase::PutBundleToDisturbeDB(
     return true;
 }
 
-void NotificationPreferencesDatabase::GenerateEntry(
-    const std::string &key, const std::string &value, std::vector<DistributedKv::Entry> &entries) const
-{
-    DistributedKv::Entry entry;
-    DistributedKv::Key dbKey(key);
-    DistributedKv::Value dbValue(value);
-    entry.key = dbKey;
-    entry.value = dbValue;
-    entries.push_back(entry);
-}
-
 bool NotificationPreferencesDatabase::SlotToEntry(const std::string &bundleName, const int32_t &bundleUid,
     const sptr<NotificationSlot> &slot, std::vector<DistributedKv::Entry> &entries)
 {
@@ -835,33 +1151,10 @@ bool NotificationPreferencesDatabase::SlotToEntry(const std::string &bundleName,
 void NotificationPreferencesDatabase::GenerateSlotEntry(const std::string &bundleKey,
     const sptr<NotificationSlot> &slot, std::vector<DistributedKv::Entry> &entries) const
 {
-    std::string slotType = std::to_string(slot->GetType());
-    GenerateEntry(GenerateSlotKey(bundleKey, slotType, KEY_SLOT_TYPE), std::to_string(slot->GetType()), entries);
-    GenerateEntry(GenerateSlotKey(bundleKey, slotType, KEY_SLOT_ID), slot->GetId(), entries);
-    GenerateEntry(GenerateSlotKey(bundleKey, slotType, KEY_SLOT_GROUPID), slot->GetSlotGroup(), entries);
-    GenerateEntry(GenerateSlotKey(bundleKey, slotType, KEY_SLOT_NAME), slot->GetName(), entries);
-    GenerateEntry(GenerateSlotKey(bundleKey, slotType, KEY_SLOT_DESCRIPTION), slot->GetDescription(), entries);
-    GenerateEntry(GenerateSlotKey(bundleKey, slotType, KEY_SLOT_LEVEL), std::to_string(slot->GetLevel()), entries);
-    GenerateEntry(
-        GenerateSlotKey(bundleKey, slotType, KEY_SLOT_SHOW_BADGE), std::to_string(slot->IsShowBadge()), entries);
-    GenerateEntry(
-        GenerateSlotKey(bundleKey, slotType, KEY_SLOT_ENABLE_LIGHT), std::to_string(slot->CanEnableLight()), entries);
-    GenerateEntry(
-        GenerateSlotKey(bundleKey, slotType, KEY_SLOT_ENABLE_VRBRATION), std::to_string(slot->CanVibrate()), entries);
-    GenerateEntry(GenerateSlotKey(bundleKey, slotType, KEY_SLOT_LED_LIGHT_COLOR),
-        std::to_string(slot->GetLedLightColor()),
-        entries);
-    GenerateEntry(GenerateSlotKey(bundleKey, slotType, KEY_SLOT_LOCKSCREEN_VISIBLENESS),
-        std::to_string(static_cast<int>(slot->GetLockScreenVisibleness())),
-        entries);
-    GenerateEntry(GenerateSlotKey(bundleKey, slotType, KEY_SLOT_SOUND), slot->GetSound().ToString(), entries);
-    GenerateEntry(GenerateSlotKey(bundleKey, slotType, KEY_SLOT_ENABLE_BYPASS_DND),
-        std::to_string(slot->IsEnableBypassDnd()),
-        entries);
-    GenerateEntry(GenerateSlotKey(bundleKey, slotType, KEY_SLOT_VIBRATION_STYLE),
-        VectorToString(slot->GetVibrationStyle()),
-        entries);
-    GenerateEntry(GenerateSlotKey(bundleKey, slotType, KEY_SLOT_ENABLED), std::to_string(slot->GetEnable()), entries);
+    DistributedKv::Entry entry;
+    entry.key = DistributedKv::Key(GenerateSlotRecordKey(bundleKey, std::to_string(slot->GetType())));
+    entry.value = EncodeSlotRecord(slot);
+    entries.push_back(entry);
 }
 
 bool NotificationPreferencesDatabase::GroupToEntry(const std::string &bundleName, const int32_t &bundleUid,
@@ -885,136 +1178,193 @@ bool NotificationPreferencesDatabase::GroupToEntry(const std::string &bundleName
 void NotificationPreferencesDatabase::GenerateGroupEntry(const std::string &bundleKey,
     const sptr<NotificationSlotGroup> &group, std::vector<DistributedKv::Entry> &entries) const
 {
-    std::string groupLebal = group->GetId().append(KEY_UNDER_LINE);
-    GenerateEntry(GenerateGroupKey(bundleKey, groupLebal + KEY_GROUP_ID), group->GetId(), entries);
-    GenerateEntry(GenerateGroupKey(bundleKey, groupLebal + KEY_GROUP_NAME), group->GetName(), entries);
-    GenerateEntry(GenerateGroupKey(bundleKey, groupLebal + KEY_GROUP_DESCRIPTION), group->GetDescription(), entries);
-    GenerateEntry(
-        GenerateGroupKey(bundleKey, groupLebal + KEY_GROUP_DISABLE), std::to_string(group->IsDisabled()), entries);
+    DistributedKv::Entry entry;
+    entry.key = DistributedKv::Key(GenerateGroupRecordKey(bundleKey, group->GetId()));
+    entry.value = EncodeGroupRecord(group);
+    entries.push_back(entry);
 }
 
-void NotificationPreferencesDatabase::ParseBundleFromDistureDB(
-    NotificationPreferencesInfo &info, const std::vector<DistributedKv::Entry> &entries)
+void NotificationPreferencesDatabase::ParseBundleFromDistureDB(NotificationPreferencesInfo &info,
+    const std::vector<DistributedKv::Entry> &labelEntries, const std::vector<DistributedKv::Entry> &bundleEntries,
+    std::vector<DistributedKv::Entry> &recordEntries, std::vector<DistributedKv::Key> &legacyKeys)
 {
-    if (!CheckKvStore()) {
-        ANS_LOGE("KvStore is nullptr.");
-        return;
+    std::map<std::string, LoadingBundle, std::less<>> bundles;
+    for (auto &item : labelEntries) {
+        bundles.emplace(item.value.ToString(), LoadingBundle());
     }
-    for (auto item : entries) {
-        std::string bundleKey = item.value.ToString();
-        ANS_LOGD("Bundle name is %{public}s.", bundleKey.c_str());
-        std::vector<DistributedKv::Entry> bundleEntries;
-        kvStorePtr_->GetEntries(DistributedKv::Key(GenerateBundleKey(bundleKey)), bundleEntries);
-        ANS_LOGD("Bundle key is %{public}s.", GenerateBundleKey(bundleKey).c_str());
-        NotificationPreferencesInfo::BundleInfo bunldeInfo;
-        for (auto bundleEntry : bundleEntries) {
-            if (IsSlotKey(GenerateBundleKey(bundleKey), bundleEntry.key.ToString())) {
-                ParseSlotFromDisturbeDB(bunldeInfo, bundleKey, bundleEntry);
-            } else if (IsGroupKey(GenerateBundleKey(bundleKey), bundleEntry.key.ToString())) {
-                ParseGroupFromDisturbeDB(bunldeInfo, bundleKey, bundleEntry);
-            } else {
-                ParseBundlePropertyFromDisturbeDB(bunldeInfo, bundleKey, bundleEntry);
+
+    const std::string bundlePrefix = KEY_ANS_BUNDLE + KEY_UNDER_LINE;
+    for (auto &entry : bundleEntries) {
+        std::string_view key = ToStringView(entry.key);
+        if (key.compare(0, bundlePrefix.size(), bundlePrefix) != 0) {
+            continue;
+        }
+        key.remove_prefix(bundlePrefix.size());
+        // The key is "<bundleKey>_<rest>" and the bundle key may contain the separator, take the longest match.
+        auto bundleIter = bundles.end();
+        std::string_view rest;
+        for (size_t pos = key.find(KEY_UNDER_LINE[0]); pos != std::string_view::npos;
+            pos = key.find(KEY_UNDER_LINE[0], pos + 1)) {
+            auto iter = bundles.find(key.substr(0, pos));
+            if (iter != bundles.end()) {
+                bundleIter = iter;
+                rest = key.substr(pos + 1);
             }
         }
-
-        info.SetBundleInfo(bunldeInfo);
+        if (bundleIter == bundles.end()) {
+            ANS_LOGW("Bundle of the key is not found.");
+            continue;
+        }
+        if (!ParseRecordEntry(bundleIter->second, rest, entry.value)) {
+            bundleIter->second.legacyEntries.emplace_back(rest, &entry);
+        }
     }
-}
 
-void NotificationPreferencesDatabase::ParseSlotFromDisturbeDB(NotificationPreferencesInfo::BundleInfo &bundleInfo,
-    const std::string &bundleKey, const DistributedKv::Entry &entry)
-{
-    std::string slotKey = entry.key.ToString();
-    std::string typeStr = SubUniqueIdentifyFromString(GenerateSlotKey(bundleKey) + KEY_UNDER_LINE, slotKey);
-    NotificationConstant::SlotType slotType = static_cast<NotificationConstant::SlotType>(StringToInt(typeStr));
-    sptr<NotificationSlot> slot = nullptr;
-    if (!bundleInfo.GetSlot(slotType, slot)) {
-        slot = new NotificationSlot(slotType);
+    for (auto &item : bundles) {
+        LoadingBundle &bundle = item.second;
+        if (!bundle.legacyEntries.empty()) {
+            // Entries of the layout with one entry per property, the records they are migrated to win.
+            for (auto &legacyEntry : bundle.legacyEntries) {
+                ParseLegacyEntry(bundle, legacyEntry.first, legacyEntry.second->value);
+                legacyKeys.push_back(legacyEntry.second->key);
+            }
+            ApplyLegacyEntries(bundle);
+            GenerateRecordEntries(item.first, bundle.bundleInfo, recordEntries);
+        }
+        info.SetBundleInfo(std::move(bundle.bundleInfo));
     }
-    std::string findString = GenerateSlotKey(bundleKey, typeStr) + KEY_UNDER_LINE;
-    ParseSlot(findString, slot, entry);
-    bundleInfo.SetSlot(slot);
 }
 
-void NotificationPreferencesDatabase::ParseGroupFromDisturbeDB(NotificationPreferencesInfo::BundleInfo &bundleInfo,
-    const std::string &bundleKey, const DistributedKv::Entry &entry)
+bool NotificationPreferencesDatabase::ParseRecordEntry(
+    LoadingBundle &bundle, const std::string_view &key, const DistributedKv::Value &value)
 {
-    if (!CheckKvStore()) {
-        ANS_LOGE("KvStore is nullptr.");
-        return;
-    }
-    std::string groupKey = entry.key.ToString();
-    std::string groupId = SubUniqueIdentifyFromString(GenerateGroupKey(bundleKey) + KEY_UNDER_LINE, groupKey);
-    sptr<NotificationSlotGroup> group;
-    if (!bundleInfo.GetGroup(groupId, group)) {
-        std::string groupName;
-        std::string groupNameKey = GenerateGroupKey(bundleKey, groupId + KEY_UNDER_LINE + KEY_GROUP_NAME);
-        GetValueFromDisturbeDB(
-            groupNameKey, [&groupName](DistributedKv::Value &value) { groupName = value.ToString(); });
-        if (groupName.empty()) {
-            ANS_LOGE("Group name does not exsited.");
-            return;
+    std::string_view slotKey = key;
+    std::string_view groupKey = key;
+    if (key == KEY_BUNDLE_RECORD) {
+        if (!DecodeBundleRecord(value, bundle.bundleInfo)) {
+            ANS_LOGW("Invalid bundle record.");
+            return true;
+        }
+        bundle.hasBundleRecord = true;
+    } else if (ConsumeToken(slotKey, KEY_SLOT_RECORD)) {
+        int32_t type = 0;
+        if (!ViewToInt(slotKey, type)) {
+            ANS_LOGW("Invalid slot record key.");
+            return true;
+        }
+        NotificationConstant::SlotType slotType = static_cast<NotificationConstant::SlotType>(type);
+        sptr<NotificationSlot> slot = new NotificationSlot(slotType);
+        if (!DecodeSlotRecord(value, slot)) {
+            ANS_LOGW("Invalid slot record.");
+            return true;
         }
-        group = new NotificationSlotGroup(groupId, groupName);
+        bundle.bundleInfo.SetSlot(slot);
+        bundle.slotRecords.insert(slotType);
+    } else if (ConsumeToken(groupKey, KEY_GROUP_RECORD)) {
+        std::string groupId(groupKey);
+        sptr<NotificationSlotGroup> group = DecodeGroupRecord(groupId, value);
+        if (group == nullptr) {
+            ANS_LOGW("Invalid group record.");
+            return true;
+        }
+        bundle.bundleInfo.SetGroup(group);
+        bundle.groupRecords.insert(groupId);
+    } else {
+        return false;
     }
-
-    ParseGroupDescription(bundleKey, group, entry);
-    bundleInfo.SetGroup(group);
+    return true;
 }
 
-void NotificationPreferencesDatabase::ParseBundlePropertyFromDisturbeDB(
-    NotificationPreferencesInfo::BundleInfo &bundleInfo, const std::string &bundleKey,
-    const DistributedKv::Entry &entry)
+void NotificationPreferencesDatabase::ParseLegacyEntry(
+    LoadingBundle &bundle, const std::string_view &key, const DistributedKv::Value &value)
 {
-    std::string typeStr = FindLastString(GenerateBundleKey(bundleKey), entry.key.ToString());
-    std::string valueStr = entry.value.ToString();
-    ANS_LOGD("DB key = %{public}s , type str %{public}s", entry.key.ToString().c_str(), typeStr.c_str());
-
-    auto iter = bundleMap_.find(typeStr);
-    if (iter != bundleMap_.end()) {
-        auto func = iter->second;
-        func(this, bundleInfo, valueStr);
+    std::string_view slotKey = key;
+    std::string_view groupKey = key;
+    std::string_view id;
+    std::string_view property;
+    if (ConsumeToken(slotKey, KEY_SLOT) && ConsumeToken(slotKey, KEY_SLOT_TYPE)) {
+        int32_t type = 0;
+        if (!SplitLastToken(slotKey, id, property) || !ViewToInt(id, type)) {
+            ANS_LOGW("Invalid slot key.");
+            return;
+        }
+        NotificationConstant::SlotType slotType = static_cast<NotificationConstant::SlotType>(type);
+        if (bundle.slotRecords.count(slotType) != 0) {
+            return;
+        }
+        sptr<NotificationSlot> slot = nullptr;
+        if (!bundle.bundleInfo.GetSlot(slotType, slot)) {
+            slot = new NotificationSlot(slotType);
+            bundle.bundleInfo.SetSlot(slot);
+        }
+        std::string valueStr = value.ToString();
+        if (property == KEY_SLOT_ENABLE_VRBRATION) {
+            bundle.enableVibrations[slotType] = valueStr;
+        }
+        auto iter = slotMap_.find(property);
+        if (iter != slotMap_.end()) {
+            iter->second(this, slot, valueStr);
+        }
+    } else if (ConsumeToken(groupKey, KEY_GROUP) && ConsumeToken(groupKey, KEY_GROUP_ID)) {
+        if (!SplitLastToken(groupKey, id, property)) {
+            ANS_LOGW("Invalid group key.");
+            return;
+        }
+        std::string groupId(id);
+        if (bundle.groupRecords.count(groupId) != 0) {
+            return;
+        }
+        if (property == KEY_GROUP_NAME) {
+            bundle.groups[groupId].first = value.ToString();
+        } else if (property == KEY_GROUP_DESCRIPTION) {
+            bundle.groups[groupId].second = value.ToString();
+        }
+    } else if (!bundle.hasBundleRecord) {
+        auto iter = bundleMap_.find(key);
+        if (iter != bundleMap_.end()) {
+            std::string valueStr = value.ToString();
+            iter->second(this, bundle.bundleInfo, valueStr);
+        }
     }
 }
 
-void NotificationPreferencesDatabase::ParseSlot(
-    const std::string &findString, sptr<NotificationSlot> &slot, const DistributedKv::Entry &entry)
+void NotificationPreferencesDatabase::ApplyLegacyEntries(LoadingBundle &bundle)
 {
-    std::string typeStr = FindLastString(findString, entry.key.ToString());
-    std::string valueStr = entry.value.ToString();
-    ANS_LOGD("db key = %{public}s , %{public}s : %{public}s ",
-        entry.key.ToString().c_str(),
-        typeStr.c_str(),
-        entry.value.ToString().c_str());
-
-    auto iter = slotMap_.find(typeStr);
-    if (iter != slotMap_.end()) {
-        auto func = iter->second;
-        func(this, slot, valueStr);
+    // The vibration style sets whether to vibrate, so the stored value is applied after it.
+    for (auto &enableVibration : bundle.enableVibrations) {
+        sptr<NotificationSlot> slot;
+        if (bundle.bundleInfo.GetSlot(enableVibration.first, slot)) {
+            ParseSlotEnableVrbration(slot, enableVibration.second);
+        }
     }
-
-    if (!typeStr.compare(KEY_SLOT_VIBRATION_STYLE)) {
-        GetValueFromDisturbeDB(findString + KEY_SLOT_ENABLE_VRBRATION,
-            [&](DistributedKv::Value &value) { ParseSlotEnableVrbration(slot, value.ToString()); });
+    for (auto &group : bundle.groups) {
+        if (group.second.first.empty()) {
+            ANS_LOGE("Group name does not exsited.");
+            continue;
+        }
+        sptr<NotificationSlotGroup> slotGroup = new NotificationSlotGroup(group.first, group.second.first);
+        slotGroup->SetDescription(group.second.second);
+        bundle.bundleInfo.SetGroup(slotGroup);
     }
 }
 
-std::string NotificationPreferencesDatabase::FindLastString(
-    const std::string &findString, const std::string &inputString) const
+void NotificationPreferencesDatabase::GenerateRecordEntries(const std::string &bundleKey,
+    NotificationPreferencesInfo::BundleInfo &bundleInfo, std::vector<DistributedKv::Entry> &entries) const
 {
-    std::string keyStr;
-    size_t pos = findString.size();
-    if (pos != std::string::npos) {
-        keyStr = inputString.substr(pos);
+    DistributedKv::Entry entry;
+    entry.key = DistributedKv::Key(GenerateBundleKey(bundleKey, KEY_BUNDLE_RECORD));
+    entry.value = EncodeBundleRecord(bundleInfo);
+    entries.push_back(entry);
+    std::vector<sptr<NotificationSlot>> slots;
+    bundleInfo.GetAllSlots(slots);
+    for (auto &slot : slots) {
+        GenerateSlotEntry(bundleKey, slot, entries);
+    }
+    std::vector<sptr<NotificationSlotGroup>> groups;
+    bundleInfo.GetAllGroups(groups);
+    for (auto &group : groups) {
+        GenerateGroupEntry(bundleKey, group, entries);
     }
-    return keyStr;
-}
-
-std::string NotificationPreferencesDatabase::VectorToString(const std::vector<int64_t> &data) const
-{
-    std::stringstream streamStr;
-    std::copy(data.begin(), data.end(), std::ostream_iterator<int>(streamStr, KEY_UNDER_LINE.c_str()));
-    return streamStr.str();
 }
 
 void NotificationPreferencesDatabase::StringToVector(const std::string &str, std::vector<int64_t> &data) const
@@ -1049,34 +1399,6 @@ int64_t NotificationPreferencesDatabase::StringToInt64(const std::string &str) c
     return value;
 }
 
-bool NotificationPreferencesDatabase::IsSlotKey(const std::string &bundleKey, const std::string &key) const
-{
-    std::string tempStr = FindLastString(bundleKey, key);
-    size_t pos = tempStr.find_first_of(KEY_UNDER_LINE);
-    std::string slotStr;
-    if (pos != std::string::npos) {
-        slotStr = tempStr.substr(0, pos);
-    }
-    if (!slotStr.compare(KEY_SLOT)) {
-        return true;
-    }
-    return false;
-}
-
-bool NotificationPreferencesDatabase::IsGroupKey(const std::string &bundleKey, const std::string &key) const
-{
-    std::string tempStr = FindLastString(bundleKey, key);
-    size_t pos = tempStr.find_first_of(KEY_UNDER_LINE);
-    std::string slotStr;
-    if (pos != std::string::npos) {
-        slotStr = tempStr.substr(0, pos);
-    }
-    if (!slotStr.compare(KEY_GROUP)) {
-        return true;
-    }
-    return false;
-}
-
 std::string NotificationPreferencesDatabase::GenerateSlotKey(
     const std::string &bundleKey, const std::string &type, const std::string &subType) const
 {
@@ -1138,17 +1460,26 @@ std::string NotificationPreferencesDatabase::GenerateBundleKey(
     return key;
 }
 
-std::string NotificationPreferencesDatabase::SubUniqueIdentifyFromString(
-    const std::string &findString, const std::string &keyStr) const
+std::string NotificationPreferencesDatabase::GenerateSlotRecordKey(
+    const std::string &bundleKey, const std::string &type) const
 {
-    std::string slotType;
-    std::string tempStr = FindLastString(findString, keyStr);
-    size_t pos = tempStr.find_last_of(KEY_UNDER_LINE);
-    if (pos != std::string::npos) {
-        slotType = tempStr.substr(0, pos);
-    }
+    /* slot record key
+     *
+     * ans_bundle_bundlekey_slotRecord_0
+     *
+     */
+    return GenerateBundleKey(bundleKey).append(KEY_SLOT_RECORD).append(KEY_UNDER_LINE).append(type);
+}
 
-    return slotType;
+std::string NotificationPreferencesDatabase::GenerateGroupRecordKey(
+    const std::string &bundleKey, const std::string &groupId) const
+{
+    /* group record key
+     *
+     * ans_bundle_bundlekey_groupRecord_id0
+     *
+     */
+    return GenerateBundleKey(bundleKey).append(KEY_GROUP_RECORD).append(KEY_UNDER_LINE).append(groupId);
 }
 
 void NotificationPreferencesDatabase::ParseDoNotDisturbType(NotificationPreferencesInfo &info)
@@ -1191,18 +1522,6 @@ void NotificationPreferencesDatabase::ParseEnableAllNotification(NotificationPre
     }
 }
 
-void NotificationPreferencesDatabase::ParseGroupDescription(
-    const std::string &bundleKey, sptr<NotificationSlotGroup> &group, const DistributedKv::Entry &entry)
-{
-    std::string findStr = GenerateGroupKey(bundleKey, group->GetId()) + KEY_UNDER_LINE;
-    std::string typeStr = FindLastString(findStr, entry.key.ToString());
-    std::string valueStr = entry.value.ToString();
-    if (!typeStr.compare(KEY_GROUP_DESCRIPTION)) {
-        ANS_LOGD("SetGroupDescription is %{public}s.", valueStr.c_str());
-        group->SetDescription(valueStr);
-    }
-}
-
 void NotificationPreferencesDatabase::ParseBundleName(
     NotificationPreferencesInfo::BundleInfo &bundleInfo, const std::string &value) const
 {
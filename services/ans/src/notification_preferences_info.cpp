@@ -161,7 +161,11 @@ bool NotificationPreferencesInfo::BundleInfo::GetGroup(const std::string &groupI
 {
     auto iter = groups_.find(groupId);
     if (iter != groups_.end()) {
-        group = iter->second;
+        // The stored group is shared with the readers of other threads, the slots are set on a copy.
+        group = new (std::nothrow) NotificationSlotGroup(*iter->second);
+        if (group == nullptr) {
+            return false;
+        }
         std::vector<NotificationSlot> slots;
         GetAllSlotsInGroup(groupId, slots);
         group->SetSlots(slots);
@@ -174,10 +178,14 @@ bool NotificationPreferencesInfo::BundleInfo::GetAllGroups(std::vector<sptr<Noti
 {
     std::for_each(
         groups_.begin(), groups_.end(), [&](std::map<std::string, sptr<NotificationSlotGroup>>::reference iter) {
+            sptr<NotificationSlotGroup> slotGroup = new (std::nothrow) NotificationSlotGroup(*iter.second);
+            if (slotGroup == nullptr) {
+                return;
+            }
             std::vector<NotificationSlot> slots;
             GetAllSlotsInGroup(iter.second->GetId(), slots);
-            iter.second->SetSlots(slots);
-            group.emplace_back(iter.second);
+            slotGroup->SetSlots(slots);
+            group.emplace_back(slotGroup);
         });
     return true;
 }
@@ -243,6 +251,12 @@ void NotificationPreferencesInfo::SetBundleInfo(const BundleInfo &info)
     infos_.insert_or_assign(bundleKey, info);
 }
 
+void NotificationPreferencesInfo::SetBundleInfo(BundleInfo &&info)
+{
+    std::string bundleKey = info.GetBundleName().append(std::to_string(info.GetBundleUid()));
+    infos_.insert_or_assign(bundleKey, std::move(info));
+}
+
 bool NotificationPreferencesInfo::GetBundleInfo(
     const sptr<NotificationBundleOption> &bundleOption, BundleInfo &info) const
 {
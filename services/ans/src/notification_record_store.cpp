@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "notification_record_store.h"
+
+namespace OHOS {
+namespace Notification {
+namespace {
+constexpr char INDEX_KEY_SPLITER = '|';
+}  // namespace
+
+bool NotificationRecordStore::Add(const RecordPtr &record)
+{
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+    if (record == nullptr || record->notification == nullptr || record->request == nullptr) {
+        return false;
+    }
+
+    std::string key = record->notification->GetKey();
+    if (entries_.find(key) != entries_.end()) {
+        return false;
+    }
+
+    Entry entry;
+    entry.orderKey.createTime = record->request->GetCreateTime();
+    entry.orderKey.sequence = ++lastSequence_;
+    entry.indexKeys = GenerateIndexKeys(record);
+    records_.emplace(entry.orderKey, record);
+    AddToIndexes(entry.orderKey, record, entry.indexKeys);
+    entries_.emplace(key, std::move(entry));
+    version_++;
+    return true;
+}
+
+bool NotificationRecordStore::Update(const RecordPtr &record)
+{
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+    if (record == nullptr || record->notification == nullptr || record->request == nullptr) {
+        return false;
+    }
+
+    auto entryIter = entries_.find(record->notification->GetKey());
+    if (entryIter == entries_.end()) {
+        return false;
+    }
+
+    Entry &entry = entryIter->second;
+    RemoveFromIndexes(entry.orderKey, entry.indexKeys);
+    records_.erase(entry.orderKey);
+
+    // Among the records of the new create time, the record goes where a stable sort of the list would put it.
+    int64_t createTime = record->request->GetCreateTime();
+    if (createTime > entry.orderKey.createTime) {
+        entry.orderKey.sequence = --firstSequence_;
+    } else if (createTime < entry.orderKey.createTime) {
+        entry.orderKey.sequence = ++lastSequence_;
+    }
+    entry.orderKey.createTime = createTime;
+    entry.indexKeys = GenerateIndexKeys(record);
+    records_.emplace(entry.orderKey, record);
+    AddToIndexes(entry.orderKey, record, entry.indexKeys);
+    version_++;
+    return true;
+}
+
+bool NotificationRecordStore::Remove(const RecordPtr &record)
+{
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+    if (record == nullptr || record->notification == nullptr) {
+        return false;
+    }
+
+    auto entryIter = entries_.find(record->notification->GetKey());
+    if (entryIter == entries_.end()) {
+        return false;
+    }
+    auto recordIter = records_.find(entryIter->second.orderKey);
+    if (recordIter == records_.end() || recordIter->second != record) {
+        return false;
+    }
+
+    RemoveFromIndexes(entryIter->second.orderKey, entryIter->second.indexKeys);
+    records_.erase(recordIter);
+    entries_.erase(entryIter);
+    version_++;
+    return true;
+}
+
+NotificationRecordStore::RecordPtr NotificationRecordStore::GetEvictionCandidate() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return evictionIndex_.empty() ? nullptr : evictionIndex_.begin()->second;
+}
+
+NotificationRecordStore::RecordPtr NotificationRecordStore::GetEvictionCandidate(const std::string &bundleName) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto iter = bundleEvictionIndex_.find(bundleName);
+    if (iter == bundleEvictionIndex_.end() || iter->second.empty()) {
+        return nullptr;
+    }
+    return iter->second.begin()->second;
+}
+
+NotificationRecordStore::RecordPtr NotificationRecordStore::Find(const std::string &key) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto entryIter = entries_.find(key);
+    if (entryIter == entries_.end()) {
+        return nullptr;
+    }
+    auto recordIter = records_.find(entryIter->second.orderKey);
+    return (recordIter == records_.end()) ? nullptr : recordIter->second;
+}
+
+bool NotificationRecordStore::Exists(const std::string &key) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return entries_.find(key) != entries_.end();
+}
+
+NotificationRecordStore::RecordPtr NotificationRecordStore::FindById(const std::string &bundleName, int32_t uid,
+    const std::string &label, int32_t notificationId, const std::string &deviceId) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const RecordMap *records = FindInIndex(idIndex_, GenerateIdKey(bundleName, uid, label, notificationId, deviceId));
+    if (records == nullptr || records->empty()) {
+        return nullptr;
+    }
+
+    // Agent notifications of different creators may share the same owner bundle, label and id.
+    return records->begin()->second;
+}
+
+std::vector<NotificationRecordStore::RecordPtr> NotificationRecordStore::GetByBundle(
+    const std::string &bundleName, int32_t uid) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return Collect({FindInIndex(bundleIndex_, GenerateBundleKey(bundleName, uid))});
+}
+
+std::vector<NotificationRecordStore::RecordPtr> NotificationRecordStore::GetByBundleNameOrUid(
+    const std::string &bundleName, int32_t uid, bool includeRemote) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<const RecordMap *> maps = {FindInIndex(bundleNameIndex_, bundleName), FindInIndex(uidIndex_, uid)};
+    if (includeRemote) {
+        for (auto &device : deviceIndex_) {
+            maps.push_back(&device.second);
+        }
+    }
+    return Collect(maps);
+}
+
+std::vector<NotificationRecordStore::RecordPtr> NotificationRecordStore::GetByUser(int32_t userId) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return Collect({FindInIndex(userIndex_, userId)});
+}
+
+std::vector<NotificationRecordStore::RecordPtr> NotificationRecordStore::GetByGroup(
+    const std::string &bundleName, int32_t uid, const std::string &groupName) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (groupName.empty()) {
+        return {};
+    }
+    std::string groupKey = GenerateBundleKey(bundleName, uid) + INDEX_KEY_SPLITER + groupName;
+    return Collect({FindInIndex(groupIndex_, groupKey)});
+}
+
+size_t NotificationRecordStore::GetCountByBundleName(const std::string &bundleName) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const RecordMap *records = FindInIndex(bundleNameIndex_, bundleName);
+    return (records == nullptr) ? 0 : records->size();
+}
+
+std::vector<NotificationRecordStore::RecordPtr> NotificationRecordStore::GetByBundleName(
+    const std::string &bundleName) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return Collect({FindInIndex(bundleNameIndex_, bundleName)});
+}
+
+size_t NotificationRecordStore::GetCountByOwnerBundleName(const std::string &bundleName) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto iter = bundleEvictionIndex_.find(bundleName);
+    return (iter == bundleEvictionIndex_.end()) ? 0 : iter->second.size();
+}
+
+uint64_t NotificationRecordStore::GetVersion() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return version_;
+}
+
+size_t NotificationRecordStore::Size() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return records_.size();
+}
+
+bool NotificationRecordStore::Empty() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return records_.empty();
+}
+
+void NotificationRecordStore::Clear()
+{
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+    records_.clear();
+    entries_.clear();
+    bundleIndex_.clear();
+    bundleNameIndex_.clear();
+    uidIndex_.clear();
+    userIndex_.clear();
+    groupIndex_.clear();
+    idIndex_.clear();
+    deviceIndex_.clear();
+    evictionIndex_.clear();
+    bundleEvictionIndex_.clear();
+    version_++;
+}
+
+std::vector<NotificationRecordStore::RecordPtr> NotificationRecordStore::GetAll() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<RecordPtr> records;
+    records.reserve(records_.size());
+    for (auto &record : records_) {
+        records.push_back(record.second);
+    }
+    return records;
+}
+
+size_t NotificationRecordStore::GetCountByBundle(const std::string &bundleName, int32_t uid) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const RecordMap *records = FindInIndex(bundleIndex_, GenerateBundleKey(bundleName, uid));
+    return (records == nullptr) ? 0 : records->size();
+}
+
+NotificationRecordStore::ConstIterator NotificationRecordStore::begin() const
+{
+    return ConstIterator(records_.cbegin());
+}
+
+NotificationRecordStore::ConstIterator NotificationRecordStore::end() const
+{
+    return ConstIterator(records_.cend());
+}
+
+NotificationRecordStore::IndexKeys NotificationRecordStore::GenerateIndexKeys(const RecordPtr &record)
+{
+    IndexKeys indexKeys;
+#ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
+    indexKeys.deviceId = record->deviceId;
+#endif
+    if (record->bundleOption != nullptr) {
+        indexKeys.bundleName = record->bundleOption->GetBundleName();
+        indexKeys.uid = record->bundleOption->GetUid();
+    }
+    indexKeys.bundleKey = GenerateBundleKey(indexKeys.bundleName, indexKeys.uid);
+    indexKeys.ownerBundleName = record->notification->GetBundleName();
+    indexKeys.userId = record->notification->GetUserId();
+    if (record->slot != nullptr) {
+        indexKeys.level = static_cast<int32_t>(record->slot->GetLevel());
+    }
+    indexKeys.idKey = GenerateIdKey(indexKeys.bundleName, indexKeys.uid, record->notification->GetLabel(),
+        record->notification->GetId(), indexKeys.deviceId);
+    if ((record->request != nullptr) && !record->request->GetGroupName().empty()) {
+        indexKeys.groupKey = indexKeys.bundleKey + INDEX_KEY_SPLITER + record->request->GetGroupName();
+    }
+    return indexKeys;
+}
+
+std::string NotificationRecordStore::GenerateBundleKey(const std::string &bundleName, int32_t uid)
+{
+    return bundleName + INDEX_KEY_SPLITER + std::to_string(uid);
+}
+
+std::string NotificationRecordStore::GenerateIdKey(const std::string &bundleName, int32_t uid,
+    const std::string &label, int32_t notificationId, const std::string &deviceId)
+{
+    return deviceId + INDEX_KEY_SPLITER + GenerateBundleKey(bundleName, uid) + INDEX_KEY_SPLITER + label +
+        INDEX_KEY_SPLITER + std::to_string(notificationId);
+}
+
+void NotificationRecordStore::AddToIndexes(
+    const OrderKey &orderKey, const RecordPtr &record, const IndexKeys &indexKeys)
+{
+    AddToIndex(bundleIndex_, indexKeys.bundleKey, orderKey, record);
+    AddToIndex(bundleNameIndex_, indexKeys.bundleName, orderKey, record);
+    AddToIndex(uidIndex_, indexKeys.uid, orderKey, record);
+    AddToIndex(userIndex_, indexKeys.userId, orderKey, record);
+    AddToIndex(idIndex_, indexKeys.idKey, orderKey, record);
+    if (!indexKeys.groupKey.empty()) {
+        AddToIndex(groupIndex_, indexKeys.groupKey, orderKey, record);
+    }
+    if (!indexKeys.deviceId.empty()) {
+        AddToIndex(deviceIndex_, indexKeys.deviceId, orderKey, record);
+    }
+    EvictionKey evictionKey {indexKeys.level, orderKey};
+    evictionIndex_.emplace(evictionKey, record);
+    bundleEvictionIndex_[indexKeys.ownerBundleName].emplace(evictionKey, record);
+}
+
+void NotificationRecordStore::RemoveFromIndexes(const OrderKey &orderKey, const IndexKeys &indexKeys)
+{
+    RemoveFromIndex(bundleIndex_, indexKeys.bundleKey, orderKey);
+    RemoveFromIndex(bundleNameIndex_, indexKeys.bundleName, orderKey);
+    RemoveFromIndex(uidIndex_, indexKeys.uid, orderKey);
+    RemoveFromIndex(userIndex_, indexKeys.userId, orderKey);
+    RemoveFromIndex(idIndex_, indexKeys.idKey, orderKey);
+    if (!indexKeys.groupKey.empty()) {
+        RemoveFromIndex(groupIndex_, indexKeys.groupKey, orderKey);
+    }
+    if (!indexKeys.deviceId.empty()) {
+        RemoveFromIndex(deviceIndex_, indexKeys.deviceId, orderKey);
+    }
+    EvictionKey evictionKey {indexKeys.level, orderKey};
+    evictionIndex_.erase(evictionKey);
+    auto iter = bundleEvictionIndex_.find(indexKeys.ownerBundleName);
+    if (iter != bundleEvictionIndex_.end()) {
+        iter->second.erase(evictionKey);
+        if (iter->second.empty()) {
+            bundleEvictionIndex_.erase(iter);
+        }
+    }
+}
+
+std::vector<NotificationRecordStore::RecordPtr> NotificationRecordStore::Collect(
+    const std::vector<const RecordMap *> &maps)
+{
+    std::vector<RecordPtr> result;
+    if (maps.size() == 1) {
+        if (maps.front() != nullptr) {
+            result.reserve(maps.front()->size());
+            for (auto &record : *maps.front()) {
+                result.push_back(record.second);
+            }
+        }
+        return result;
+    }
+
+    RecordMap merged;
+    for (auto map : maps) {
+        if (map != nullptr) {
+            merged.insert(map->begin(), map->end());
+        }
+    }
+    result.reserve(merged.size());
+    for (auto &record : merged) {
+        result.push_back(record.second);
+    }
+    return result;
+}
+
+template<typename K>
+void NotificationRecordStore::AddToIndex(
+    Index<K> &index, const K &key, const OrderKey &orderKey, const RecordPtr &record)
+{
+    index[key].emplace(orderKey, record);
+}
+
+template<typename K>
+void NotificationRecordStore::RemoveFromIndex(Index<K> &index, const K &key, const OrderKey &orderKey)
+{
+    auto iter = index.find(key);
+    if (iter == index.end()) {
+        return;
+    }
+    iter->second.erase(orderKey);
+    if (iter->second.empty()) {
+        index.erase(iter);
+    }
+}
+
+template<typename K>
+const NotificationRecordStore::RecordMap *NotificationRecordStore::FindInIndex(const Index<K> &index, const K &key)
+{
+    auto iter = index.find(key);
+    if (iter == index.end()) {
+        return nullptr;
+    }
+    return &iter->second;
+}
+}  // namespace Notification
+}  // namespace OHOS
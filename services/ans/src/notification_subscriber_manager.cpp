@@ -16,8 +16,11 @@
 #include "notification_subscriber_manager.h"
 
 #include <algorithm>
+#include <cinttypes>
 #include <memory>
 #include <set>
+#include <sstream>
+#include <unordered_map>
 
 #include "ans_const_define.h"
 #include "ans_inner_errors.h"
@@ -29,11 +32,24 @@
 
 namespace OHOS {
 namespace Notification {
+namespace {
+constexpr size_t MAX_SORTING_MAP_CHANGE_NUM = 64;
+constexpr size_t DELIVERY_WORKER_NUM = 4;
+constexpr size_t DEFAULT_DELIVERY_QUEUE_CAPACITY = 1024;
+constexpr char UPDATED_DELIVERY_KEY[] = "updated";
+constexpr char DO_NOT_DISTURB_DELIVERY_KEY[] = "doNotDisturb";
+constexpr char ENABLED_DELIVERY_KEY[] = "enabled";
+}  // namespace
+
 struct NotificationSubscriberManager::SubscriberRecord {
     sptr<AnsSubscriberInterface> subscriber {nullptr};
     std::set<std::string> bundleList_ {};
     bool subscribedAll {false};
     int32_t userId {SUBSCRIBE_USER_INIT};
+    bool sortingMapDelta {false};
+    uint64_t sortingMapVersion {0};
+    uint64_t sequence {0};
+    std::shared_ptr<NotificationDeliveryQueue> deliveryQueue {nullptr};
 };
 
 NotificationSubscriberManager::NotificationSubscriberManager()
@@ -41,13 +57,25 @@ NotificationSubscriberManager::NotificationSubscriberManager()
     runner_ = OHOS::AppExecFwk::EventRunner::Create();
     handler_ = std::make_shared<OHOS::AppExecFwk::EventHandler>(runner_);
     AnsWatchdog::AddHandlerThread(handler_, runner_);
+    for (size_t i = 0; i < DELIVERY_WORKER_NUM; i++) {
+        auto runner = OHOS::AppExecFwk::EventRunner::Create();
+        auto handler = std::make_shared<OHOS::AppExecFwk::EventHandler>(runner);
+        AnsWatchdog::AddHandlerThread(handler, runner);
+        deliveryRunners_.push_back(runner);
+        deliveryHandlers_.push_back(handler);
+    }
+    deliveryQueueCapacity_ = DEFAULT_DELIVERY_QUEUE_CAPACITY;
     recipient_ =
         new RemoteDeathRecipient(std::bind(&NotificationSubscriberManager::OnRemoteDied, this, std::placeholders::_1));
 }
 
 NotificationSubscriberManager::~NotificationSubscriberManager()
 {
+    for (auto &record : subscriberRecordList_) {
+        record->deliveryQueue->Stop();
+    }
     subscriberRecordList_.clear();
+    subscriberRoutes_.clear();
 }
 
 ErrCode NotificationSubscriberManager::AddSubscriber(
@@ -131,6 +159,34 @@ void NotificationSubscriberManager::NotifyCanceled(
     handler_->PostTask(NotifyCanceledFunc);
 }
 
+void NotificationSubscriberManager::NotifyConsumedBatch(
+    const std::vector<sptr<Notification>> &notifications, const sptr<NotificationSortingMap> &notificationMap)
+{
+    if (handler_ == nullptr) {
+        ANS_LOGE("handler is nullptr");
+        return;
+    }
+
+    AppExecFwk::EventHandler::Callback NotifyConsumedBatchFunc =
+        std::bind(&NotificationSubscriberManager::NotifyConsumedBatchInner, this, notifications, notificationMap);
+
+    handler_->PostTask(NotifyConsumedBatchFunc);
+}
+
+void NotificationSubscriberManager::NotifyCanceledBatch(const std::vector<sptr<Notification>> &notifications,
+    const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason)
+{
+    if (handler_ == nullptr) {
+        ANS_LOGE("handler is nullptr");
+        return;
+    }
+
+    AppExecFwk::EventHandler::Callback NotifyCanceledBatchFunc = std::bind(
+        &NotificationSubscriberManager::NotifyCanceledBatchInner, this, notifications, notificationMap, deleteReason);
+
+    handler_->PostTask(NotifyCanceledBatchFunc);
+}
+
 void NotificationSubscriberManager::NotifyUpdated(const sptr<NotificationSortingMap> &notificationMap)
 {
     if (handler_ == nullptr) {
@@ -171,6 +227,32 @@ void NotificationSubscriberManager::NotifyEnabledNotificationChanged(
     handler_->PostTask(func);
 }
 
+ErrCode NotificationSubscriberManager::ResyncSortingMap(
+    const sptr<AnsSubscriberInterface> &subscriber, const sptr<NotificationSortingMap> &notificationMap)
+{
+    if (subscriber == nullptr || notificationMap == nullptr) {
+        ANS_LOGE("subscriber or notificationMap is null.");
+        return ERR_ANS_INVALID_PARAM;
+    }
+
+    ErrCode result = ERR_ANS_TASK_ERR;
+    handler_->PostSyncTask(std::bind([this, &subscriber, &notificationMap, &result]() {
+        std::shared_ptr<SubscriberRecord> record = FindSubscriberRecord(subscriber);
+        if (record == nullptr) {
+            ANS_LOGE("subscriber not found.");
+            result = ERR_ANS_INVALID_PARAM;
+            return;
+        }
+        UpdateSortingMap(notificationMap);
+        record->sortingMapVersion = 0;
+        sptr<AnsSubscriberInterface> target = record->subscriber;
+        DeliverWithSortingMap(record, UPDATED_DELIVERY_KEY, notificationMap,
+            [target](const sptr<NotificationSortingMap> &sortingMap) { target->OnUpdated(sortingMap); });
+        result = ERR_OK;
+    }));
+    return result;
+}
+
 void NotificationSubscriberManager::OnRemoteDied(const wptr<IRemoteObject> &object)
 {
     ANS_LOGI("OnRemoteDied");
@@ -178,6 +260,8 @@ void NotificationSubscriberManager::OnRemoteDied(const wptr<IRemoteObject> &obje
         std::shared_ptr<SubscriberRecord> record = FindSubscriberRecord(object);
         if (record != nullptr) {
             ANS_LOGW("subscriber removed.");
+            record->deliveryQueue->Stop();
+            RemoveFromRoutes(record);
             subscriberRecordList_.remove(record);
         }
     }),
@@ -216,6 +300,10 @@ std::shared_ptr<NotificationSubscriberManager::SubscriberRecord> NotificationSub
     std::shared_ptr<SubscriberRecord> record = std::make_shared<SubscriberRecord>();
     if (record != nullptr) {
         record->subscriber = subscriber;
+        record->sequence = ++subscriberSequence_;
+        record->deliveryQueue = std::make_shared<NotificationDeliveryQueue>(
+            deliveryHandlers_[record->sequence % deliveryHandlers_.size()], deliveryQueueCapacity_,
+            deliveryQueuePolicy_);
     }
     return record;
 }
@@ -223,6 +311,7 @@ std::shared_ptr<NotificationSubscriberManager::SubscriberRecord> NotificationSub
 void NotificationSubscriberManager::AddRecordInfo(
     std::shared_ptr<SubscriberRecord> &record, const sptr<NotificationSubscribeInfo> &subscribeInfo)
 {
+    RemoveFromRoutes(record);
     if (subscribeInfo != nullptr) {
         record->bundleList_.clear();
         record->subscribedAll = true;
@@ -231,15 +320,20 @@ void NotificationSubscriberManager::AddRecordInfo(
             record->subscribedAll = false;
         }
         record->userId = subscribeInfo->GetAppUserId();
+        record->sortingMapDelta = subscribeInfo->IsSortingMapDeltaEnabled();
     } else {
         record->bundleList_.clear();
         record->subscribedAll = true;
+        record->sortingMapDelta = false;
     }
+    record->sortingMapVersion = 0;
+    AddToRoutes(record);
 }
 
 void NotificationSubscriberManager::RemoveRecordInfo(
     std::shared_ptr<SubscriberRecord> &record, const sptr<NotificationSubscribeInfo> &subscribeInfo)
 {
+    RemoveFromRoutes(record);
     if (subscribeInfo != nullptr) {
         for (auto bundle : subscribeInfo->GetAppNames()) {
             if (record->subscribedAll) {
@@ -252,6 +346,7 @@ void NotificationSubscriberManager::RemoveRecordInfo(
         record->bundleList_.clear();
         record->subscribedAll = false;
     }
+    AddToRoutes(record);
 }
 
 ErrCode NotificationSubscriberManager::AddSubscriberInner(
@@ -292,9 +387,12 @@ ErrCode NotificationSubscriberManager::RemoveSubscriberInner(
     if (!record->subscribedAll && record->bundleList_.empty()) {
         record->subscriber->AsObject()->RemoveDeathRecipient(recipient_);
 
+        RemoveFromRoutes(record);
         subscriberRecordList_.remove(record);
 
-        record->subscriber->OnDisconnected();
+        // Callbacks queued before the unsubscription are still delivered, OnDisconnected is the last one.
+        sptr<AnsSubscriberInterface> target = record->subscriber;
+        record->deliveryQueue->Close([target]() { target->OnDisconnected(); });
         ANS_LOGI("subscriber is disconnected.");
     }
 
@@ -305,22 +403,13 @@ void NotificationSubscriberManager::NotifyConsumedInner(
     const sptr<Notification> &notification, const sptr<NotificationSortingMap> &notificationMap)
 {
     ANS_LOGD("%{public}s notification->GetUserId <%{public}d>", __FUNCTION__, notification->GetUserId());
-    int32_t recvUserId = notification->GetNotificationRequest().GetReceiverUserId();
-    int32_t sendUserId = notification->GetUserId();
-    for (auto record : subscriberRecordList_) {
-        auto BundleNames = notification->GetBundleName();
-        ANS_LOGD("%{public}s record->userId = <%{public}d> BundleName  = <%{public}s",
-            __FUNCTION__, record->userId, BundleNames.c_str());
-        auto iter = std::find(record->bundleList_.begin(), record->bundleList_.end(), BundleNames);
-        if (!record->subscribedAll == (iter != record->bundleList_.end()) &&
-            ((record->userId == sendUserId) ||
-            (record->userId == SUBSCRIBE_USER_ALL) ||
-            (record->userId == recvUserId) ||
-            IsSystemUser(record->userId) ||  // Delete this, When the systemui subscribe carry the user ID.
-            IsSystemUser(sendUserId))) {
-            record->subscriber->OnConsumed(notification, notificationMap);
-            record->subscriber->OnConsumed(notification);
-        }
+    UpdateSortingMap(notificationMap);
+    for (auto record : GetRoutedSubscribers(notification)) {
+        sptr<AnsSubscriberInterface> subscriber = record->subscriber;
+        DeliverWithSortingMap(record, notification->GetKey(), notificationMap,
+            [subscriber, notification](const sptr<NotificationSortingMap> &sortingMap) {
+                subscriber->OnConsumedCombined(notification, sortingMap);
+            });
     }
 }
 
@@ -328,35 +417,84 @@ void NotificationSubscriberManager::NotifyCanceledInner(
     const sptr<Notification> &notification, const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason)
 {
     ANS_LOGD("%{public}s notification->GetUserId <%{public}d>", __FUNCTION__, notification->GetUserId());
-    int32_t recvUserId = notification->GetNotificationRequest().GetReceiverUserId();
-    int32_t sendUserId = notification->GetUserId();
-    for (auto record : subscriberRecordList_) {
-        ANS_LOGD("%{public}s record->userId = <%{public}d>", __FUNCTION__, record->userId);
-        auto BundleNames = notification->GetBundleName();
-        auto iter = std::find(record->bundleList_.begin(), record->bundleList_.end(), BundleNames);
-        if (!record->subscribedAll == (iter != record->bundleList_.end()) &&
-            ((record->userId == sendUserId) ||
-            (record->userId == SUBSCRIBE_USER_ALL) ||
-            (record->userId == recvUserId) ||
-            IsSystemUser(record->userId) ||   // Delete this, When the systemui subscribe carry the user ID.
-            IsSystemUser(sendUserId))) {
-            record->subscriber->OnCanceled(notification, notificationMap, deleteReason);
-            record->subscriber->OnCanceled(notification);
+    UpdateSortingMap(notificationMap);
+    for (auto record : GetRoutedSubscribers(notification)) {
+        sptr<AnsSubscriberInterface> subscriber = record->subscriber;
+        DeliverWithSortingMap(record, notification->GetKey(), notificationMap,
+            [subscriber, notification, deleteReason](const sptr<NotificationSortingMap> &sortingMap) {
+                subscriber->OnCanceledCombined(notification, sortingMap, deleteReason);
+            });
+    }
+}
+
+std::map<uint64_t, std::pair<std::shared_ptr<NotificationSubscriberManager::SubscriberRecord>,
+    std::vector<sptr<Notification>>>>
+NotificationSubscriberManager::GroupBySubscriber(const std::vector<sptr<Notification>> &notifications)
+{
+    // Keyed by the subscription sequence, so subscribers get the batch in the order they get single notifications.
+    std::map<uint64_t, std::pair<std::shared_ptr<SubscriberRecord>, std::vector<sptr<Notification>>>> groups;
+    for (auto &notification : notifications) {
+        for (auto &record : GetRoutedSubscribers(notification)) {
+            auto &group = groups[record->sequence];
+            group.first = record;
+            group.second.push_back(notification);
         }
     }
+    return groups;
+}
+
+void NotificationSubscriberManager::NotifyConsumedBatchInner(
+    const std::vector<sptr<Notification>> &notifications, const sptr<NotificationSortingMap> &notificationMap)
+{
+    ANS_LOGD("%{public}s size <%{public}zu>", __FUNCTION__, notifications.size());
+    UpdateSortingMap(notificationMap);
+    for (auto &group : GroupBySubscriber(notifications)) {
+        std::shared_ptr<SubscriberRecord> record = group.second.first;
+        std::vector<sptr<Notification>> routed = std::move(group.second.second);
+        sptr<AnsSubscriberInterface> subscriber = record->subscriber;
+        // A batch is never coalesced, the callback replacing it would not carry all of its notifications.
+        DeliverWithSortingMap(record, "", notificationMap,
+            [subscriber, routed](const sptr<NotificationSortingMap> &sortingMap) {
+                subscriber->OnConsumedList(routed, sortingMap);
+            });
+    }
+}
+
+void NotificationSubscriberManager::NotifyCanceledBatchInner(const std::vector<sptr<Notification>> &notifications,
+    const sptr<NotificationSortingMap> &notificationMap, int32_t deleteReason)
+{
+    ANS_LOGD("%{public}s size <%{public}zu>", __FUNCTION__, notifications.size());
+    UpdateSortingMap(notificationMap);
+    for (auto &group : GroupBySubscriber(notifications)) {
+        std::shared_ptr<SubscriberRecord> record = group.second.first;
+        std::vector<sptr<Notification>> routed = std::move(group.second.second);
+        sptr<AnsSubscriberInterface> subscriber = record->subscriber;
+        DeliverWithSortingMap(record, "", notificationMap,
+            [subscriber, routed, deleteReason](const sptr<NotificationSortingMap> &sortingMap) {
+                subscriber->OnCanceledList(routed, sortingMap, deleteReason);
+            });
+    }
 }
 
 void NotificationSubscriberManager::NotifyUpdatedInner(const sptr<NotificationSortingMap> &notificationMap)
 {
-    for (auto record : subscriberRecordList_) {
-        record->subscriber->OnUpdated(notificationMap);
+    UpdateSortingMap(notificationMap);
+    // A subscriber may be disconnected while its callback is delivered, so iterate a copy of the list.
+    std::list<std::shared_ptr<SubscriberRecord>> records = subscriberRecordList_;
+    for (auto record : records) {
+        sptr<AnsSubscriberInterface> subscriber = record->subscriber;
+        DeliverWithSortingMap(record, UPDATED_DELIVERY_KEY, notificationMap,
+            [subscriber](const sptr<NotificationSortingMap> &sortingMap) { subscriber->OnUpdated(sortingMap); });
     }
 }
 
 void NotificationSubscriberManager::NotifyDoNotDisturbDateChangedInner(const sptr<NotificationDoNotDisturbDate> &date)
 {
-    for (auto record : subscriberRecordList_) {
-        record->subscriber->OnDoNotDisturbDateChange(date);
+    std::list<std::shared_ptr<SubscriberRecord>> records = subscriberRecordList_;
+    for (auto record : records) {
+        sptr<AnsSubscriberInterface> subscriber = record->subscriber;
+        Deliver(record, DO_NOT_DISTURB_DELIVERY_KEY,
+            [subscriber, date]() { subscriber->OnDoNotDisturbDateChange(date); });
     }
 }
 
@@ -365,12 +503,355 @@ bool NotificationSubscriberManager::IsSystemUser(int32_t userId)
     return ((userId >= SUBSCRIBE_USER_SYSTEM_BEGIN) && (userId <= SUBSCRIBE_USER_SYSTEM_END));
 }
 
+int32_t NotificationSubscriberManager::GetRouteUserId(int32_t userId)
+{
+    // Subscribers of all users and of the system users receive the notifications of every user.
+    // Delete the system user case, When the systemui subscribe carry the user ID.
+    if ((userId == SUBSCRIBE_USER_ALL) || IsSystemUser(userId)) {
+        return SUBSCRIBE_USER_ALL;
+    }
+    return userId;
+}
+
+void NotificationSubscriberManager::AddToRoutes(const std::shared_ptr<SubscriberRecord> &record)
+{
+    if (!record->subscribedAll && record->bundleList_.empty()) {
+        return;
+    }
+
+    SubscriberRoute &route = subscriberRoutes_[GetRouteUserId(record->userId)];
+    if (record->subscribedAll) {
+        route.allBundles.emplace(record->sequence, record);
+        return;
+    }
+    for (auto &bundle : record->bundleList_) {
+        route.bundles[bundle].emplace(record->sequence, record);
+    }
+}
+
+void NotificationSubscriberManager::RemoveFromRoutes(const std::shared_ptr<SubscriberRecord> &record)
+{
+    auto routeIter = subscriberRoutes_.find(GetRouteUserId(record->userId));
+    if (routeIter == subscriberRoutes_.end()) {
+        return;
+    }
+
+    SubscriberRoute &route = routeIter->second;
+    if (record->subscribedAll) {
+        route.allBundles.erase(record->sequence);
+    } else {
+        for (auto &bundle : record->bundleList_) {
+            auto bundleIter = route.bundles.find(bundle);
+            if (bundleIter == route.bundles.end()) {
+                continue;
+            }
+            bundleIter->second.erase(record->sequence);
+            if (bundleIter->second.empty()) {
+                route.bundles.erase(bundleIter);
+            }
+        }
+    }
+    if (route.allBundles.empty() && route.bundles.empty()) {
+        subscriberRoutes_.erase(routeIter);
+    }
+}
+
+std::vector<std::shared_ptr<NotificationSubscriberManager::SubscriberRecord>>
+    NotificationSubscriberManager::GetRoutedSubscribers(const sptr<Notification> &notification)
+{
+    int32_t recvUserId = notification->GetNotificationRequest().GetReceiverUserId();
+    int32_t sendUserId = notification->GetUserId();
+    std::string bundleName = notification->GetBundleName();
+
+    std::vector<const SubscriberRoute *> routes;
+    if (IsSystemUser(sendUserId)) {
+        for (auto &route : subscriberRoutes_) {
+            routes.push_back(&route.second);
+        }
+    } else {
+        std::set<int32_t> routeUserIds = {sendUserId, recvUserId, SUBSCRIBE_USER_ALL};
+        for (auto routeUserId : routeUserIds) {
+            auto iter = subscriberRoutes_.find(routeUserId);
+            if (iter != subscriberRoutes_.end()) {
+                routes.push_back(&iter->second);
+            }
+        }
+    }
+
+    SubscriberRecordMap subscribers;
+    for (auto route : routes) {
+        for (auto &subscriber : route->allBundles) {
+            if (subscriber.second->bundleList_.find(bundleName) == subscriber.second->bundleList_.end()) {
+                subscribers.emplace(subscriber);
+            }
+        }
+        auto iter = route->bundles.find(bundleName);
+        if (iter != route->bundles.end()) {
+            subscribers.insert(iter->second.begin(), iter->second.end());
+        }
+    }
+    ANS_LOGD("%{public}s bundleName = <%{public}s> sendUserId = <%{public}d> subscribers = <%{public}zu>",
+        __FUNCTION__, bundleName.c_str(), sendUserId, subscribers.size());
+
+    std::vector<std::shared_ptr<SubscriberRecord>> records;
+    records.reserve(subscribers.size());
+    for (auto &subscriber : subscribers) {
+        records.push_back(subscriber.second);
+    }
+    return records;
+}
+
 void NotificationSubscriberManager::NotifyEnabledNotificationChangedInner(
     const sptr<EnabledNotificationCallbackData> &callbackData)
 {
-    for (auto record : subscriberRecordList_) {
-        record->subscriber->OnEnabledNotificationChanged(callbackData);
+    std::string key;
+    if (callbackData != nullptr) {
+        key = std::string(ENABLED_DELIVERY_KEY) + "|" + callbackData->GetBundle() + "|" +
+            std::to_string(callbackData->GetUid());
+    }
+    std::list<std::shared_ptr<SubscriberRecord>> records = subscriberRecordList_;
+    for (auto record : records) {
+        sptr<AnsSubscriberInterface> subscriber = record->subscriber;
+        Deliver(record, key,
+            [subscriber, callbackData]() { subscriber->OnEnabledNotificationChanged(callbackData); });
+    }
+}
+
+void NotificationSubscriberManager::Deliver(const std::shared_ptr<SubscriberRecord> &record, const std::string &key,
+    const NotificationDeliveryQueue::Task &task, NotificationDeliveryQueue::SortingMapType type,
+    const NotificationDeliveryQueue::Task &fullTask)
+{
+    // A callback given up to make room is not a problem for the sorting map versions, the queue replaces the next
+    // delta by its full sorting map, so every queued delta still applies to the one before it.
+    switch (record->deliveryQueue->Push(key, task, type, fullTask)) {
+        case NotificationDeliveryQueue::PushResult::REJECTED:
+            ANS_LOGW("delivery queue of subscriber %{public}" PRIu64 " is full, disconnect it.", record->sequence);
+            DisconnectSubscriber(record);
+            break;
+        default:
+            break;
+    }
+}
+
+void NotificationSubscriberManager::DeliverWithSortingMap(const std::shared_ptr<SubscriberRecord> &record,
+    const std::string &key, const sptr<NotificationSortingMap> &notificationMap, const SortingMapTask &task)
+{
+    sptr<NotificationSortingMap> sortingMap = GetSortingMapForSubscriber(record, notificationMap);
+    auto sortingMapTask = [task, sortingMap]() { task(sortingMap); };
+    if (sortingMap == nullptr) {
+        Deliver(record, key, sortingMapTask);
+        return;
+    }
+    if (!sortingMap->IsDelta()) {
+        Deliver(record, key, sortingMapTask, NotificationDeliveryQueue::SortingMapType::FULL);
+        return;
+    }
+    sptr<NotificationSortingMap> fullMap = sortingMap_;
+    Deliver(record, key, sortingMapTask, NotificationDeliveryQueue::SortingMapType::DELTA,
+        [task, fullMap]() { task(fullMap); });
+}
+
+void NotificationSubscriberManager::DisconnectSubscriber(const std::shared_ptr<SubscriberRecord> &record)
+{
+    record->deliveryQueue->Stop();
+    record->subscriber->AsObject()->RemoveDeathRecipient(recipient_);
+    RemoveFromRoutes(record);
+    subscriberRecordList_.remove(record);
+    record->subscriber->OnDisconnected();
+}
+
+ErrCode NotificationSubscriberManager::SetDeliveryQueuePolicy(
+    size_t capacity, NotificationDeliveryQueue::OverflowPolicy policy)
+{
+    if (capacity == 0) {
+        ANS_LOGE("capacity is invalid.");
+        return ERR_ANS_INVALID_PARAM;
+    }
+
+    handler_->PostSyncTask(std::bind([this, capacity, policy]() {
+        deliveryQueueCapacity_ = capacity;
+        deliveryQueuePolicy_ = policy;
+        for (auto &record : subscriberRecordList_) {
+            record->deliveryQueue->SetPolicy(capacity, policy);
+        }
+    }));
+    return ERR_OK;
+}
+
+void NotificationSubscriberManager::Dump(std::vector<std::string> &dumpInfo)
+{
+    handler_->PostSyncTask(std::bind([this, &dumpInfo]() {
+        for (auto &record : subscriberRecordList_) {
+            NotificationDeliveryQueue::Stats stats = record->deliveryQueue->GetStats();
+            std::stringstream stream;
+            stream << "\tSubscriber: " << record->sequence << "\n";
+            stream << "\t\tUserId: " << record->userId << "\n";
+            stream << "\t\tSubscribedAll: " << (record->subscribedAll ? "true" : "false") << "\n";
+            stream << "\t\tBundles:";
+            for (auto &bundle : record->bundleList_) {
+                stream << " " << bundle;
+            }
+            stream << "\n";
+            stream << "\t\tQueue: depth " << stats.depth << ", max depth " << stats.maxDepth << ", capacity "
+                   << deliveryQueueCapacity_ << ", policy "
+                   << NotificationDeliveryQueue::PolicyToString(deliveryQueuePolicy_) << "\n";
+            stream << "\t\tDelivered: " << stats.delivered << ", coalesced " << stats.coalesced << ", dropped "
+                   << stats.dropped << "\n";
+            stream << "\t\tLatency: average " << stats.averageLatency << "us, max " << stats.maxLatency << "us\n";
+            dumpInfo.push_back(stream.str());
+        }
+    }));
+}
+
+void NotificationSubscriberManager::UpdateSortingMap(const sptr<NotificationSortingMap> &notificationMap)
+{
+    if (notificationMap == nullptr || notificationMap == sortingMapSource_) {
+        return;
+    }
+    sptr<NotificationSortingMap> versionedMap = new (std::nothrow) NotificationSortingMap(*notificationMap);
+    if (versionedMap == nullptr) {
+        ANS_LOGE("Failed to copy the sorting map, subscribers are given full maps until the next change.");
+        sortingMapSource_ = nullptr;
+        sortingMap_ = nullptr;
+        sortingMapChanges_.clear();
+        return;
+    }
+
+    SortingMapChange change;
+    change.version = ++sortingMapVersion_;
+    bool hasDeltaSubscriber = std::any_of(subscriberRecordList_.begin(), subscriberRecordList_.end(),
+        [](const std::shared_ptr<SubscriberRecord> &record) { return record->sortingMapDelta; });
+    if (hasDeltaSubscriber) {
+        change.changedKeys = GetChangedKeys(sortingMap_, notificationMap);
+        sortingMapChanges_.push_back(std::move(change));
+        if (sortingMapChanges_.size() > MAX_SORTING_MAP_CHANGE_NUM) {
+            sortingMapChanges_.pop_front();
+        }
+    } else {
+        // Subscribers that opt in later start from a full sorting map.
+        sortingMapChanges_.clear();
+    }
+
+    versionedMap->SetVersion(sortingMapVersion_);
+    sortingMapSource_ = notificationMap;
+    sortingMap_ = versionedMap;
+}
+
+std::set<std::string> NotificationSubscriberManager::GetChangedKeys(
+    const sptr<NotificationSortingMap> &previous, const sptr<NotificationSortingMap> &current)
+{
+    std::set<std::string> changedKeys;
+    std::vector<std::string> currentKeys = current->GetKey();
+    if (previous == nullptr) {
+        changedKeys.insert(currentKeys.begin(), currentKeys.end());
+        return changedKeys;
+    }
+
+    std::unordered_map<std::string, size_t> previousPositions;
+    std::vector<std::string> previousKeys = previous->GetKey();
+    for (size_t i = 0; i < previousKeys.size(); i++) {
+        previousPositions[previousKeys[i]] = i;
+    }
+
+    // Keys kept from the previous map, in the current order, with their previous positions.
+    std::vector<std::string> keptKeys;
+    std::vector<size_t> positions;
+    for (auto &key : currentKeys) {
+        auto iter = previousPositions.find(key);
+        if (iter == previousPositions.end()) {
+            changedKeys.insert(key);
+            continue;
+        }
+        keptKeys.push_back(key);
+        positions.push_back(iter->second);
+        previousPositions.erase(iter);
+    }
+    for (auto &removed : previousPositions) {
+        changedKeys.insert(removed.first);
+    }
+
+    // The longest run of kept keys in their previous order stays in place, all other kept keys moved.
+    std::vector<size_t> tails;
+    std::vector<int64_t> predecessors(positions.size(), -1);
+    for (size_t i = 0; i < positions.size(); i++) {
+        auto iter = std::lower_bound(tails.begin(), tails.end(), positions[i],
+            [&positions](size_t index, size_t position) { return positions[index] < position; });
+        if (iter != tails.begin()) {
+            predecessors[i] = static_cast<int64_t>(*(iter - 1));
+        }
+        if (iter == tails.end()) {
+            tails.push_back(i);
+        } else {
+            *iter = i;
+        }
+    }
+    std::vector<bool> inPlace(positions.size(), false);
+    for (int64_t i = tails.empty() ? -1 : static_cast<int64_t>(tails.back()); i >= 0; i = predecessors[i]) {
+        inPlace[i] = true;
+    }
+
+    for (size_t i = 0; i < keptKeys.size(); i++) {
+        if (!inPlace[i]) {
+            changedKeys.insert(keptKeys[i]);
+            continue;
+        }
+        NotificationSorting previousSorting;
+        NotificationSorting currentSorting;
+        previous->GetNotificationSorting(keptKeys[i], previousSorting);
+        current->GetNotificationSorting(keptKeys[i], currentSorting);
+        if (previousSorting.slot_ != currentSorting.slot_) {
+            changedKeys.insert(keptKeys[i]);
+        }
+    }
+    return changedKeys;
+}
+
+sptr<NotificationSortingMap> NotificationSubscriberManager::GetSortingMapForSubscriber(
+    const std::shared_ptr<SubscriberRecord> &record, const sptr<NotificationSortingMap> &notificationMap)
+{
+    if (notificationMap == nullptr || notificationMap != sortingMapSource_) {
+        return notificationMap;
+    }
+    if (!record->sortingMapDelta) {
+        return sortingMap_;
+    }
+
+    uint64_t baseVersion = record->sortingMapVersion;
+    record->sortingMapVersion = sortingMapVersion_;
+    if ((baseVersion == 0) || (baseVersion > sortingMapVersion_) || ((baseVersion < sortingMapVersion_) &&
+        (sortingMapChanges_.empty() || (sortingMapChanges_.front().version > baseVersion + 1)))) {
+        return sortingMap_;
+    }
+
+    std::set<std::string> changedKeys;
+    for (auto &change : sortingMapChanges_) {
+        if (change.version > baseVersion) {
+            changedKeys.insert(change.changedKeys.begin(), change.changedKeys.end());
+        }
+    }
+    if (changedKeys.size() >= sortingMap_->GetKey().size()) {
+        return sortingMap_;
+    }
+
+    std::vector<NotificationSorting> sortingList;
+    std::vector<std::string> removedKeys;
+    for (auto &key : changedKeys) {
+        NotificationSorting sorting;
+        if (sortingMap_->GetNotificationSorting(key, sorting)) {
+            sortingList.push_back(sorting);
+        } else {
+            removedKeys.push_back(key);
+        }
+    }
+
+    sptr<NotificationSortingMap> delta = new (std::nothrow) NotificationSortingMap(sortingList);
+    if (delta == nullptr) {
+        ANS_LOGE("Failed to create sorting map delta.");
+        return sortingMap_;
     }
+    delta->SetVersion(sortingMapVersion_);
+    delta->SetDelta(baseVersion, removedKeys);
+    return delta;
 }
 }  // namespace Notification
 }  // namespace OHOS
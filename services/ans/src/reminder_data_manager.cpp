@@ -22,6 +22,7 @@
 #include "notification_slot.h"
 #include "os_account_manager.h"
 #include "reminder_event_manager.h"
+#include "reminder_request_calendar.h"
 #include "time_service_client.h"
 #include "singleton.h"
 
@@ -29,6 +30,7 @@ namespace OHOS {
 namespace Notification {
 namespace {
 const std::string ALL_PACKAGES = "allPackages";
+const std::string APP_KEY_SEPARATOR = "|";
 const int32_t MAIN_USER_ID = 100;
 }
 
@@ -42,6 +44,17 @@ std::mutex ReminderDataManager::SHOW_MUTEX;
 std::mutex ReminderDataManager::ALERT_MUTEX;
 std::mutex ReminderDataManager::TIMER_MUTEX;
 
+ReminderDataManager::~ReminderDataManager()
+{
+    if (timerId_ == 0) {
+        return;
+    }
+    sptr<MiscServices::TimeServiceClient> timer = MiscServices::TimeServiceClient::GetInstance();
+    if (timer != nullptr) {
+        timer->DestroyTimer(timerId_);
+    }
+}
+
 void ReminderDataManager::PublishReminder(const sptr<ReminderRequest> &reminder,
     const sptr<NotificationBundleOption> &bundleOption)
 {
@@ -86,19 +99,21 @@ void ReminderDataManager::GetValidReminders(
     const sptr<NotificationBundleOption> &bundleOption, std::vector<sptr<ReminderRequest>> &reminders)
 {
     std::lock_guard<std::mutex> lock(ReminderDataManager::MUTEX);
-    for (auto it = reminderVector_.begin(); it != reminderVector_.end(); ++it) {
-        if ((*it)->IsExpired()) {
+    auto ait = appReminders_.find(
+        GenerateAppKey(bundleOption->GetBundleName(), ReminderRequest::GetUserId(bundleOption->GetUid())));
+    if (ait == appReminders_.end()) {
+        return;
+    }
+    for (auto reminderId : ait->second) {
+        auto rit = reminderMap_.find(reminderId);
+        if (rit == reminderMap_.end()) {
             continue;
         }
-        int32_t reminderId = (*it)->GetReminderId();
-        auto mit = notificationBundleOptionMap_.find(reminderId);
-        if (mit == notificationBundleOptionMap_.end()) {
-            ANSR_LOGE("Get bundle option occur error, reminderId=%{public}d", reminderId);
-        } else {
-            if (IsBelongToSameApp(mit->second, bundleOption)) {
-                reminders.push_back(*it);
-            }
+        sptr<ReminderRequest> reminder = LoadReminder(rit->second, reminderId);
+        if (reminder == nullptr || reminder->IsExpired()) {
+            continue;
         }
+        reminders.push_back(reminder);
     }
 }
 
@@ -111,32 +126,43 @@ void ReminderDataManager::CancelAllReminders(const int32_t &userId)
 void ReminderDataManager::CancelRemindersImplLocked(const std::string &packageName, const int32_t &userId)
 {
     MUTEX.lock();
-    if (activeReminderId_ != -1 && IsMatched(activeReminder_, packageName, userId)) {
+    if (activeReminderId_ != -1 && IsMatched(activeReminderId_, packageName, userId)) {
         activeReminder_->OnStop();
         StopTimer(TimerType::TRIGGER_TIMER);
         ANSR_LOGD("Stop active reminder, reminderId=%{public}d", activeReminderId_);
     }
-    for (auto vit = reminderVector_.begin(); vit != reminderVector_.end();) {
-        int32_t reminderId = (*vit)->GetReminderId();
+    std::vector<int32_t> reminderIds;
+    if (packageName == ALL_PACKAGES) {
+        for (auto &item : reminderMap_) {
+            reminderIds.push_back(item.first);
+        }
+    } else {
+        auto ait = appReminders_.find(GenerateAppKey(packageName, userId));
+        if (ait != appReminders_.end()) {
+            reminderIds.assign(ait->second.begin(), ait->second.end());
+        }
+    }
+    for (auto reminderId : reminderIds) {
         auto mit = notificationBundleOptionMap_.find(reminderId);
         if (mit == notificationBundleOptionMap_.end()) {
             ANSR_LOGE("Get bundle option occur error, reminderId=%{public}d", reminderId);
-            ++vit;
             continue;
         }
-        if (IsMatched(*vit, packageName, userId)) {
-            if ((*vit)->IsAlerting()) {
-                StopAlertingReminder(*vit);
+        if (IsMatched(reminderId, packageName, userId)) {
+            // A reminder not loaded yet has not been shown since boot.
+            auto rit = reminderMap_.find(reminderId);
+            sptr<ReminderRequest> reminder = (rit == reminderMap_.end()) ? nullptr : rit->second.reminder;
+            if (reminder != nullptr) {
+                if (reminder->IsAlerting()) {
+                    StopAlertingReminder(reminder);
+                }
+                CancelNotification(reminder);
+                RemoveFromShowedReminders(reminder);
             }
-            CancelNotification(*vit);
-            RemoveFromShowedReminders(*vit);
-            ANSR_LOGD("Containers(vector/map) remove. reminderId=%{public}d", reminderId);
-            vit = reminderVector_.erase(vit);
+            ANSR_LOGD("Containers(indexes/map) remove. reminderId=%{public}d", reminderId);
+            RemoveFromIndexes(reminderId);
             notificationBundleOptionMap_.erase(mit);
-            totalCount_--;
-            continue;
         }
-        ++vit;
     }
     if (packageName == ALL_PACKAGES) {
         store_->DeleteUser(userId);
@@ -147,12 +173,12 @@ void ReminderDataManager::CancelRemindersImplLocked(const std::string &packageNa
     StartRecentReminder();
 }
 
-bool ReminderDataManager::IsMatched(const sptr<ReminderRequest> &reminder,
+bool ReminderDataManager::IsMatched(const int32_t &reminderId,
     const std::string &packageName, const int32_t &userId) const
 {
-    auto mit = notificationBundleOptionMap_.find(reminder->GetReminderId());
+    auto mit = notificationBundleOptionMap_.find(reminderId);
     if (mit == notificationBundleOptionMap_.end()) {
-        ANS_LOGE("Failed to get bundle information. reminderId=%{public}d", reminder->GetReminderId());
+        ANS_LOGE("Failed to get bundle information. reminderId=%{public}d", reminderId);
         return true;
     }
     if (ReminderRequest::GetUserId(mit->second->GetUid()) != userId) {
@@ -191,23 +217,25 @@ void ReminderDataManager::CancelNotification(const sptr<ReminderRequest> &remind
 bool ReminderDataManager::CheckReminderLimitExceededLocked(const sptr<NotificationBundleOption> &bundleOption) const
 {
     std::lock_guard<std::mutex> lock(ReminderDataManager::MUTEX);
-    if (totalCount_ >= ReminderDataManager::MAX_NUM_REMINDER_LIMIT_SYSTEM) {
+    if (reminderMap_.size() >= static_cast<size_t>(ReminderDataManager::MAX_NUM_REMINDER_LIMIT_SYSTEM)) {
         ANSR_LOGW("The number of validate reminders exceeds the system upper limit:%{public}d, \
             and new reminder can not be published", MAX_NUM_REMINDER_LIMIT_SYSTEM);
         return true;
     }
+    auto ait = appReminders_.find(
+        GenerateAppKey(bundleOption->GetBundleName(), ReminderRequest::GetUserId(bundleOption->GetUid())));
+    if (ait == appReminders_.end() ||
+        ait->second.size() < static_cast<size_t>(ReminderDataManager::MAX_NUM_REMINDER_LIMIT_APP)) {
+        return false;
+    }
+    // Only the expired reminders of the application are left to be excluded.
     int8_t count = 0;
-    for (auto it = reminderVector_.begin(); it != reminderVector_.end(); ++it) {
-        if ((*it)->IsExpired()) {
-            continue;
-        }
-        auto mit = notificationBundleOptionMap_.find((*it)->GetReminderId());
-        if (mit == notificationBundleOptionMap_.end()) {
-            ANSR_LOGE("Error occur when get bundle option, reminderId=%{public}d", (*it)->GetReminderId());
-        } else {
-            if (IsBelongToSameApp(mit->second, bundleOption)) {
-                count++;
-            }
+    for (auto reminderId : ait->second) {
+        auto rit = reminderMap_.find(reminderId);
+        // A reminder not loaded yet is not expired, the expired ones are not loaded at boot.
+        if (rit != reminderMap_.end() &&
+            ((rit->second.reminder == nullptr) || !rit->second.reminder->IsExpired())) {
+            count++;
         }
     }
     if (count >= ReminderDataManager::MAX_NUM_REMINDER_LIMIT_APP) {
@@ -293,7 +321,7 @@ void ReminderDataManager::OnProcessDiedLocked(const sptr<NotificationBundleOptio
     }
 }
 
-std::shared_ptr<ReminderTimerInfo> ReminderDataManager::CreateTimerInfo(TimerType type) const
+std::shared_ptr<ReminderTimerInfo> ReminderDataManager::CreateTimerInfo() const
 {
     auto sharedTimerInfo = std::make_shared<ReminderTimerInfo>();
     if ((sharedTimerInfo->TIMER_TYPE_WAKEUP > UINT8_MAX) || (sharedTimerInfo->TIMER_TYPE_EXACT > UINT8_MAX)) {
@@ -311,26 +339,9 @@ std::shared_ptr<ReminderTimerInfo> ReminderDataManager::CreateTimerInfo(TimerTyp
     std::vector<AbilityRuntime::WantAgent::WantAgentConstant::Flags> flags;
     flags.push_back(AbilityRuntime::WantAgent::WantAgentConstant::Flags::UPDATE_PRESENT_FLAG);
 
+    // The timer is shared by all the deadlines, the due ones are found when it fires.
     auto want = std::make_shared<OHOS::AAFwk::Want>();
-    switch (type) {
-        case (TimerType::TRIGGER_TIMER): {
-            want->SetAction(ReminderRequest::REMINDER_EVENT_ALARM_ALERT);
-            want->SetParam(ReminderRequest::PARAM_REMINDER_ID, activeReminderId_);
-            break;
-        }
-        case (TimerType::ALERTING_TIMER): {
-            if (alertingReminderId_ == -1) {
-                ANSR_LOGE("Create alerting time out timer Illegal.");
-                return sharedTimerInfo;
-            }
-            want->SetAction(ReminderRequest::REMINDER_EVENT_ALERT_TIMEOUT);
-            want->SetParam(ReminderRequest::PARAM_REMINDER_ID, alertingReminderId_);
-            break;
-        }
-        default:
-            ANSR_LOGE("TimerType not support");
-            break;
-    }
+    want->SetAction(ReminderRequest::REMINDER_EVENT_ALARM_ALERT);
     std::vector<std::shared_ptr<AAFwk::Want>> wants;
     wants.push_back(want);
     AbilityRuntime::WantAgent::WantAgentInfo wantAgentInfo(
@@ -353,10 +364,9 @@ std::shared_ptr<ReminderTimerInfo> ReminderDataManager::CreateTimerInfo(TimerTyp
 sptr<ReminderRequest> ReminderDataManager::FindReminderRequestLocked(const int32_t &reminderId)
 {
     std::lock_guard<std::mutex> lock(ReminderDataManager::MUTEX);
-    for (auto it = reminderVector_.begin(); it != reminderVector_.end(); ++it) {
-        if (reminderId == (*it)->GetReminderId()) {
-            return *it;
-        }
+    auto it = reminderMap_.find(reminderId);
+    if (it != reminderMap_.end()) {
+        return LoadReminder(it->second, reminderId);
     }
     ANSR_LOGD("Not find the reminder");
     return nullptr;
@@ -393,9 +403,89 @@ sptr<NotificationBundleOption> ReminderDataManager::FindNotificationBundleOption
     }
 }
 
-bool ReminderDataManager::cmp(sptr<ReminderRequest> &reminderRequest, sptr<ReminderRequest> &other)
+std::string ReminderDataManager::GenerateAppKey(const std::string &bundleName, const int32_t &userId)
+{
+    return bundleName + APP_KEY_SEPARATOR + std::to_string(userId);
+}
+
+void ReminderDataManager::AddToIndexes(
+    const sptr<ReminderRequest> &reminder, const sptr<NotificationBundleOption> &bundleOption)
+{
+    AddToIndexes(reminder->GetReminderId(), reminder->GetTriggerTimeInMilli(), bundleOption);
+    auto it = reminderMap_.find(reminder->GetReminderId());
+    if (it != reminderMap_.end()) {
+        it->second.reminder = reminder;
+    }
+}
+
+void ReminderDataManager::AddToIndexes(const int32_t &reminderId, const uint64_t &triggerTime,
+    const sptr<NotificationBundleOption> &bundleOption)
 {
-    return reminderRequest->GetTriggerTimeInMilli() < other->GetTriggerTimeInMilli();
+    RemoveFromIndexes(reminderId);
+    ReminderEntry entry;
+    entry.queuedTriggerTime = triggerTime;
+    if (bundleOption != nullptr) {
+        entry.appKey =
+            GenerateAppKey(bundleOption->GetBundleName(), ReminderRequest::GetUserId(bundleOption->GetUid()));
+        appReminders_[entry.appKey].insert(reminderId);
+    }
+    triggerQueue_.emplace(entry.queuedTriggerTime, reminderId);
+    reminderMap_.emplace(reminderId, std::move(entry));
+}
+
+bool ReminderDataManager::RemoveFromIndexes(const int32_t &reminderId)
+{
+    auto it = reminderMap_.find(reminderId);
+    if (it == reminderMap_.end()) {
+        return false;
+    }
+    triggerQueue_.erase(std::make_pair(it->second.queuedTriggerTime, reminderId));
+    if (!it->second.appKey.empty()) {
+        auto ait = appReminders_.find(it->second.appKey);
+        if (ait != appReminders_.end()) {
+            ait->second.erase(reminderId);
+            if (ait->second.empty()) {
+                appReminders_.erase(ait);
+            }
+        }
+    }
+    reminderMap_.erase(it);
+    return true;
+}
+
+std::set<std::pair<uint64_t, int32_t>>::iterator ReminderDataManager::RequeueReminder(const int32_t &reminderId)
+{
+    auto it = reminderMap_.find(reminderId);
+    if (it == reminderMap_.end()) {
+        return triggerQueue_.end();
+    }
+    triggerQueue_.erase(std::make_pair(it->second.queuedTriggerTime, reminderId));
+    if (it->second.reminder != nullptr) {
+        it->second.queuedTriggerTime = it->second.reminder->GetTriggerTimeInMilli();
+    }
+    return triggerQueue_.emplace(it->second.queuedTriggerTime, reminderId).first;
+}
+
+void ReminderDataManager::RebuildTriggerQueue()
+{
+    triggerQueue_.clear();
+    for (auto &item : reminderMap_) {
+        if (item.second.reminder != nullptr) {
+            item.second.queuedTriggerTime = item.second.reminder->GetTriggerTimeInMilli();
+        }
+        triggerQueue_.emplace(item.second.queuedTriggerTime, item.first);
+    }
+}
+
+sptr<ReminderRequest> ReminderDataManager::LoadReminder(ReminderEntry &entry, const int32_t &reminderId)
+{
+    if (entry.reminder == nullptr) {
+        entry.reminder = store_->GetReminder(reminderId);
+        if (entry.reminder == nullptr) {
+            ANSR_LOGE("Load reminder fail, reminderId=%{public}d", reminderId);
+        }
+    }
+    return entry.reminder;
 }
 
 void ReminderDataManager::CloseReminder(const OHOS::EventFwk::Want &want, bool cancelNotification)
@@ -463,17 +553,6 @@ void ReminderDataManager::RefreshRemindersDueToSysTimeChange(uint8_t type)
     StartRecentReminder();
 }
 
-void ReminderDataManager::TerminateAlerting(const OHOS::EventFwk::Want &want)
-{
-    int32_t reminderId = static_cast<int32_t>(want.GetIntParam(ReminderRequest::PARAM_REMINDER_ID, -1));
-    sptr<ReminderRequest> reminder = FindReminderRequestLocked(reminderId);
-    if (reminder == nullptr) {
-        ANSR_LOGE("Invalid reminder id: %{public}d", reminderId);
-        return;
-    }
-    TerminateAlerting(reminder, "timeOut");
-}
-
 void ReminderDataManager::TerminateAlerting(const uint16_t waitInSecond, const sptr<ReminderRequest> &reminder)
 {
     sleep(waitInSecond);
@@ -525,10 +604,11 @@ void ReminderDataManager::UpdateAndSaveReminderLocked(
         ANSR_LOGE("Containers add to map error");
         return;
     }
-    ANSR_LOGD("Containers(vector) add. reminderId=%{public}d", reminderId);
-    reminderVector_.push_back(reminder);
-    totalCount_++;
+    ANSR_LOGD("Containers(indexes) add. reminderId=%{public}d", reminderId);
+    AddToIndexes(reminder, bundleOption);
     store_->UpdateOrInsert(reminder, bundleOption);
+    // A published reminder is written at once, the later changes of its state may be written behind.
+    store_->Flush();
 }
 
 void ReminderDataManager::SetService(AdvancedNotificationService *advancedNotificationService)
@@ -584,16 +664,38 @@ bool ReminderDataManager::ShouldAlert(const sptr<ReminderRequest> &reminder) con
 
 void ReminderDataManager::ShowActiveReminder(const EventFwk::Want &want)
 {
-    int32_t reminderId = static_cast<int32_t>(want.GetIntParam(ReminderRequest::PARAM_REMINDER_ID, -1));
-    ANSR_LOGI("Begin to show reminder(reminderId=%{public}d)", reminderId);
-    if (reminderId == activeReminderId_) {
-        ResetStates(TimerType::TRIGGER_TIMER);
+    ANSR_LOGI("Begin to handle the due deadlines");
+    sptr<ReminderRequest> reminder = nullptr;
+    sptr<ReminderRequest> timeoutReminder = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(ReminderDataManager::TIMER_MUTEX);
+        armedTime_ = 0;  // the system timer is one-shot.
+        time_t now;
+        (void)time(&now);  // unit is seconds.
+        if (now < 0) {
+            ANSR_LOGE("Get now time error");
+            RearmTimer();
+            return;
+        }
+        // Deadlines in the same tick as now are handled together.
+        uint64_t dueTime = ReminderRequest::GetDurationSinceEpochInMilli(now)
+            + ReminderRequest::SAME_TIME_DISTINGUISH_MILLISECONDS;
+        if ((alertingDeadline_ != 0) && (alertingDeadline_ <= dueTime)) {
+            timeoutReminder = alertingReminder_;
+        }
+        if ((triggerDeadline_ != 0) && (triggerDeadline_ <= dueTime)) {
+            reminder = activeReminder_;
+            ResetStates(TimerType::TRIGGER_TIMER);
+        }
+        RearmTimer();
+    }
+    if (timeoutReminder != nullptr) {
+        TerminateAlerting(timeoutReminder, "timeOut");
     }
-    sptr<ReminderRequest> reminder = FindReminderRequestLocked(reminderId);
     if (reminder == nullptr) {
-        ANSR_LOGW("Invalid reminder id: %{public}d", reminderId);
         return;
     }
+    ANSR_LOGI("Show reminder(reminderId=%{public}d)", reminder->GetReminderId());
     if (HandleSysTimeChange(reminder)) {
         return;
     }
@@ -641,15 +743,27 @@ void ReminderDataManager::ShowActiveReminderExtendLocked(sptr<ReminderRequest> &
 {
     std::lock_guard<std::mutex> lock(ReminderDataManager::MUTEX);
     uint64_t triggerTime = reminder->GetTriggerTimeInMilli();
-    bool isAlerting = false;
-    sptr<ReminderRequest> playSoundReminder = nullptr;
-    for (auto it = reminderVector_.begin(); it != reminderVector_.end(); ++it) {
-        if ((*it)->IsExpired()) {
+    // Showing a reminder changes its trigger time, so collect the reminders triggered at the same time first.
+    std::vector<sptr<ReminderRequest>> sameTimeReminders;
+    for (auto it = triggerQueue_.lower_bound(std::make_pair(triggerTime, INT32_MIN));
+        it != triggerQueue_.end() && it->first - triggerTime <= ReminderRequest::SAME_TIME_DISTINGUISH_MILLISECONDS;
+        ++it) {
+        auto rit = reminderMap_.find(it->second);
+        if (rit == reminderMap_.end()) {
+            continue;
+        }
+        sptr<ReminderRequest> tmp = LoadReminder(rit->second, it->second);
+        if (tmp == nullptr || tmp->IsExpired()) {
             continue;
         }
-        if ((*it)->GetTriggerTimeInMilli() - triggerTime > ReminderRequest::SAME_TIME_DISTINGUISH_MILLISECONDS) {
+        if (tmp->GetTriggerTimeInMilli() - triggerTime > ReminderRequest::SAME_TIME_DISTINGUISH_MILLISECONDS) {
             continue;
         }
+        sameTimeReminders.push_back(tmp);
+    }
+    bool isAlerting = false;
+    sptr<ReminderRequest> playSoundReminder = nullptr;
+    for (auto it = sameTimeReminders.begin(); it != sameTimeReminders.end(); ++it) {
         if (!isAlerting) {
             playSoundReminder = (*it);
             isAlerting = true;
@@ -812,39 +926,40 @@ void ReminderDataManager::StopAlertingReminder(const sptr<ReminderRequest> &remi
 std::string ReminderDataManager::Dump() const
 {
     std::lock_guard<std::mutex> lock(ReminderDataManager::MUTEX);
-    std::map<std::string, std::vector<sptr<ReminderRequest>>> bundleNameMap;
-    for (auto it = reminderVector_.begin(); it != reminderVector_.end(); ++it) {
-        if ((*it)->IsExpired()) {
+    // The reminders of each bundle with their trigger times, the ones not loaded yet are not built for the dump.
+    std::map<std::string, std::vector<std::pair<uint64_t, std::string>>> bundleNameMap;
+    for (auto it = reminderMap_.begin(); it != reminderMap_.end(); ++it) {
+        sptr<ReminderRequest> reminder = it->second.reminder;
+        if (reminder != nullptr && reminder->IsExpired()) {
             continue;
         }
-        int32_t reminderId = (*it)->GetReminderId();
+        int32_t reminderId = it->first;
         auto mit = notificationBundleOptionMap_.find(reminderId);
         if (mit == notificationBundleOptionMap_.end()) {
             ANSR_LOGE("Dump get notificationBundleOption(reminderId=%{public}d) fail", reminderId);
             continue;
         }
-        std::string bundleName = mit->second->GetBundleName();
-        auto val = bundleNameMap.find(bundleName);
-        if (val == bundleNameMap.end()) {
-            std::vector<sptr<ReminderRequest>> reminders;
-            reminders.push_back(*it);
-            bundleNameMap.insert(std::pair<std::string, std::vector<sptr<ReminderRequest>>>(bundleName, reminders));
+        if (reminder == nullptr) {
+            bundleNameMap[mit->second->GetBundleName()].emplace_back(it->second.queuedTriggerTime,
+                "ReminderRequest{ reminderId=" + std::to_string(reminderId) + ", triggerTime="
+                + std::to_string(it->second.queuedTriggerTime) + ", notLoaded }");
         } else {
-            val->second.push_back(*it);
+            bundleNameMap[mit->second->GetBundleName()].emplace_back(
+                reminder->GetTriggerTimeInMilli(), reminder->Dump());
         }
     }
 
     std::string allReminders = "";
     for (auto it = bundleNameMap.begin(); it != bundleNameMap.end(); ++it) {
         std::string bundleName = it->first;
-        std::vector<sptr<ReminderRequest>> reminders = it->second;
-        sort(reminders.begin(), reminders.end(), cmp);
+        std::vector<std::pair<uint64_t, std::string>> reminders = it->second;
+        sort(reminders.begin(), reminders.end());
         std::string oneBundleReminders = bundleName + ":{\n";
         oneBundleReminders += "    totalCount:" + std::to_string(reminders.size()) + ",\n";
         oneBundleReminders += "    reminders:{\n";
         for (auto vit = reminders.begin(); vit != reminders.end(); ++vit) {
             oneBundleReminders += "        [\n";
-            std::string reminderInfo = (*vit)->Dump();
+            std::string reminderInfo = vit->second;
             oneBundleReminders += "            " + reminderInfo + "\n";
             oneBundleReminders += "        ],\n";
         }
@@ -853,7 +968,7 @@ std::string ReminderDataManager::Dump() const
         allReminders += oneBundleReminders;
     }
 
-    return "ReminderDataManager{ totalCount:" + std::to_string(totalCount_) + ",\n" +
+    return "ReminderDataManager{ totalCount:" + std::to_string(reminderMap_.size()) + ",\n" +
            "timerId:" + std::to_string(timerId_) + ",\n" +
            "activeReminderId:" + std::to_string(activeReminderId_) + ",\n" +
            allReminders + "}";
@@ -862,27 +977,53 @@ std::string ReminderDataManager::Dump() const
 sptr<ReminderRequest> ReminderDataManager::GetRecentReminderLocked()
 {
     std::lock_guard<std::mutex> lock(ReminderDataManager::MUTEX);
-    sort(reminderVector_.begin(), reminderVector_.end(), cmp);
-    for (auto it = reminderVector_.begin(); it != reminderVector_.end();) {
-        if (!(*it)->IsExpired()) {
-            ANSR_LOGI("GetRecentReminderLocked: %{public}s", (*it)->Dump().c_str());
-            time_t now;
-            (void)time(&now);  // unit is seconds.
-            if (now < 0
-                || ReminderRequest::GetDurationSinceEpochInMilli(now) > (*it)->GetTriggerTimeInMilli()) {
+    time_t now;
+    (void)time(&now);  // unit is seconds.
+    for (auto it = triggerQueue_.begin(); it != triggerQueue_.end();) {
+        uint64_t queuedTriggerTime = it->first;
+        int32_t reminderId = it->second;
+        auto rit = reminderMap_.find(reminderId);
+        if (rit == reminderMap_.end()) {
+            it = triggerQueue_.erase(it);
+            continue;
+        }
+        sptr<ReminderRequest> reminder = rit->second.reminder;
+        if (reminder == nullptr) {
+            // Not loaded yet, it is not expired and its trigger time is the queued one.
+            if (now < 0 || ReminderRequest::GetDurationSinceEpochInMilli(now) > queuedTriggerTime) {
+                it++;
+                continue;
+            }
+            reminder = LoadReminder(rit->second, reminderId);
+            if (reminder == nullptr) {
+                it++;
+                continue;
+            }
+        }
+        uint64_t triggerTime = reminder->GetTriggerTimeInMilli();
+        if (triggerTime != queuedTriggerTime) {
+            // The trigger time changed since the reminder was queued, move it and go on from where it is now
+            // if it moved earlier, or from the next one otherwise.
+            auto newIt = RequeueReminder(reminderId);
+            it = (triggerTime < queuedTriggerTime) ? newIt :
+                triggerQueue_.upper_bound(std::make_pair(queuedTriggerTime, reminderId));
+            continue;
+        }
+        if (!reminder->IsExpired()) {
+            ANSR_LOGI("GetRecentReminderLocked: %{public}s", reminder->Dump().c_str());
+            if (now < 0 || ReminderRequest::GetDurationSinceEpochInMilli(now) > triggerTime) {
                 ANSR_LOGE("Get recent reminder while the trigger time is overdue.");
                 it++;
                 continue;
             }
-            return *it;
+            return reminder;
         }
-        if (!(*it)->CanRemove()) {
-            ANSR_LOGD("Reminder has been expired: %{public}s", (*it)->Dump().c_str());
+        if (!reminder->CanRemove()) {
+            ANSR_LOGD("Reminder has been expired: %{public}s", reminder->Dump().c_str());
             it++;
             continue;
         }
-        int32_t reminderId = (*it)->GetReminderId();
-        ANSR_LOGD("Containers(vector) remove. reminderId=%{public}d", reminderId);
+        ANSR_LOGD("Containers(indexes) remove. reminderId=%{public}d", reminderId);
         auto mit = notificationBundleOptionMap_.find(reminderId);
         if (mit == notificationBundleOptionMap_.end()) {
             ANSR_LOGE("Remove notificationBundleOption(reminderId=%{public}d) fail", reminderId);
@@ -890,8 +1031,8 @@ sptr<ReminderRequest> ReminderDataManager::GetRecentReminderLocked()
             ANSR_LOGD("Containers(map) remove. reminderId=%{public}d", reminderId);
             notificationBundleOptionMap_.erase(mit);
         }
-        it = reminderVector_.erase(it);
-        totalCount_--;
+        it = std::next(it);
+        RemoveFromIndexes(reminderId);
         store_->Delete(reminderId);
     }
     return nullptr;
@@ -946,12 +1087,21 @@ void ReminderDataManager::HandleSameNotificationIdShowing(const sptr<ReminderReq
         return;
     }
 
-    for (auto it = reminderVector_.begin(); it != reminderVector_.end(); ++it) {
-        int32_t tmpId = (*it)->GetReminderId();
+    auto ait = appReminders_.find(
+        GenerateAppKey(mit->second->GetBundleName(), ReminderRequest::GetUserId(mit->second->GetUid())));
+    if (ait == appReminders_.end()) {
+        return;
+    }
+    for (auto tmpId : ait->second) {
         if (tmpId == curReminderId) {
             continue;
         }
-        if (!(*it)->IsShowing()) {
+        auto rit = reminderMap_.find(tmpId);
+        if (rit == reminderMap_.end()) {
+            continue;
+        }
+        sptr<ReminderRequest> tmp = rit->second.reminder;
+        if (tmp == nullptr || !tmp->IsShowing()) {
             continue;
         }
         sptr<NotificationBundleOption>  bundleOption = FindNotificationBundleOption(tmpId);
@@ -959,13 +1109,13 @@ void ReminderDataManager::HandleSameNotificationIdShowing(const sptr<ReminderReq
             ANSR_LOGW("Get notificationBundleOption(reminderId=%{public}d) fail", tmpId);
             continue;
         }
-        if (notificationId == (*it)->GetNotificationId() && IsBelongToSameApp(bundleOption, mit->second)) {
-            if ((*it)->IsAlerting()) {
-                StopAlertingReminder(*it);
+        if (notificationId == tmp->GetNotificationId()) {
+            if (tmp->IsAlerting()) {
+                StopAlertingReminder(tmp);
             }
-            (*it)->OnSameNotificationIdCovered();
-            RemoveFromShowedReminders(*it);
-            store_->UpdateOrInsert((*it), FindNotificationBundleOption((*it)->GetReminderId()));
+            tmp->OnSameNotificationIdCovered();
+            RemoveFromShowedReminders(tmp);
+            store_->UpdateOrInsert(tmp, bundleOption);
         }
     }
 }
@@ -1002,13 +1152,42 @@ void ReminderDataManager::InitUserId()
     }
 }
 
-void ReminderDataManager::GetImmediatelyShowRemindersLocked(std::vector<sptr<ReminderRequest>> &reminders) const
+void ReminderDataManager::GetImmediatelyShowRemindersLocked(std::vector<sptr<ReminderRequest>> &reminders)
 {
     std::lock_guard<std::mutex> lock(ReminderDataManager::MUTEX);
-    for (auto reminderSptr : reminderVector_) {
+    time_t now;
+    (void)time(&now);  // unit is seconds.
+    for (auto it = triggerQueue_.begin(); it != triggerQueue_.end();) {
+        uint64_t queuedTriggerTime = it->first;
+        int32_t reminderId = it->second;
+        auto rit = reminderMap_.find(reminderId);
+        if (rit == reminderMap_.end()) {
+            it++;
+            continue;
+        }
+        // Only the reminders to show are loaded.
+        if ((rit->second.reminder == nullptr) &&
+            ((now < 0) || (queuedTriggerTime > ReminderRequest::GetDurationSinceEpochInMilli(now)))) {
+            break;
+        }
+        sptr<ReminderRequest> reminderSptr = LoadReminder(rit->second, reminderId);
+        if (reminderSptr == nullptr) {
+            it++;
+            continue;
+        }
+        uint64_t triggerTime = reminderSptr->GetTriggerTimeInMilli();
+        if (triggerTime != queuedTriggerTime) {
+            // A stale queued time must not hide the due reminders behind it, move the reminder and go on from
+            // where it is now if it moved earlier, or from the next one otherwise.
+            auto newIt = RequeueReminder(reminderId);
+            it = (triggerTime < queuedTriggerTime) ? newIt :
+                triggerQueue_.upper_bound(std::make_pair(queuedTriggerTime, reminderId));
+            continue;
+        }
         if (!(reminderSptr->ShouldShowImmediately())) {
             break;
         }
+        it++;
         if (reminderSptr->GetReminderType() != ReminderRequest::ReminderType::TIMER) {
             reminderSptr->SetSnoozeTimesDynamic(0);
         }
@@ -1052,28 +1231,32 @@ bool ReminderDataManager::IsBelongToSameApp(const sptr<NotificationBundleOption>
 void ReminderDataManager::LoadReminderFromDb()
 {
     std::lock_guard<std::mutex> lock(ReminderDataManager::MUTEX);
-    std::vector<sptr<ReminderRequest>> existReminders = store_->GetAllValidReminders();
-    reminderVector_ = existReminders;
-    ANSR_LOGD("LoadReminderFromDb, reminder size=%{public}zu", reminderVector_.size());
-    for (auto it = reminderVector_.begin(); it != reminderVector_.end(); ++it) {
-        sptr<NotificationBundleOption> bundleOption = new (std::nothrow) NotificationBundleOption();
+    // Only the schedule is read, the reminders are built when they are needed.
+    ReminderStore::ReminderSchedule schedule;
+    if (!store_->GetAllValidSchedule(schedule)) {
+        ANSR_LOGE("Get reminder schedule fail");
+    }
+    size_t size = schedule.reminderIds.size();
+    ANSR_LOGD("LoadReminderFromDb, reminder size=%{public}zu", size);
+    for (size_t i = 0; i < size; i++) {
+        int32_t reminderId = schedule.reminderIds[i];
+        uint64_t triggerTime = schedule.triggerTimes[i];
+        sptr<NotificationBundleOption> bundleOption =
+            new (std::nothrow) NotificationBundleOption(schedule.bundleNames[i], schedule.uids[i]);
         if (bundleOption == nullptr) {
             ANS_LOGE("Failed to create bundle option due to low memory.");
-            return;
-        }
-        int32_t reminderId = (*it)->GetReminderId();
-        if (!(store_->GetBundleOption(reminderId, bundleOption))) {
-            ANSR_LOGE("Get bundle option fail, reminderId=%{public}d", reminderId);
+            AddToIndexes(reminderId, triggerTime, nullptr);
             continue;
         }
         auto ret = notificationBundleOptionMap_.insert(
             std::pair<int32_t, sptr<NotificationBundleOption>>(reminderId, bundleOption));
         if (!ret.second) {
             ANSR_LOGE("Containers add to map error");
+            AddToIndexes(reminderId, triggerTime, nullptr);
             continue;
         }
+        AddToIndexes(reminderId, triggerTime, bundleOption);
     }
-    totalCount_ = static_cast<int16_t>(reminderVector_.size());
     ReminderRequest::GLOBAL_ID = store_->GetMaxId() + 1;
 }
 
@@ -1173,28 +1356,36 @@ std::vector<sptr<ReminderRequest>> ReminderDataManager::RefreshRemindersLocked(u
 {
     std::lock_guard<std::mutex> lock(ReminderDataManager::MUTEX);
     std::vector<sptr<ReminderRequest>> showImmediately;
-    for (auto it = reminderVector_.begin(); it != reminderVector_.end(); ++it) {
+    std::vector<sptr<ReminderRequest>> reminders;
+    for (auto &item : triggerQueue_) {
+        auto rit = reminderMap_.find(item.second);
+        if (rit == reminderMap_.end()) {
+            continue;
+        }
+        sptr<ReminderRequest> reminder = LoadReminder(rit->second, item.second);
+        if (reminder != nullptr) {
+            reminders.push_back(reminder);
+        }
+    }
+    // The calendar reminders get their next trigger times against the same local time.
+    ReminderRequestCalendar::RefreshPass pass;
+    for (auto it = reminders.begin(); it != reminders.end(); ++it) {
         sptr<ReminderRequest> reminder = HandleRefreshReminder(type, (*it));
         if (reminder != nullptr) {
             showImmediately.push_back(reminder);
         }
     }
+    // The trigger times may move earlier when the system time changes.
+    RebuildTriggerQueue();
     return showImmediately;
 }
 
 void ReminderDataManager::RemoveReminderLocked(const int32_t &reminderId)
 {
     std::lock_guard<std::mutex> lock(ReminderDataManager::MUTEX);
-    for (auto it = reminderVector_.begin(); it != reminderVector_.end();) {
-        if (reminderId == (*it)->GetReminderId()) {
-            ANSR_LOGD("Containers(vector) remove. reminderId=%{public}d", reminderId);
-            it = reminderVector_.erase(it);
-            totalCount_--;
-            store_->Delete(reminderId);
-            break;
-        } else {
-            ++it;
-        }
+    if (RemoveFromIndexes(reminderId)) {
+        ANSR_LOGD("Containers(indexes) remove. reminderId=%{public}d", reminderId);
+        store_->Delete(reminderId);
     }
     auto it = notificationBundleOptionMap_.find(reminderId);
     if (it == notificationBundleOptionMap_.end()) {
@@ -1213,11 +1404,6 @@ void ReminderDataManager::StartTimerLocked(const sptr<ReminderRequest> &reminder
 
 void ReminderDataManager::StartTimer(const sptr<ReminderRequest> &reminderRequest, TimerType type)
 {
-    sptr<MiscServices::TimeServiceClient> timer = MiscServices::TimeServiceClient::GetInstance();
-    if (timer == nullptr) {
-        ANS_LOGE("Failed to start timer due to get TimeServiceClient is null.");
-        return;
-    }
     time_t now;
     (void)time(&now);  // unit is seconds.
     if (now < 0) {
@@ -1227,28 +1413,25 @@ void ReminderDataManager::StartTimer(const sptr<ReminderRequest> &reminderReques
     uint64_t triggerTime = 0;
     switch (type) {
         case TimerType::TRIGGER_TIMER: {
-            if (timerId_ != 0) {
+            if (triggerDeadline_ != 0) {
                 ANSR_LOGE("Trigger timer has already started.");
                 break;
             }
             SetActiveReminder(reminderRequest);
-            timerId_ = timer->CreateTimer(REMINDER_DATA_MANAGER->CreateTimerInfo(type));
             triggerTime = reminderRequest->GetTriggerTimeInMilli();
-            timer->StartTimer(timerId_, triggerTime);
-            ANSR_LOGD("Start timing (next triggerTime), timerId=%{public}" PRIu64 "", timerId_);
+            triggerDeadline_ = triggerTime;
+            ANSR_LOGD("Start timing (next triggerTime)");
             break;
         }
         case TimerType::ALERTING_TIMER: {
-            if (timerIdAlerting_ != 0) {
+            if (alertingDeadline_ != 0) {
                 ANSR_LOGE("Alerting time out timer has already started.");
                 break;
             }
             triggerTime = ReminderRequest::GetDurationSinceEpochInMilli(now)
                 + static_cast<uint64_t>(reminderRequest->GetRingDuration() * ReminderRequest::MILLI_SECONDS);
-            timerIdAlerting_ = timer->CreateTimer(REMINDER_DATA_MANAGER->CreateTimerInfo(type));
-            timer->StartTimer(timerIdAlerting_, triggerTime);
-            ANSR_LOGD(
-                "Start timing (alerting time out), timerId=%{public}" PRIu64 "", timerIdAlerting_);
+            alertingDeadline_ = triggerTime;
+            ANSR_LOGD("Start timing (alerting time out)");
             break;
         }
         default: {
@@ -1256,6 +1439,7 @@ void ReminderDataManager::StartTimer(const sptr<ReminderRequest> &reminderReques
             break;
         }
     }
+    RearmTimer();
     if (triggerTime == 0) {
         ANSR_LOGW("Start timer fail");
     } else {
@@ -1272,20 +1456,15 @@ void ReminderDataManager::StopTimerLocked(TimerType type)
 
 void ReminderDataManager::StopTimer(TimerType type)
 {
-    sptr<MiscServices::TimeServiceClient> timer = MiscServices::TimeServiceClient::GetInstance();
-    if (timer == nullptr) {
-        ANSR_LOGE("Failed to stop timer due to get TimeServiceClient is null.");
-        return;
-    }
-    uint64_t timerId = 0;
+    uint64_t deadline = 0;
     switch (type) {
         case TimerType::TRIGGER_TIMER: {
-            timerId = timerId_;
+            deadline = triggerDeadline_;
             ANSR_LOGD("Stop timing (next triggerTime)");
             break;
         }
         case TimerType::ALERTING_TIMER: {
-            timerId = timerIdAlerting_;
+            deadline = alertingDeadline_;
             ANSR_LOGD("Stop timing (alerting time out)");
             break;
         }
@@ -1294,27 +1473,59 @@ void ReminderDataManager::StopTimer(TimerType type)
             break;
         }
     }
-    if (timerId == 0) {
+    if (deadline == 0) {
         ANSR_LOGD("Timer is not running");
         return;
     }
-    ANSR_LOGD("Stop timer id=%{public}" PRIu64 "", timerId);
-    timer->StopTimer(timerId);
     ResetStates(type);
+    RearmTimer();
+}
+
+void ReminderDataManager::RearmTimer()
+{
+    uint64_t deadline = triggerDeadline_;
+    if ((alertingDeadline_ != 0) && ((deadline == 0) || (alertingDeadline_ < deadline))) {
+        deadline = alertingDeadline_;
+    }
+    if (deadline == armedTime_) {
+        return;
+    }
+    sptr<MiscServices::TimeServiceClient> timer = MiscServices::TimeServiceClient::GetInstance();
+    if (timer == nullptr) {
+        ANSR_LOGE("Failed to arm timer due to get TimeServiceClient is null.");
+        return;
+    }
+    if (armedTime_ != 0) {
+        timer->StopTimer(timerId_);
+        armedTime_ = 0;
+    }
+    if (deadline == 0) {
+        ANSR_LOGD("Stop timer id=%{public}" PRIu64 "", timerId_);
+        return;
+    }
+    if (timerId_ == 0) {
+        timerId_ = timer->CreateTimer(CreateTimerInfo());
+    }
+    if (!timer->StartTimer(timerId_, deadline)) {
+        ANSR_LOGE("Failed to start timer id=%{public}" PRIu64 "", timerId_);
+        return;
+    }
+    armedTime_ = deadline;
+    ANSR_LOGD("Arm timer id=%{public}" PRIu64 " at %{public}" PRIu64 "", timerId_, deadline);
 }
 
 void ReminderDataManager::ResetStates(TimerType type)
 {
     switch (type) {
         case TimerType::TRIGGER_TIMER: {
-            ANSR_LOGD("ResetStates(activeReminderId, timerId(next triggerTime))");
-            timerId_ = 0;
+            ANSR_LOGD("ResetStates(activeReminderId, triggerDeadline)");
+            triggerDeadline_ = 0;
             activeReminderId_ = -1;
             break;
         }
         case TimerType::ALERTING_TIMER: {
-            ANSR_LOGD("ResetStates(alertingReminderId, timeId(alerting time out))");
-            timerIdAlerting_ = 0;
+            ANSR_LOGD("ResetStates(alertingReminderId, alertingDeadline)");
+            alertingDeadline_ = 0;
             alertingReminderId_ = -1;
             break;
         }
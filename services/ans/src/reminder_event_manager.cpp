@@ -38,7 +38,6 @@ void ReminderEventManager::init(std::shared_ptr<ReminderDataManager> &reminderDa
 {
     MatchingSkills matchingSkills;
     matchingSkills.AddEvent(ReminderRequest::REMINDER_EVENT_ALARM_ALERT);
-    matchingSkills.AddEvent(ReminderRequest::REMINDER_EVENT_ALERT_TIMEOUT);
     matchingSkills.AddEvent(ReminderRequest::REMINDER_EVENT_CLOSE_ALERT);
     matchingSkills.AddEvent(ReminderRequest::REMINDER_EVENT_SNOOZE_ALERT);
     matchingSkills.AddEvent(CommonEventSupport::COMMON_EVENT_BOOT_COMPLETED);
@@ -93,10 +92,6 @@ void ReminderEventManager::ReminderEventSubscriber::OnReceiveEvent(const EventFw
         reminderDataManager_->ShowActiveReminder(want);
         return;
     }
-    if (action == ReminderRequest::REMINDER_EVENT_ALERT_TIMEOUT) {
-        reminderDataManager_->TerminateAlerting(want);
-        return;
-    }
     if (action == ReminderRequest::REMINDER_EVENT_CLOSE_ALERT) {
         reminderDataManager_->CloseReminder(want, true);
         return;
@@ -1650,5 +1650,65 @@ HWTEST_F(AdvancedNotificationServiceTest, AdvancedNotificationServiceTest_11300,
     EXPECT_EQ(
         advancedNotificationService_->CancelContinuousTaskNotification(label, 1), (int)ERR_ANS_NOT_SYSTEM_SERVICE);
 }
+
+/**
+ * @tc.number    : AdvancedNotificationServiceTest_11400
+ * @tc.name      : ANS_PublishBatch_0100
+ * @tc.desc      : Publish a batch of notifications and cancel them in one batch, results are per notification
+ */
+HWTEST_F(AdvancedNotificationServiceTest, AdvancedNotificationServiceTest_11400, Function | SmallTest | Level1)
+{
+    TestAddSlot(NotificationConstant::SlotType::OTHER);
+    std::string label = "batch's label";
+    std::vector<sptr<NotificationRequest>> requests;
+    for (int32_t id = 1; id <= 3; id++) {
+        sptr<NotificationRequest> req = new NotificationRequest(id);
+        req->SetSlotType(NotificationConstant::SlotType::OTHER);
+        req->SetLabel(label);
+        std::shared_ptr<NotificationNormalContent> normalContent = std::make_shared<NotificationNormalContent>();
+        normalContent->SetText("normalContent's text");
+        normalContent->SetTitle("normalContent's title");
+        req->SetContent(std::make_shared<NotificationContent>(normalContent));
+        requests.push_back(req);
+    }
+    requests.push_back(nullptr);
+
+    std::vector<ErrCode> results;
+    EXPECT_EQ(advancedNotificationService_->PublishBatch(label, requests, results), (int)ERR_ANS_INVALID_PARAM);
+    ASSERT_EQ(results.size(), requests.size());
+    EXPECT_EQ(results[0], (int)ERR_OK);
+    EXPECT_EQ(results[1], (int)ERR_OK);
+    EXPECT_EQ(results[2], (int)ERR_OK);
+    EXPECT_EQ(results[3], (int)ERR_ANS_INVALID_PARAM);
+
+    std::vector<int32_t> ids = {1, 2, 3, 4};
+    EXPECT_EQ(advancedNotificationService_->CancelBatch(label, ids, results), (int)ERR_ANS_NOTIFICATION_NOT_EXISTS);
+    ASSERT_EQ(results.size(), ids.size());
+    EXPECT_EQ(results[0], (int)ERR_OK);
+    EXPECT_EQ(results[1], (int)ERR_OK);
+    EXPECT_EQ(results[2], (int)ERR_OK);
+    EXPECT_EQ(results[3], (int)ERR_ANS_NOTIFICATION_NOT_EXISTS);
+    SleepForFC();
+}
+
+/**
+ * @tc.number    : AdvancedNotificationServiceTest_11500
+ * @tc.name      : ANS_PublishBatch_0200
+ * @tc.desc      : Test PublishBatch and CancelBatch reject empty and oversized batches
+ */
+HWTEST_F(AdvancedNotificationServiceTest, AdvancedNotificationServiceTest_11500, Function | SmallTest | Level1)
+{
+    std::string label = "batch's label";
+    std::vector<ErrCode> results;
+    std::vector<sptr<NotificationRequest>> requests;
+    EXPECT_EQ(advancedNotificationService_->PublishBatch(label, requests, results), (int)ERR_ANS_INVALID_PARAM);
+    requests.assign(MAX_NOTIFICATION_BATCH_NUM + 1, new NotificationRequest(1));
+    EXPECT_EQ(advancedNotificationService_->PublishBatch(label, requests, results), (int)ERR_ANS_INVALID_PARAM);
+
+    std::vector<int32_t> ids;
+    EXPECT_EQ(advancedNotificationService_->CancelBatch(label, ids, results), (int)ERR_ANS_INVALID_PARAM);
+    ids.assign(MAX_NOTIFICATION_BATCH_NUM + 1, 1);
+    EXPECT_EQ(advancedNotificationService_->CancelBatch(label, ids, results), (int)ERR_ANS_INVALID_PARAM);
+}
 }  // namespace Notification
 }  // namespace OHOS
\ No newline at end of file
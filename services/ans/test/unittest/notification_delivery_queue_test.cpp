@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <gtest/gtest.h>
+
+#define private public
+#include "notification_delivery_queue.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace Notification {
+using OverflowPolicy = NotificationDeliveryQueue::OverflowPolicy;
+using PushResult = NotificationDeliveryQueue::PushResult;
+using SortingMapType = NotificationDeliveryQueue::SortingMapType;
+
+class NotificationDeliveryQueueTest : public testing::Test {
+public:
+    static void SetUpTestCase() {};
+    static void TearDownTestCase() {};
+    void SetUp() {};
+    void TearDown() {};
+};
+
+/**
+ * @tc.number    : NotificationDeliveryQueueTest_00100
+ * @tc.name      : ANS_Push_0100
+ * @tc.desc      : Test COALESCE policy replaces the queued callback of the same key at the tail, or drops the oldest
+ */
+HWTEST_F(NotificationDeliveryQueueTest, NotificationDeliveryQueueTest_00100, Function | SmallTest | Level1)
+{
+    // Without a handler the callbacks stay queued until they are drained by the test.
+    auto queue = std::make_shared<NotificationDeliveryQueue>(nullptr, 2, OverflowPolicy::COALESCE);
+    std::vector<int32_t> delivered;
+    EXPECT_EQ(queue->Push("key0", [&delivered]() { delivered.push_back(0); }), PushResult::QUEUED);
+    EXPECT_EQ(queue->Push("key1", [&delivered]() { delivered.push_back(1); }), PushResult::QUEUED);
+    EXPECT_EQ(queue->Push("key0", [&delivered]() { delivered.push_back(2); }), PushResult::COALESCED);
+    EXPECT_EQ(queue->Push("key3", [&delivered]() { delivered.push_back(3); }), PushResult::DROPPED_OLDEST);
+
+    NotificationDeliveryQueue::Stats stats = queue->GetStats();
+    EXPECT_EQ(stats.depth, 2);
+    EXPECT_EQ(stats.coalesced, 1);
+    EXPECT_EQ(stats.dropped, 1);
+
+    // The coalesced callback moved after key1, so key1 is the oldest one dropped.
+    queue->Drain();
+    EXPECT_EQ(delivered, std::vector<int32_t>({2, 3}));
+    EXPECT_EQ(queue->GetStats().delivered, 2);
+}
+
+/**
+ * @tc.number    : NotificationDeliveryQueueTest_00200
+ * @tc.name      : ANS_Push_0200
+ * @tc.desc      : Test DROP_OLDEST policy never coalesces and DISCONNECT policy rejects the callback
+ */
+HWTEST_F(NotificationDeliveryQueueTest, NotificationDeliveryQueueTest_00200, Function | SmallTest | Level1)
+{
+    auto queue = std::make_shared<NotificationDeliveryQueue>(nullptr, 1, OverflowPolicy::DROP_OLDEST);
+    EXPECT_EQ(queue->Push("key", []() {}), PushResult::QUEUED);
+    EXPECT_EQ(queue->Push("key", []() {}), PushResult::DROPPED_OLDEST);
+
+    queue->SetPolicy(1, OverflowPolicy::DISCONNECT);
+    EXPECT_EQ(queue->Push("key", []() {}), PushResult::REJECTED);
+    EXPECT_EQ(queue->GetStats().depth, 1);
+
+    queue->Stop();
+    EXPECT_EQ(queue->Push("key", []() {}), PushResult::CLOSED);
+    EXPECT_EQ(queue->GetStats().depth, 0);
+}
+
+/**
+ * @tc.number    : NotificationDeliveryQueueTest_00300
+ * @tc.name      : ANS_Close_0100
+ * @tc.desc      : Test the callbacks are delivered in order on the handler and the last one is the closing callback
+ */
+HWTEST_F(NotificationDeliveryQueueTest, NotificationDeliveryQueueTest_00300, Function | SmallTest | Level1)
+{
+    auto handler = std::make_shared<AppExecFwk::EventHandler>(AppExecFwk::EventRunner::Create());
+    auto queue = std::make_shared<NotificationDeliveryQueue>(handler, 1, OverflowPolicy::COALESCE);
+    std::vector<int32_t> delivered;
+    const int32_t callbackNum = 100;
+    for (int32_t i = 0; i < callbackNum; i++) {
+        queue->Push("", [&delivered, i]() { delivered.push_back(i); });
+    }
+    queue->Close([&delivered]() { delivered.push_back(-1); });
+    EXPECT_EQ(queue->Push("", []() {}), PushResult::CLOSED);
+
+    ASSERT_EQ(delivered.size(), callbackNum + 1);
+    for (int32_t i = 0; i < callbackNum; i++) {
+        EXPECT_EQ(delivered[i], i);
+    }
+    EXPECT_EQ(delivered.back(), -1);
+    EXPECT_EQ(queue->GetStats().delivered, callbackNum + 1);
+    EXPECT_EQ(NotificationDeliveryQueue::PolicyToString(OverflowPolicy::DROP_OLDEST), "dropOldest");
+}
+
+/**
+ * @tc.number    : NotificationDeliveryQueueTest_00400
+ * @tc.name      : ANS_Push_0300
+ * @tc.desc      : Test the delta queued after a given up sorting map is replaced by its full sorting map
+ */
+HWTEST_F(NotificationDeliveryQueueTest, NotificationDeliveryQueueTest_00400, Function | SmallTest | Level1)
+{
+    auto queue = std::make_shared<NotificationDeliveryQueue>(nullptr, 3, OverflowPolicy::COALESCE);
+    std::vector<std::string> delivered;
+    auto push = [&queue, &delivered](const std::string &key, const std::string &name, SortingMapType type) {
+        return queue->Push(key, [&delivered, name]() { delivered.push_back(name + "-delta"); }, type,
+            [&delivered, name]() { delivered.push_back(name + "-full"); });
+    };
+    EXPECT_EQ(push("key0", "a", SortingMapType::DELTA), PushResult::QUEUED);
+    EXPECT_EQ(push("key1", "b", SortingMapType::DELTA), PushResult::QUEUED);
+    EXPECT_EQ(push("key2", "c", SortingMapType::DELTA), PushResult::QUEUED);
+    // b is coalesced, so c no longer applies to the sorting map before it.
+    EXPECT_EQ(push("key1", "d", SortingMapType::DELTA), PushResult::COALESCED);
+    // a is dropped, c is full already and d applies to it.
+    EXPECT_EQ(push("key4", "e", SortingMapType::DELTA), PushResult::DROPPED_OLDEST);
+
+    queue->Drain();
+    EXPECT_EQ(delivered, std::vector<std::string>({"c-full", "d-delta", "e-delta"}));
+}
+}  // namespace Notification
+}  // namespace OHOS
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "notification_image_cache.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace Notification {
+namespace {
+constexpr int32_t IMAGE_SIZE = 16;
+constexpr size_t IMAGE_BYTES = IMAGE_SIZE * IMAGE_SIZE * sizeof(uint32_t);
+
+std::shared_ptr<Media::PixelMap> CreatePixelMap(uint32_t color)
+{
+    std::vector<uint32_t> colors(IMAGE_SIZE * IMAGE_SIZE, color);
+    Media::InitializationOptions opts;
+    opts.size.width = IMAGE_SIZE;
+    opts.size.height = IMAGE_SIZE;
+    opts.pixelFormat = Media::PixelFormat::RGBA_8888;
+    return Media::PixelMap::Create(colors.data(), colors.size(), opts);
+}
+}  // namespace
+
+class NotificationImageCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase() {};
+    static void TearDownTestCase() {};
+    void SetUp() {};
+    void TearDown() {};
+};
+
+/**
+ * @tc.number    : NotificationImageCacheTest_00100
+ * @tc.name      : ANS_Share_0100
+ * @tc.desc      : Test Share returns the cached image for the images of the same content
+ */
+HWTEST_F(NotificationImageCacheTest, NotificationImageCacheTest_00100, Function | SmallTest | Level1)
+{
+    NotificationImageCache cache(IMAGE_BYTES * 4);
+    std::shared_ptr<Media::PixelMap> first = CreatePixelMap(0xff0000ff);
+    std::shared_ptr<Media::PixelMap> second = CreatePixelMap(0xff0000ff);
+    std::shared_ptr<Media::PixelMap> other = CreatePixelMap(0xff00ff00);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    ASSERT_NE(other, nullptr);
+
+    std::shared_ptr<Media::PixelMap> firstShared = cache.Share(first);
+    std::shared_ptr<Media::PixelMap> secondShared = cache.Share(second);
+    std::shared_ptr<Media::PixelMap> otherShared = cache.Share(other);
+    EXPECT_EQ(firstShared, first);
+    EXPECT_EQ(secondShared, first);
+    EXPECT_EQ(otherShared, other);
+    EXPECT_EQ(cache.Share(nullptr), nullptr);
+
+    NotificationImageCache::Stats stats = cache.GetStats();
+    EXPECT_EQ(stats.entries, 2);
+    EXPECT_EQ(stats.bytes, IMAGE_BYTES * 2);
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 2);
+}
+
+/**
+ * @tc.number    : NotificationImageCacheTest_00200
+ * @tc.name      : ANS_Share_0200
+ * @tc.desc      : Test Share evicts the least recently used image over the budget
+ */
+HWTEST_F(NotificationImageCacheTest, NotificationImageCacheTest_00200, Function | SmallTest | Level1)
+{
+    NotificationImageCache cache(IMAGE_BYTES * 2);
+    std::shared_ptr<Media::PixelMap> red = CreatePixelMap(0xff0000ff);
+    std::shared_ptr<Media::PixelMap> green = CreatePixelMap(0xff00ff00);
+    std::shared_ptr<Media::PixelMap> blue = CreatePixelMap(0xffff0000);
+    EXPECT_EQ(cache.Share(red), red);
+    EXPECT_EQ(cache.Share(green), green);
+    // Using red again makes green the least recently used image.
+    EXPECT_EQ(cache.Share(CreatePixelMap(0xff0000ff)), red);
+    EXPECT_EQ(cache.Share(blue), blue);
+
+    NotificationImageCache::Stats stats = cache.GetStats();
+    EXPECT_EQ(stats.entries, 2);
+    EXPECT_EQ(stats.evictions, 1);
+    EXPECT_EQ(cache.Share(CreatePixelMap(0xff0000ff)), red);
+    std::shared_ptr<Media::PixelMap> greenCopy = CreatePixelMap(0xff00ff00);
+    EXPECT_EQ(cache.Share(greenCopy), greenCopy);
+}
+
+/**
+ * @tc.number    : NotificationImageCacheTest_00300
+ * @tc.name      : ANS_SetBudget_0100
+ * @tc.desc      : Test the images over the budget are not cached and a smaller budget evicts the cached ones
+ */
+HWTEST_F(NotificationImageCacheTest, NotificationImageCacheTest_00300, Function | SmallTest | Level1)
+{
+    NotificationImageCache cache(IMAGE_BYTES - 1);
+    std::shared_ptr<Media::PixelMap> red = CreatePixelMap(0xff0000ff);
+    EXPECT_EQ(cache.Share(red), red);
+    EXPECT_EQ(cache.GetStats().entries, 0);
+
+    cache.SetBudget(IMAGE_BYTES * 2);
+    EXPECT_EQ(cache.Share(red), red);
+    EXPECT_EQ(cache.Share(CreatePixelMap(0xff00ff00))->GetByteCount(), static_cast<int32_t>(IMAGE_BYTES));
+    EXPECT_EQ(cache.GetStats().entries, 2);
+
+    // The evicted image stays alive for its users.
+    cache.SetBudget(0);
+    NotificationImageCache::Stats stats = cache.GetStats();
+    EXPECT_EQ(stats.entries, 0);
+    EXPECT_EQ(stats.bytes, 0);
+    EXPECT_EQ(stats.evictions, 2);
+    EXPECT_NE(red->GetPixels(), nullptr);
+}
+
+/**
+ * @tc.number    : NotificationImageCacheTest_00400
+ * @tc.name      : ANS_Dump_0100
+ * @tc.desc      : Test the references out of the cache are reported as saved bytes
+ */
+HWTEST_F(NotificationImageCacheTest, NotificationImageCacheTest_00400, Function | SmallTest | Level1)
+{
+    NotificationImageCache cache(IMAGE_BYTES * 4);
+    std::vector<std::shared_ptr<Media::PixelMap>> users;
+    const int32_t userNum = 3;
+    for (int32_t i = 0; i < userNum; i++) {
+        users.push_back(cache.Share(CreatePixelMap(0xff0000ff)));
+    }
+
+    NotificationImageCache::Stats stats = cache.GetStats();
+    EXPECT_EQ(stats.inUseEntries, 1);
+    EXPECT_EQ(stats.savedBytes, IMAGE_BYTES * (userNum - 1));
+
+    std::vector<std::string> dumpInfo;
+    cache.Dump(dumpInfo);
+    ASSERT_EQ(dumpInfo.size(), 1);
+    EXPECT_NE(dumpInfo[0].find("ImageCache"), std::string::npos);
+}
+}  // namespace Notification
+}  // namespace OHOS
@@ -14,6 +14,7 @@
  */
 
 #define private public
+#include <set>
 #include <gtest/gtest.h>
 
 #include "notification_preferences_database.h"
@@ -354,6 +355,111 @@ HWTEST_F(NotificationPreferencesDatabaseTest, ParseFromDisturbeDB_00100, Functio
     EXPECT_TRUE(preferncesDB_->ParseFromDisturbeDB(info));
 }
 
+/**
+ * @tc.number    : ParseFromDisturbeDB_00200
+ * @tc.name      :
+ * @tc.desc      : Parse the slots and groups of the bundles from disturbe DB in one scan.
+ */
+HWTEST_F(NotificationPreferencesDatabaseTest, ParseFromDisturbeDB_00200, Function | SmallTest | Level1)
+{
+    EXPECT_TRUE(preferncesDB_->RemoveAllDataFromDisturbeDB());
+    sptr<NotificationSlot> slot = new NotificationSlot(NotificationConstant::SlotType::SOCIAL_COMMUNICATION);
+    slot->SetVibrationStyle({1, 2});
+    slot->SetEnableVibration(false);
+    slot->SetDescription("description");
+    EXPECT_TRUE(preferncesDB_->PutSlotsToDisturbeDB(bundleName_, bundleUid_, {slot}));
+    sptr<NotificationSlotGroup> group = new NotificationSlotGroup("group_id", "name");
+    group->SetDescription("groupDescription");
+    EXPECT_TRUE(preferncesDB_->PutGroupsToDisturbeDB(bundleName_, bundleUid_, {group}));
+    // The bundle key of this bundle starts with the bundle key of the other one.
+    std::string otherBundleName = bundleName_ + std::to_string(bundleUid_) + "_other";
+    sptr<NotificationSlot> otherSlot = new NotificationSlot(NotificationConstant::SlotType::OTHER);
+    EXPECT_TRUE(preferncesDB_->PutSlotsToDisturbeDB(otherBundleName, 1, {otherSlot}));
+
+    NotificationPreferencesInfo info;
+    EXPECT_TRUE(preferncesDB_->ParseFromDisturbeDB(info));
+    NotificationPreferencesInfo::BundleInfo bundleInfo;
+    EXPECT_TRUE(info.GetBundleInfo(new NotificationBundleOption(bundleName_, bundleUid_), bundleInfo));
+    sptr<NotificationSlot> loadedSlot;
+    EXPECT_TRUE(bundleInfo.GetSlot(NotificationConstant::SlotType::SOCIAL_COMMUNICATION, loadedSlot));
+    ASSERT_NE(loadedSlot, nullptr);
+    EXPECT_FALSE(loadedSlot->CanVibrate());
+    EXPECT_EQ(loadedSlot->GetVibrationStyle(), std::vector<int64_t>({1, 2}));
+    EXPECT_EQ(loadedSlot->GetDescription(), "description");
+    EXPECT_FALSE(bundleInfo.GetSlot(NotificationConstant::SlotType::OTHER, loadedSlot));
+    sptr<NotificationSlotGroup> loadedGroup;
+    EXPECT_TRUE(bundleInfo.GetGroup("group_id", loadedGroup));
+    ASSERT_NE(loadedGroup, nullptr);
+    EXPECT_EQ(loadedGroup->GetName(), "name");
+    EXPECT_EQ(loadedGroup->GetDescription(), "groupDescription");
+
+    NotificationPreferencesInfo::BundleInfo otherInfo;
+    EXPECT_TRUE(info.GetBundleInfo(new NotificationBundleOption(otherBundleName, 1), otherInfo));
+    EXPECT_TRUE(otherInfo.GetSlot(NotificationConstant::SlotType::OTHER, loadedSlot));
+    EXPECT_TRUE(preferncesDB_->RemoveAllDataFromDisturbeDB());
+}
+
+/**
+ * @tc.number    : ParseFromDisturbeDB_00300
+ * @tc.name      :
+ * @tc.desc      : Parse the entries of the layout with one entry per property, and migrate them to records.
+ */
+HWTEST_F(NotificationPreferencesDatabaseTest, ParseFromDisturbeDB_00300, Function | SmallTest | Level1)
+{
+    EXPECT_TRUE(preferncesDB_->RemoveAllDataFromDisturbeDB());
+    std::string bundleKey = bundleName_ + std::to_string(bundleUid_);
+    std::string slotType = std::to_string(NotificationConstant::SlotType::SOCIAL_COMMUNICATION);
+    std::vector<DistributedKv::Entry> entries;
+    auto addEntry = [&entries](const std::string &key, const std::string &value) {
+        DistributedKv::Entry entry;
+        entry.key = DistributedKv::Key(key);
+        entry.value = DistributedKv::Value(value);
+        entries.push_back(entry);
+    };
+    addEntry(KEY_BUNDLE_LABEL + bundleKey, bundleKey);
+    addEntry(preferncesDB_->GenerateBundleKey(bundleKey, KEY_BUNDLE_NAME), bundleName_);
+    addEntry(preferncesDB_->GenerateBundleKey(bundleKey, KEY_BUNDLE_UID), std::to_string(bundleUid_));
+    addEntry(preferncesDB_->GenerateBundleKey(bundleKey, KEY_BUNDLE_BADGE_TOTAL_NUM), "3");
+    addEntry(preferncesDB_->GenerateSlotKey(bundleKey, slotType, KEY_SLOT_TYPE), slotType);
+    addEntry(preferncesDB_->GenerateSlotKey(bundleKey, slotType, KEY_SLOT_DESCRIPTION), "description");
+    addEntry(preferncesDB_->GenerateSlotKey(bundleKey, slotType, KEY_SLOT_VIBRATION_STYLE), "1_2_");
+    addEntry(preferncesDB_->GenerateSlotKey(bundleKey, slotType, KEY_SLOT_ENABLE_VRBRATION), "0");
+    addEntry(preferncesDB_->GenerateGroupKey(bundleKey, "group_id") + KEY_UNDER_LINE + KEY_GROUP_NAME, "name");
+    ASSERT_TRUE(preferncesDB_->CheckKvStore());
+    EXPECT_EQ(preferncesDB_->kvStorePtr_->PutBatch(entries), DistributedKv::Status::SUCCESS);
+
+    for (int32_t i = 0; i < 2; i++) {
+        // The second load reads the records the first one migrated to.
+        NotificationPreferencesInfo info;
+        EXPECT_TRUE(preferncesDB_->ParseFromDisturbeDB(info));
+        NotificationPreferencesInfo::BundleInfo bundleInfo;
+        EXPECT_TRUE(info.GetBundleInfo(new NotificationBundleOption(bundleName_, bundleUid_), bundleInfo));
+        EXPECT_EQ(bundleInfo.GetBadgeTotalNum(), 3);
+        sptr<NotificationSlot> slot;
+        EXPECT_TRUE(bundleInfo.GetSlot(NotificationConstant::SlotType::SOCIAL_COMMUNICATION, slot));
+        ASSERT_NE(slot, nullptr);
+        EXPECT_FALSE(slot->CanVibrate());
+        EXPECT_EQ(slot->GetVibrationStyle(), std::vector<int64_t>({1, 2}));
+        EXPECT_EQ(slot->GetDescription(), "description");
+        sptr<NotificationSlotGroup> group;
+        EXPECT_TRUE(bundleInfo.GetGroup("group_id", group));
+        ASSERT_NE(group, nullptr);
+        EXPECT_EQ(group->GetName(), "name");
+    }
+
+    std::vector<DistributedKv::Entry> bundleEntries;
+    DistributedKv::Key bundlePrefix(preferncesDB_->GenerateBundleKey(bundleKey));
+    EXPECT_EQ(preferncesDB_->kvStorePtr_->GetEntries(bundlePrefix, bundleEntries), DistributedKv::Status::SUCCESS);
+    std::set<std::string> keys;
+    for (auto &entry : bundleEntries) {
+        keys.insert(entry.key.ToString());
+    }
+    EXPECT_EQ(keys, std::set<std::string>({preferncesDB_->GenerateBundleKey(bundleKey, KEY_BUNDLE_RECORD),
+        preferncesDB_->GenerateSlotRecordKey(bundleKey, slotType),
+        preferncesDB_->GenerateGroupRecordKey(bundleKey, "group_id")}));
+    EXPECT_TRUE(preferncesDB_->RemoveAllDataFromDisturbeDB());
+}
+
 /**
  * @tc.name      : RemoveAllDataFromDisturbeDB_00100
  * @tc.number    :
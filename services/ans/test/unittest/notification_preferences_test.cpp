@@ -1149,5 +1149,47 @@ HWTEST_F(NotificationPreferencesTest, GetHasPoppedDialog_00100, Function | Small
     EXPECT_EQ((int)NotificationPreferences::GetInstance().GetHasPoppedDialog(bundleOption_, hasPopped), (int)ERR_OK);
     EXPECT_TRUE(hasPopped);
 }
+
+/**
+ * @tc.number    : SetBundleProperty_00100
+ * @tc.name      :
+ * @tc.desc      : Set properties of two bundles, each bundle keeps its slots and the properties set before
+ */
+HWTEST_F(NotificationPreferencesTest, SetBundleProperty_00100, Function | SmallTest | Level1)
+{
+    TestAddNotificationSlot();
+    EXPECT_EQ((int)NotificationPreferences::GetInstance().SetImportance(bundleOption_, 1), (int)ERR_OK);
+    EXPECT_EQ((int)NotificationPreferences::GetInstance().SetShowBadge(noExsitbundleOption_, true), (int)ERR_OK);
+
+    std::vector<sptr<NotificationSlot>> slots;
+    EXPECT_EQ((int)NotificationPreferences::GetInstance().GetNotificationAllSlots(bundleOption_, slots), (int)ERR_OK);
+    EXPECT_EQ(slots.size(), 1);
+    int32_t importance = 0;
+    EXPECT_EQ((int)NotificationPreferences::GetInstance().GetImportance(bundleOption_, importance), (int)ERR_OK);
+    EXPECT_EQ(importance, 1);
+    bool enable = false;
+    EXPECT_EQ((int)NotificationPreferences::GetInstance().IsShowBadge(noExsitbundleOption_, enable), (int)ERR_OK);
+    EXPECT_TRUE(enable);
+}
+
+/**
+ * @tc.number    : AddNotificationSlotGroups_00600
+ * @tc.name      :
+ * @tc.desc      : Add slot groups with an invalid one, none of the groups is added
+ */
+HWTEST_F(NotificationPreferencesTest, AddNotificationSlotGroups_00600, Function | SmallTest | Level1)
+{
+    TestAddNotificationSlot();
+    std::vector<sptr<NotificationSlotGroup>> groups;
+    groups.push_back(new NotificationSlotGroup("id", "name"));
+    groups.push_back(new NotificationSlotGroup("", "name"));
+    EXPECT_EQ((int)NotificationPreferences::GetInstance().AddNotificationSlotGroups(bundleOption_, groups),
+        (int)ERR_ANS_PREFERENCES_NOTIFICATION_SLOTGROUP_ID_INVALID);
+
+    std::vector<sptr<NotificationSlotGroup>> result;
+    EXPECT_EQ(
+        (int)NotificationPreferences::GetInstance().GetNotificationAllSlotGroups(bundleOption_, result), (int)ERR_OK);
+    EXPECT_TRUE(result.empty());
+}
 }  // namespace Notification
 }  // namespace OHOS
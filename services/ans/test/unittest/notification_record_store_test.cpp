@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#define private public
+#include "notification_record_store.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace Notification {
+namespace {
+std::shared_ptr<NotificationRecord> CreateRecord(int32_t id, const std::string &bundleName, int32_t uid,
+    const std::string &groupName = "", int64_t createTime = 0)
+{
+    sptr<NotificationRequest> request = new NotificationRequest(id);
+    request->createTime_ = createTime;
+    request->SetOwnerBundleName(bundleName);
+    request->SetCreatorUid(uid);
+    request->SetGroupName(groupName);
+    std::shared_ptr<NotificationRecord> record = std::make_shared<NotificationRecord>();
+    record->request = request;
+    record->notification = new Notification(request);
+    record->bundleOption = new NotificationBundleOption(bundleName, uid);
+    return record;
+}
+}  // namespace
+
+class NotificationRecordStoreTest : public testing::Test {
+public:
+    static void SetUpTestCase() {};
+    static void TearDownTestCase() {};
+    void SetUp() {};
+    void TearDown() {};
+};
+
+/**
+ * @tc.number    : NotificationRecordStoreTest_00100
+ * @tc.name      : ANS_Add_0100
+ * @tc.desc      : Test Add and Find function
+ */
+HWTEST_F(NotificationRecordStoreTest, NotificationRecordStoreTest_00100, Function | SmallTest | Level1)
+{
+    NotificationRecordStore store;
+    auto record = CreateRecord(1, "bundleName", 1000);
+    EXPECT_TRUE(store.Add(record));
+    EXPECT_FALSE(store.Add(record));
+    EXPECT_EQ(store.Size(), 1);
+    EXPECT_TRUE(store.Exists(record->notification->GetKey()));
+    EXPECT_EQ(store.Find(record->notification->GetKey()), record);
+    EXPECT_EQ(store.FindById("bundleName", 1000, "", 1, ""), record);
+    EXPECT_EQ(store.FindById("bundleName", 1000, "", 2, ""), nullptr);
+}
+
+/**
+ * @tc.number    : NotificationRecordStoreTest_00200
+ * @tc.name      : ANS_Update_0100
+ * @tc.desc      : Test Update function moves the record to the new indexes
+ */
+HWTEST_F(NotificationRecordStoreTest, NotificationRecordStoreTest_00200, Function | SmallTest | Level1)
+{
+    NotificationRecordStore store;
+    auto record = CreateRecord(1, "bundleName", 1000, "group0");
+    EXPECT_TRUE(store.Add(record));
+    EXPECT_EQ(store.GetByGroup("bundleName", 1000, "group0").size(), 1);
+
+    auto newRecord = CreateRecord(1, "bundleName", 1000, "group1");
+    EXPECT_TRUE(store.Update(newRecord));
+    EXPECT_EQ(store.Size(), 1);
+    EXPECT_TRUE(store.GetByGroup("bundleName", 1000, "group0").empty());
+    EXPECT_EQ(store.GetByGroup("bundleName", 1000, "group1").size(), 1);
+    EXPECT_EQ(store.Find(record->notification->GetKey()), newRecord);
+}
+
+/**
+ * @tc.number    : NotificationRecordStoreTest_00300
+ * @tc.name      : ANS_Remove_0100
+ * @tc.desc      : Test Remove function only removes the stored record
+ */
+HWTEST_F(NotificationRecordStoreTest, NotificationRecordStoreTest_00300, Function | SmallTest | Level1)
+{
+    NotificationRecordStore store;
+    auto record = CreateRecord(1, "bundleName", 1000);
+    auto other = CreateRecord(1, "bundleName", 1000);
+    EXPECT_TRUE(store.Add(record));
+    EXPECT_FALSE(store.Remove(other));
+    EXPECT_TRUE(store.Remove(record));
+    EXPECT_TRUE(store.Empty());
+    EXPECT_TRUE(store.GetByBundle("bundleName", 1000).empty());
+    EXPECT_EQ(store.GetCountByBundleName("bundleName"), 0);
+}
+
+/**
+ * @tc.number    : NotificationRecordStoreTest_00400
+ * @tc.name      : ANS_GetByBundle_0100
+ * @tc.desc      : Test the bundle, uid and user indexes
+ */
+HWTEST_F(NotificationRecordStoreTest, NotificationRecordStoreTest_00400, Function | SmallTest | Level1)
+{
+    NotificationRecordStore store;
+    EXPECT_TRUE(store.Add(CreateRecord(1, "bundleName", 1000)));
+    EXPECT_TRUE(store.Add(CreateRecord(2, "bundleName", 1000)));
+    EXPECT_TRUE(store.Add(CreateRecord(3, "otherBundle", 1001)));
+    EXPECT_TRUE(store.Add(CreateRecord(4, "otherBundle", 1000)));
+
+    EXPECT_EQ(store.GetByBundle("bundleName", 1000).size(), 2);
+    EXPECT_EQ(store.GetCountByBundleName("otherBundle"), 2);
+    EXPECT_EQ(store.GetByBundleNameOrUid("bundleName", 1000, false).size(), 3);
+    int32_t userId = (*store.begin())->notification->GetUserId();
+    EXPECT_EQ(store.GetByUser(userId).size(), 4);
+}
+
+/**
+ * @tc.number    : NotificationRecordStoreTest_00500
+ * @tc.name      : ANS_Order_0100
+ * @tc.desc      : Test the records are ordered by create time and then by the order they were added
+ */
+HWTEST_F(NotificationRecordStoreTest, NotificationRecordStoreTest_00500, Function | SmallTest | Level1)
+{
+    NotificationRecordStore store;
+    EXPECT_TRUE(store.Add(CreateRecord(1, "bundleName", 1000, "", 20)));
+    EXPECT_TRUE(store.Add(CreateRecord(2, "bundleName", 1000, "", 10)));
+    EXPECT_TRUE(store.Add(CreateRecord(3, "bundleName", 1000, "", 20)));
+    EXPECT_TRUE(store.Add(CreateRecord(4, "bundleName", 1000, "", 10)));
+
+    std::vector<int32_t> ids;
+    for (auto &record : store) {
+        ids.push_back(record->notification->GetId());
+    }
+    EXPECT_EQ(ids, std::vector<int32_t>({2, 4, 1, 3}));
+
+    std::vector<std::shared_ptr<NotificationRecord>> records = store.GetByBundle("bundleName", 1000);
+    ASSERT_EQ(records.size(), 4);
+    EXPECT_EQ(records.front()->notification->GetId(), 2);
+    EXPECT_EQ(records.back()->notification->GetId(), 3);
+}
+
+/**
+ * @tc.number    : NotificationRecordStoreTest_00600
+ * @tc.name      : ANS_Order_0200
+ * @tc.desc      : Test Update moves the record as a stable sort of the list would
+ */
+HWTEST_F(NotificationRecordStoreTest, NotificationRecordStoreTest_00600, Function | SmallTest | Level1)
+{
+    NotificationRecordStore store;
+    EXPECT_TRUE(store.Add(CreateRecord(2, "bundleName", 1000, "", 20)));
+    EXPECT_TRUE(store.Add(CreateRecord(1, "bundleName", 1000, "", 10)));
+    EXPECT_TRUE(store.Add(CreateRecord(3, "bundleName", 1000, "", 30)));
+
+    // Moving forward in time puts the record before the records it now ties with.
+    EXPECT_TRUE(store.Update(CreateRecord(1, "bundleName", 1000, "", 20)));
+    // Moving backward in time puts the record after the records it now ties with.
+    EXPECT_TRUE(store.Update(CreateRecord(3, "bundleName", 1000, "", 20)));
+
+    std::vector<int32_t> ids;
+    for (auto &record : store) {
+        ids.push_back(record->notification->GetId());
+    }
+    EXPECT_EQ(ids, std::vector<int32_t>({1, 2, 3}));
+}
+
+/**
+ * @tc.number    : NotificationRecordStoreTest_00700
+ * @tc.name      : ANS_GetEvictionCandidate_0100
+ * @tc.desc      : Test the eviction candidate has the lowest slot level and then the earliest create time
+ */
+HWTEST_F(NotificationRecordStoreTest, NotificationRecordStoreTest_00700, Function | SmallTest | Level1)
+{
+    NotificationRecordStore store;
+    EXPECT_EQ(store.GetEvictionCandidate(), nullptr);
+
+    auto high = CreateRecord(1, "bundleName", 1000, "", 10);
+    high->slot = new NotificationSlot();
+    high->slot->SetLevel(NotificationSlot::NotificationLevel::LEVEL_HIGH);
+    auto lowNew = CreateRecord(2, "bundleName", 1000, "", 30);
+    lowNew->slot = new NotificationSlot();
+    lowNew->slot->SetLevel(NotificationSlot::NotificationLevel::LEVEL_LOW);
+    auto lowOld = CreateRecord(3, "otherBundle", 1001, "", 20);
+    lowOld->slot = new NotificationSlot();
+    lowOld->slot->SetLevel(NotificationSlot::NotificationLevel::LEVEL_LOW);
+    EXPECT_TRUE(store.Add(high));
+    EXPECT_TRUE(store.Add(lowNew));
+    EXPECT_TRUE(store.Add(lowOld));
+
+    EXPECT_EQ(store.GetEvictionCandidate(), lowOld);
+    EXPECT_EQ(store.GetEvictionCandidate("bundleName"), lowNew);
+    EXPECT_EQ(store.GetEvictionCandidate("noBundle"), nullptr);
+
+    EXPECT_TRUE(store.Remove(lowNew));
+    EXPECT_EQ(store.GetEvictionCandidate("bundleName"), high);
+    EXPECT_TRUE(store.Remove(lowOld));
+    EXPECT_EQ(store.GetEvictionCandidate(), high);
+}
+
+/**
+ * @tc.number    : NotificationRecordStoreTest_00750
+ * @tc.name      : ANS_GetCountByOwnerBundleName_0100
+ * @tc.desc      : Test an agent notification is counted and evicted by its owner bundle
+ */
+HWTEST_F(NotificationRecordStoreTest, NotificationRecordStoreTest_00750, Function | SmallTest | Level1)
+{
+    NotificationRecordStore store;
+    auto agent = CreateRecord(1, "ownerBundle", 1000);
+    agent->bundleOption = new NotificationBundleOption("agentBundle", 1001);
+    EXPECT_TRUE(store.Add(agent));
+    EXPECT_TRUE(store.Add(CreateRecord(2, "ownerBundle", 1000)));
+
+    EXPECT_EQ(store.GetCountByOwnerBundleName("ownerBundle"), 2);
+    EXPECT_EQ(store.GetCountByOwnerBundleName("agentBundle"), 0);
+    EXPECT_EQ(store.GetCountByBundleName("agentBundle"), 1);
+    EXPECT_EQ(store.GetEvictionCandidate("ownerBundle"), agent);
+
+    EXPECT_TRUE(store.Remove(agent));
+    EXPECT_EQ(store.GetCountByOwnerBundleName("ownerBundle"), 1);
+}
+
+/**
+ * @tc.number    : NotificationRecordStoreTest_00800
+ * @tc.name      : ANS_Concurrency_0100
+ * @tc.desc      : Test queries from other threads while a single thread adds and removes records
+ */
+HWTEST_F(NotificationRecordStoreTest, NotificationRecordStoreTest_00800, Function | SmallTest | Level1)
+{
+    const int32_t recordNum = 100;
+    const int32_t loopNum = 100;
+    const int32_t readerNum = 4;
+    NotificationRecordStore store;
+    std::vector<std::shared_ptr<NotificationRecord>> records;
+    for (int32_t i = 0; i < recordNum; i++) {
+        records.push_back(CreateRecord(i, "bundleName", 1000));
+    }
+
+    std::atomic<bool> stopped(false);
+    std::atomic<bool> failed(false);
+    std::vector<std::thread> readers;
+    for (int32_t i = 0; i < readerNum; i++) {
+        readers.emplace_back([&]() {
+            while (!stopped) {
+                size_t count = store.GetCountByBundle("bundleName", 1000);
+                std::vector<std::shared_ptr<NotificationRecord>> all = store.GetAll();
+                if (count > static_cast<size_t>(recordNum) || all.size() > static_cast<size_t>(recordNum)) {
+                    failed = true;
+                }
+                for (auto &record : all) {
+                    if (record == nullptr) {
+                        failed = true;
+                    }
+                }
+            }
+        });
+    }
+
+    for (int32_t loop = 0; loop < loopNum; loop++) {
+        for (auto &record : records) {
+            store.Add(record);
+        }
+        for (auto &record : records) {
+            store.Remove(record);
+        }
+    }
+    stopped = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    EXPECT_FALSE(failed);
+    EXPECT_TRUE(store.Empty());
+}
+}  // namespace Notification
+}  // namespace OHOS
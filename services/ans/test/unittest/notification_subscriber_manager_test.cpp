@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <gtest/gtest.h>
 #include <iostream>
 
@@ -191,5 +192,177 @@ HWTEST_F(NotificationSubscriberManagerTest, NotificationSubscriberManagerTest_00
     sptr<NotificationSubscribeInfo> info = new NotificationSubscribeInfo();
     EXPECT_EQ(notificationSubscriberManager_->RemoveSubscriber(nullptr, info), (int)ERR_ANS_INVALID_PARAM);
 }
+
+namespace {
+sptr<NotificationSortingMap> CreateSortingMap(const std::vector<std::string> &keys, const sptr<NotificationSlot> &slot)
+{
+    std::vector<NotificationSorting> sortingList;
+    for (auto &key : keys) {
+        NotificationSorting sorting;
+        sorting.SetKey(key);
+        sorting.SetRanking(static_cast<uint64_t>(sortingList.size()));
+        sorting.SetSlot(slot);
+        sortingList.push_back(sorting);
+    }
+    return new NotificationSortingMap(sortingList);
+}
+}  // namespace
+
+/**
+ * @tc.number    : NotificationSubscriberManagerTest_009
+ * @tc.name      : ANS_GetChangedKeys_0100
+ * @tc.desc      : Test GetChangedKeys function only reports the added, removed and moved keys.
+ */
+HWTEST_F(NotificationSubscriberManagerTest, NotificationSubscriberManagerTest_009, Function | SmallTest | Level1)
+{
+    sptr<NotificationSlot> slot = new NotificationSlot();
+    sptr<NotificationSortingMap> previous = CreateSortingMap({"a", "b", "c", "d"}, slot);
+    sptr<NotificationSortingMap> current = CreateSortingMap({"b", "d", "e", "a"}, slot);
+    std::set<std::string> changedKeys = notificationSubscriberManager_->GetChangedKeys(previous, current);
+    EXPECT_EQ(changedKeys, std::set<std::string>({"a", "c", "e"}));
+}
+
+/**
+ * @tc.number    : NotificationSubscriberManagerTest_010
+ * @tc.name      : ANS_ApplyDelta_0100
+ * @tc.desc      : Test a sorting map delta rebuilds the full sorting map.
+ */
+HWTEST_F(NotificationSubscriberManagerTest, NotificationSubscriberManagerTest_010, Function | SmallTest | Level1)
+{
+    sptr<NotificationSlot> slot = new NotificationSlot();
+    sptr<NotificationSortingMap> previous = CreateSortingMap({"a", "b", "c", "d"}, slot);
+    previous->SetVersion(1);
+    sptr<NotificationSortingMap> current = CreateSortingMap({"b", "d", "e", "a"}, slot);
+
+    std::vector<NotificationSorting> sortingList;
+    NotificationSorting sorting;
+    EXPECT_TRUE(current->GetNotificationSorting("a", sorting));
+    sortingList.push_back(sorting);
+    EXPECT_TRUE(current->GetNotificationSorting("e", sorting));
+    sortingList.push_back(sorting);
+    NotificationSortingMap delta(sortingList);
+    delta.SetVersion(2);
+    delta.SetDelta(1, {"c"});
+
+    EXPECT_TRUE(previous->ApplyDelta(delta));
+    EXPECT_EQ(previous->GetVersion(), 2);
+    EXPECT_EQ(previous->GetKey(), current->GetKey());
+    EXPECT_FALSE(previous->ApplyDelta(delta));
+}
+
+/**
+ * @tc.number    : NotificationSubscriberManagerTest_011
+ * @tc.name      : ANS_ResyncSortingMap_0100
+ * @tc.desc      : Test ResyncSortingMap function when the sorting map is nullptr, return is ERR_ANS_INVALID_PARAM.
+ */
+HWTEST_F(NotificationSubscriberManagerTest, NotificationSubscriberManagerTest_011, Function | SmallTest | Level1)
+{
+    EXPECT_EQ(notificationSubscriberManager_->ResyncSortingMap(subscriber_, nullptr), (int)ERR_ANS_INVALID_PARAM);
+}
+
+/**
+ * @tc.number    : NotificationSubscriberManagerTest_012
+ * @tc.name      : ANS_GetRoutedSubscribers_0100
+ * @tc.desc      : Test GetRoutedSubscribers function routes by bundle name and user id.
+ */
+HWTEST_F(NotificationSubscriberManagerTest, NotificationSubscriberManagerTest_012, Function | SmallTest | Level1)
+{
+    TestAnsSubscriber bundleSubscriber;
+    auto bundleRecord = notificationSubscriberManager_->CreateSubscriberRecord(bundleSubscriber.GetImpl());
+    sptr<NotificationSubscribeInfo> bundleInfo = new NotificationSubscribeInfo();
+    bundleInfo->AddAppName("test_bundle");
+    bundleInfo->AddAppUserId(200);
+    notificationSubscriberManager_->AddRecordInfo(bundleRecord, bundleInfo);
+
+    TestAnsSubscriber userSubscriber;
+    auto userRecord = notificationSubscriberManager_->CreateSubscriberRecord(userSubscriber.GetImpl());
+    sptr<NotificationSubscribeInfo> userInfo = new NotificationSubscribeInfo();
+    userInfo->AddAppUserId(201);
+    notificationSubscriberManager_->AddRecordInfo(userRecord, userInfo);
+
+    sptr<NotificationRequest> request = new NotificationRequest();
+    request->SetOwnerBundleName("test_bundle");
+    request->SetCreatorUserId(200);
+    sptr<Notification> notification = new Notification(request);
+    auto subscribers = notificationSubscriberManager_->GetRoutedSubscribers(notification);
+    EXPECT_NE(std::find(subscribers.begin(), subscribers.end(), bundleRecord), subscribers.end());
+    EXPECT_EQ(std::find(subscribers.begin(), subscribers.end(), userRecord), subscribers.end());
+
+    request->SetOwnerBundleName("other_bundle");
+    request->SetCreatorUserId(201);
+    subscribers = notificationSubscriberManager_->GetRoutedSubscribers(notification);
+    EXPECT_EQ(std::find(subscribers.begin(), subscribers.end(), bundleRecord), subscribers.end());
+    EXPECT_NE(std::find(subscribers.begin(), subscribers.end(), userRecord), subscribers.end());
+
+    sptr<NotificationSubscribeInfo> excludeInfo = new NotificationSubscribeInfo();
+    excludeInfo->AddAppName("other_bundle");
+    notificationSubscriberManager_->RemoveRecordInfo(userRecord, excludeInfo);
+    subscribers = notificationSubscriberManager_->GetRoutedSubscribers(notification);
+    EXPECT_EQ(std::find(subscribers.begin(), subscribers.end(), userRecord), subscribers.end());
+
+    notificationSubscriberManager_->RemoveFromRoutes(bundleRecord);
+    notificationSubscriberManager_->RemoveFromRoutes(userRecord);
+}
+
+/**
+ * @tc.number    : NotificationSubscriberManagerTest_013
+ * @tc.name      : ANS_OnConsumedCombined_0100
+ * @tc.desc      : Test the combined consumed and canceled callbacks are delivered as both callbacks.
+ */
+HWTEST_F(NotificationSubscriberManagerTest, NotificationSubscriberManagerTest_013, Function | SmallTest | Level1)
+{
+    class CountingSubscriber : public NotificationSubscriber {
+    public:
+        void OnConnected() override
+        {}
+        void OnDisconnected() override
+        {}
+        void OnDied() override
+        {}
+        void OnUpdate(const std::shared_ptr<NotificationSortingMap> &sortingMap) override
+        {}
+        void OnDoNotDisturbDateChange(const std::shared_ptr<NotificationDoNotDisturbDate> &date) override
+        {}
+        void OnEnabledNotificationChanged(
+            const std::shared_ptr<EnabledNotificationCallbackData> &callbackData) override
+        {}
+        void OnCanceled(const std::shared_ptr<Notification> &request) override
+        {
+            canceledNum++;
+        }
+        void OnCanceled(const std::shared_ptr<Notification> &request,
+            const std::shared_ptr<NotificationSortingMap> &sortingMap, int deleteReason) override
+        {
+            canceledMapNum++;
+            lastReason = deleteReason;
+        }
+        void OnConsumed(const std::shared_ptr<Notification> &request) override
+        {
+            consumedNum++;
+        }
+        void OnConsumed(const std::shared_ptr<Notification> &request,
+            const std::shared_ptr<NotificationSortingMap> &sortingMap) override
+        {
+            consumedMapNum++;
+        }
+
+        int32_t consumedNum = 0;
+        int32_t consumedMapNum = 0;
+        int32_t canceledNum = 0;
+        int32_t canceledMapNum = 0;
+        int32_t lastReason = 0;
+    };
+
+    CountingSubscriber subscriber;
+    sptr<Notification> notification = new Notification(new NotificationRequest());
+    subscriber.GetImpl()->OnConsumedCombined(notification, nullptr);
+    EXPECT_EQ(subscriber.consumedNum, 1);
+    EXPECT_EQ(subscriber.consumedMapNum, 1);
+
+    subscriber.GetImpl()->OnCanceledCombined(notification, nullptr, NotificationConstant::CANCEL_REASON_DELETE);
+    EXPECT_EQ(subscriber.canceledNum, 1);
+    EXPECT_EQ(subscriber.canceledMapNum, 1);
+    EXPECT_EQ(subscriber.lastReason, NotificationConstant::CANCEL_REASON_DELETE);
+}
 }  // namespace Notification
 }  // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#include "reminder_data_manager.h"
+#include "reminder_request_timer.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace Notification {
+namespace {
+sptr<ReminderRequest> CreateReminder(int32_t reminderId, uint64_t triggerTime)
+{
+    sptr<ReminderRequest> reminder = new ReminderRequestTimer(reminderId);
+    reminder->SetTriggerTimeInMilli(triggerTime);
+    return reminder;
+}
+
+uint64_t GetNowInMilli()
+{
+    time_t now;
+    (void)time(&now);
+    return ReminderRequest::GetDurationSinceEpochInMilli(now);
+}
+
+const uint64_t ONE_MINUTE_IN_MILLI = 60000;
+}  // namespace
+
+class ReminderDataManagerTest : public testing::Test {
+public:
+    static void SetUpTestCase() {};
+    static void TearDownTestCase() {};
+    void SetUp() {};
+    void TearDown() {};
+};
+
+/**
+ * @tc.number    : ReminderDataManagerTest_00100
+ * @tc.name      : AddToIndexes_0100
+ * @tc.desc      : Test AddToIndexes keeps the trigger queue ordered and groups the reminders by app
+ */
+HWTEST_F(ReminderDataManagerTest, ReminderDataManagerTest_00100, Function | SmallTest | Level1)
+{
+    ReminderDataManager manager;
+    sptr<NotificationBundleOption> bundleOption = new NotificationBundleOption("bundleName", 1000);
+    manager.AddToIndexes(CreateReminder(1, 3000), bundleOption);
+    manager.AddToIndexes(CreateReminder(2, 1000), bundleOption);
+    manager.AddToIndexes(3, 2000, nullptr);
+
+    ASSERT_EQ(manager.triggerQueue_.size(), 3);
+    auto it = manager.triggerQueue_.begin();
+    EXPECT_EQ(*it++, std::make_pair(static_cast<uint64_t>(1000), 2));
+    EXPECT_EQ(*it++, std::make_pair(static_cast<uint64_t>(2000), 3));
+    EXPECT_EQ(*it++, std::make_pair(static_cast<uint64_t>(3000), 1));
+    EXPECT_NE(manager.reminderMap_[1].reminder, nullptr);
+    EXPECT_EQ(manager.reminderMap_[3].reminder, nullptr);
+
+    std::string appKey = ReminderDataManager::GenerateAppKey("bundleName", ReminderRequest::GetUserId(1000));
+    ASSERT_EQ(manager.appReminders_.size(), 1);
+    EXPECT_EQ(manager.appReminders_[appKey], std::set<int32_t>({1, 2}));
+}
+
+/**
+ * @tc.number    : ReminderDataManagerTest_00200
+ * @tc.name      : AddToIndexes_0200
+ * @tc.desc      : Test AddToIndexes replaces the entries of a reminder added again
+ */
+HWTEST_F(ReminderDataManagerTest, ReminderDataManagerTest_00200, Function | SmallTest | Level1)
+{
+    ReminderDataManager manager;
+    manager.AddToIndexes(CreateReminder(1, 1000), new NotificationBundleOption("bundleName", 1000));
+    manager.AddToIndexes(CreateReminder(1, 2000), new NotificationBundleOption("otherName", 1000));
+
+    ASSERT_EQ(manager.triggerQueue_.size(), 1);
+    EXPECT_EQ(*manager.triggerQueue_.begin(), std::make_pair(static_cast<uint64_t>(2000), 1));
+    ASSERT_EQ(manager.reminderMap_.size(), 1);
+    EXPECT_EQ(manager.reminderMap_[1].queuedTriggerTime, 2000);
+    ASSERT_EQ(manager.appReminders_.size(), 1);
+    EXPECT_EQ(manager.appReminders_.begin()->first,
+        ReminderDataManager::GenerateAppKey("otherName", ReminderRequest::GetUserId(1000)));
+}
+
+/**
+ * @tc.number    : ReminderDataManagerTest_00300
+ * @tc.name      : RemoveFromIndexes_0100
+ * @tc.desc      : Test RemoveFromIndexes removes every entry of the reminder and drops the empty app set
+ */
+HWTEST_F(ReminderDataManagerTest, ReminderDataManagerTest_00300, Function | SmallTest | Level1)
+{
+    ReminderDataManager manager;
+    sptr<NotificationBundleOption> bundleOption = new NotificationBundleOption("bundleName", 1000);
+    manager.AddToIndexes(CreateReminder(1, 1000), bundleOption);
+    manager.AddToIndexes(CreateReminder(2, 2000), bundleOption);
+
+    EXPECT_TRUE(manager.RemoveFromIndexes(1));
+    EXPECT_FALSE(manager.RemoveFromIndexes(1));
+    ASSERT_EQ(manager.triggerQueue_.size(), 1);
+    EXPECT_EQ(manager.triggerQueue_.begin()->second, 2);
+    EXPECT_EQ(manager.reminderMap_.count(1), 0);
+    ASSERT_EQ(manager.appReminders_.size(), 1);
+    EXPECT_EQ(manager.appReminders_.begin()->second, std::set<int32_t>({2}));
+
+    EXPECT_TRUE(manager.RemoveFromIndexes(2));
+    EXPECT_TRUE(manager.triggerQueue_.empty());
+    EXPECT_TRUE(manager.reminderMap_.empty());
+    EXPECT_TRUE(manager.appReminders_.empty());
+}
+
+/**
+ * @tc.number    : ReminderDataManagerTest_00400
+ * @tc.name      : RebuildTriggerQueue_0100
+ * @tc.desc      : Test RebuildTriggerQueue reorders the loaded reminders and keeps the unloaded ones
+ */
+HWTEST_F(ReminderDataManagerTest, ReminderDataManagerTest_00400, Function | SmallTest | Level1)
+{
+    ReminderDataManager manager;
+    sptr<ReminderRequest> first = CreateReminder(1, 1000);
+    sptr<ReminderRequest> second = CreateReminder(2, 2000);
+    manager.AddToIndexes(first, nullptr);
+    manager.AddToIndexes(second, nullptr);
+    manager.AddToIndexes(3, 1500, nullptr);
+
+    first->SetTriggerTimeInMilli(3000);
+    second->SetTriggerTimeInMilli(500);
+    manager.RebuildTriggerQueue();
+
+    ASSERT_EQ(manager.triggerQueue_.size(), 3);
+    auto it = manager.triggerQueue_.begin();
+    EXPECT_EQ(*it++, std::make_pair(static_cast<uint64_t>(500), 2));
+    EXPECT_EQ(*it++, std::make_pair(static_cast<uint64_t>(1500), 3));
+    EXPECT_EQ(*it++, std::make_pair(static_cast<uint64_t>(3000), 1));
+    EXPECT_EQ(manager.reminderMap_[1].queuedTriggerTime, 3000);
+    EXPECT_EQ(manager.reminderMap_[2].queuedTriggerTime, 500);
+
+    EXPECT_TRUE(manager.RemoveFromIndexes(1));
+    EXPECT_EQ(manager.triggerQueue_.size(), 2);
+}
+
+/**
+ * @tc.number    : ReminderDataManagerTest_00500
+ * @tc.name      : GetImmediatelyShowReminders_0100
+ * @tc.desc      : Test a stale queued trigger time is requeued instead of hiding the due reminders behind it
+ */
+HWTEST_F(ReminderDataManagerTest, ReminderDataManagerTest_00500, Function | SmallTest | Level1)
+{
+    ReminderDataManager manager;
+    uint64_t nowMilli = GetNowInMilli();
+    const uint64_t distance = ONE_MINUTE_IN_MILLI;
+    sptr<ReminderRequest> stale = CreateReminder(1, nowMilli - distance);
+    sptr<ReminderRequest> due = CreateReminder(2, nowMilli - distance / 2);
+    manager.AddToIndexes(stale, nullptr);
+    manager.AddToIndexes(due, nullptr);
+    stale->SetTriggerTimeInMilli(nowMilli + distance);
+
+    std::vector<sptr<ReminderRequest>> reminders;
+    manager.GetImmediatelyShowRemindersLocked(reminders);
+    ASSERT_EQ(reminders.size(), 1);
+    EXPECT_EQ(reminders[0], due);
+    EXPECT_EQ(manager.reminderMap_[1].queuedTriggerTime, nowMilli + distance);
+    EXPECT_EQ(manager.triggerQueue_.rbegin()->second, 1);
+}
+
+/**
+ * @tc.number    : ReminderDataManagerTest_00600
+ * @tc.name      : RearmTimer_0100
+ * @tc.desc      : Test the timer is armed at the trigger deadline when it is before the alerting deadline,
+ *                 and moves to the alerting deadline when the trigger timer stops
+ */
+HWTEST_F(ReminderDataManagerTest, ReminderDataManagerTest_00600, Function | SmallTest | Level1)
+{
+    ReminderDataManager manager;
+    sptr<ReminderRequest> alerting = CreateReminder(1, GetNowInMilli());
+    alerting->SetRingDuration(3 * ONE_MINUTE_IN_MILLI / ReminderRequest::MILLI_SECONDS);
+    sptr<ReminderRequest> next = CreateReminder(2, GetNowInMilli() + ONE_MINUTE_IN_MILLI);
+
+    manager.StartTimerLocked(alerting, ReminderDataManager::TimerType::ALERTING_TIMER);
+    manager.StartTimerLocked(next, ReminderDataManager::TimerType::TRIGGER_TIMER);
+    EXPECT_EQ(manager.triggerDeadline_, next->GetTriggerTimeInMilli());
+    EXPECT_LT(manager.triggerDeadline_, manager.alertingDeadline_);
+    EXPECT_EQ(manager.armedTime_, manager.triggerDeadline_);
+
+    manager.StopTimerLocked(ReminderDataManager::TimerType::TRIGGER_TIMER);
+    EXPECT_EQ(manager.triggerDeadline_, 0);
+    EXPECT_EQ(manager.armedTime_, manager.alertingDeadline_);
+
+    manager.StopTimerLocked(ReminderDataManager::TimerType::ALERTING_TIMER);
+    EXPECT_EQ(manager.alertingDeadline_, 0);
+    EXPECT_EQ(manager.armedTime_, 0);
+}
+
+/**
+ * @tc.number    : ReminderDataManagerTest_00700
+ * @tc.name      : RearmTimer_0200
+ * @tc.desc      : Test the timer is armed at the alerting deadline when it is before the trigger deadline,
+ *                 and moves to the trigger deadline when the alerting timer stops
+ */
+HWTEST_F(ReminderDataManagerTest, ReminderDataManagerTest_00700, Function | SmallTest | Level1)
+{
+    ReminderDataManager manager;
+    sptr<ReminderRequest> alerting = CreateReminder(1, GetNowInMilli());
+    alerting->SetRingDuration(ONE_MINUTE_IN_MILLI / ReminderRequest::MILLI_SECONDS);
+    sptr<ReminderRequest> next = CreateReminder(2, GetNowInMilli() + 3 * ONE_MINUTE_IN_MILLI);
+
+    manager.StartTimerLocked(next, ReminderDataManager::TimerType::TRIGGER_TIMER);
+    manager.StartTimerLocked(alerting, ReminderDataManager::TimerType::ALERTING_TIMER);
+    EXPECT_LT(manager.alertingDeadline_, manager.triggerDeadline_);
+    EXPECT_EQ(manager.armedTime_, manager.alertingDeadline_);
+
+    // A timer already running keeps its deadline.
+    uint64_t alertingDeadline = manager.alertingDeadline_;
+    manager.StartTimerLocked(next, ReminderDataManager::TimerType::ALERTING_TIMER);
+    EXPECT_EQ(manager.alertingDeadline_, alertingDeadline);
+    EXPECT_EQ(manager.armedTime_, alertingDeadline);
+
+    manager.StopTimerLocked(ReminderDataManager::TimerType::ALERTING_TIMER);
+    EXPECT_EQ(manager.alertingDeadline_, 0);
+    EXPECT_EQ(manager.armedTime_, manager.triggerDeadline_);
+}
+
+/**
+ * @tc.number    : ReminderDataManagerTest_00800
+ * @tc.name      : RearmTimer_0300
+ * @tc.desc      : Test snoozing the alerting reminder stops both timers and rearms at the snoozed trigger time
+ */
+HWTEST_F(ReminderDataManagerTest, ReminderDataManagerTest_00800, Function | SmallTest | Level1)
+{
+    ReminderDataManager manager;
+    sptr<ReminderRequest> reminder = CreateReminder(1, GetNowInMilli() + ONE_MINUTE_IN_MILLI);
+    reminder->SetRingDuration(2 * ONE_MINUTE_IN_MILLI / ReminderRequest::MILLI_SECONDS);
+    manager.StartTimerLocked(reminder, ReminderDataManager::TimerType::TRIGGER_TIMER);
+    manager.StartTimerLocked(reminder, ReminderDataManager::TimerType::ALERTING_TIMER);
+    EXPECT_EQ(manager.armedTime_, manager.triggerDeadline_);
+
+    // The same timer steps as SnoozeReminderImpl takes for the active and alerting reminder.
+    manager.StopTimerLocked(ReminderDataManager::TimerType::TRIGGER_TIMER);
+    manager.StopTimerLocked(ReminderDataManager::TimerType::ALERTING_TIMER);
+    EXPECT_EQ(manager.armedTime_, 0);
+    uint64_t snoozeTime = GetNowInMilli() + 5 * ONE_MINUTE_IN_MILLI;
+    reminder->SetTriggerTimeInMilli(snoozeTime);
+    manager.StartTimerLocked(reminder, ReminderDataManager::TimerType::TRIGGER_TIMER);
+
+    EXPECT_EQ(manager.alertingDeadline_, 0);
+    EXPECT_EQ(manager.triggerDeadline_, snoozeTime);
+    EXPECT_EQ(manager.armedTime_, snoozeTime);
+    EXPECT_EQ(manager.activeReminderId_, 1);
+}
+}  // namespace Notification
+}  // namespace OHOS
@@ -58,6 +58,15 @@ public:
      */
     bool PutToDistributedDB(const std::string &key, const std::string &value);
 
+    /**
+     * @brief Get the value of its key from database.
+     *
+     * @param key Indicates the key.
+     * @param value Indicates the value.
+     * @return Whether to get key-value success.
+     */
+    bool PutBatchToDistributedDB(const std::vector<Entry> &entries);
+
     /**
      * @brief Get the value of its key from database.
      *
@@ -67,6 +76,16 @@ public:
      */
     bool GetFromDistributedDB(const std::string &key, std::string &value);
 
+    /**
+     * @brief Get the value of its key from database, telling a key not in the database from a failed read.
+     *
+     * @param key Indicates the key.
+     * @param value Indicates the value.
+     * @param isFound Indicates whether the key is in the database.
+     * @return Whether the database is read, a key not found is read successfully.
+     */
+    bool GetFromDistributedDB(const std::string &key, std::string &value, bool &isFound);
+
     /**
      * @brief Get all entries which key start with prefixKey.
      *
@@ -84,6 +103,21 @@ public:
      */
     bool DeleteToDistributedDB(const std::string &key);
 
+    /**
+     * @brief Delete key-values of their keys from database in one transaction.
+     *
+     * @param keys Indicates the keys.
+     * @return Whether to delete key-values success.
+     */
+    bool DeleteBatchToDistributedDB(const std::vector<std::string> &keys);
+
+    /**
+     * @brief Get the time to wait before database can be called without being rejected by the flow control.
+     *
+     * @return The time to wait in milliseconds, 0 if it can be called now.
+     */
+    int64_t GetFlowControlDelay(void);
+
     /**
      * @brief Clear all entries which put by specified device.
      *
@@ -17,6 +17,7 @@
 #define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_DISTRIBUTED_INCLUDE_DATABASE_CALLBACK_H
 
 #include <string>
+#include <vector>
 
 #include "kvstore_observer.h"
 
@@ -31,6 +32,9 @@ public:
         std::function<void(const std::string &deviceId, const std::string &key, const std::string &value)> OnInsert;
         std::function<void(const std::string &deviceId, const std::string &key, const std::string &value)> OnUpdate;
         std::function<void(const std::string &deviceId, const std::string &key, const std::string &value)> OnDelete;
+        // Receives the entries inserted by one change at once, OnInsert receives them one by one if it is not set.
+        std::function<void(const std::string &deviceId, const std::vector<DistributedKv::Entry> &entries)>
+            OnInsertBatch;
     };
 
     /**
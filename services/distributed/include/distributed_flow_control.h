@@ -16,8 +16,9 @@
 #ifndef BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_DISTRIBUTED_INCLUDE_DISTRIBUTED_FLOW_CONTROL_H
 #define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_DISTRIBUTED_INCLUDE_DISTRIBUTED_FLOW_CONTROL_H
 
-#include <chrono>
-#include <list>
+#include <cstdint>
+
+#include "distributed_rate_limiter.h"
 
 namespace OHOS {
 namespace Notification {
@@ -50,6 +51,13 @@ public:
      */
     bool KvStoreFlowControl(void);
 
+    /**
+     * @brief Get the time to wait before SingleKvStore interface flow control can pass, the call is not counted.
+     *
+     * @return The time to wait in milliseconds, 0 if it can pass now.
+     */
+    int64_t KvStoreFlowControlDelay(void);
+
     /**
      * @brief Clear DistributedKvDataManager interface flow control count.
      */
@@ -67,12 +75,8 @@ protected:
     static const size_t KVSTORE_MAXINUM_PER_MINUTE = 10000;
 
 private:
-    size_t kvManagerSecondMaxinum_;
-    size_t kvManagerMinuteMaxinum_;
-    size_t kvStoreSecondMaxinum_;
-    size_t kvStoreMinuteMaxinum_;
-    std::list<std::chrono::system_clock::time_point> kvDataManagerTimestampList_;
-    std::list<std::chrono::system_clock::time_point> kvStoreTimestampList_;
+    DistributedRateLimiter kvManagerLimiter_;
+    DistributedRateLimiter kvStoreLimiter_;
 };
 }  // namespace Notification
 }  // namespace OHOS
@@ -16,22 +16,38 @@
 #ifndef BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_DISTRIBUTED_INCLUDE_NOTIFICATION_MANAGER_H
 #define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_DISTRIBUTED_INCLUDE_NOTIFICATION_MANAGER_H
 
+#include <map>
+#include <mutex>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "singleton.h"
+#include "thread_pool.h"
 
 #include "event_handler.h"
 #include "event_runner.h"
 
+#include "ans_image_util.h"
 #include "distributed_database.h"
 #include "distributed_database_callback.h"
 #include "distributed_device_callback.h"
+#include "distributed_notification_writer.h"
 #include "notification_request.h"
 
 namespace OHOS {
 namespace Notification {
 class DistributedNotificationManager : public DelayedSingleton<DistributedNotificationManager> {
 public:
+    /**
+     * @brief A remote notification of a batch published at once.
+     */
+    struct DistributedRequest {
+        std::string deviceId;
+        std::string bundleName;
+        sptr<NotificationRequest> request;
+    };
+
     /**
      * @brief Distributed notification callback function for remote device.
      */
@@ -45,6 +61,8 @@ public:
         std::function<void(
             const std::string &deviceId, const std::string &bundleName, const std::string &label, int32_t id)>
             OnDelete;
+        // Receives the remote notifications synchronized at once, OnPublish receives them one by one if it is not set.
+        std::function<void(std::vector<DistributedRequest> &requests)> OnPublishBatch;
     };
 
     /**
@@ -54,7 +72,8 @@ public:
      * @param label Indicates the label of the notifications.
      * @param id Indicates the bundle uid of the application whose notifications are to be publish.
      * @param request Indicates the NotificationRequest object for setting the notification content.
-     * @return ErrCode Returns the publish result.
+     * @return ErrCode Returns ERR_OK once the notification is queued to be written, the write reaches the database
+     * later and is dropped after failing several times.
      */
     ErrCode Publish(
         const std::string &bundleName, const std::string &label, int32_t id, const sptr<NotificationRequest> &request);
@@ -66,7 +85,8 @@ public:
      * @param label Indicates the label of the notifications.
      * @param id Indicates the bundle uid of the application whose notifications are to be update.
      * @param request Indicates the NotificationRequest object for setting the notification content.
-     * @return ErrCode Returns the update result.
+     * @return ErrCode Returns ERR_OK once the notification is queued to be written, the write reaches the database
+     * later and is dropped after failing several times.
      */
     ErrCode Update(
         const std::string &bundleName, const std::string &label, int32_t id, const sptr<NotificationRequest> &request);
@@ -77,7 +97,8 @@ public:
      * @param bundleName Indicates the bundle name of the application whose notifications are to be remove.
      * @param label Indicates the label of the notifications.
      * @param id Indicates the bundle uid of the application whose notifications are to be remove.
-     * @return ErrCode Returns the remove result.
+     * @return ErrCode Returns ERR_OK once the removal is queued to be written, the write reaches the database later
+     * and is dropped after failing several times.
      */
     ErrCode Delete(const std::string &bundleName, const std::string &label, int32_t id);
 
@@ -131,6 +152,7 @@ public:
 
 private:
     void OnDatabaseInsert(const std::string &deviceId, const std::string &key, const std::string &value);
+    void OnDatabaseInsertBatch(const std::string &deviceId, const std::vector<DistributedKv::Entry> &entries);
     void OnDatabaseUpdate(const std::string &deviceId, const std::string &key, const std::string &value);
     void OnDatabaseDelete(const std::string &deviceId, const std::string &key, const std::string &value);
     void OnDeviceConnected(const std::string &deviceId);
@@ -144,6 +166,27 @@ private:
         int32_t id = 0;
     };
 
+    struct RemoteRecord {
+        std::string key;  // key in the database
+        std::string notificationKey;
+        bool isBinary = false;
+        ResolveKey resolveKey;
+        std::string value;
+        sptr<NotificationRequest> request;
+        std::set<std::string> missingImages;
+        bool imageReadFailed = false;
+    };
+
+    /**
+     * @brief A remote notification published without some of its images, which are not synchronized yet.
+     */
+    struct WaitingRecord {
+        std::string deviceId;
+        std::string value;
+        std::set<std::string> missingImages;  // hashes
+        uint32_t readRetryTimes = 0;
+    };
+
     void GenerateDistributedKey(const std::string &deviceId, const std::string &bundleName, const std::string &label,
         int32_t id, std::string &key);
     bool GenerateLocalDistributedKey(
@@ -151,9 +194,159 @@ private:
     bool ResolveDistributedKey(const std::string &key, ResolveKey &resolveKey);
     bool GetDeviceIdFromKey(const std::string &key, std::string &deviceId);
     bool CheckDeviceId(const std::string &deviceId, const std::string &key);
+    bool IsTaggedKey(const std::string &key, const std::string &tag);
+
+    /**
+     * @brief Generates the key of a notification written in the binary format. It has a tag in place of the bundle
+     * name and the rest of the distributed key escaped, so that the devices reading only json reject it as invalid.
+     *
+     * @param key Indicates the distributed key of the notification.
+     * @param recordKey Indicates the key of the binary record.
+     */
+    void GenerateRecordKey(const std::string &key, std::string &recordKey);
+    bool ResolveRecordKey(const std::string &recordKey, std::string &key);
+    bool ResolveImageKey(const std::string &key, std::string &deviceId, std::string &hash);
+
+    /**
+     * @brief Resolves the distributed key of the notification stored under a key in either format.
+     *
+     * @param key Indicates the key in the database.
+     * @param notificationKey Indicates the distributed key of the notification.
+     * @param isBinary Indicates whether the notification is written in the binary format.
+     * @return Returns false if the key is not the key of a notification.
+     */
+    bool ResolveNotificationKey(const std::string &key, std::string &notificationKey, bool &isBinary);
+
+    /**
+     * @brief Puts a local notification with its images, each image is put once whatever the number of notifications
+     * referencing it. They are written to the database by the writer on its next flush. Called with localMutex_ held.
+     *
+     * @param key Indicates the distributed key of the notification.
+     * @param request Indicates the notification.
+     * @return ErrCode Returns the put result.
+     */
+    ErrCode PutRequestToDistributedDB(const std::string &key, const sptr<NotificationRequest> &request);
+
+    /**
+     * @brief Converts a record to a request.
+     *
+     * @param deviceId Indicates the ID of the device writing the record.
+     * @param value Indicates the record.
+     * @param images Indicates the images read along with the record, by hash. The other images are read from the
+     * database.
+     * @param missingImages Indicates the hashes of the images not found, the request is converted without them.
+     * @param imageReadFailed Indicates whether some of the missing images are missing because the database could not
+     * be read, rather than because they are not synchronized yet.
+     * @return Returns the request, or nullptr if the record is invalid.
+     */
+    sptr<NotificationRequest> ConvertToRequest(const std::string &deviceId, const std::string &value,
+        const std::map<std::string, std::string> *images = nullptr, std::set<std::string> *missingImages = nullptr,
+        bool *imageReadFailed = nullptr);
+
+    /**
+     * @brief Converts the records to requests, a large number of records is converted by the threads of convertPool_
+     * along with the calling thread.
+     *
+     * @param records Indicates the records, the request of a record is nullptr if it is invalid.
+     * @param images Indicates the images read along with the records, by hash.
+     */
+    void ConvertToRequests(std::vector<RemoteRecord> &records, const std::map<std::string, std::string> &images);
+    void GenerateImageKey(const std::string &deviceId, const std::string &hash, std::string &key);
+
+    /**
+     * @brief References the images of a local notification, the images not referenced yet are put. The images are
+     * moved out of the attachments.
+     */
+    void AcquireImages(const std::string &deviceId, AnsImageUtil::ImageAttachments &attachments,
+        std::set<std::string> &hashes);
+    void ReleaseImages(const std::string &deviceId, const std::set<std::string> &hashes);
+    void ReleaseNotificationImages(const std::string &key);
+    void ClearImages();
+
+    /**
+     * @brief Forgets the images whose puts are dropped by the writer, so that the next notification referencing them
+     * puts them again.
+     *
+     * @param keys Indicates the keys of the dropped puts.
+     */
+    void OnWritesDropped(const std::vector<std::string> &keys);
+
+    /**
+     * @brief Records the images a remote notification is waiting for, or forgets it if it waits for none.
+     *
+     * @param key Indicates the key of the notification in the database.
+     * @param deviceId Indicates the ID of the device writing the notification.
+     * @param value Indicates the record.
+     * @param missingImages Indicates the hashes of the images not synchronized yet.
+     * @param readFailed Indicates whether some images could not be read, they are read again later.
+     */
+    void WaitForImages(const std::string &key, const std::string &deviceId, const std::string &value,
+        const std::set<std::string> &missingImages, bool readFailed);
+
+    /**
+     * @brief Reads again the images of a waiting remote notification which could not be read.
+     *
+     * @param key Indicates the key of the notification in the database.
+     */
+    void RetryImageRead(const std::string &key);
+
+    /**
+     * @brief Updates the remote notifications once the last image they wait for is inserted.
+     *
+     * @param key Indicates the key of the image.
+     * @param image Indicates the image.
+     */
+    void OnImageInsert(const std::string &key, const std::string &image);
+
+    /**
+     * @brief Puts the binary format version of this device, the remote devices write the binary format once every
+     * online device has put its version.
+     */
+    void AdvertiseCodec();
+    void LoadOnlineDevices();
+    void OnDeviceCodec(const std::string &key, const std::string &value, bool isDelete);
+    bool IsCodecSupported(uint32_t version);
+
+    /**
+     * @brief Stops waiting for the codec of a device connected before its codec is synchronized.
+     *
+     * @param deviceId Indicates the ID of the device.
+     * @param sequence Indicates the connection sequence the wait started with.
+     */
+    void OnCodecWaitTimeout(const std::string &deviceId, uint64_t sequence);
+    bool IsBinaryRecordSupported();
+
+    /**
+     * @brief Rewrites the local notifications not in the format chosen for the online devices: as json with inline
+     * images once a device without codec is online, and back to the binary format once every device reads it.
+     */
+    void RewriteLocalRecords();
+
+    /**
+     * @brief Whether the images are written beside the notifications, the devices not advertising any binary
+     * format version read the images inline only.
+     */
+    bool IsImageReferenceSupported();
+
+    /**
+     * @brief Records the format a local notification is written in.
+     *
+     * @return Returns true if the notification was written in the other format before.
+     */
+    bool SetLocalRecordFormat(const std::string &key, bool isBinary);
+    bool TakeLocalRecordFormat(const std::string &key);
+
+    /**
+     * @brief Records the format a remote notification is written in.
+     *
+     * @return Returns true if the notification was written in the other format before.
+     */
+    bool SetRemoteRecordFormat(const std::string &key, bool isBinary);
+    void ClearRecordFormats();
 
     bool PublishCallback(
         const std::string &deviceId, const std::string &bundleName, sptr<NotificationRequest> &request);
+    bool PublishBatchCallback(std::vector<DistributedRequest> &requests);
     bool UpdateCallback(const std::string &deviceId, const std::string &bundleName, sptr<NotificationRequest> &request);
     bool DeleteCallback(
         const std::string &deviceId, const std::string &bundleName, const std::string &label, int32_t id);
@@ -162,11 +355,38 @@ private:
     std::shared_ptr<OHOS::AppExecFwk::EventRunner> runner_ = nullptr;
     std::shared_ptr<OHOS::AppExecFwk::EventHandler> handler_ = nullptr;
     std::shared_ptr<DistributedDatabase> database_ = nullptr;
+    std::shared_ptr<DistributedNotificationWriter> writer_ = nullptr;
+    OHOS::ThreadPool convertPool_ {"DistributedConvert"};
+    size_t convertThreadNum_ = 0;
 
     std::shared_ptr<DistributedDatabaseCallback> databaseCb_;
     std::shared_ptr<DistributedDeviceCallback> deviceCb_;
     IDistributedCallback callback_ = {0};
 
+    // Serializes the writes of the local notifications, so that a rewrite does not overtake a later publish.
+    std::mutex localMutex_;
+    std::map<std::string, sptr<NotificationRequest>> localRequests_;  // distributed key -> request
+
+    std::mutex imageMutex_;
+    std::map<std::string, uint32_t> imageRefs_;  // hash -> number of local notifications referencing the image
+    std::map<std::string, std::set<std::string>> notificationImages_;  // distributed key -> hashes
+    // The images are queued to the writer out of imageMutex_. An image referenced again while its delete is being
+    // queued is put once the delete is queued, so that the put is not overtaken by the delete.
+    std::map<std::string, uint32_t> deletingImages_;  // hash -> number of deletes being queued
+    std::map<std::string, std::string> deferredImages_;  // hash -> image
+
+    std::map<std::string, WaitingRecord> waitingRecords_;  // key in the database -> record, used on handler_ only
+
+    std::mutex codecMutex_;
+    std::set<std::string> onlineDevices_;
+    // The devices connected before their codec is synchronized, by connection sequence. They do not change the format
+    // until CODEC_WAIT_TIME passes, so that a reconnecting device does not have every notification rewritten twice.
+    std::map<std::string, uint64_t> codecWaitingDevices_;
+    uint64_t connectionSequence_ = 0;
+    std::map<std::string, uint32_t> deviceCodecs_;  // device id -> binary format version
+    std::map<std::string, bool> localRecordFormats_;  // distributed key -> whether written in the binary format
+    std::map<std::string, bool> remoteRecordFormats_;
+
     DECLARE_DELAYED_SINGLETON(DistributedNotificationManager);
     DISALLOW_COPY_AND_MOVE(DistributedNotificationManager);
 };
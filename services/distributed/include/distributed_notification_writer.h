@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_DISTRIBUTED_INCLUDE_DISTRIBUTED_NOTIFICATION_WRITER_H
+#define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_DISTRIBUTED_INCLUDE_DISTRIBUTED_NOTIFICATION_WRITER_H
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "event_handler.h"
+
+#include "distributed_database.h"
+
+namespace OHOS {
+namespace Notification {
+/**
+ * Writes the local notifications to the distributed database in batches.
+ *
+ * The writes of a flush interval are coalesced by key, the latest one wins, and written in the order of their latest
+ * write with one PutBatch or DeleteBatch per run of the same kind. A flush rejected by the flow control is delayed
+ * until the budget allows it instead of being dropped. The writes failing several times are dropped, the owner is told
+ * which puts are lost through the drop callback.
+ */
+class DistributedNotificationWriter : public std::enable_shared_from_this<DistributedNotificationWriter> {
+public:
+    struct Stats {
+        size_t pending {0};
+        uint64_t written {0};     // entries written to the database
+        uint64_t coalesced {0};   // writes superseded by a later write of the same key before being flushed
+        uint64_t batches {0};     // PutBatch and DeleteBatch calls
+        uint64_t delayed {0};     // flushes delayed by the flow control
+        uint64_t dropped {0};     // entries given up after failing too many times
+    };
+
+    /**
+     * @brief The constructor.
+     *
+     * @param handler Indicates the handler the flushes run on, without it the writes wait for Flush.
+     * @param flushInterval Indicates the time in milliseconds the writes are gathered before being flushed.
+     */
+    DistributedNotificationWriter(const std::shared_ptr<AppExecFwk::EventHandler> &handler, int64_t flushInterval);
+    ~DistributedNotificationWriter() = default;
+
+    /**
+     * @brief Sets the database the writes are flushed to.
+     *
+     * @param database Indicates the database.
+     */
+    void SetDatabase(const std::shared_ptr<DistributedDatabase> &database);
+
+    /**
+     * @brief Sets the callback receiving the keys of the puts dropped after failing several times, it is called out
+     * of the locks of the writer.
+     *
+     * @param callback Indicates the callback.
+     */
+    void SetDropCallback(const std::function<void(const std::vector<std::string> &keys)> &callback);
+
+    /**
+     * @brief Puts a key-value on the next flush.
+     *
+     * @param key Indicates the key.
+     * @param value Indicates the value.
+     */
+    void Put(const std::string &key, const std::string &value);
+
+    /**
+     * @brief Deletes a key-value on the next flush.
+     *
+     * @param key Indicates the key.
+     */
+    void Delete(const std::string &key);
+
+    /**
+     * @brief Writes the pending writes now on the calling thread.
+     *
+     * @return Returns true if the pending writes are written, otherwise they are left for a later flush.
+     */
+    bool Flush();
+
+    /**
+     * @brief Drops the pending writes.
+     */
+    void Clear();
+
+    Stats GetStats();
+
+private:
+    struct Operation {
+        std::string key;
+        std::string value;
+        bool isDelete {false};
+    };
+
+    void Enqueue(Operation &&operation);
+    void ScheduleFlush(int64_t delay);
+    void OnFlush();
+    bool DoFlush(bool scheduled);
+    bool WriteOperations(std::list<Operation> &operations, int64_t &delay);
+    bool Requeue(std::list<Operation> &operations, int64_t &delay, std::vector<std::string> &droppedKeys);
+
+    std::weak_ptr<AppExecFwk::EventHandler> handler_;
+    int64_t flushInterval_ {0};
+    std::mutex flushMutex_;
+    std::mutex mutex_;
+    std::shared_ptr<DistributedDatabase> database_;
+    std::function<void(const std::vector<std::string> &keys)> dropCallback_;
+    std::list<Operation> operations_;
+    std::unordered_map<std::string, std::list<Operation>::iterator> index_;
+    bool flushScheduled_ {false};
+    uint32_t failedTimes_ {0};
+    Stats stats_;
+};
+}  // namespace Notification
+}  // namespace OHOS
+
+#endif  // BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_DISTRIBUTED_INCLUDE_DISTRIBUTED_NOTIFICATION_WRITER_H
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_DISTRIBUTED_INCLUDE_DISTRIBUTED_RATE_LIMITER_H
+#define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_DISTRIBUTED_INCLUDE_DISTRIBUTED_RATE_LIMITER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace OHOS {
+namespace Notification {
+/**
+ * Limits the number of calls per second and per minute in fixed memory.
+ *
+ * Each window counts its calls in buckets of 1/60 of its length and a call expires with its bucket, so a check
+ * costs constant time whatever the number of calls in the window.
+ */
+class DistributedRateLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief The constructor.
+     *
+     * @param secondMaxinum The maximum number of calls per second.
+     * @param minuteMaxinum The maximum number of calls per minute.
+     */
+    DistributedRateLimiter(size_t secondMaxinum, size_t minuteMaxinum);
+
+    /**
+     * @brief Counts a call if both windows allow it.
+     *
+     * @param now Indicates the time of the call.
+     * @return True if the call is allowed, otherwise false and the call is not counted.
+     */
+    bool TryAcquire(Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Get the time to wait before a call is allowed, the call is not counted.
+     *
+     * @param now Indicates the current time.
+     * @return The time to wait in milliseconds, 0 if a call is allowed now.
+     */
+    int64_t GetDelay(Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Forgets the counted calls.
+     */
+    void Clear(void);
+
+private:
+    class Window {
+    public:
+        Window(Clock::duration length, size_t maxinum);
+        bool IsFull(Clock::time_point now);
+        void Add(void);
+        Clock::duration GetDelay(Clock::time_point now);
+        void Clear(void);
+
+    private:
+        static constexpr int64_t BUCKET_NUM = 60;
+
+        void Advance(Clock::time_point now);
+
+        Clock::duration bucketLength_;
+        size_t maxinum_ {0};
+        std::array<uint32_t, BUCKET_NUM> buckets_ {};
+        int64_t currentBucket_ {0};  // number of bucket lengths since the clock epoch
+        size_t total_ {0};
+    };
+
+    Window second_;
+    Window minute_;
+};
+}  // namespace Notification
+}  // namespace OHOS
+
+#endif  // BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_DISTRIBUTED_INCLUDE_DISTRIBUTED_RATE_LIMITER_H
@@ -16,13 +16,17 @@
 #ifndef BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_DISTRIBUTED_INCLUDE_SCREEN_STATUS_MANAGER_H
 #define BASE_NOTIFICATION_DISTRIBUTED_NOTIFICATION_SERVICE_SERVICES_DISTRIBUTED_INCLUDE_SCREEN_STATUS_MANAGER_H
 
+#include <atomic>
+#include <map>
 #include <mutex>
+#include <set>
 
 #include "distributed_kv_data_manager.h"
 #include "event_handler.h"
 #include "event_runner.h"
 #include "singleton.h"
 
+#include "distributed_database_callback.h"
 #include "distributed_device_callback.h"
 #include "distributed_flow_control.h"
 
@@ -32,7 +36,8 @@ class DistributedScreenStatusManager : private DistributedFlowControl,
                                        public DelayedSingleton<DistributedScreenStatusManager> {
 public:
     /**
-     * @brief Check if any other device screen is on.
+     * @brief Check if any other device screen is on. The screen status of the other devices is kept in memory and
+     * updated by the database changes, the database is only queried until the status is loaded.
      *
      * @param isUsing True for any other device screen is on, otherwise false.
      * @return Returns the error code.
@@ -50,6 +55,11 @@ public:
 private:
     void OnDeviceConnected(const std::string &deviceId);
     void OnDeviceDisconnected(const std::string &deviceId);
+    void OnRemoteScreenStatusChanged(const std::string &deviceId, const std::string &key, const std::string &value);
+    void OnRemoteScreenStatusDeleted(const std::string &deviceId, const std::string &key, const std::string &value);
+
+    ErrCode LoadRemoteScreenStatus(void);
+    void UpdateRemoteUsing(void);
 
     void GetKvDataManager(void);
     bool CheckKvDataManager(void);
@@ -65,9 +75,16 @@ private:
     std::unique_ptr<DistributedKv::DistributedKvDataManager> kvDataManager_ = nullptr;
     std::shared_ptr<DistributedKv::SingleKvStore> kvStore_ = nullptr;
     std::shared_ptr<DistributedDeviceCallback> deviceCb_ = nullptr;
+    std::shared_ptr<DistributedDatabaseCallback> databaseCb_ = nullptr;
 
     bool localScreenOn_ = false;
 
+    bool subscribed_ = false;
+    std::set<std::string> onlineDevices_;
+    std::map<std::string, bool> remoteScreenOn_;  // device id -> screen on, as stored in the database
+    std::atomic<bool> remoteStatusLoaded_ {false};
+    std::atomic<bool> remoteUsing_ {false};
+
     DECLARE_DELAYED_SINGLETON(DistributedScreenStatusManager);
     DISALLOW_COPY_AND_MOVE(DistributedScreenStatusManager);
 };
@@ -130,9 +130,38 @@ bool DistributedDatabase::PutToDistributedDB(const std::string &key, const std::
     return true;
 }
 
+bool DistributedDatabase::PutBatchToDistributedDB(const std::vector<Entry> &entries)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!CheckKvStore()) {
+        return false;
+    }
+
+    if (!KvStoreFlowControl()) {
+        ANS_LOGE("KvStore flow control.");
+        return false;
+    }
+
+    DistributedKv::Status status = kvStore_->PutBatch(entries);
+    if (status != DistributedKv::Status::SUCCESS) {
+        ANS_LOGE("kvStore PutBatch() failed ret = 0x%{public}x", status);
+        return false;
+    }
+
+    return true;
+}
+
 bool DistributedDatabase::GetFromDistributedDB(const std::string &key, std::string &value)
+{
+    bool isFound = false;
+    return GetFromDistributedDB(key, value, isFound) && isFound;
+}
+
+bool DistributedDatabase::GetFromDistributedDB(const std::string &key, std::string &value, bool &isFound)
 {
     std::lock_guard<std::mutex> lock(mutex_);
+    isFound = false;
 
     if (!CheckKvStore()) {
         return false;
@@ -146,13 +175,16 @@ bool DistributedDatabase::GetFromDistributedDB(const std::string &key, std::stri
     DistributedKv::Key kvStoreKey(key);
     DistributedKv::Value kvStoreValue;
     DistributedKv::Status status = kvStore_->Get(kvStoreKey, kvStoreValue);
+    if (status == DistributedKv::Status::KEY_NOT_FOUND) {
+        return true;
+    }
     if (status != DistributedKv::Status::SUCCESS) {
         ANS_LOGE("kvStore Get() failed ret = 0x%{public}x", status);
         return false;
     }
 
     value = kvStoreValue.ToString();
-
+    isFound = true;
     return true;
 }
 
@@ -202,6 +234,35 @@ bool DistributedDatabase::DeleteToDistributedDB(const std::string &key)
     return true;
 }
 
+bool DistributedDatabase::DeleteBatchToDistributedDB(const std::vector<std::string> &keys)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!CheckKvStore()) {
+        return false;
+    }
+
+    if (!KvStoreFlowControl()) {
+        ANS_LOGE("KvStore flow control.");
+        return false;
+    }
+
+    std::vector<DistributedKv::Key> kvStoreKeys(keys.begin(), keys.end());
+    DistributedKv::Status status = kvStore_->DeleteBatch(kvStoreKeys);
+    if (status != DistributedKv::Status::SUCCESS) {
+        ANS_LOGE("kvStore DeleteBatch() failed ret = 0x%{public}x", status);
+        return false;
+    }
+
+    return true;
+}
+
+int64_t DistributedDatabase::GetFlowControlDelay(void)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return KvStoreFlowControlDelay();
+}
+
 bool DistributedDatabase::ClearDataByDevice(const std::string &deviceId)
 {
     std::lock_guard<std::mutex> lock(mutex_);
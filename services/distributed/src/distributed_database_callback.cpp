@@ -29,10 +29,13 @@ void DistributedDatabaseCallback::OnChange(const DistributedKv::ChangeNotificati
 {
     ANS_LOGI("%{public}s start", __FUNCTION__);
 
-    if (callback_.OnInsert) {
-        const std::vector<DistributedKv::Entry> &entryList = changeNotification.GetInsertEntries();
-        ANS_LOGI("GetInsertEntries count %{public}zu", entryList.size());
-        for (auto entry : entryList) {
+    const std::vector<DistributedKv::Entry> &insertEntries = changeNotification.GetInsertEntries();
+    if (callback_.OnInsertBatch && (insertEntries.size() > 1)) {
+        ANS_LOGI("GetInsertEntries batch count %{public}zu", insertEntries.size());
+        callback_.OnInsertBatch(changeNotification.GetDeviceId(), insertEntries);
+    } else if (callback_.OnInsert) {
+        ANS_LOGI("GetInsertEntries count %{public}zu", insertEntries.size());
+        for (auto entry : insertEntries) {
             callback_.OnInsert(changeNotification.GetDeviceId(), entry.key.ToString(), entry.value.ToString());
         }
     }
@@ -20,76 +20,33 @@ namespace Notification {
 DistributedFlowControl::DistributedFlowControl(
     size_t kvManagerSecondMaxinum, size_t kvManagerMinuteMaxinum, size_t kvStoreSecondMaxinum,
     size_t kvStoreMinuteMaxinum)
-    : kvManagerSecondMaxinum_(kvManagerSecondMaxinum),
-      kvManagerMinuteMaxinum_(kvManagerMinuteMaxinum),
-      kvStoreSecondMaxinum_(kvStoreSecondMaxinum),
-      kvStoreMinuteMaxinum_(kvStoreMinuteMaxinum)
+    : kvManagerLimiter_(kvManagerSecondMaxinum, kvManagerMinuteMaxinum),
+      kvStoreLimiter_(kvStoreSecondMaxinum, kvStoreMinuteMaxinum)
 {}
 
 bool DistributedFlowControl::KvManagerFlowControl(void)
 {
-    std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
-    kvDataManagerTimestampList_.remove_if([&](const std::chrono::system_clock::time_point &value) -> bool {
-        return now - value > std::chrono::minutes(1);
-    });
-
-    size_t listSize = kvStoreTimestampList_.size();
-    if (listSize >= kvManagerMinuteMaxinum_) {
-        return false;
-    }
-
-    size_t count = 0;
-    for (auto value : kvDataManagerTimestampList_) {
-        if (now - value > std::chrono::seconds(1)) {
-            if (count >= kvManagerSecondMaxinum_) {
-                return false;
-            } else {
-                break;
-            }
-        }
-        count++;
-    }
-
-    kvDataManagerTimestampList_.push_front(now);
-    return true;
+    return kvManagerLimiter_.TryAcquire();
 }
 
 bool DistributedFlowControl::KvStoreFlowControl(void)
 {
-    std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
-    kvStoreTimestampList_.remove_if([&](const std::chrono::system_clock::time_point &value) -> bool {
-        return now - value > std::chrono::minutes(1);
-    });
-
-    size_t listSize = kvStoreTimestampList_.size();
-    if (listSize >= kvStoreMinuteMaxinum_) {
-        return false;
-    }
-
-    size_t count = 0;
-    for (auto value : kvStoreTimestampList_) {
-        if (now - value > std::chrono::seconds(1)) {
-            if (count >= kvStoreSecondMaxinum_) {
-                return false;
-            } else {
-                break;
-            }
-        }
-        count++;
-    }
+    return kvStoreLimiter_.TryAcquire();
+}
 
-    kvStoreTimestampList_.push_front(now);
-    return true;
+int64_t DistributedFlowControl::KvStoreFlowControlDelay(void)
+{
+    return kvStoreLimiter_.GetDelay();
 }
 
 void DistributedFlowControl::KvManagerFlowControlClear(void)
 {
-    kvDataManagerTimestampList_.clear();
+    kvManagerLimiter_.Clear();
 }
 
 void DistributedFlowControl::KvStoreFlowControlClear(void)
 {
-    kvStoreTimestampList_.clear();
+    kvStoreLimiter_.Clear();
 }
 }  // namespace Notification
 }  // namespace OHOS
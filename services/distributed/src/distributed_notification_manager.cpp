@@ -15,16 +15,35 @@
 
 #include "distributed_notification_manager.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <thread>
 #include <vector>
 
 #include "ans_inner_errors.h"
 #include "ans_log_wrapper.h"
 #include "ans_watchdog.h"
+#include "notification_binary_convert.h"
 
 namespace OHOS {
 namespace Notification {
 namespace {
 const std::string DELIMITER = "|";
+const std::string IMAGE_KEY_TAG = "#image";
+const std::string RECORD_KEY_TAG = "#record";
+const std::string CODEC_KEY_TAG = "#codec";
+const std::string ESCAPE = "%";
+const std::string ESCAPED_ESCAPE = "%25";
+const std::string ESCAPED_DELIMITER = "%7C";
+constexpr int64_t WRITE_FLUSH_INTERVAL = 50;  // ms
+constexpr int64_t CODEC_WAIT_TIME = 3000;  // ms
+constexpr int64_t IMAGE_READ_RETRY_INTERVAL = 1000;  // ms
+constexpr uint32_t MAX_IMAGE_READ_RETRY_TIMES = 3;
+constexpr size_t MAX_CONVERT_THREAD_NUM = 4;
+constexpr size_t MIN_CONVERT_RECORDS_PER_THREAD = 8;
+// Image references came with the first binary format version, the devices advertising any version read them.
+constexpr uint32_t IMAGE_REFERENCE_CODEC_VERSION = 1;
 }  // namespace
 
 DistributedNotificationManager::DistributedNotificationManager()
@@ -32,6 +51,13 @@ DistributedNotificationManager::DistributedNotificationManager()
     runner_ = OHOS::AppExecFwk::EventRunner::Create();
     handler_ = std::make_shared<OHOS::AppExecFwk::EventHandler>(runner_);
     AnsWatchdog::AddHandlerThread(handler_, runner_);
+    writer_ = std::make_shared<DistributedNotificationWriter>(handler_, WRITE_FLUSH_INTERVAL);
+    writer_->SetDropCallback(std::bind(&DistributedNotificationManager::OnWritesDropped, this, std::placeholders::_1));
+    // The calling thread converts along with the pool.
+    size_t threadNum = std::min(static_cast<size_t>(std::thread::hardware_concurrency()), MAX_CONVERT_THREAD_NUM);
+    if ((threadNum > 1) && (convertPool_.Start(static_cast<int>(threadNum - 1)) == ERR_OK)) {
+        convertThreadNum_ = threadNum - 1;
+    }
 
     DistributedDatabaseCallback::IDatabaseChange databaseCallback = {
         .OnInsert = std::bind(&DistributedNotificationManager::OnDatabaseInsert,
@@ -49,6 +75,10 @@ DistributedNotificationManager::DistributedNotificationManager()
             std::placeholders::_1,
             std::placeholders::_2,
             std::placeholders::_3),
+        .OnInsertBatch = std::bind(&DistributedNotificationManager::OnDatabaseInsertBatch,
+            this,
+            std::placeholders::_1,
+            std::placeholders::_2),
     };
     databaseCb_ = std::make_shared<DistributedDatabaseCallback>(databaseCallback);
 
@@ -63,11 +93,16 @@ DistributedNotificationManager::DistributedNotificationManager()
         ANS_LOGE("database_ is nullptr.");
         return;
     }
+    writer_->SetDatabase(database_);
     database_->RecreateDistributedDB();
+    LoadOnlineDevices();
+    AdvertiseCodec();
 }
 
 DistributedNotificationManager::~DistributedNotificationManager()
 {
+    convertPool_.Stop();
+    writer_->Flush();
     handler_->PostSyncTask(std::bind([&]() { callback_ = {}; }), AppExecFwk::EventHandler::Priority::HIGH);
 }
 
@@ -127,54 +162,249 @@ bool DistributedNotificationManager::CheckDeviceId(const std::string &deviceId,
     return deviceId == resolveKey.deviceId;
 }
 
+bool DistributedNotificationManager::GetDeviceIdFromKey(const std::string &key, std::string &deviceId)
+{
+    std::size_t deviceIdEndPosition = key.find(DELIMITER);
+    if (deviceIdEndPosition == std::string::npos) {
+        return false;
+    }
+    deviceId = key.substr(0, deviceIdEndPosition);
+    return true;
+}
+
+bool DistributedNotificationManager::IsTaggedKey(const std::string &key, const std::string &tag)
+{
+    std::size_t deviceIdEndPosition = key.find(DELIMITER);
+    if (deviceIdEndPosition == std::string::npos) {
+        return false;
+    }
+    return key.compare(deviceIdEndPosition + DELIMITER.size(), tag.size() + DELIMITER.size(), tag + DELIMITER) == 0;
+}
+
+void DistributedNotificationManager::GenerateRecordKey(const std::string &key, std::string &recordKey)
+{
+    std::size_t deviceIdEndPosition = key.find(DELIMITER);
+    recordKey = key.substr(0, deviceIdEndPosition) + DELIMITER + RECORD_KEY_TAG + DELIMITER;
+    for (std::size_t i = deviceIdEndPosition + DELIMITER.size(); i < key.size(); i++) {
+        if (key.compare(i, ESCAPE.size(), ESCAPE) == 0) {
+            recordKey += ESCAPED_ESCAPE;
+        } else if (key.compare(i, DELIMITER.size(), DELIMITER) == 0) {
+            recordKey += ESCAPED_DELIMITER;
+        } else {
+            recordKey += key[i];
+        }
+    }
+}
+
+bool DistributedNotificationManager::ResolveRecordKey(const std::string &recordKey, std::string &key)
+{
+    std::string deviceId;
+    if (!GetDeviceIdFromKey(recordKey, deviceId)) {
+        return false;
+    }
+    key = deviceId + DELIMITER;
+    std::size_t position = deviceId.size() + DELIMITER.size() + RECORD_KEY_TAG.size() + DELIMITER.size();
+    while (position < recordKey.size()) {
+        if (recordKey.compare(position, ESCAPED_ESCAPE.size(), ESCAPED_ESCAPE) == 0) {
+            key += ESCAPE;
+            position += ESCAPED_ESCAPE.size();
+        } else if (recordKey.compare(position, ESCAPED_DELIMITER.size(), ESCAPED_DELIMITER) == 0) {
+            key += DELIMITER;
+            position += ESCAPED_DELIMITER.size();
+        } else {
+            key += recordKey[position++];
+        }
+    }
+    return true;
+}
+
+bool DistributedNotificationManager::ResolveImageKey(const std::string &key, std::string &deviceId, std::string &hash)
+{
+    if (!IsTaggedKey(key, IMAGE_KEY_TAG) || !GetDeviceIdFromKey(key, deviceId)) {
+        return false;
+    }
+    hash = key.substr(deviceId.size() + DELIMITER.size() + IMAGE_KEY_TAG.size() + DELIMITER.size());
+    return true;
+}
+
+bool DistributedNotificationManager::ResolveNotificationKey(
+    const std::string &key, std::string &notificationKey, bool &isBinary)
+{
+    if (IsTaggedKey(key, IMAGE_KEY_TAG) || IsTaggedKey(key, CODEC_KEY_TAG)) {
+        return false;
+    }
+
+    isBinary = IsTaggedKey(key, RECORD_KEY_TAG);
+    if (!isBinary) {
+        notificationKey = key;
+        return true;
+    }
+    return ResolveRecordKey(key, notificationKey);
+}
+
 void DistributedNotificationManager::OnDatabaseInsert(
     const std::string &deviceId, const std::string &key, const std::string &value)
 {
     ANS_LOGD("%{public}s", __FUNCTION__);
     handler_->PostTask(std::bind([=]() {
-        if (!CheckDeviceId(deviceId, key)) {
+        if (IsTaggedKey(key, CODEC_KEY_TAG)) {
+            OnDeviceCodec(key, value, false);
+            return;
+        }
+        if (IsTaggedKey(key, IMAGE_KEY_TAG)) {
+            OnImageInsert(key, value);
+            return;
+        }
+        std::string notificationKey;
+        bool isBinary = false;
+        if (!ResolveNotificationKey(key, notificationKey, isBinary)) {
+            return;
+        }
+        if (!CheckDeviceId(deviceId, notificationKey)) {
             ANS_LOGW("device id are not the same. deviceId:%{public}s key:%{public}s", deviceId.c_str(), key.c_str());
         }
 
         ResolveKey resolveKey;
-        if (!ResolveDistributedKey(key, resolveKey)) {
+        if (!ResolveDistributedKey(notificationKey, resolveKey)) {
             ANS_LOGE("key <%{public}s> is invalid.", key.c_str());
             return;
         }
 
+        std::set<std::string> missingImages;
+        bool imageReadFailed = false;
         sptr<NotificationRequest> request =
-            NotificationJsonConverter::ConvertFromJsonString<NotificationRequest>(value);
+            ConvertToRequest(resolveKey.deviceId, value, nullptr, &missingImages, &imageReadFailed);
         if (request == nullptr) {
-            ANS_LOGE("convert json to request failed. key:%{public}s", key.c_str());
+            ANS_LOGE("convert value to request failed. key:%{public}s", key.c_str());
             return;
         }
+        WaitForImages(key, resolveKey.deviceId, value, missingImages, imageReadFailed);
 
+        // A notification switching format is put under its new key before being deleted from the former one.
+        if (SetRemoteRecordFormat(notificationKey, isBinary)) {
+            UpdateCallback(resolveKey.deviceId, resolveKey.bundleName, request);
+            return;
+        }
         PublishCallback(resolveKey.deviceId, resolveKey.bundleName, request);
     }));
 }
 
+void DistributedNotificationManager::OnDatabaseInsertBatch(
+    const std::string &deviceId, const std::vector<DistributedKv::Entry> &entries)
+{
+    ANS_LOGD("%{public}s", __FUNCTION__);
+    handler_->PostTask(std::bind([=]() {
+        std::map<std::string, std::string> images;  // hash -> image put along with the notifications
+        std::vector<std::string> imageKeys;
+        std::vector<RemoteRecord> records;
+        std::map<std::string, size_t> recordIndexes;  // distributed key -> index in records
+        for (auto &entry : entries) {
+            std::string key = entry.key.ToString();
+            if (IsTaggedKey(key, CODEC_KEY_TAG)) {
+                OnDeviceCodec(key, entry.value.ToString(), false);
+                continue;
+            }
+            std::string imageDeviceId;
+            std::string hash;
+            if (ResolveImageKey(key, imageDeviceId, hash)) {
+                images.emplace(hash, entry.value.ToString());
+                imageKeys.push_back(key);
+                continue;
+            }
+
+            RemoteRecord record;
+            record.key = key;
+            if (!ResolveNotificationKey(key, record.notificationKey, record.isBinary)) {
+                continue;
+            }
+            if (!CheckDeviceId(deviceId, record.notificationKey)) {
+                ANS_LOGW("device id are not the same. deviceId:%{public}s key:%{public}s", deviceId.c_str(),
+                    key.c_str());
+            }
+            if (!ResolveDistributedKey(record.notificationKey, record.resolveKey)) {
+                ANS_LOGE("key <%{public}s> is invalid.", key.c_str());
+                continue;
+            }
+            record.value = entry.value.ToString();
+
+            // Caught switching format, the notification is in both formats and the binary one is the later.
+            auto iter = recordIndexes.find(record.notificationKey);
+            if (iter == recordIndexes.end()) {
+                recordIndexes.emplace(record.notificationKey, records.size());
+                records.push_back(std::move(record));
+            } else if (record.isBinary) {
+                records[iter->second] = std::move(record);
+            }
+        }
+
+        ConvertToRequests(records, images);
+
+        std::vector<DistributedRequest> requests;
+        for (auto &record : records) {
+            if (record.request == nullptr) {
+                ANS_LOGE("convert value to request failed. key:%{public}s", record.notificationKey.c_str());
+                continue;
+            }
+            WaitForImages(
+                record.key, record.resolveKey.deviceId, record.value, record.missingImages, record.imageReadFailed);
+            if (SetRemoteRecordFormat(record.notificationKey, record.isBinary)) {
+                UpdateCallback(record.resolveKey.deviceId, record.resolveKey.bundleName, record.request);
+                continue;
+            }
+            requests.push_back({record.resolveKey.deviceId, record.resolveKey.bundleName, record.request});
+        }
+        PublishBatchCallback(requests);
+
+        // The notifications synchronized before their images are updated now.
+        std::string imageDeviceId;
+        std::string hash;
+        for (auto &imageKey : imageKeys) {
+            if (ResolveImageKey(imageKey, imageDeviceId, hash)) {
+                OnImageInsert(imageKey, images[hash]);
+            }
+        }
+    }));
+}
+
 void DistributedNotificationManager::OnDatabaseUpdate(
     const std::string &deviceId, const std::string &key, const std::string &value)
 {
     ANS_LOGD("%{public}s", __FUNCTION__);
     handler_->PostTask(std::bind([=]() {
-        if (!CheckDeviceId(deviceId, key)) {
+        if (IsTaggedKey(key, CODEC_KEY_TAG)) {
+            OnDeviceCodec(key, value, false);
+            return;
+        }
+        if (IsTaggedKey(key, IMAGE_KEY_TAG)) {
+            OnImageInsert(key, value);
+            return;
+        }
+        std::string notificationKey;
+        bool isBinary = false;
+        if (!ResolveNotificationKey(key, notificationKey, isBinary)) {
+            return;
+        }
+        if (!CheckDeviceId(deviceId, notificationKey)) {
             ANS_LOGW("device id are not the same. deviceId:%{public}s key:%{public}s", deviceId.c_str(), key.c_str());
         }
 
         ResolveKey resolveKey;
-        if (!ResolveDistributedKey(key, resolveKey)) {
+        if (!ResolveDistributedKey(notificationKey, resolveKey)) {
             ANS_LOGE("key <%{public}s> is invalid.", key.c_str());
             return;
         }
 
+        std::set<std::string> missingImages;
+        bool imageReadFailed = false;
         sptr<NotificationRequest> request =
-            NotificationJsonConverter::ConvertFromJsonString<NotificationRequest>(value);
+            ConvertToRequest(resolveKey.deviceId, value, nullptr, &missingImages, &imageReadFailed);
         if (request == nullptr) {
-            ANS_LOGE("convert json to request failed. key:%{public}s", key.c_str());
+            ANS_LOGE("convert value to request failed. key:%{public}s", key.c_str());
             return;
         }
+        WaitForImages(key, resolveKey.deviceId, value, missingImages, imageReadFailed);
 
+        SetRemoteRecordFormat(notificationKey, isBinary);
         UpdateCallback(resolveKey.deviceId, resolveKey.bundleName, request);
     }));
 }
@@ -184,16 +414,41 @@ void DistributedNotificationManager::OnDatabaseDelete(
 {
     ANS_LOGD("%{public}s", __FUNCTION__);
     handler_->PostTask(std::bind([=]() {
-        if (!CheckDeviceId(deviceId, key)) {
+        if (IsTaggedKey(key, CODEC_KEY_TAG)) {
+            OnDeviceCodec(key, value, true);
+            return;
+        }
+        std::string notificationKey;
+        bool isBinary = false;
+        if (!ResolveNotificationKey(key, notificationKey, isBinary)) {
+            return;
+        }
+        waitingRecords_.erase(key);
+        if (!CheckDeviceId(deviceId, notificationKey)) {
             ANS_LOGW("device id are not the same. deviceId:%{public}s key:%{public}s", deviceId.c_str(), key.c_str());
         }
 
         ResolveKey resolveKey;
-        if (!ResolveDistributedKey(key, resolveKey)) {
+        if (!ResolveDistributedKey(notificationKey, resolveKey)) {
             ANS_LOGE("key <%{public}s> is invalid.", key.c_str());
             return;
         }
 
+        {
+            // The notification lives on under the key of its new format.
+            std::lock_guard<std::mutex> lock(codecMutex_);
+            auto iter = remoteRecordFormats_.find(notificationKey);
+            if (iter != remoteRecordFormats_.end()) {
+                if (iter->second != isBinary) {
+                    return;
+                }
+                remoteRecordFormats_.erase(iter);
+            }
+        }
+
+        // A local notification deleted by a remote device no longer references its images.
+        TakeLocalRecordFormat(notificationKey);
+        ReleaseNotificationImages(notificationKey);
         DeleteCallback(resolveKey.deviceId, resolveKey.bundleName, resolveKey.label, resolveKey.id);
     }));
 }
@@ -201,10 +456,41 @@ void DistributedNotificationManager::OnDatabaseDelete(
 void DistributedNotificationManager::OnDeviceConnected(const std::string &deviceId)
 {
     ANS_LOGD("%{public}s", __FUNCTION__);
-    handler_->PostTask(std::bind([=]() {}));
+    handler_->PostTask(std::bind([=]() {
+        uint64_t sequence = 0;
+        {
+            std::lock_guard<std::mutex> lock(codecMutex_);
+            onlineDevices_.insert(deviceId);
+            if (deviceCodecs_.count(deviceId) == 0) {
+                sequence = ++connectionSequence_;
+                codecWaitingDevices_[deviceId] = sequence;
+            }
+        }
+        if (sequence == 0) {
+            RewriteLocalRecords();
+            return;
+        }
+
+        handler_->PostTask(
+            std::bind(&DistributedNotificationManager::OnCodecWaitTimeout, this, deviceId, sequence), CODEC_WAIT_TIME);
+    }));
     return;
 }
 
+void DistributedNotificationManager::OnCodecWaitTimeout(const std::string &deviceId, uint64_t sequence)
+{
+    // A device without codec is taken as an earlier one once its codec is not synchronized in time.
+    {
+        std::lock_guard<std::mutex> lock(codecMutex_);
+        auto iter = codecWaitingDevices_.find(deviceId);
+        if ((iter == codecWaitingDevices_.end()) || (iter->second != sequence)) {
+            return;
+        }
+        codecWaitingDevices_.erase(iter);
+    }
+    RewriteLocalRecords();
+}
+
 void DistributedNotificationManager::OnDeviceDisconnected(const std::string &deviceId)
 {
     ANS_LOGD("%{public}s", __FUNCTION__);
@@ -217,9 +503,16 @@ void DistributedNotificationManager::OnDeviceDisconnected(const std::string &dev
             return;
         }
 
+        std::set<std::string> notificationKeys;
         for (auto index : entries) {
+            std::string notificationKey;
+            bool isBinary = false;
+            if (!ResolveNotificationKey(index.key.ToString(), notificationKey, isBinary) ||
+                !notificationKeys.insert(notificationKey).second) {
+                continue;
+            }
             ResolveKey resolveKey;
-            if (!ResolveDistributedKey(index.key.ToString(), resolveKey)) {
+            if (!ResolveDistributedKey(notificationKey, resolveKey)) {
                 ANS_LOGE("key <%{public}s> is invalid.", index.key.ToString().c_str());
                 continue;
             }
@@ -228,10 +521,25 @@ void DistributedNotificationManager::OnDeviceDisconnected(const std::string &dev
         }
 
         database_->ClearDataByDevice(deviceId);
+        for (auto iter = waitingRecords_.begin(); iter != waitingRecords_.end();) {
+            iter = (iter->second.deviceId == deviceId) ? waitingRecords_.erase(iter) : std::next(iter);
+        }
+        {
+            std::lock_guard<std::mutex> lock(codecMutex_);
+            onlineDevices_.erase(deviceId);
+            deviceCodecs_.erase(deviceId);
+            codecWaitingDevices_.erase(deviceId);
+            for (auto &notificationKey : notificationKeys) {
+                remoteRecordFormats_.erase(notificationKey);
+            }
+        }
 
         std::vector<DistributedDatabase::DeviceInfo> deviceList;
         if (database_->GetDeviceInfoList(deviceList) == ERR_OK && deviceList.empty()) {
             database_->RecreateDistributedDB();
+            ClearImages();
+            ClearRecordFormats();
+            AdvertiseCodec();
         }
     }));
     return;
@@ -249,6 +557,25 @@ bool DistributedNotificationManager::PublishCallback(
     return true;
 }
 
+bool DistributedNotificationManager::PublishBatchCallback(std::vector<DistributedRequest> &requests)
+{
+    if (requests.empty()) {
+        return true;
+    }
+
+    ANS_LOGI("callback_.OnPublishBatch start, count %{public}zu.", requests.size());
+    if (callback_.OnPublishBatch) {
+        callback_.OnPublishBatch(requests);
+    } else {
+        for (auto &request : requests) {
+            PublishCallback(request.deviceId, request.bundleName, request.request);
+        }
+    }
+    ANS_LOGI("callback_.OnPublishBatch end.");
+
+    return true;
+}
+
 bool DistributedNotificationManager::UpdateCallback(
     const std::string &deviceId, const std::string &bundleName, sptr<NotificationRequest> &request)
 {
@@ -283,18 +610,8 @@ ErrCode DistributedNotificationManager::Publish(
         return ERR_ANS_DISTRIBUTED_GET_INFO_FAILED;
     }
 
-    std::string value;
-    if (!NotificationJsonConverter::ConvertToJsonString(request, value)) {
-        ANS_LOGE("convert request to json failed. key:%{public}s", key.c_str());
-        return ERR_ANS_DISTRIBUTED_OPERATION_FAILED;
-    }
-
-    if (!database_->PutToDistributedDB(key, value)) {
-        ANS_LOGE("put to distributed DB failed. key:%{public}s", key.c_str());
-        return ERR_ANS_DISTRIBUTED_OPERATION_FAILED;
-    }
-
-    return ERR_OK;
+    std::lock_guard<std::mutex> lock(localMutex_);
+    return PutRequestToDistributedDB(key, request);
 }
 
 ErrCode DistributedNotificationManager::Update(
@@ -307,17 +624,8 @@ ErrCode DistributedNotificationManager::Update(
         return ERR_ANS_DISTRIBUTED_GET_INFO_FAILED;
     }
 
-    std::string value;
-    if (!NotificationJsonConverter::ConvertToJsonString(request, value)) {
-        ANS_LOGE("convert request to json failed. key:%{public}s", key.c_str());
-        return ERR_ANS_DISTRIBUTED_OPERATION_FAILED;
-    }
-
-    if (!database_->PutToDistributedDB(key, value)) {
-        ANS_LOGE("put to distributed DB failed. key:%{public}s", key.c_str());
-        return ERR_ANS_DISTRIBUTED_OPERATION_FAILED;
-    }
-    return ERR_OK;
+    std::lock_guard<std::mutex> lock(localMutex_);
+    return PutRequestToDistributedDB(key, request);
 }
 
 ErrCode DistributedNotificationManager::Delete(const std::string &bundleName, const std::string &label, int32_t id)
@@ -329,10 +637,16 @@ ErrCode DistributedNotificationManager::Delete(const std::string &bundleName, co
         return ERR_ANS_DISTRIBUTED_GET_INFO_FAILED;
     }
 
-    if (!database_->DeleteToDistributedDB(key)) {
-        ANS_LOGE("delete to distributed DB failed. key:%{public}s", key.c_str());
-        return ERR_ANS_DISTRIBUTED_OPERATION_FAILED;
+    std::lock_guard<std::mutex> lock(localMutex_);
+    localRequests_.erase(key);
+    if (TakeLocalRecordFormat(key)) {
+        std::string recordKey;
+        GenerateRecordKey(key, recordKey);
+        writer_->Delete(recordKey);
+    } else {
+        writer_->Delete(key);
     }
+    ReleaseNotificationImages(key);
     return ERR_OK;
 }
 
@@ -343,11 +657,12 @@ ErrCode DistributedNotificationManager::DeleteRemoteNotification(
 
     std::string key;
     GenerateDistributedKey(deviceId, bundleName, label, id, key);
+    std::string recordKey;
+    GenerateRecordKey(key, recordKey);
 
-    if (!database_->DeleteToDistributedDB(key)) {
-        ANS_LOGE("delete to distributed DB failed. key:%{public}s", key.c_str());
-        return ERR_ANS_DISTRIBUTED_OPERATION_FAILED;
-    }
+    // The remote notification is written in either format.
+    writer_->Delete(key);
+    writer_->Delete(recordKey);
     return ERR_OK;
 }
 
@@ -376,21 +691,49 @@ ErrCode DistributedNotificationManager::GetCurrentDistributedNotification(
         return ERR_ANS_DISTRIBUTED_OPERATION_FAILED;
     }
 
+    std::set<std::string> notificationKeys;
+    std::vector<RemoteRecord> records;
     for (auto index : entries) {
-        ResolveKey resolveKey;
-        if (!ResolveDistributedKey(index.key.ToString(), resolveKey)) {
+        RemoteRecord record;
+        record.key = index.key.ToString();
+        if (!ResolveNotificationKey(record.key, record.notificationKey, record.isBinary) ||
+            !notificationKeys.insert(record.notificationKey).second) {
+            continue;
+        }
+        if (!ResolveDistributedKey(record.notificationKey, record.resolveKey)) {
             ANS_LOGE("key <%{public}s> is invalid.", index.key.ToString().c_str());
             continue;
         }
+        record.value = index.value.ToString();
+        records.push_back(std::move(record));
+    }
 
-        sptr<NotificationRequest> request =
-            NotificationJsonConverter::ConvertFromJsonString<NotificationRequest>(index.value.ToString());
-        if (request == nullptr) {
-            ANS_LOGE("convert json to request failed. key:%{public}s", index.key.ToString().c_str());
+    ConvertToRequests(records, {});
+    std::vector<DistributedRequest> requests;
+    std::vector<WaitingRecord> waitingRecords;
+    std::vector<std::string> waitingKeys;
+    std::vector<bool> imageReadFailures;
+    for (auto &record : records) {
+        if (record.request == nullptr) {
+            ANS_LOGE("convert value to request failed. key:%{public}s", record.notificationKey.c_str());
             continue;
         }
+        if (!record.missingImages.empty()) {
+            waitingKeys.push_back(record.key);
+            waitingRecords.push_back({record.resolveKey.deviceId, record.value, record.missingImages});
+            imageReadFailures.push_back(record.imageReadFailed);
+        }
 
-        PublishCallback(resolveKey.deviceId, resolveKey.bundleName, request);
+        requests.push_back({record.resolveKey.deviceId, record.resolveKey.bundleName, record.request});
+    }
+    PublishBatchCallback(requests);
+    if (!waitingRecords.empty()) {
+        handler_->PostTask(std::bind([=]() {
+            for (size_t index = 0; index < waitingKeys.size(); index++) {
+                WaitForImages(waitingKeys[index], waitingRecords[index].deviceId, waitingRecords[index].value,
+                    waitingRecords[index].missingImages, imageReadFailures[index]);
+            }
+        }));
     }
 
     return ERR_OK;
@@ -416,11 +759,535 @@ ErrCode DistributedNotificationManager::OnDistributedKvStoreDeathRecipient()
         ANS_LOGE("database_ is nullptr.");
         return ERR_ANS_NO_MEMORY;
     }
+    // The store is recreated empty, the writes pending for the former one are given up with their images.
+    std::lock_guard<std::mutex> lock(localMutex_);
+    localRequests_.clear();
+    writer_->Clear();
+    writer_->SetDatabase(database_);
+    ClearImages();
+    ClearRecordFormats();
     if (!database_->RecreateDistributedDB()) {
         ANS_LOGE("RecreateDistributedDB failed.");
         return ERR_ANS_DISTRIBUTED_OPERATION_FAILED;
     }
+    AdvertiseCodec();
     return ERR_OK;
 }
+
+ErrCode DistributedNotificationManager::PutRequestToDistributedDB(
+    const std::string &key, const sptr<NotificationRequest> &request)
+{
+    ResolveKey resolveKey;
+    if (!ResolveDistributedKey(key, resolveKey)) {
+        ANS_LOGE("key <%{public}s> is invalid.", key.c_str());
+        return ERR_ANS_DISTRIBUTED_OPERATION_FAILED;
+    }
+
+    // The binary format is written once every online device reads it, the json is kept for the earlier ones.
+    // The images are carried as binary entries keyed by their content once every online device reads them, the
+    // notification only references them. They are inline for the earlier devices.
+    bool isBinary = IsBinaryRecordSupported();
+    AnsImageUtil::ImageAttachments attachments;
+    std::string value;
+    auto convert = [&request, &value, isBinary]() {
+        return isBinary ? NotificationBinaryConverter::ConvertToBinaryString(request, value) :
+            NotificationJsonConverter::ConvertToJsonString(request, value);
+    };
+    bool converted = false;
+    if (isBinary || IsImageReferenceSupported()) {
+        AnsImageUtil::AttachmentScope scope(attachments);
+        converted = convert();
+    } else {
+        converted = convert();
+    }
+    if (!converted) {
+        ANS_LOGE("convert request failed. key:%{public}s", key.c_str());
+        return ERR_ANS_DISTRIBUTED_OPERATION_FAILED;
+    }
+
+    // Queued after its images, so that they are written no later than the notification referencing them.
+    std::set<std::string> hashes;
+    AcquireImages(resolveKey.deviceId, attachments, hashes);
+    std::string recordKey;
+    GenerateRecordKey(key, recordKey);
+    writer_->Put(isBinary ? recordKey : key, value);
+    // Switching format, it is deleted from the former key after being put under the new one.
+    if (SetLocalRecordFormat(key, isBinary)) {
+        writer_->Delete(isBinary ? key : recordKey);
+    }
+
+    // The images of the notification it replaces are released once they are no longer referenced.
+    std::set<std::string> oldHashes;
+    {
+        std::lock_guard<std::mutex> lock(imageMutex_);
+        oldHashes.swap(notificationImages_[key]);
+        if (hashes.empty()) {
+            notificationImages_.erase(key);
+        } else {
+            notificationImages_[key] = std::move(hashes);
+        }
+    }
+    ReleaseImages(resolveKey.deviceId, oldHashes);
+    localRequests_[key] = request;
+    return ERR_OK;
+}
+
+sptr<NotificationRequest> DistributedNotificationManager::ConvertToRequest(const std::string &deviceId,
+    const std::string &value, const std::map<std::string, std::string> *images, std::set<std::string> *missingImages,
+    bool *imageReadFailed)
+{
+    AnsImageUtil::ImageAttachments attachments;
+    attachments.resolver = [this, &deviceId, images, missingImages, imageReadFailed](
+        const std::string &hash, std::string &image) {
+        if (images != nullptr) {
+            auto iter = images->find(hash);
+            if (iter != images->end()) {
+                image = iter->second;
+                return true;
+            }
+        }
+        std::string imageKey;
+        GenerateImageKey(deviceId, hash, imageKey);
+        bool isFound = false;
+        bool isRead = database_->GetFromDistributedDB(imageKey, image, isFound);
+        if (isRead && isFound && !image.empty()) {
+            return true;
+        }
+        // The image may be synchronized after the notification referencing it, or is read again if the read failed.
+        if (missingImages != nullptr) {
+            missingImages->insert(hash);
+        }
+        if (!isRead && (imageReadFailed != nullptr)) {
+            *imageReadFailed = true;
+        }
+        return false;
+    };
+    AnsImageUtil::AttachmentScope scope(attachments);
+    if (NotificationBinaryConverter::IsBinaryString(value)) {
+        return NotificationBinaryConverter::ConvertFromBinaryString<NotificationRequest>(value);
+    }
+    return NotificationJsonConverter::ConvertFromJsonString<NotificationRequest>(value);
+}
+
+void DistributedNotificationManager::ConvertToRequests(
+    std::vector<RemoteRecord> &records, const std::map<std::string, std::string> &images)
+{
+    // Each thread takes the next record, the attachments of the images are open per thread.
+    std::atomic<size_t> next(0);
+    auto convert = [this, &records, &images, &next]() {
+        for (size_t index = next++; index < records.size(); index = next++) {
+            RemoteRecord &record = records[index];
+            record.request = ConvertToRequest(
+                record.resolveKey.deviceId, record.value, &images, &record.missingImages, &record.imageReadFailed);
+        }
+    };
+
+    size_t threadNum = std::min(convertThreadNum_ + 1, records.size() / MIN_CONVERT_RECORDS_PER_THREAD);
+    size_t taskNum = (threadNum > 1) ? (threadNum - 1) : 0;
+    std::mutex mutex;
+    std::condition_variable finished;
+    size_t finishedNum = 0;
+    for (size_t i = 0; i < taskNum; i++) {
+        convertPool_.AddTask([&convert, &mutex, &finished, &finishedNum]() {
+            convert();
+            std::lock_guard<std::mutex> lock(mutex);
+            finishedNum++;
+            finished.notify_one();
+        });
+    }
+    convert();
+    // The tasks refer to this frame, they are waited for even if the records are all taken.
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&finishedNum, taskNum]() { return finishedNum == taskNum; });
+}
+
+void DistributedNotificationManager::GenerateImageKey(
+    const std::string &deviceId, const std::string &hash, std::string &key)
+{
+    key = deviceId + DELIMITER + IMAGE_KEY_TAG + DELIMITER + hash;
+}
+
+void DistributedNotificationManager::AcquireImages(const std::string &deviceId,
+    AnsImageUtil::ImageAttachments &attachments, std::set<std::string> &hashes)
+{
+    std::vector<std::pair<std::string, std::string>> newImages;  // key -> image
+    {
+        std::lock_guard<std::mutex> lock(imageMutex_);
+        for (auto &image : attachments.images) {
+            hashes.insert(image.first);
+            auto result = imageRefs_.emplace(image.first, 0);
+            result.first->second++;
+            if (!result.second) {
+                continue;
+            }
+            if (deletingImages_.count(image.first) != 0) {
+                deferredImages_[image.first] = std::move(image.second);
+                continue;
+            }
+            std::string imageKey;
+            GenerateImageKey(deviceId, image.first, imageKey);
+            newImages.emplace_back(std::move(imageKey), std::move(image.second));
+        }
+    }
+    for (auto &image : newImages) {
+        writer_->Put(image.first, image.second);
+    }
+}
+
+void DistributedNotificationManager::ReleaseImages(const std::string &deviceId, const std::set<std::string> &hashes)
+{
+    std::vector<std::string> releasedHashes;
+    {
+        std::lock_guard<std::mutex> lock(imageMutex_);
+        for (auto &hash : hashes) {
+            auto iter = imageRefs_.find(hash);
+            if (iter == imageRefs_.end()) {
+                continue;
+            }
+            if (--iter->second > 0) {
+                continue;
+            }
+            imageRefs_.erase(iter);
+            deletingImages_[hash]++;
+            releasedHashes.push_back(hash);
+        }
+    }
+    if (releasedHashes.empty()) {
+        return;
+    }
+
+    std::string imageKey;
+    for (auto &hash : releasedHashes) {
+        GenerateImageKey(deviceId, hash, imageKey);
+        writer_->Delete(imageKey);
+    }
+
+    // The images referenced again meanwhile are put after their deletes.
+    std::vector<std::pair<std::string, std::string>> deferredImages;  // key -> image
+    {
+        std::lock_guard<std::mutex> lock(imageMutex_);
+        for (auto &hash : releasedHashes) {
+            auto iter = deletingImages_.find(hash);
+            if ((iter == deletingImages_.end()) || (--iter->second > 0)) {
+                continue;
+            }
+            deletingImages_.erase(iter);
+            auto deferred = deferredImages_.find(hash);
+            if (deferred == deferredImages_.end()) {
+                continue;
+            }
+            if (imageRefs_.count(hash) != 0) {
+                GenerateImageKey(deviceId, hash, imageKey);
+                deferredImages.emplace_back(imageKey, std::move(deferred->second));
+            }
+            deferredImages_.erase(deferred);
+        }
+    }
+    for (auto &image : deferredImages) {
+        writer_->Put(image.first, image.second);
+    }
+}
+
+void DistributedNotificationManager::ReleaseNotificationImages(const std::string &key)
+{
+    ResolveKey resolveKey;
+    if (!ResolveDistributedKey(key, resolveKey)) {
+        return;
+    }
+    std::set<std::string> hashes;
+    {
+        std::lock_guard<std::mutex> lock(imageMutex_);
+        auto iter = notificationImages_.find(key);
+        if (iter == notificationImages_.end()) {
+            return;
+        }
+        hashes.swap(iter->second);
+        notificationImages_.erase(iter);
+    }
+    ReleaseImages(resolveKey.deviceId, hashes);
+}
+
+void DistributedNotificationManager::ClearImages()
+{
+    std::lock_guard<std::mutex> lock(imageMutex_);
+    imageRefs_.clear();
+    notificationImages_.clear();
+    deferredImages_.clear();
+}
+
+void DistributedNotificationManager::OnWritesDropped(const std::vector<std::string> &keys)
+{
+    std::lock_guard<std::mutex> lock(imageMutex_);
+    std::string deviceId;
+    std::string hash;
+    for (auto &key : keys) {
+        if (!ResolveImageKey(key, deviceId, hash) || (imageRefs_.erase(hash) == 0)) {
+            continue;
+        }
+        ANS_LOGW("The image %{public}s is not written, it is put again with the next notification.", hash.c_str());
+        for (auto iter = notificationImages_.begin(); iter != notificationImages_.end();) {
+            iter->second.erase(hash);
+            iter = iter->second.empty() ? notificationImages_.erase(iter) : std::next(iter);
+        }
+    }
+}
+
+void DistributedNotificationManager::WaitForImages(const std::string &key, const std::string &deviceId,
+    const std::string &value, const std::set<std::string> &missingImages, bool readFailed)
+{
+    if (missingImages.empty()) {
+        waitingRecords_.erase(key);
+        return;
+    }
+    ANS_LOGI("%{public}zu images of %{public}s are not synchronized yet.", missingImages.size(), key.c_str());
+    waitingRecords_[key] = {deviceId, value, missingImages};
+    if (readFailed) {
+        // The images already in the database are not inserted again, they are read again instead.
+        handler_->PostTask(
+            std::bind(&DistributedNotificationManager::RetryImageRead, this, key), IMAGE_READ_RETRY_INTERVAL);
+    }
+}
+
+void DistributedNotificationManager::RetryImageRead(const std::string &key)
+{
+    auto iter = waitingRecords_.find(key);
+    if (iter == waitingRecords_.end()) {
+        return;
+    }
+    WaitingRecord &record = iter->second;
+    std::string notificationKey;
+    bool isBinary = false;
+    ResolveKey resolveKey;
+    if (!ResolveNotificationKey(key, notificationKey, isBinary) ||
+        !ResolveDistributedKey(notificationKey, resolveKey)) {
+        waitingRecords_.erase(iter);
+        return;
+    }
+
+    std::set<std::string> missingImages;
+    bool imageReadFailed = false;
+    sptr<NotificationRequest> request =
+        ConvertToRequest(record.deviceId, record.value, nullptr, &missingImages, &imageReadFailed);
+    if (request == nullptr) {
+        waitingRecords_.erase(iter);
+        return;
+    }
+    if (missingImages.empty()) {
+        waitingRecords_.erase(iter);
+        UpdateCallback(resolveKey.deviceId, resolveKey.bundleName, request);
+        return;
+    }
+    record.missingImages = std::move(missingImages);
+    if (imageReadFailed && (++record.readRetryTimes < MAX_IMAGE_READ_RETRY_TIMES)) {
+        handler_->PostTask(
+            std::bind(&DistributedNotificationManager::RetryImageRead, this, key), IMAGE_READ_RETRY_INTERVAL);
+    }
+}
+
+void DistributedNotificationManager::OnImageInsert(const std::string &key, const std::string &image)
+{
+    std::string deviceId;
+    std::string hash;
+    if (!ResolveImageKey(key, deviceId, hash)) {
+        return;
+    }
+
+    std::vector<std::pair<std::string, WaitingRecord>> readyRecords;
+    for (auto iter = waitingRecords_.begin(); iter != waitingRecords_.end();) {
+        WaitingRecord &record = iter->second;
+        if ((record.deviceId != deviceId) || (record.missingImages.erase(hash) == 0) ||
+            !record.missingImages.empty()) {
+            ++iter;
+            continue;
+        }
+        readyRecords.emplace_back(iter->first, std::move(record));
+        iter = waitingRecords_.erase(iter);
+    }
+
+    std::map<std::string, std::string> images = {{hash, image}};
+    for (auto &readyRecord : readyRecords) {
+        std::string notificationKey;
+        bool isBinary = false;
+        ResolveKey resolveKey;
+        if (!ResolveNotificationKey(readyRecord.first, notificationKey, isBinary) ||
+            !ResolveDistributedKey(notificationKey, resolveKey)) {
+            continue;
+        }
+        std::set<std::string> missingImages;
+        bool imageReadFailed = false;
+        sptr<NotificationRequest> request =
+            ConvertToRequest(deviceId, readyRecord.second.value, &images, &missingImages, &imageReadFailed);
+        if (request == nullptr) {
+            continue;
+        }
+        WaitForImages(readyRecord.first, deviceId, readyRecord.second.value, missingImages, imageReadFailed);
+        UpdateCallback(resolveKey.deviceId, resolveKey.bundleName, request);
+    }
+}
+
+void DistributedNotificationManager::AdvertiseCodec()
+{
+    std::string deviceId;
+    if (!database_->GetLocalDeviceId(deviceId)) {
+        ANS_LOGE("Get local device id failed.");
+        return;
+    }
+    std::string key = deviceId + DELIMITER + CODEC_KEY_TAG + DELIMITER;
+    writer_->Put(key, ToString(NotificationBinaryConverter::BINARY_VERSION));
+}
+
+void DistributedNotificationManager::LoadOnlineDevices()
+{
+    std::string localDeviceId;
+    std::vector<DistributedDatabase::DeviceInfo> deviceList;
+    if (!database_->GetLocalDeviceId(localDeviceId) || !database_->GetDeviceInfoList(deviceList)) {
+        ANS_LOGE("Get device info failed.");
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(codecMutex_);
+    for (auto &device : deviceList) {
+        if (device.deviceId != localDeviceId) {
+            onlineDevices_.insert(device.deviceId);
+        }
+    }
+}
+
+void DistributedNotificationManager::OnDeviceCodec(const std::string &key, const std::string &value, bool isDelete)
+{
+    std::string deviceId;
+    if (!GetDeviceIdFromKey(key, deviceId)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(codecMutex_);
+        if (isDelete) {
+            deviceCodecs_.erase(deviceId);
+        } else {
+            deviceCodecs_[deviceId] = static_cast<uint32_t>(atoi(value.c_str()));
+            // A device writing its version is online even if its connection was reported before this manager started.
+            onlineDevices_.insert(deviceId);
+            codecWaitingDevices_.erase(deviceId);
+        }
+    }
+    RewriteLocalRecords();
+}
+
+bool DistributedNotificationManager::IsCodecSupported(uint32_t version)
+{
+    std::lock_guard<std::mutex> lock(codecMutex_);
+    // Without any online device the json is kept, the notifications are synchronized to the next device anyway.
+    if (onlineDevices_.empty()) {
+        return false;
+    }
+    for (auto &deviceId : onlineDevices_) {
+        if (codecWaitingDevices_.count(deviceId) != 0) {
+            continue;
+        }
+        auto iter = deviceCodecs_.find(deviceId);
+        if (iter == deviceCodecs_.end() || iter->second < version) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DistributedNotificationManager::IsBinaryRecordSupported()
+{
+    return IsCodecSupported(NotificationBinaryConverter::BINARY_VERSION);
+}
+
+bool DistributedNotificationManager::IsImageReferenceSupported()
+{
+    return IsCodecSupported(IMAGE_REFERENCE_CODEC_VERSION);
+}
+
+void DistributedNotificationManager::RewriteLocalRecords()
+{
+    {
+        // Without any online device the notifications are left as they are until the next one connects.
+        std::lock_guard<std::mutex> codecLock(codecMutex_);
+        if (onlineDevices_.empty()) {
+            return;
+        }
+    }
+    bool isBinarySupported = IsBinaryRecordSupported();
+    bool isImageReferenceSupported = IsImageReferenceSupported();
+
+    std::lock_guard<std::mutex> lock(localMutex_);
+    std::set<std::string> keys;
+    {
+        std::lock_guard<std::mutex> codecLock(codecMutex_);
+        for (auto &format : localRecordFormats_) {
+            if (format.second != isBinarySupported) {
+                keys.insert(format.first);
+            }
+        }
+    }
+    if (!isImageReferenceSupported) {
+        std::lock_guard<std::mutex> imageLock(imageMutex_);
+        for (auto &images : notificationImages_) {
+            keys.insert(images.first);
+        }
+    }
+    if (keys.empty()) {
+        return;
+    }
+
+    ANS_LOGI("Rewrite %{public}zu local notifications, binary:%{public}d.", keys.size(), isBinarySupported);
+    for (auto &key : keys) {
+        auto iter = localRequests_.find(key);
+        if (iter == localRequests_.end()) {
+            continue;
+        }
+        sptr<NotificationRequest> request = iter->second;
+        if (PutRequestToDistributedDB(key, request) != ERR_OK) {
+            ANS_LOGE("Rewrite local notification failed. key:%{public}s", key.c_str());
+        }
+    }
+}
+
+bool DistributedNotificationManager::SetLocalRecordFormat(const std::string &key, bool isBinary)
+{
+    std::lock_guard<std::mutex> lock(codecMutex_);
+    auto result = localRecordFormats_.emplace(key, isBinary);
+    if (result.second || result.first->second == isBinary) {
+        return false;
+    }
+    result.first->second = isBinary;
+    return true;
+}
+
+bool DistributedNotificationManager::TakeLocalRecordFormat(const std::string &key)
+{
+    std::lock_guard<std::mutex> lock(codecMutex_);
+    auto iter = localRecordFormats_.find(key);
+    if (iter == localRecordFormats_.end()) {
+        return false;
+    }
+    bool isBinary = iter->second;
+    localRecordFormats_.erase(iter);
+    return isBinary;
+}
+
+bool DistributedNotificationManager::SetRemoteRecordFormat(const std::string &key, bool isBinary)
+{
+    std::lock_guard<std::mutex> lock(codecMutex_);
+    auto result = remoteRecordFormats_.emplace(key, isBinary);
+    if (result.second || result.first->second == isBinary) {
+        return false;
+    }
+    result.first->second = isBinary;
+    return true;
+}
+
+void DistributedNotificationManager::ClearRecordFormats()
+{
+    std::lock_guard<std::mutex> lock(codecMutex_);
+    deviceCodecs_.clear();
+    localRecordFormats_.clear();
+    remoteRecordFormats_.clear();
+}
 }  // namespace Notification
 }  // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed_notification_writer.h"
+
+#include "ans_log_wrapper.h"
+
+namespace OHOS {
+namespace Notification {
+namespace {
+constexpr size_t MAX_BATCH_SIZE = 128;  // max number of entries of a PutBatch or DeleteBatch
+constexpr uint32_t MAX_RETRY_TIMES = 3;
+constexpr int64_t RETRY_INTERVAL = 1000;  // ms
+}  // namespace
+
+DistributedNotificationWriter::DistributedNotificationWriter(
+    const std::shared_ptr<AppExecFwk::EventHandler> &handler, int64_t flushInterval)
+    : handler_(handler), flushInterval_(flushInterval)
+{}
+
+void DistributedNotificationWriter::SetDatabase(const std::shared_ptr<DistributedDatabase> &database)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    database_ = database;
+}
+
+void DistributedNotificationWriter::SetDropCallback(
+    const std::function<void(const std::vector<std::string> &keys)> &callback)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    dropCallback_ = callback;
+}
+
+void DistributedNotificationWriter::Put(const std::string &key, const std::string &value)
+{
+    Enqueue({key, value, false});
+}
+
+void DistributedNotificationWriter::Delete(const std::string &key)
+{
+    Enqueue({key, "", true});
+}
+
+void DistributedNotificationWriter::Enqueue(Operation &&operation)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = index_.find(operation.key);
+        if (iter != index_.end()) {
+            // Moved to the back, so that it is written after the writes it may depend on, such as its images.
+            operations_.erase(iter->second);
+            stats_.coalesced++;
+        }
+        std::string key = operation.key;
+        index_[key] = operations_.insert(operations_.end(), std::move(operation));
+        if (flushScheduled_) {
+            return;
+        }
+        flushScheduled_ = true;
+    }
+    ScheduleFlush(flushInterval_);
+}
+
+bool DistributedNotificationWriter::Flush()
+{
+    return DoFlush(false);
+}
+
+void DistributedNotificationWriter::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    operations_.clear();
+    index_.clear();
+    failedTimes_ = 0;
+}
+
+DistributedNotificationWriter::Stats DistributedNotificationWriter::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.pending = operations_.size();
+    return stats;
+}
+
+void DistributedNotificationWriter::ScheduleFlush(int64_t delay)
+{
+    // Posted without holding the lock, the handler may run the task before PostTask returns.
+    std::shared_ptr<AppExecFwk::EventHandler> handler = handler_.lock();
+    if (handler == nullptr) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        flushScheduled_ = false;
+        return;
+    }
+    if (!handler->PostTask(std::bind(&DistributedNotificationWriter::OnFlush, shared_from_this()), delay)) {
+        ANS_LOGE("Failed to schedule the distributed flush.");
+        std::lock_guard<std::mutex> lock(mutex_);
+        flushScheduled_ = false;
+    }
+}
+
+void DistributedNotificationWriter::OnFlush()
+{
+    DoFlush(true);
+}
+
+bool DistributedNotificationWriter::DoFlush(bool scheduled)
+{
+    int64_t delay = 0;
+    bool reschedule = false;
+    std::vector<std::string> droppedKeys;
+    {
+        // Flushes are serialized, so that the writes of a key reach the database in order.
+        std::lock_guard<std::mutex> flushLock(flushMutex_);
+        std::list<Operation> operations;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (scheduled) {
+                flushScheduled_ = false;
+            }
+            operations.swap(operations_);
+            index_.clear();
+        }
+        if (WriteOperations(operations, delay)) {
+            return true;
+        }
+        reschedule = Requeue(operations, delay, droppedKeys);
+    }
+    if (reschedule) {
+        ScheduleFlush(delay);
+    }
+    if (!droppedKeys.empty()) {
+        std::function<void(const std::vector<std::string> &keys)> dropCallback;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            dropCallback = dropCallback_;
+        }
+        if (dropCallback) {
+            dropCallback(droppedKeys);
+        }
+    }
+    return false;
+}
+
+bool DistributedNotificationWriter::WriteOperations(std::list<Operation> &operations, int64_t &delay)
+{
+    std::shared_ptr<DistributedDatabase> database;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        database = database_;
+    }
+
+    while (!operations.empty()) {
+        if (database == nullptr) {
+            return false;
+        }
+        delay = database->GetFlowControlDelay();
+        if (delay > 0) {
+            return false;
+        }
+
+        // A run of the same kind is written in one transaction.
+        bool isDelete = operations.front().isDelete;
+        auto end = operations.begin();
+        size_t size = 0;
+        while ((end != operations.end()) && (end->isDelete == isDelete) && (size < MAX_BATCH_SIZE)) {
+            end++;
+            size++;
+        }
+
+        bool result = false;
+        if (isDelete) {
+            std::vector<std::string> keys;
+            keys.reserve(size);
+            for (auto iter = operations.begin(); iter != end; iter++) {
+                keys.push_back(iter->key);
+            }
+            result = database->DeleteBatchToDistributedDB(keys);
+        } else {
+            std::vector<DistributedDatabase::Entry> entries(size);
+            size_t index = 0;
+            for (auto iter = operations.begin(); iter != end; iter++, index++) {
+                entries[index].key = DistributedKv::Key(iter->key);
+                entries[index].value = DistributedKv::Value(iter->value);
+            }
+            result = database->PutBatchToDistributedDB(entries);
+        }
+        if (!result) {
+            delay = database->GetFlowControlDelay();
+            return false;
+        }
+
+        operations.erase(operations.begin(), end);
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.batches++;
+        stats_.written += size;
+        failedTimes_ = 0;
+    }
+    return true;
+}
+
+bool DistributedNotificationWriter::Requeue(
+    std::list<Operation> &operations, int64_t &delay, std::vector<std::string> &droppedKeys)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (delay > 0) {
+        stats_.delayed++;
+    } else if (++failedTimes_ > MAX_RETRY_TIMES) {
+        ANS_LOGE("Failed to write %{public}zu entries to distributed DB, given up.", operations.size());
+        stats_.dropped += operations.size();
+        failedTimes_ = 0;
+        for (auto &operation : operations) {
+            // A put superseded by a write queued meanwhile is not lost.
+            if (!operation.isDelete && (index_.find(operation.key) == index_.end())) {
+                droppedKeys.push_back(operation.key);
+            }
+        }
+        return false;
+    } else {
+        ANS_LOGW("Failed to write %{public}zu entries to distributed DB, retry later.", operations.size());
+        delay = RETRY_INTERVAL;
+    }
+
+    // The writes not written go before the ones queued meanwhile, unless superseded by them.
+    auto position = operations_.begin();
+    for (auto &operation : operations) {
+        if (index_.find(operation.key) != index_.end()) {
+            stats_.coalesced++;
+            continue;
+        }
+        std::string key = operation.key;
+        index_[key] = operations_.insert(position, std::move(operation));
+    }
+    if (operations_.empty() || flushScheduled_) {
+        return false;
+    }
+    flushScheduled_ = true;
+    return true;
+}
+}  // namespace Notification
+}  // namespace OHOS
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed_rate_limiter.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace Notification {
+constexpr int64_t DistributedRateLimiter::Window::BUCKET_NUM;
+
+DistributedRateLimiter::DistributedRateLimiter(size_t secondMaxinum, size_t minuteMaxinum)
+    : second_(std::chrono::seconds(1), secondMaxinum), minute_(std::chrono::minutes(1), minuteMaxinum)
+{}
+
+bool DistributedRateLimiter::TryAcquire(Clock::time_point now)
+{
+    if (second_.IsFull(now) || minute_.IsFull(now)) {
+        return false;
+    }
+    second_.Add();
+    minute_.Add();
+    return true;
+}
+
+int64_t DistributedRateLimiter::GetDelay(Clock::time_point now)
+{
+    Clock::duration delay = std::max(second_.GetDelay(now), minute_.GetDelay(now));
+    if (delay <= Clock::duration::zero()) {
+        return 0;
+    }
+    // Rounded up, so that a call is allowed once the delay is over.
+    return std::chrono::duration_cast<std::chrono::milliseconds>(delay).count() + 1;
+}
+
+void DistributedRateLimiter::Clear(void)
+{
+    second_.Clear();
+    minute_.Clear();
+}
+
+DistributedRateLimiter::Window::Window(Clock::duration length, size_t maxinum)
+    : bucketLength_(length / BUCKET_NUM), maxinum_(maxinum)
+{}
+
+bool DistributedRateLimiter::Window::IsFull(Clock::time_point now)
+{
+    Advance(now);
+    return total_ >= maxinum_;
+}
+
+void DistributedRateLimiter::Window::Add(void)
+{
+    buckets_[currentBucket_ % BUCKET_NUM]++;
+    total_++;
+}
+
+DistributedRateLimiter::Clock::duration DistributedRateLimiter::Window::GetDelay(Clock::time_point now)
+{
+    if (!IsFull(now)) {
+        return Clock::duration::zero();
+    }
+
+    // Wait for the oldest buckets to expire until the window has room for a call.
+    size_t remaining = total_;
+    int64_t oldestBucket = std::max(currentBucket_ - BUCKET_NUM + 1, static_cast<int64_t>(0));
+    for (int64_t bucket = oldestBucket; bucket <= currentBucket_; bucket++) {
+        remaining -= buckets_[bucket % BUCKET_NUM];
+        if (remaining < maxinum_) {
+            return bucketLength_ * (bucket + BUCKET_NUM) - now.time_since_epoch();
+        }
+    }
+    return bucketLength_ * (currentBucket_ + BUCKET_NUM) - now.time_since_epoch();
+}
+
+void DistributedRateLimiter::Window::Clear(void)
+{
+    buckets_.fill(0);
+    total_ = 0;
+}
+
+void DistributedRateLimiter::Window::Advance(Clock::time_point now)
+{
+    int64_t bucket = now.time_since_epoch() / bucketLength_;
+    if (bucket <= currentBucket_) {
+        return;
+    }
+
+    // The buckets passed over are expired, at most the whole window.
+    int64_t expired = bucket - currentBucket_;
+    if (expired > BUCKET_NUM) {
+        expired = BUCKET_NUM;
+    }
+    for (int64_t i = 1; i <= expired; i++) {
+        uint32_t &count = buckets_[(currentBucket_ + i) % BUCKET_NUM];
+        total_ -= count;
+        count = 0;
+    }
+    currentBucket_ = bucket;
+}
+}  // namespace Notification
+}  // namespace OHOS
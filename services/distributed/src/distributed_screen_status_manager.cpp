@@ -36,6 +36,24 @@ DistributedScreenStatusManager::DistributedScreenStatusManager() : DistributedFl
         .OnDisconnected = std::bind(&DistributedScreenStatusManager::OnDeviceDisconnected, this, std::placeholders::_1),
     };
     deviceCb_ = std::make_shared<DistributedDeviceCallback>(callback);
+    DistributedDatabaseCallback::IDatabaseChange databaseCallback = {
+        .OnInsert = std::bind(&DistributedScreenStatusManager::OnRemoteScreenStatusChanged,
+            this,
+            std::placeholders::_1,
+            std::placeholders::_2,
+            std::placeholders::_3),
+        .OnUpdate = std::bind(&DistributedScreenStatusManager::OnRemoteScreenStatusChanged,
+            this,
+            std::placeholders::_1,
+            std::placeholders::_2,
+            std::placeholders::_3),
+        .OnDelete = std::bind(&DistributedScreenStatusManager::OnRemoteScreenStatusDeleted,
+            this,
+            std::placeholders::_1,
+            std::placeholders::_2,
+            std::placeholders::_3),
+    };
+    databaseCb_ = std::make_shared<DistributedDatabaseCallback>(databaseCallback);
     GetKvDataManager();
     GetKvStore();
 }
@@ -46,11 +64,16 @@ DistributedScreenStatusManager::~DistributedScreenStatusManager()
 void DistributedScreenStatusManager::OnDeviceConnected(const std::string &deviceId)
 {
     ANS_LOGI("deviceId:%{public}s", deviceId.c_str());
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    onlineDevices_.insert(deviceId);
+    UpdateRemoteUsing();
 }
 
 void DistributedScreenStatusManager::OnDeviceDisconnected(const std::string &deviceId)
 {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
+    onlineDevices_.erase(deviceId);
+    UpdateRemoteUsing();
     if (!CheckKvDataManager()) {
         return;
     }
@@ -61,6 +84,7 @@ void DistributedScreenStatusManager::OnDeviceDisconnected(const std::string &dev
     if (status != DistributedKv::Status::SUCCESS) {
         ANS_LOGE("kvDataManager GetDeviceList() failed ret = 0x%{public}x", status);
         kvDataManager_.reset();
+        remoteStatusLoaded_ = false;
         return;
     }
 
@@ -68,7 +92,15 @@ void DistributedScreenStatusManager::OnDeviceDisconnected(const std::string &dev
         return;
     }
 
+    if (subscribed_ && kvStore_ != nullptr) {
+        status = kvStore_->UnSubscribeKvStore(DistributedKv::SubscribeType::SUBSCRIBE_TYPE_REMOTE, databaseCb_);
+        if (status != DistributedKv::Status::SUCCESS) {
+            ANS_LOGW("kvStore UnSubscribeKvStore failed ret = 0x%{public}x", status);
+        }
+    }
+    subscribed_ = false;
     kvStore_.reset();
+    remoteStatusLoaded_ = false;
 
     DistributedKv::AppId appId = {.appId = APP_ID};
     DistributedKv::StoreId storeId = {.storeId = STORE_ID};
@@ -91,6 +123,8 @@ void DistributedScreenStatusManager::GetKvDataManager(void)
             kvDataManager_.reset();
         }
     }
+    // The devices connected while nobody watched are only known from a new load.
+    remoteStatusLoaded_ = false;
 
     KvManagerFlowControlClear();
 }
@@ -130,6 +164,14 @@ void DistributedScreenStatusManager::GetKvStore(void)
         return;
     }
 
+    // The status of the other devices is loaded again from the new store.
+    remoteStatusLoaded_ = false;
+    status = kvStore_->SubscribeKvStore(DistributedKv::SubscribeType::SUBSCRIBE_TYPE_REMOTE, databaseCb_);
+    subscribed_ = (status == DistributedKv::Status::SUCCESS);
+    if (!subscribed_) {
+        ANS_LOGW("kvStore SubscribeKvStore failed ret = 0x%{public}x", status);
+    }
+
     KvStoreFlowControlClear();
 }
 
@@ -151,8 +193,26 @@ std::string DistributedScreenStatusManager::GenerateDistributedKey(const std::st
 }
 
 ErrCode DistributedScreenStatusManager::CheckRemoteDevicesIsUsing(bool &isUsing)
+{
+    if (!remoteStatusLoaded_) {
+        ErrCode result = LoadRemoteScreenStatus();
+        if (result != ERR_OK) {
+            return result;
+        }
+    }
+
+    isUsing = isUsing || remoteUsing_;
+    ANS_LOGD("%{public}s, isUsing:%{public}s", __FUNCTION__, isUsing ? "true" : "false");
+    return ERR_OK;
+}
+
+ErrCode DistributedScreenStatusManager::LoadRemoteScreenStatus(void)
 {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if (remoteStatusLoaded_) {
+        return ERR_OK;
+    }
+
     if (!CheckKvDataManager() || !CheckKvStore()) {
         return ERR_ANS_DISTRIBUTED_OPERATION_FAILED;
     }
@@ -180,25 +240,56 @@ ErrCode DistributedScreenStatusManager::CheckRemoteDevicesIsUsing(bool &isUsing)
         return ERR_ANS_DISTRIBUTED_GET_INFO_FAILED;
     }
 
-    for (auto entry : entries) {
+    onlineDevices_.clear();
+    for (auto &devInfo : devInfoList) {
+        onlineDevices_.insert(devInfo.deviceId);
+    }
+    remoteScreenOn_.clear();
+    for (auto &entry : entries) {
         std::string key = entry.key.ToString();
         std::string deviceId = key.substr(0, key.find_first_of(DELIMITER));
-        ANS_LOGD("value:%{public}s", entry.value.ToString().c_str());
-        for (auto devInfo : devInfoList) {
-            if (devInfo.deviceId == deviceId) {
-                isUsing = isUsing || (entry.value.ToString() == SCREEN_STATUS_VALUE_ON);
-                break;
-            }
-        }
-        if (isUsing) {
-            break;
-        }
+        remoteScreenOn_[deviceId] = (entry.value.ToString() == SCREEN_STATUS_VALUE_ON);
     }
+    UpdateRemoteUsing();
 
-    ANS_LOGI("%{public}s, isUsing:%{public}s", __FUNCTION__, isUsing ? "true" : "false");
+    // Without the database changes the status would go stale, so it is queried again on the next check.
+    remoteStatusLoaded_ = subscribed_;
+    ANS_LOGI("%{public}s, devices:%{public}zu, entries:%{public}zu",
+        __FUNCTION__, onlineDevices_.size(), entries.size());
     return ERR_OK;
 }
 
+void DistributedScreenStatusManager::OnRemoteScreenStatusChanged(
+    const std::string &deviceId, const std::string &key, const std::string &value)
+{
+    ANS_LOGD("key:%{public}s, value:%{public}s", key.c_str(), value.c_str());
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    remoteScreenOn_[key.substr(0, key.find_first_of(DELIMITER))] = (value == SCREEN_STATUS_VALUE_ON);
+    UpdateRemoteUsing();
+}
+
+void DistributedScreenStatusManager::OnRemoteScreenStatusDeleted(
+    const std::string &deviceId, const std::string &key, const std::string &value)
+{
+    ANS_LOGD("key:%{public}s", key.c_str());
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    remoteScreenOn_.erase(key.substr(0, key.find_first_of(DELIMITER)));
+    UpdateRemoteUsing();
+}
+
+void DistributedScreenStatusManager::UpdateRemoteUsing(void)
+{
+    bool isUsing = false;
+    for (auto &device : onlineDevices_) {
+        auto iter = remoteScreenOn_.find(device);
+        if ((iter != remoteScreenOn_.end()) && iter->second) {
+            isUsing = true;
+            break;
+        }
+    }
+    remoteUsing_ = isUsing;
+}
+
 ErrCode DistributedScreenStatusManager::SetLocalScreenStatus(bool screenOn)
 {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
@@ -104,6 +104,22 @@ HWTEST_F(DistributedDatabaseTest, PutToDistributedDB_00100, Function | SmallTest
     EXPECT_EQ(database_->PutToDistributedDB(key, value), true);
 }
 
+/**
+ * @tc.name      : DistributedDatabase_PutBatchToDistributedDB_00100
+ * @tc.number    : PutBatchToDistributedDB_00100
+ * @tc.desc      : Put key-values in one transaction.
+ */
+HWTEST_F(DistributedDatabaseTest, PutBatchToDistributedDB_00100, Function | SmallTest | Level1)
+{
+    std::vector<DistributedDatabase::Entry> entries(2);
+    entries[0].key = DistributedKv::Key("<key1>");
+    entries[0].value = DistributedKv::Value("<value1>");
+    entries[1].key = DistributedKv::Key("<key2>");
+    entries[1].value = DistributedKv::Value("<value2>");
+
+    EXPECT_EQ(database_->PutBatchToDistributedDB(entries), true);
+}
+
 /**
  * @tc.name      : DistributedDatabase_GetFromDistributedDB_00100
  * @tc.number    : GetFromDistributedDB_00100
@@ -142,6 +158,36 @@ HWTEST_F(DistributedDatabaseTest, DeleteToDistributedDB_00100, Function | SmallT
     EXPECT_EQ(database_->DeleteToDistributedDB(key), true);
 }
 
+/**
+ * @tc.name      : DistributedDatabase_DeleteBatchToDistributedDB_00100
+ * @tc.number    : DeleteBatchToDistributedDB_00100
+ * @tc.desc      : Delete key-values with their keys in one transaction.
+ */
+HWTEST_F(DistributedDatabaseTest, DeleteBatchToDistributedDB_00100, Function | SmallTest | Level1)
+{
+    std::vector<std::string> keys = {"<key1>", "<key2>"};
+
+    EXPECT_EQ(database_->DeleteBatchToDistributedDB(keys), true);
+}
+
+/**
+ * @tc.name      : DistributedDatabase_GetFlowControlDelay_00100
+ * @tc.number    : GetFlowControlDelay_00100
+ * @tc.desc      : The database is delayed once the calls of a second are used up.
+ */
+HWTEST_F(DistributedDatabaseTest, GetFlowControlDelay_00100, Function | SmallTest | Level1)
+{
+    EXPECT_EQ(database_->GetFlowControlDelay(), 0);
+
+    const int32_t maxCallsPerSecond = 1000;
+    std::string key("<key>");
+    std::string value;
+    for (int32_t i = 0; i < maxCallsPerSecond; i++) {
+        database_->GetFromDistributedDB(key, value);
+    }
+    EXPECT_GT(database_->GetFlowControlDelay(), 0);
+}
+
 /**
  * @tc.name      : DistributedDatabase_ClearDataByDevice_00100
  * @tc.number    : ClearDataByDevice_00100
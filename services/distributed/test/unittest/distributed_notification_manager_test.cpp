@@ -17,7 +17,11 @@
 
 #include "gtest/gtest.h"
 
+#define private public
 #include "distributed_notification_manager.h"
+#undef private
+#include "notification_binary_convert.h"
+#include "notification_json_convert.h"
 
 using namespace testing::ext;
 namespace OHOS {
@@ -36,6 +40,10 @@ public:
         const std::string &deviceId, const std::string &bundleName, const std::string &label, int32_t id) {};
 
 protected:
+    std::shared_ptr<Media::PixelMap> CreateIcon(uint32_t color);
+    // The database and device changes are handled on handler_, they are done once a task posted after them runs.
+    void SyncHandler();
+
     std::shared_ptr<DistributedNotificationManager> distributedManager_;
 };
 
@@ -50,6 +58,22 @@ void DistributedNotificationManagerTest::TearDown()
     DistributedNotificationManager::DestroyInstance();
 }
 
+std::shared_ptr<Media::PixelMap> DistributedNotificationManagerTest::CreateIcon(uint32_t color)
+{
+    const int32_t iconSize = 64;
+    std::vector<uint32_t> colors(iconSize * iconSize, color);
+    Media::InitializationOptions opts;
+    opts.size.width = iconSize;
+    opts.size.height = iconSize;
+    opts.pixelFormat = Media::PixelFormat::RGBA_8888;
+    return Media::PixelMap::Create(colors.data(), colors.size(), opts);
+}
+
+void DistributedNotificationManagerTest::SyncHandler()
+{
+    distributedManager_->handler_->PostSyncTask([]() {});
+}
+
 /**
  * @tc.name      : Distributed_Publish_00100
  * @tc.number    : Distributed_Publish_00100
@@ -67,6 +91,72 @@ HWTEST_F(DistributedNotificationManagerTest, Distributed_Publish_00100, Function
     EXPECT_EQ(distributedManager_->Publish(bundleName, label, id, request), ERR_OK);
 }
 
+/**
+ * @tc.name      : Distributed_Publish_00200
+ * @tc.number    : Distributed_Publish_00200
+ * @tc.desc      : Publish local notifications sharing an icon, the icon is put once and released with the last one.
+ */
+HWTEST_F(DistributedNotificationManagerTest, Distributed_Publish_00200, Function | SmallTest | Level1)
+{
+    std::shared_ptr<Media::PixelMap> icon = CreateIcon(0xff0000ff);
+    ASSERT_NE(icon, nullptr);
+
+    // The images are written beside the notifications once the remote device reads them.
+    distributedManager_->OnDatabaseInsert("<remoteDeviceId>", "<remoteDeviceId>|#codec|", "1");
+    SyncHandler();
+    std::string bundleName = "<bundleName>";
+    std::string label = "<label>";
+    for (int32_t id = 1000; id < 1002; id++) {
+        sptr<NotificationRequest> request = new NotificationRequest(id);
+        request->SetLabel(label);
+        request->SetLittleIcon(icon);
+        request->SetBigIcon(icon);
+        EXPECT_EQ(distributedManager_->Publish(bundleName, label, id, request), ERR_OK);
+    }
+    ASSERT_EQ(distributedManager_->imageRefs_.size(), 1);
+    EXPECT_EQ(distributedManager_->imageRefs_.begin()->second, 2);
+
+    EXPECT_EQ(distributedManager_->Delete(bundleName, label, 1000), ERR_OK);
+    EXPECT_EQ(distributedManager_->imageRefs_.begin()->second, 1);
+    EXPECT_EQ(distributedManager_->Delete(bundleName, label, 1001), ERR_OK);
+    EXPECT_TRUE(distributedManager_->imageRefs_.empty());
+    EXPECT_TRUE(distributedManager_->notificationImages_.empty());
+}
+
+/**
+ * @tc.name      : Distributed_Publish_00300
+ * @tc.number    : Distributed_Publish_00300
+ * @tc.desc      : An icon whose put is dropped by the writer is forgotten and put again with the next notification.
+ */
+HWTEST_F(DistributedNotificationManagerTest, Distributed_Publish_00300, Function | SmallTest | Level1)
+{
+    std::shared_ptr<Media::PixelMap> icon = CreateIcon(0xff00ffff);
+    ASSERT_NE(icon, nullptr);
+
+    distributedManager_->OnDatabaseInsert("<remoteDeviceId>", "<remoteDeviceId>|#codec|", "1");
+    SyncHandler();
+    std::string bundleName = "<bundleName>";
+    std::string label = "<label>";
+    sptr<NotificationRequest> request = new NotificationRequest(1000);
+    request->SetLabel(label);
+    request->SetLittleIcon(icon);
+    EXPECT_EQ(distributedManager_->Publish(bundleName, label, 1000, request), ERR_OK);
+    ASSERT_EQ(distributedManager_->imageRefs_.size(), 1);
+    std::string hash = distributedManager_->imageRefs_.begin()->first;
+    std::string imageKey;
+    distributedManager_->GenerateImageKey("<localDeviceId>", hash, imageKey);
+
+    distributedManager_->OnWritesDropped({imageKey});
+    EXPECT_TRUE(distributedManager_->imageRefs_.empty());
+    EXPECT_TRUE(distributedManager_->notificationImages_.empty());
+
+    EXPECT_EQ(distributedManager_->Update(bundleName, label, 1000, request), ERR_OK);
+    ASSERT_EQ(distributedManager_->imageRefs_.size(), 1);
+    EXPECT_EQ(distributedManager_->imageRefs_[hash], 1);
+    EXPECT_EQ(distributedManager_->Delete(bundleName, label, 1000), ERR_OK);
+    EXPECT_TRUE(distributedManager_->imageRefs_.empty());
+}
+
 /**
  * @tc.name      : Distributed_Update_00100
  * @tc.number    : Distributed_Update_00100
@@ -180,5 +270,249 @@ HWTEST_F(DistributedNotificationManagerTest, Distributed_Get_Local_DeviceInfo_00
     DistributedDatabase::DeviceInfo deviceInfo;
     EXPECT_EQ(distributedManager_->GetLocalDeviceInfo(deviceInfo), ERR_OK);
 }
+
+/**
+ * @tc.name      : Distributed_Codec_00100
+ * @tc.number    : Distributed_Codec_00100
+ * @tc.desc      : A local notification is written as json until every online device advertises the binary format.
+ */
+HWTEST_F(DistributedNotificationManagerTest, Distributed_Codec_00100, Function | SmallTest | Level1)
+{
+    sptr<NotificationRequest> request = new NotificationRequest(1000);
+    request->SetLabel("<label>");
+
+    std::string bundleName = "<bundleName>";
+    std::string label = request->GetLabel();
+    int32_t id = request->GetNotificationId();
+    std::string key;
+    distributedManager_->GenerateLocalDistributedKey(bundleName, label, id, key);
+
+    EXPECT_EQ(distributedManager_->Publish(bundleName, label, id, request), ERR_OK);
+    ASSERT_EQ(distributedManager_->localRecordFormats_.count(key), 1);
+    EXPECT_FALSE(distributedManager_->localRecordFormats_[key]);
+
+    distributedManager_->OnDatabaseInsert("<remoteDeviceId>", "<remoteDeviceId>|#codec|", "1");
+    SyncHandler();
+    EXPECT_TRUE(distributedManager_->IsBinaryRecordSupported());
+    EXPECT_EQ(distributedManager_->Update(bundleName, label, id, request), ERR_OK);
+    EXPECT_TRUE(distributedManager_->localRecordFormats_[key]);
+
+    std::string recordKey;
+    distributedManager_->GenerateRecordKey(key, recordKey);
+    std::string notificationKey;
+    bool isBinary = false;
+    EXPECT_TRUE(distributedManager_->ResolveNotificationKey(recordKey, notificationKey, isBinary));
+    EXPECT_TRUE(isBinary);
+    EXPECT_EQ(notificationKey, key);
+
+    EXPECT_EQ(distributedManager_->Delete(bundleName, label, id), ERR_OK);
+    EXPECT_EQ(distributedManager_->localRecordFormats_.count(key), 0);
+}
+
+/**
+ * @tc.name      : Distributed_Codec_00200
+ * @tc.number    : Distributed_Codec_00200
+ * @tc.desc      : The local notifications are rewritten as json with inline images once a device without codec
+ *                 connects, and back to the binary format once it advertises one.
+ */
+HWTEST_F(DistributedNotificationManagerTest, Distributed_Codec_00200, Function | SmallTest | Level1)
+{
+    std::shared_ptr<Media::PixelMap> icon = CreateIcon(0xffffff00);
+    ASSERT_NE(icon, nullptr);
+
+    distributedManager_->OnDatabaseInsert("<remoteDeviceId>", "<remoteDeviceId>|#codec|", "1");
+    SyncHandler();
+    sptr<NotificationRequest> request = new NotificationRequest(1000);
+    request->SetLabel("<label>");
+    request->SetLittleIcon(icon);
+    std::string bundleName = "<bundleName>";
+    std::string key;
+    distributedManager_->GenerateLocalDistributedKey(bundleName, request->GetLabel(), 1000, key);
+    EXPECT_EQ(distributedManager_->Publish(bundleName, request->GetLabel(), 1000, request), ERR_OK);
+    EXPECT_TRUE(distributedManager_->localRecordFormats_[key]);
+    EXPECT_EQ(distributedManager_->imageRefs_.size(), 1);
+
+    distributedManager_->OnDeviceConnected("<olderDeviceId>");
+    SyncHandler();
+    // The codec of the device is not synchronized in time.
+    auto iter = distributedManager_->codecWaitingDevices_.find("<olderDeviceId>");
+    if (iter != distributedManager_->codecWaitingDevices_.end()) {
+        distributedManager_->OnCodecWaitTimeout(iter->first, iter->second);
+    }
+    EXPECT_FALSE(distributedManager_->IsBinaryRecordSupported());
+    EXPECT_FALSE(distributedManager_->localRecordFormats_[key]);
+    EXPECT_TRUE(distributedManager_->imageRefs_.empty());
+    EXPECT_TRUE(distributedManager_->notificationImages_.empty());
+
+    distributedManager_->OnDatabaseInsert("<olderDeviceId>", "<olderDeviceId>|#codec|", "1");
+    SyncHandler();
+    EXPECT_TRUE(distributedManager_->IsBinaryRecordSupported());
+    EXPECT_TRUE(distributedManager_->localRecordFormats_[key]);
+    EXPECT_EQ(distributedManager_->imageRefs_.size(), 1);
+
+    EXPECT_EQ(distributedManager_->Delete(bundleName, request->GetLabel(), 1000), ERR_OK);
+    EXPECT_TRUE(distributedManager_->localRequests_.empty());
+}
+
+/**
+ * @tc.name      : Distributed_Codec_00300
+ * @tc.number    : Distributed_Codec_00300
+ * @tc.desc      : A reconnecting device keeps the local notifications in the binary format while its codec is being
+ *                 synchronized.
+ */
+HWTEST_F(DistributedNotificationManagerTest, Distributed_Codec_00300, Function | SmallTest | Level1)
+{
+    std::shared_ptr<Media::PixelMap> icon = CreateIcon(0xff808080);
+    ASSERT_NE(icon, nullptr);
+
+    distributedManager_->OnDatabaseInsert("<remoteDeviceId>", "<remoteDeviceId>|#codec|", "1");
+    SyncHandler();
+    sptr<NotificationRequest> request = new NotificationRequest(1000);
+    request->SetLabel("<label>");
+    request->SetLittleIcon(icon);
+    std::string bundleName = "<bundleName>";
+    std::string key;
+    distributedManager_->GenerateLocalDistributedKey(bundleName, request->GetLabel(), 1000, key);
+    EXPECT_EQ(distributedManager_->Publish(bundleName, request->GetLabel(), 1000, request), ERR_OK);
+    EXPECT_TRUE(distributedManager_->localRecordFormats_[key]);
+
+    // Reconnected, its codec is synchronized again after the connection.
+    {
+        std::lock_guard<std::mutex> lock(distributedManager_->codecMutex_);
+        distributedManager_->deviceCodecs_.erase("<remoteDeviceId>");
+        distributedManager_->codecWaitingDevices_["<remoteDeviceId>"] = ++distributedManager_->connectionSequence_;
+    }
+    distributedManager_->RewriteLocalRecords();
+    EXPECT_TRUE(distributedManager_->IsBinaryRecordSupported());
+    EXPECT_TRUE(distributedManager_->localRecordFormats_[key]);
+    EXPECT_EQ(distributedManager_->imageRefs_.size(), 1);
+
+    distributedManager_->OnDatabaseInsert("<remoteDeviceId>", "<remoteDeviceId>|#codec|", "1");
+    SyncHandler();
+    EXPECT_TRUE(distributedManager_->codecWaitingDevices_.empty());
+    EXPECT_TRUE(distributedManager_->localRecordFormats_[key]);
+    EXPECT_EQ(distributedManager_->imageRefs_.size(), 1);
+
+    EXPECT_EQ(distributedManager_->Delete(bundleName, request->GetLabel(), 1000), ERR_OK);
+}
+
+/**
+ * @tc.name      : Distributed_InsertBatch_00100
+ * @tc.number    : Distributed_InsertBatch_00100
+ * @tc.desc      : The remote notifications inserted by one change are converted and published in one callback.
+ */
+HWTEST_F(DistributedNotificationManagerTest, Distributed_InsertBatch_00100, Function | SmallTest | Level1)
+{
+    const int32_t notificationNum = 40;
+    std::vector<DistributedKv::Entry> entries;
+    for (int32_t id = 0; id < notificationNum; id++) {
+        sptr<NotificationRequest> request = new NotificationRequest(id);
+        request->SetLabel("<label>");
+        std::string value;
+        ASSERT_TRUE(NotificationJsonConverter::ConvertToJsonString(request, value));
+        DistributedKv::Entry entry;
+        entry.key = "<remoteDeviceId>|<bundleName>|<label>|" + std::to_string(id);
+        entry.value = value;
+        entries.push_back(entry);
+    }
+    DistributedKv::Entry codecEntry;
+    codecEntry.key = "<remoteDeviceId>|#codec|";
+    codecEntry.value = "1";
+    entries.push_back(codecEntry);
+
+    int32_t publishNum = 0;
+    std::vector<DistributedNotificationManager::DistributedRequest> published;
+    DistributedNotificationManager::IDistributedCallback callback = {
+        .OnPublish = [&publishNum](const std::string &deviceId, const std::string &bundleName,
+            sptr<NotificationRequest> &request) { publishNum++; },
+        .OnPublishBatch = [&published](std::vector<DistributedNotificationManager::DistributedRequest> &requests) {
+            published.insert(published.end(), requests.begin(), requests.end());
+        },
+    };
+    EXPECT_EQ(distributedManager_->RegisterCallback(callback), ERR_OK);
+
+    distributedManager_->OnDatabaseInsertBatch("<remoteDeviceId>", entries);
+    SyncHandler();
+    EXPECT_EQ(publishNum, 0);
+    ASSERT_EQ(published.size(), static_cast<size_t>(notificationNum));
+    for (int32_t id = 0; id < notificationNum; id++) {
+        EXPECT_EQ(published[id].deviceId, "<remoteDeviceId>");
+        EXPECT_EQ(published[id].bundleName, "<bundleName>");
+        ASSERT_NE(published[id].request, nullptr);
+        EXPECT_EQ(published[id].request->GetNotificationId(), id);
+    }
+    EXPECT_EQ(distributedManager_->deviceCodecs_["<remoteDeviceId>"], NotificationBinaryConverter::BINARY_VERSION);
+}
+
+/**
+ * @tc.name      : Distributed_Image_00100
+ * @tc.number    : Distributed_Image_00100
+ * @tc.desc      : A remote notification synchronized before its image is updated once the image is inserted.
+ */
+HWTEST_F(DistributedNotificationManagerTest, Distributed_Image_00100, Function | SmallTest | Level1)
+{
+    std::shared_ptr<Media::PixelMap> icon = CreateIcon(0xff00ff00);
+    ASSERT_NE(icon, nullptr);
+
+    sptr<NotificationRequest> request = new NotificationRequest(1000);
+    request->SetLabel("<label>");
+    request->SetLittleIcon(icon);
+    AnsImageUtil::ImageAttachments attachments;
+    std::string value;
+    {
+        AnsImageUtil::AttachmentScope scope(attachments);
+        ASSERT_TRUE(NotificationJsonConverter::ConvertToJsonString(request, value));
+    }
+    ASSERT_EQ(attachments.images.size(), 1);
+    std::string hash = attachments.images.begin()->first;
+
+    std::vector<sptr<NotificationRequest>> updated;
+    DistributedNotificationManager::IDistributedCallback callback = {
+        .OnUpdate = [&updated](const std::string &deviceId, const std::string &bundleName,
+            sptr<NotificationRequest> &request) { updated.push_back(request); },
+    };
+    EXPECT_EQ(distributedManager_->RegisterCallback(callback), ERR_OK);
+
+    std::string key = "<remoteDeviceId>|<bundleName>|<label>|1000";
+    distributedManager_->OnDatabaseInsert("<remoteDeviceId>", key, value);
+    SyncHandler();
+    ASSERT_EQ(distributedManager_->waitingRecords_.count(key), 1);
+    EXPECT_EQ(distributedManager_->waitingRecords_[key].missingImages.count(hash), 1);
+
+    distributedManager_->OnDatabaseInsert(
+        "<remoteDeviceId>", "<remoteDeviceId>|#image|" + hash, attachments.images.begin()->second);
+    SyncHandler();
+    EXPECT_TRUE(distributedManager_->waitingRecords_.empty());
+    ASSERT_EQ(updated.size(), 1);
+    ASSERT_NE(updated[0], nullptr);
+    EXPECT_NE(updated[0]->GetLittleIcon(), nullptr);
+}
+
+/**
+ * @tc.name      : Distributed_Image_00200
+ * @tc.number    : Distributed_Image_00200
+ * @tc.desc      : The images of a local notification are inline until every online device advertises a codec.
+ */
+HWTEST_F(DistributedNotificationManagerTest, Distributed_Image_00200, Function | SmallTest | Level1)
+{
+    std::shared_ptr<Media::PixelMap> icon = CreateIcon(0xffff0000);
+    ASSERT_NE(icon, nullptr);
+
+    sptr<NotificationRequest> request = new NotificationRequest(1000);
+    request->SetLabel("<label>");
+    request->SetLittleIcon(icon);
+    std::string bundleName = "<bundleName>";
+    EXPECT_FALSE(distributedManager_->IsImageReferenceSupported());
+    EXPECT_EQ(distributedManager_->Publish(bundleName, request->GetLabel(), 1000, request), ERR_OK);
+    EXPECT_TRUE(distributedManager_->imageRefs_.empty());
+
+    distributedManager_->OnDatabaseInsert("<remoteDeviceId>", "<remoteDeviceId>|#codec|", "1");
+    SyncHandler();
+    EXPECT_TRUE(distributedManager_->IsImageReferenceSupported());
+    EXPECT_EQ(distributedManager_->Update(bundleName, request->GetLabel(), 1000, request), ERR_OK);
+    EXPECT_EQ(distributedManager_->imageRefs_.size(), 1);
+    EXPECT_EQ(distributedManager_->Delete(bundleName, request->GetLabel(), 1000), ERR_OK);
+    EXPECT_TRUE(distributedManager_->imageRefs_.empty());
+}
 }  // namespace Notification
-}  // namespace OHOS
\ No newline at end of file
+}  // namespace OHOS
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "distributed_notification_writer.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace Notification {
+namespace {
+constexpr int64_t FLUSH_INTERVAL = 50;  // ms
+}  // namespace
+
+class DistributedNotificationWriterTest : public testing::Test {
+public:
+    void SetUp() override;
+    void TearDown() override;
+
+protected:
+    std::shared_ptr<DistributedDatabase> database_;
+    std::shared_ptr<DistributedNotificationWriter> writer_;
+};
+
+void DistributedNotificationWriterTest::SetUp()
+{
+    DistributedDatabaseCallback::IDatabaseChange databaseCallback;
+    DistributedDeviceCallback::IDeviceChange deviceCallback;
+    database_ = std::make_shared<DistributedDatabase>(
+        std::make_shared<DistributedDatabaseCallback>(databaseCallback),
+        std::make_shared<DistributedDeviceCallback>(deviceCallback));
+    // Without a handler the writes wait for Flush.
+    writer_ = std::make_shared<DistributedNotificationWriter>(nullptr, FLUSH_INTERVAL);
+    writer_->SetDatabase(database_);
+}
+
+void DistributedNotificationWriterTest::TearDown()
+{
+    writer_ = nullptr;
+    database_ = nullptr;
+}
+
+/**
+ * @tc.name      : DistributedNotificationWriter_Flush_00100
+ * @tc.number    : Flush_00100
+ * @tc.desc      : The writes of a key are coalesced and the runs of the same kind are written in one batch.
+ */
+HWTEST_F(DistributedNotificationWriterTest, Flush_00100, Function | SmallTest | Level1)
+{
+    writer_->Put("<key1>", "<value1>");
+    writer_->Put("<key2>", "<value2>");
+    writer_->Put("<key1>", "<value3>");
+    writer_->Put("<key1>", "<value4>");
+    writer_->Delete("<key3>");
+
+    DistributedNotificationWriter::Stats stats = writer_->GetStats();
+    EXPECT_EQ(stats.pending, 3);
+    EXPECT_EQ(stats.coalesced, 2);
+    EXPECT_EQ(stats.batches, 0);
+
+    EXPECT_TRUE(writer_->Flush());
+    stats = writer_->GetStats();
+    EXPECT_EQ(stats.pending, 0);
+    EXPECT_EQ(stats.written, 3);
+    EXPECT_EQ(stats.batches, 2);
+}
+
+/**
+ * @tc.name      : DistributedNotificationWriter_Flush_00200
+ * @tc.number    : Flush_00200
+ * @tc.desc      : The writes rejected by the flow control are kept and written once the budget allows it.
+ */
+HWTEST_F(DistributedNotificationWriterTest, Flush_00200, Function | SmallTest | Level1)
+{
+    const int32_t maxCallsPerSecond = 1000;
+    std::string value;
+    for (int32_t i = 0; i < maxCallsPerSecond; i++) {
+        database_->GetFromDistributedDB("<key>", value);
+    }
+    int64_t delay = database_->GetFlowControlDelay();
+    ASSERT_GT(delay, 0);
+
+    writer_->Put("<key1>", "<value1>");
+    EXPECT_FALSE(writer_->Flush());
+    writer_->Put("<key1>", "<value2>");
+    DistributedNotificationWriter::Stats stats = writer_->GetStats();
+    EXPECT_EQ(stats.pending, 1);
+    EXPECT_EQ(stats.delayed, 1);
+    EXPECT_EQ(stats.dropped, 0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+    EXPECT_TRUE(writer_->Flush());
+    stats = writer_->GetStats();
+    EXPECT_EQ(stats.pending, 0);
+    EXPECT_EQ(stats.written, 1);
+}
+
+/**
+ * @tc.name      : DistributedNotificationWriter_Flush_00300
+ * @tc.number    : Flush_00300
+ * @tc.desc      : The writes failing several times are dropped and the lost puts are passed to the drop callback.
+ */
+HWTEST_F(DistributedNotificationWriterTest, Flush_00300, Function | SmallTest | Level1)
+{
+    const int32_t maxRetryTimes = 3;
+    std::vector<std::string> droppedKeys;
+    writer_->SetDropCallback([&droppedKeys](const std::vector<std::string> &keys) {
+        droppedKeys.insert(droppedKeys.end(), keys.begin(), keys.end());
+    });
+    // Without a database every flush fails.
+    writer_->SetDatabase(nullptr);
+    writer_->Put("<key1>", "<value1>");
+    writer_->Delete("<key2>");
+    for (int32_t i = 0; i < maxRetryTimes; i++) {
+        EXPECT_FALSE(writer_->Flush());
+        EXPECT_TRUE(droppedKeys.empty());
+    }
+    EXPECT_FALSE(writer_->Flush());
+    ASSERT_EQ(droppedKeys.size(), 1);
+    EXPECT_EQ(droppedKeys[0], "<key1>");
+    DistributedNotificationWriter::Stats stats = writer_->GetStats();
+    EXPECT_EQ(stats.pending, 0);
+    EXPECT_EQ(stats.dropped, 2);
+}
+
+/**
+ * @tc.name      : DistributedNotificationWriter_Clear_00100
+ * @tc.number    : Clear_00100
+ * @tc.desc      : The pending writes are dropped.
+ */
+HWTEST_F(DistributedNotificationWriterTest, Clear_00100, Function | SmallTest | Level1)
+{
+    writer_->Put("<key1>", "<value1>");
+    writer_->Delete("<key2>");
+    writer_->Clear();
+
+    EXPECT_TRUE(writer_->Flush());
+    DistributedNotificationWriter::Stats stats = writer_->GetStats();
+    EXPECT_EQ(stats.written, 0);
+    EXPECT_EQ(stats.batches, 0);
+}
+}  // namespace Notification
+}  // namespace OHOS
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include "distributed_flow_control.h"
+#include "distributed_rate_limiter.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace Notification {
+namespace {
+const DistributedRateLimiter::Clock::time_point START_TIME(std::chrono::hours(1));
+}  // namespace
+
+class DistributedRateLimiterTest : public testing::Test {
+public:
+    void SetUp() override {};
+    void TearDown() override {};
+};
+
+/**
+ * @tc.name      : DistributedRateLimiter_TryAcquire_00100
+ * @tc.number    : TryAcquire_00100
+ * @tc.desc      : The calls over the limit of a second are rejected until the calls of the second expire.
+ */
+HWTEST_F(DistributedRateLimiterTest, TryAcquire_00100, Function | SmallTest | Level1)
+{
+    const size_t secondMaxinum = 3;
+    DistributedRateLimiter limiter(secondMaxinum, secondMaxinum * 10);
+    DistributedRateLimiter::Clock::time_point now = START_TIME;
+    for (size_t i = 0; i < secondMaxinum; i++) {
+        EXPECT_TRUE(limiter.TryAcquire(now));
+    }
+    EXPECT_FALSE(limiter.TryAcquire(now));
+    EXPECT_FALSE(limiter.TryAcquire(now + std::chrono::milliseconds(500)));
+
+    int64_t delay = limiter.GetDelay(now);
+    EXPECT_GT(delay, 0);
+    EXPECT_LE(delay, 1001);
+    EXPECT_TRUE(limiter.TryAcquire(now + std::chrono::milliseconds(delay)));
+}
+
+/**
+ * @tc.name      : DistributedRateLimiter_TryAcquire_00200
+ * @tc.number    : TryAcquire_00200
+ * @tc.desc      : The calls over the limit of a minute are rejected even if each second is under its limit.
+ */
+HWTEST_F(DistributedRateLimiterTest, TryAcquire_00200, Function | SmallTest | Level1)
+{
+    const size_t minuteMaxinum = 5;
+    DistributedRateLimiter limiter(minuteMaxinum, minuteMaxinum);
+    DistributedRateLimiter::Clock::time_point now = START_TIME;
+    for (size_t i = 0; i < minuteMaxinum; i++) {
+        EXPECT_TRUE(limiter.TryAcquire(now));
+        now += std::chrono::seconds(2);
+    }
+    EXPECT_FALSE(limiter.TryAcquire(now));
+    EXPECT_GT(limiter.GetDelay(now), 1000);
+
+    // The first call expires a minute after it.
+    EXPECT_TRUE(limiter.TryAcquire(START_TIME + std::chrono::minutes(1) + std::chrono::seconds(1)));
+}
+
+/**
+ * @tc.name      : DistributedRateLimiter_Clear_00100
+ * @tc.number    : Clear_00100
+ * @tc.desc      : The counted calls are forgotten.
+ */
+HWTEST_F(DistributedRateLimiterTest, Clear_00100, Function | SmallTest | Level1)
+{
+    DistributedRateLimiter limiter(1, 1);
+    EXPECT_TRUE(limiter.TryAcquire(START_TIME));
+    EXPECT_FALSE(limiter.TryAcquire(START_TIME));
+    limiter.Clear();
+    EXPECT_EQ(limiter.GetDelay(START_TIME), 0);
+    EXPECT_TRUE(limiter.TryAcquire(START_TIME));
+}
+
+/**
+ * @tc.name      : DistributedFlowControl_KvManagerFlowControl_00100
+ * @tc.number    : KvManagerFlowControl_00100
+ * @tc.desc      : The DistributedKvDataManager calls are limited by their own limit of a minute.
+ */
+HWTEST_F(DistributedRateLimiterTest, KvManagerFlowControl_00100, Function | SmallTest | Level1)
+{
+    const size_t kvManagerMinuteMaxinum = 2;
+    const size_t kvStoreMaxinum = 100;
+    DistributedFlowControl flowControl(kvStoreMaxinum, kvManagerMinuteMaxinum, kvStoreMaxinum, kvStoreMaxinum);
+    EXPECT_TRUE(flowControl.KvStoreFlowControl());
+    EXPECT_TRUE(flowControl.KvManagerFlowControl());
+    EXPECT_TRUE(flowControl.KvManagerFlowControl());
+    EXPECT_FALSE(flowControl.KvManagerFlowControl());
+    EXPECT_TRUE(flowControl.KvStoreFlowControl());
+
+    flowControl.KvManagerFlowControlClear();
+    EXPECT_TRUE(flowControl.KvManagerFlowControl());
+}
+}  // namespace Notification
+}  // namespace OHOS
@@ -17,6 +17,7 @@
 
 #include "gtest/gtest.h"
 
+#define private public
 #include "distributed_screen_status_manager.h"
 
 using namespace testing::ext;
@@ -53,6 +54,57 @@ HWTEST_F(DistributedScreenStatusManagerTest, CheckRemoteDevicesIsUsing_00100, Fu
     EXPECT_EQ(DistributedScreenStatusManager_->CheckRemoteDevicesIsUsing(isUsing), ERR_OK);
 }
 
+/**
+ * @tc.name      : DistributedScreenStatusManager_CheckRemoteDevicesIsUsing_00200
+ * @tc.number    : CheckRemoteDevicesIsUsing_00200
+ * @tc.desc      : Test CheckRemoteDevicesIsUsing function follows the database changes.
+ */
+HWTEST_F(DistributedScreenStatusManagerTest, CheckRemoteDevicesIsUsing_00200, Function | SmallTest | Level1)
+{
+    const std::string key = "<remoteDeviceId>|screen_status";
+    bool isUsing = false;
+    EXPECT_EQ(DistributedScreenStatusManager_->CheckRemoteDevicesIsUsing(isUsing), ERR_OK);
+    EXPECT_FALSE(isUsing);
+    EXPECT_TRUE(DistributedScreenStatusManager_->remoteStatusLoaded_);
+
+    DistributedScreenStatusManager_->OnRemoteScreenStatusChanged("<remoteDeviceId>", key, "on");
+    EXPECT_EQ(DistributedScreenStatusManager_->CheckRemoteDevicesIsUsing(isUsing), ERR_OK);
+    EXPECT_TRUE(isUsing);
+
+    isUsing = false;
+    DistributedScreenStatusManager_->OnRemoteScreenStatusChanged("<remoteDeviceId>", key, "off");
+    EXPECT_EQ(DistributedScreenStatusManager_->CheckRemoteDevicesIsUsing(isUsing), ERR_OK);
+    EXPECT_FALSE(isUsing);
+
+    DistributedScreenStatusManager_->OnRemoteScreenStatusChanged("<remoteDeviceId>", key, "on");
+    DistributedScreenStatusManager_->OnRemoteScreenStatusDeleted("<remoteDeviceId>", key, "");
+    EXPECT_EQ(DistributedScreenStatusManager_->CheckRemoteDevicesIsUsing(isUsing), ERR_OK);
+    EXPECT_FALSE(isUsing);
+}
+
+/**
+ * @tc.name      : DistributedScreenStatusManager_CheckRemoteDevicesIsUsing_00300
+ * @tc.number    : CheckRemoteDevicesIsUsing_00300
+ * @tc.desc      : Test CheckRemoteDevicesIsUsing function only counts the connected devices.
+ */
+HWTEST_F(DistributedScreenStatusManagerTest, CheckRemoteDevicesIsUsing_00300, Function | SmallTest | Level1)
+{
+    bool isUsing = false;
+    EXPECT_EQ(DistributedScreenStatusManager_->CheckRemoteDevicesIsUsing(isUsing), ERR_OK);
+    DistributedScreenStatusManager_->OnRemoteScreenStatusChanged("<newDeviceId>", "<newDeviceId>|screen_status", "on");
+    EXPECT_EQ(DistributedScreenStatusManager_->CheckRemoteDevicesIsUsing(isUsing), ERR_OK);
+    EXPECT_FALSE(isUsing);
+
+    DistributedScreenStatusManager_->OnDeviceConnected("<newDeviceId>");
+    EXPECT_EQ(DistributedScreenStatusManager_->CheckRemoteDevicesIsUsing(isUsing), ERR_OK);
+    EXPECT_TRUE(isUsing);
+
+    isUsing = false;
+    DistributedScreenStatusManager_->OnDeviceDisconnected("<newDeviceId>");
+    EXPECT_EQ(DistributedScreenStatusManager_->CheckRemoteDevicesIsUsing(isUsing), ERR_OK);
+    EXPECT_FALSE(isUsing);
+}
+
 /**
  * @tc.name      : DistributedScreenStatusManager_SetLocalScreenStatus_00100
  * @tc.number    : SetLocalScreenStatus_00100
@@ -13,19 +13,44 @@
  * limitations under the License.
  */
 
+#include <atomic>
 #include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #define private public
 #include "advanced_notification_service.h"
 #include "ans_const_define.h"
+#include "ans_image_util.h"
 #include "ans_inner_errors.h"
 #include "mock_ipc_skeleton.h"
 #include "notification.h"
+#include "notification_binary_convert.h"
+#include "notification_json_convert.h"
+#include "notification_long_text_content.h"
+#include "notification_picture_content.h"
+#include "notification_preferences.h"
+#include "notification_preferences_database.h"
+#include "notification_record.h"
+#include "notification_slot.h"
 #include "notification_subscriber.h"
-
+#include "rdb_helper.h"
+#include "reminder_data_manager.h"
+#include "reminder_request_alarm.h"
+#include "reminder_request_calendar.h"
+#include "reminder_request_timer.h"
+#include "reminder_store.h"
+#ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
+#include "distributed_notification_manager.h"
+#include "distributed_notification_writer.h"
+#include "distributed_rate_limiter.h"
+#include "distributed_screen_status_manager.h"
+#endif
 
 using namespace OHOS;
 using namespace OHOS::Notification;
@@ -59,6 +84,83 @@ public:
     {}
 };
 
+std::shared_ptr<NotificationRecord> CreateNotificationRecord(
+    int32_t notificationId, const std::string &bundleName, int32_t uid)
+{
+    sptr<NotificationRequest> request = new NotificationRequest(notificationId);
+    request->SetOwnerBundleName(bundleName);
+    request->SetCreatorUid(uid);
+    std::shared_ptr<NotificationRecord> record = std::make_shared<NotificationRecord>();
+    record->request = request;
+    record->notification = new OHOS::Notification::Notification(request);
+    record->bundleOption = new NotificationBundleOption(bundleName, uid);
+    record->slot = new NotificationSlot(NotificationConstant::SlotType::OTHER);
+    return record;
+}
+
+void AddEntry(const std::string &key, const std::string &value, std::vector<DistributedKv::Entry> &entries)
+{
+    DistributedKv::Entry entry;
+    entry.key = DistributedKv::Key(key);
+    entry.value = DistributedKv::Value(value);
+    entries.push_back(entry);
+}
+
+std::shared_ptr<Media::PixelMap> CreatePixelMap(int32_t size, uint32_t color)
+{
+    std::vector<uint32_t> colors(size * size, color);
+    // Some noise, so that the image does not compress to almost nothing.
+    const uint32_t noiseMask = 0x0f0f0f;
+    const uint32_t noiseMultiplier = 2654435761U;
+    for (size_t i = 0; i < colors.size(); i++) {
+        colors[i] ^= (static_cast<uint32_t>(i) * noiseMultiplier) & noiseMask;
+    }
+    Media::InitializationOptions opts;
+    opts.size.width = size;
+    opts.size.height = size;
+    opts.pixelFormat = Media::PixelFormat::RGBA_8888;
+    return Media::PixelMap::Create(colors.data(), colors.size(), opts);
+}
+
+// Entries of a bundle in the layout with one entry per property, as stored before the records.
+void GenerateLegacyBundleEntries(const NotificationPreferencesDatabase &database, const std::string &bundleName,
+    int32_t uid, int32_t slotNum, std::vector<DistributedKv::Entry> &entries)
+{
+    std::string bundleKey = bundleName + std::to_string(uid);
+    AddEntry(KEY_BUNDLE_LABEL + bundleKey, bundleKey, entries);
+    AddEntry(database.GenerateBundleKey(bundleKey, KEY_BUNDLE_NAME), bundleName, entries);
+    AddEntry(database.GenerateBundleKey(bundleKey, KEY_BUNDLE_UID), std::to_string(uid), entries);
+    AddEntry(database.GenerateBundleKey(bundleKey, KEY_BUNDLE_IMPORTANCE), "3", entries);
+    AddEntry(database.GenerateBundleKey(bundleKey, KEY_BUNDLE_SHOW_BADGE), "0", entries);
+    AddEntry(database.GenerateBundleKey(bundleKey, KEY_BUNDLE_BADGE_TOTAL_NUM), "0", entries);
+    AddEntry(database.GenerateBundleKey(bundleKey, KEY_BUNDLE_PRIVATE_ALLOWED), "0", entries);
+    AddEntry(database.GenerateBundleKey(bundleKey, KEY_BUNDLE_ENABLE_NOTIFICATION), "1", entries);
+    AddEntry(database.GenerateBundleKey(bundleKey, KEY_BUNDLE_POPPED_DIALOG), "0", entries);
+    for (int32_t type = 0; type < slotNum; type++) {
+        sptr<NotificationSlot> slot = new NotificationSlot(static_cast<NotificationConstant::SlotType>(type));
+        std::string typeStr = std::to_string(type);
+        auto addSlotEntry = [&](const std::string &subType, const std::string &value) {
+            AddEntry(database.GenerateSlotKey(bundleKey, typeStr, subType), value, entries);
+        };
+        addSlotEntry(KEY_SLOT_TYPE, typeStr);
+        addSlotEntry(KEY_SLOT_ID, slot->GetId());
+        addSlotEntry(KEY_SLOT_GROUPID, slot->GetSlotGroup());
+        addSlotEntry(KEY_SLOT_NAME, slot->GetName());
+        addSlotEntry(KEY_SLOT_DESCRIPTION, slot->GetDescription());
+        addSlotEntry(KEY_SLOT_LEVEL, std::to_string(slot->GetLevel()));
+        addSlotEntry(KEY_SLOT_SHOW_BADGE, std::to_string(slot->IsShowBadge()));
+        addSlotEntry(KEY_SLOT_ENABLE_LIGHT, std::to_string(slot->CanEnableLight()));
+        addSlotEntry(KEY_SLOT_ENABLE_VRBRATION, std::to_string(slot->CanVibrate()));
+        addSlotEntry(KEY_SLOT_LED_LIGHT_COLOR, std::to_string(slot->GetLedLightColor()));
+        addSlotEntry(
+            KEY_SLOT_LOCKSCREEN_VISIBLENESS, std::to_string(static_cast<int32_t>(slot->GetLockScreenVisibleness())));
+        addSlotEntry(KEY_SLOT_SOUND, slot->GetSound().ToString());
+        addSlotEntry(KEY_SLOT_VIBRATION_STYLE, "");
+        addSlotEntry(KEY_SLOT_ENABLE_BYPASS_DND, std::to_string(slot->IsEnableBypassDnd()));
+        addSlotEntry(KEY_SLOT_ENABLED, std::to_string(slot->GetEnable()));
+    }
+}
+
 class BenchmarkNotificationService : public benchmark::Fixture {
 public:
     BenchmarkNotificationService()
@@ -438,6 +540,681 @@ BENCHMARK_F(BenchmarkNotificationService, SetNotificationsEnabledForSpecialBundl
         }
     }
 }
+
+/**
+ * @tc.name: PublishCancelInFullStoreTestCase
+ * @tc.desc: Publish and cancel a notification while the active notification list is full
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+BENCHMARK_F(BenchmarkNotificationService, PublishCancelInFullStoreTestCase)(benchmark::State &state)
+{
+    const int32_t bundleNum = MAX_ACTIVE_NUM / MAX_ACTIVE_NUM_PERAPP;
+    for (int32_t i = 0; i < static_cast<int32_t>(MAX_ACTIVE_NUM) - 1; i++) {
+        int32_t bundleIndex = i % bundleNum;
+        advancedNotificationService_->notificationList_.Add(CreateNotificationRecord(
+            i, "bundleName" + std::to_string(bundleIndex), 10000 + bundleIndex));
+    }
+
+    auto record = CreateNotificationRecord(MAX_ACTIVE_NUM, "bundleName", 10000);
+    std::string key = record->notification->GetKey();
+    while (state.KeepRunning()) {
+        if (advancedNotificationService_->IsNotificationExists(key)) {
+            state.SkipWithError("PublishCancelInFullStoreTestCase exists failed.");
+        }
+        advancedNotificationService_->AddToNotificationList(record);
+
+        sptr<OHOS::Notification::Notification> notification = nullptr;
+        ErrCode errCode = advancedNotificationService_->RemoveFromNotificationList(key, notification, true);
+        if (errCode != ERR_OK) {
+            state.SkipWithError("PublishCancelInFullStoreTestCase cancel failed.");
+        }
+    }
+    advancedNotificationService_->notificationList_.Clear();
+}
+
+/**
+ * @tc.name: FlowControlInFullStoreTestCase
+ * @tc.desc: Evict a notification by flow control while the active notification list is full
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+BENCHMARK_F(BenchmarkNotificationService, FlowControlInFullStoreTestCase)(benchmark::State &state)
+{
+    const int32_t bundleNum = MAX_ACTIVE_NUM / MAX_ACTIVE_NUM_PERAPP;
+    int32_t notificationId = 0;
+    for (; notificationId < static_cast<int32_t>(MAX_ACTIVE_NUM); notificationId++) {
+        int32_t bundleIndex = notificationId % bundleNum;
+        advancedNotificationService_->notificationList_.Add(CreateNotificationRecord(
+            notificationId, "bundleName" + std::to_string(bundleIndex), 10000 + bundleIndex));
+    }
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        auto record = CreateNotificationRecord(notificationId++, "newBundleName", 20000);
+        advancedNotificationService_->flowControlTimestampCount_ = 0;
+        state.ResumeTiming();
+        ErrCode errCode = advancedNotificationService_->FlowControl(record);
+        if (errCode != ERR_OK || advancedNotificationService_->notificationList_.Size() != MAX_ACTIVE_NUM) {
+            state.SkipWithError("FlowControlInFullStoreTestCase failed.");
+        }
+    }
+    advancedNotificationService_->notificationList_.Clear();
+}
+
+/**
+ * @tc.name: QueryUnderPublishLoadTestCase
+ * @tc.desc: Query active notifications and slots from several threads while notifications are published and
+ *           canceled on the service handler. The argument is the number of query threads.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+BENCHMARK_DEFINE_F(BenchmarkNotificationService, QueryUnderPublishLoadTestCase)(benchmark::State &state)
+{
+    const int32_t queryThreadNum = static_cast<int32_t>(state.range(0));
+    const int32_t queryNum = 1000;
+    std::atomic<bool> stopped(false);
+    std::atomic<uint64_t> queryCount(0);
+
+    std::thread publisher([&]() {
+        int32_t notificationId = 0;
+        while (!stopped) {
+            auto record = CreateNotificationRecord(notificationId++ % MAX_ACTIVE_NUM_PERAPP, "bundleName", 10000);
+            advancedNotificationService_->handler_->PostSyncTask(std::bind([&]() {
+                advancedNotificationService_->AddToNotificationList(record);
+                sptr<OHOS::Notification::Notification> notification = nullptr;
+                advancedNotificationService_->RemoveFromNotificationList(
+                    record->notification->GetKey(), notification, true);
+            }));
+        }
+    });
+
+    while (state.KeepRunning()) {
+        std::vector<std::thread> queryThreads;
+        for (int32_t i = 0; i < queryThreadNum; i++) {
+            queryThreads.emplace_back([&]() {
+                for (int32_t j = 0; j < queryNum; j++) {
+                    uint64_t num = 0;
+                    advancedNotificationService_->GetActiveNotificationNums(num);
+                    std::vector<sptr<NotificationSlot>> slots;
+                    advancedNotificationService_->GetSlots(slots);
+                }
+                queryCount += queryNum;
+            });
+        }
+        for (auto &queryThread : queryThreads) {
+            queryThread.join();
+        }
+    }
+
+    stopped = true;
+    publisher.join();
+    state.counters["QueriesPerSecond"] =
+        benchmark::Counter(static_cast<double>(queryCount), benchmark::Counter::kIsRate);
+    advancedNotificationService_->notificationList_.Clear();
+}
+BENCHMARK_REGISTER_F(BenchmarkNotificationService, QueryUnderPublishLoadTestCase)
+    ->Arg(1)->Arg(4)->Arg(8)->UseRealTime();
+
+/**
+ * @tc.name: SetBundlePropertyTestCase
+ * @tc.desc: Set a property of one bundle while the preferences hold many bundles.
+ *           The argument is the number of bundles.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+BENCHMARK_DEFINE_F(BenchmarkNotificationService, SetBundlePropertyTestCase)(benchmark::State &state)
+{
+    const int32_t bundleNum = static_cast<int32_t>(state.range(0));
+    const int32_t slotNum = NotificationConstant::SlotType::CUSTOM + 1;
+    NotificationPreferences &preferences = NotificationPreferences::GetInstance();
+    for (int32_t i = 0; i < bundleNum; i++) {
+        NotificationPreferencesInfo::BundleInfo bundleInfo;
+        bundleInfo.SetBundleName("bundleName" + std::to_string(i));
+        bundleInfo.SetBundleUid(10000 + i);
+        for (int32_t type = 0; type < slotNum; type++) {
+            bundleInfo.SetSlot(new NotificationSlot(static_cast<NotificationConstant::SlotType>(type)));
+        }
+        preferences.preferencesInfo_.SetBundleInfo(bundleInfo);
+    }
+
+    sptr<NotificationBundleOption> bundleOption = new NotificationBundleOption("bundleName0", 10000);
+    bool enable = false;
+    while (state.KeepRunning()) {
+        enable = !enable;
+        if (preferences.SetShowBadge(bundleOption, enable) != ERR_OK) {
+            state.SkipWithError("SetBundlePropertyTestCase failed.");
+        }
+    }
+    preferences.preferencesInfo_.ClearBundleInfo();
+}
+BENCHMARK_REGISTER_F(BenchmarkNotificationService, SetBundlePropertyTestCase)
+    ->Arg(10)->Arg(100)->Arg(1000)->Arg(5000);
+
+/**
+ * @tc.name: SnoozeRecentReminderTestCase
+ * @tc.desc: Snooze the recent reminder, get the next recent reminder and check the limit of its application.
+ *           The argument is the number of reminders, 20 reminders per application.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+BENCHMARK_DEFINE_F(BenchmarkNotificationService, SnoozeRecentReminderTestCase)(benchmark::State &state)
+{
+    const int32_t reminderNum = static_cast<int32_t>(state.range(0));
+    const int32_t reminderNumPerApp = 20;
+    const uint64_t snoozeTimeInMilli = 5 * 60 * 1000;
+    time_t now;
+    (void)time(&now);
+    uint64_t baseTime = ReminderRequest::GetDurationSinceEpochInMilli(now) + snoozeTimeInMilli;
+    std::shared_ptr<ReminderDataManager> manager = std::make_shared<ReminderDataManager>();
+    manager->reminderMap_.clear();
+    manager->triggerQueue_.clear();
+    manager->appReminders_.clear();
+    for (int32_t i = 0; i < reminderNum; i++) {
+        sptr<ReminderRequest> reminder = new ReminderRequestTimer(i + 1);
+        reminder->SetTriggerTimeInMilli(baseTime + i);
+        int32_t app = i / reminderNumPerApp;
+        sptr<NotificationBundleOption> bundleOption =
+            new NotificationBundleOption("bundleName" + std::to_string(app), 10000 + app);
+        manager->AddToIndexes(reminder, bundleOption);
+    }
+
+    sptr<NotificationBundleOption> bundleOption = new NotificationBundleOption("bundleName0", 10000);
+    while (state.KeepRunning()) {
+        sptr<ReminderRequest> reminder = manager->GetRecentReminderLocked();
+        if (reminder == nullptr) {
+            state.SkipWithError("SnoozeRecentReminderTestCase failed.");
+            break;
+        }
+        reminder->SetTriggerTimeInMilli(reminder->GetTriggerTimeInMilli() + snoozeTimeInMilli);
+        manager->CheckReminderLimitExceededLocked(bundleOption);
+    }
+}
+BENCHMARK_REGISTER_F(BenchmarkNotificationService, SnoozeRecentReminderTestCase)
+    ->Arg(100)->Arg(2000);
+
+/**
+ * @tc.name: LoadReminderFromDbTestCase
+ * @tc.desc: Load the reminders at boot. The first argument is the number of reminders, the second one is 0 to
+ *           build every reminder from the database as before, 1 to load the schedule only.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+BENCHMARK_DEFINE_F(BenchmarkNotificationService, LoadReminderFromDbTestCase)(benchmark::State &state)
+{
+    const int32_t reminderNum = static_cast<int32_t>(state.range(0));
+    const bool scheduleOnly = (state.range(1) != 0);
+    const int32_t hours = 24;
+    const int32_t minutes = 60;
+    const std::string dbDir = "/data/test/";
+    const std::string dbName = "reminder_benchmark.db";
+    NativeRdb::RdbHelper::DeleteRdbStore(dbDir + dbName);
+    std::shared_ptr<ReminderDataManager> manager = std::make_shared<ReminderDataManager>();
+    manager->store_ = std::make_shared<ReminderStore>();
+    if (manager->store_->Init(dbDir, dbName) != ReminderStore::STATE_OK) {
+        state.SkipWithError("LoadReminderFromDbTestCase init store failed.");
+        return;
+    }
+    sptr<NotificationBundleOption> bundleOption = new NotificationBundleOption("benchmarkBundle", 10000);
+    for (int32_t i = 0; i < reminderNum; i++) {
+        sptr<ReminderRequest> reminder = new ReminderRequestAlarm(
+            static_cast<uint8_t>((i / minutes) % hours), static_cast<uint8_t>(i % minutes), {});
+        reminder->InitReminderId();
+        manager->store_->UpdateOrInsert(reminder, bundleOption);
+    }
+    manager->store_->Flush();
+
+    while (state.KeepRunning()) {
+        manager->reminderMap_.clear();
+        manager->triggerQueue_.clear();
+        manager->appReminders_.clear();
+        manager->notificationBundleOptionMap_.clear();
+        if (scheduleOnly) {
+            manager->LoadReminderFromDb();
+            continue;
+        }
+        // The former LoadReminderFromDb, every reminder is built and its bundle option is queried one by one.
+        std::lock_guard<std::mutex> lock(ReminderDataManager::MUTEX);
+        std::vector<sptr<ReminderRequest>> existReminders = manager->store_->GetAllValidReminders();
+        for (auto &reminder : existReminders) {
+            sptr<NotificationBundleOption> option = new (std::nothrow) NotificationBundleOption();
+            int32_t reminderId = reminder->GetReminderId();
+            if (!(manager->store_->GetBundleOption(reminderId, option))) {
+                continue;
+            }
+            manager->notificationBundleOptionMap_.insert(
+                std::pair<int32_t, sptr<NotificationBundleOption>>(reminderId, option));
+        }
+        benchmark::DoNotOptimize(existReminders);
+        ReminderRequest::GLOBAL_ID = manager->store_->GetMaxId() + 1;
+    }
+    manager->store_ = nullptr;
+    NativeRdb::RdbHelper::DeleteRdbStore(dbDir + dbName);
+}
+BENCHMARK_REGISTER_F(BenchmarkNotificationService, LoadReminderFromDbTestCase)
+    ->Args({2000, 0})->Args({2000, 1});
+
+/**
+ * @tc.name: RefreshCalendarRemindersTestCase
+ * @tc.desc: Refresh the calendar reminders after the time zone changes. The first argument is the number of
+ *           reminders, the second one is 1 to refresh them in one pass sharing the local time, 0 otherwise.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+BENCHMARK_DEFINE_F(BenchmarkNotificationService, RefreshCalendarRemindersTestCase)(benchmark::State &state)
+{
+    const int32_t reminderNum = static_cast<int32_t>(state.range(0));
+    const bool inPass = (state.range(1) != 0);
+    const int32_t minutes = 60;
+    time_t now;
+    (void)time(&now);
+    struct tm dateTime;
+    (void)localtime_r(&now, &dateTime);
+    std::vector<uint8_t> repeatMonths = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    std::vector<uint8_t> repeatDays = {31};
+    std::vector<sptr<ReminderRequest>> reminders;
+    for (int32_t i = 0; i < reminderNum; i++) {
+        dateTime.tm_min = i % minutes;
+        reminders.push_back(new ReminderRequestCalendar(dateTime, repeatMonths, repeatDays));
+    }
+
+    while (state.KeepRunning()) {
+        if (inPass) {
+            ReminderRequestCalendar::RefreshPass pass;
+            for (auto &reminder : reminders) {
+                reminder->OnTimeZoneChange();
+            }
+        } else {
+            for (auto &reminder : reminders) {
+                reminder->OnTimeZoneChange();
+            }
+        }
+    }
+}
+BENCHMARK_REGISTER_F(BenchmarkNotificationService, RefreshCalendarRemindersTestCase)
+    ->Args({2000, 0})->Args({2000, 1});
+
+/**
+ * @tc.name: ParsePreferencesFromDbTestCase
+ * @tc.desc: Load the preferences at service start. The argument is the number of bundles, 6 slots per bundle.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+BENCHMARK_DEFINE_F(BenchmarkNotificationService, ParsePreferencesFromDbTestCase)(benchmark::State &state)
+{
+    const int32_t bundleNum = static_cast<int32_t>(state.range(0));
+    const int32_t slotNum = NotificationConstant::SlotType::CUSTOM + 1;
+    std::unique_ptr<NotificationPreferencesDatabase> &database = NotificationPreferences::GetInstance().preferncesDB_;
+    std::vector<sptr<NotificationSlot>> slots;
+    for (int32_t type = 0; type < slotNum; type++) {
+        slots.push_back(new NotificationSlot(static_cast<NotificationConstant::SlotType>(type)));
+    }
+    for (int32_t i = 0; i < bundleNum; i++) {
+        if (!database->PutSlotsToDisturbeDB("benchmarkBundle" + std::to_string(i), 10000 + i, slots)) {
+            state.SkipWithError("ParsePreferencesFromDbTestCase failed.");
+        }
+    }
+
+    while (state.KeepRunning()) {
+        NotificationPreferencesInfo info;
+        if (!database->ParseFromDisturbeDB(info)) {
+            state.SkipWithError("ParsePreferencesFromDbTestCase failed.");
+        }
+    }
+    for (int32_t i = 0; i < bundleNum; i++) {
+        database->RemoveBundleFromDisturbeDB("benchmarkBundle" + std::to_string(i) + std::to_string(10000 + i));
+    }
+}
+BENCHMARK_REGISTER_F(BenchmarkNotificationService, ParsePreferencesFromDbTestCase)->Arg(5000);
+
+/**
+ * @tc.name: PreferencesFormatTestCase
+ * @tc.desc: Load the bundles of the preferences stored in a format, without migrating them. The arguments are the
+ *           number of bundles with 6 slots each, and the format, 0 for one entry per property, 1 for the records.
+ *           The entries and bytes counters report the size of the store.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+BENCHMARK_DEFINE_F(BenchmarkNotificationService, PreferencesFormatTestCase)(benchmark::State &state)
+{
+    const int32_t bundleNum = static_cast<int32_t>(state.range(0));
+    const bool isRecord = (state.range(1) != 0);
+    const int32_t slotNum = NotificationConstant::SlotType::CUSTOM + 1;
+    std::unique_ptr<NotificationPreferencesDatabase> &database = NotificationPreferences::GetInstance().preferncesDB_;
+    if (!database->CheckKvStore()) {
+        state.SkipWithError("PreferencesFormatTestCase failed.");
+        return;
+    }
+    std::vector<DistributedKv::Entry> entries;
+    for (int32_t i = 0; i < bundleNum; i++) {
+        std::string bundleName = "benchmarkBundle" + std::to_string(i);
+        if (isRecord) {
+            NotificationPreferencesInfo::BundleInfo bundleInfo;
+            bundleInfo.SetBundleName(bundleName);
+            bundleInfo.SetBundleUid(10000 + i);
+            for (int32_t type = 0; type < slotNum; type++) {
+                bundleInfo.SetSlot(new NotificationSlot(static_cast<NotificationConstant::SlotType>(type)));
+            }
+            std::string bundleKey = bundleName + std::to_string(10000 + i);
+            AddEntry(KEY_BUNDLE_LABEL + bundleKey, bundleKey, entries);
+            database->GenerateRecordEntries(bundleKey, bundleInfo, entries);
+        } else {
+            GenerateLegacyBundleEntries(*database, bundleName, 10000 + i, slotNum, entries);
+        }
+    }
+    size_t bytes = 0;
+    for (auto &entry : entries) {
+        bytes += entry.key.Size() + entry.value.Size();
+    }
+    if (database->kvStorePtr_->PutBatch(entries) != DistributedKv::Status::SUCCESS) {
+        state.SkipWithError("PreferencesFormatTestCase failed.");
+    }
+
+    while (state.KeepRunning()) {
+        std::vector<DistributedKv::Entry> labelEntries;
+        std::vector<DistributedKv::Entry> bundleEntries;
+        database->kvStorePtr_->GetEntries(DistributedKv::Key(KEY_BUNDLE_LABEL), labelEntries);
+        database->kvStorePtr_->GetEntries(DistributedKv::Key(KEY_ANS_BUNDLE + KEY_UNDER_LINE), bundleEntries);
+        NotificationPreferencesInfo info;
+        std::vector<DistributedKv::Entry> recordEntries;
+        std::vector<DistributedKv::Key> legacyKeys;
+        database->ParseBundleFromDistureDB(info, labelEntries, bundleEntries, recordEntries, legacyKeys);
+    }
+    state.counters["entries"] = entries.size();
+    state.counters["bytes"] = bytes;
+    for (int32_t i = 0; i < bundleNum; i++) {
+        std::string bundleKey = "benchmarkBundle" + std::to_string(i) + std::to_string(10000 + i);
+        database->RemoveBundleFromDisturbeDB(bundleKey);
+        database->kvStorePtr_->Delete(DistributedKv::Key(KEY_BUNDLE_LABEL + bundleKey));
+    }
+}
+BENCHMARK_REGISTER_F(BenchmarkNotificationService, PreferencesFormatTestCase)->Args({5000, 0})->Args({5000, 1});
+
+/**
+ * @tc.name: DistributedImagesTestCase
+ * @tc.desc: Encode a picture notification for the distributed database, the app icon is the same in all of them and
+ *           the picture is new in each. The argument is the format, 0 for the images in hexadecimal in the json,
+ *           1 for the images as binary entries keyed by content. The bytesPerPublish counter reports the bytes put
+ *           to the database, the entries of the images already put are not put again.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+BENCHMARK_DEFINE_F(BenchmarkNotificationService, DistributedImagesTestCase)(benchmark::State &state)
+{
+    const bool isAttachment = (state.range(0) != 0);
+    const int32_t iconSize = 192;
+    const int32_t pictureSize = 512;
+    const uint32_t iconColor = 0xff3366cc;
+    std::shared_ptr<Media::PixelMap> icon = CreatePixelMap(iconSize, iconColor);
+    if (icon == nullptr) {
+        state.SkipWithError("DistributedImagesTestCase failed.");
+        return;
+    }
+    std::set<std::string> putImages;
+    size_t bytes = 0;
+    uint32_t pictureColor = 0;
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        sptr<NotificationRequest> request = new NotificationRequest(1);
+        request->SetLittleIcon(icon);
+        request->SetBigIcon(icon);
+        std::shared_ptr<NotificationPictureContent> pictureContent = std::make_shared<NotificationPictureContent>();
+        pictureContent->SetTitle("title");
+        pictureContent->SetText("text");
+        pictureContent->SetBigPicture(CreatePixelMap(pictureSize, pictureColor++));
+        request->SetContent(std::make_shared<NotificationContent>(pictureContent));
+        state.ResumeTiming();
+
+        std::string value;
+        AnsImageUtil::ImageAttachments attachments;
+        if (isAttachment) {
+            AnsImageUtil::AttachmentScope scope(attachments);
+            NotificationJsonConverter::ConvertToJsonString(request, value);
+        } else {
+            NotificationJsonConverter::ConvertToJsonString(request, value);
+        }
+        bytes += value.size();
+        for (auto &image : attachments.images) {
+            if (putImages.insert(image.first).second) {
+                bytes += image.second.size();
+            }
+        }
+    }
+    state.counters["bytesPerPublish"] = benchmark::Counter(bytes, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_REGISTER_F(BenchmarkNotificationService, DistributedImagesTestCase)->Arg(0)->Arg(1);
+
+/**
+ * @tc.name: DistributedRecordFormatTestCase
+ * @tc.desc: Encode and decode a long text notification as a distributed database record. The argument is the format,
+ *           0 for the json, 1 for the binary. The bytesPerRecord counter reports the size of the record.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+BENCHMARK_DEFINE_F(BenchmarkNotificationService, DistributedRecordFormatTestCase)(benchmark::State &state)
+{
+    const bool isBinary = (state.range(0) != 0);
+    std::shared_ptr<NotificationLongTextContent> longTextContent =
+        std::make_shared<NotificationLongTextContent>(std::string(256, 'l'));
+    longTextContent->SetTitle("title");
+    longTextContent->SetText("text");
+    longTextContent->SetBriefText("brief text");
+    longTextContent->SetExpandedTitle("expanded title");
+    sptr<NotificationRequest> request = new NotificationRequest(1);
+    request->SetLabel("label");
+    request->SetCreatorBundleName("bundleName");
+    request->SetOwnerBundleName("bundleName");
+    request->SetSlotType(NotificationConstant::SlotType::SOCIAL_COMMUNICATION);
+    request->SetDeliveryTime(1650000000000);
+    request->SetDistributed(true);
+    request->SetContent(std::make_shared<NotificationContent>(longTextContent));
+
+    size_t bytes = 0;
+    while (state.KeepRunning()) {
+        std::string value;
+        std::unique_ptr<NotificationRequest> result;
+        if (isBinary) {
+            NotificationBinaryConverter::ConvertToBinaryString(request, value);
+            result.reset(NotificationBinaryConverter::ConvertFromBinaryString<NotificationRequest>(value));
+        } else {
+            NotificationJsonConverter::ConvertToJsonString(request, value);
+            result.reset(NotificationJsonConverter::ConvertFromJsonString<NotificationRequest>(value));
+        }
+        if (result == nullptr) {
+            state.SkipWithError("DistributedRecordFormatTestCase failed.");
+            return;
+        }
+        bytes += value.size();
+    }
+    state.counters["bytesPerRecord"] = benchmark::Counter(bytes, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_REGISTER_F(BenchmarkNotificationService, DistributedRecordFormatTestCase)->Arg(0)->Arg(1);
+
+#ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
+/**
+ * @tc.name: RemindTypeTestCase
+ * @tc.desc: Publish a notification with simulated peer devices connected, the remind type of the notification depends
+ *           on their screen status. The first argument is the number of peers, the second how their screen status is
+ *           obtained, 0 for querying the database on each publish, 1 for the status kept in memory.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+BENCHMARK_DEFINE_F(BenchmarkNotificationService, RemindTypeTestCase)(benchmark::State &state)
+{
+    const int32_t peerNum = state.range(0);
+    const bool isCached = (state.range(1) != 0);
+    std::shared_ptr<DistributedScreenStatusManager> screenStatusManager =
+        DistributedScreenStatusManager::GetInstance();
+    bool isUsing = false;
+    screenStatusManager->CheckRemoteDevicesIsUsing(isUsing);
+
+    std::vector<std::string> peers;
+    for (int32_t i = 0; i < peerNum; i++) {
+        std::string deviceId = "<peerDeviceId" + std::to_string(i) + ">";
+        std::string key = deviceId + "|screen_status";
+        // In the database too, so that the query finds them.
+        if (screenStatusManager->kvStore_ != nullptr) {
+            screenStatusManager->kvStore_->Put(DistributedKv::Key(key), DistributedKv::Value("off"));
+        }
+        screenStatusManager->OnDeviceConnected(deviceId);
+        screenStatusManager->OnRemoteScreenStatusChanged(deviceId, key, "off");
+        peers.push_back(deviceId);
+    }
+
+    sptr<NotificationRequest> req = new (std::nothrow) NotificationRequest(1);
+    req->SetSlotType(NotificationConstant::SlotType::OTHER);
+    std::shared_ptr<NotificationNormalContent> normalContent = std::make_shared<NotificationNormalContent>();
+    normalContent->SetText("normalContent's text");
+    normalContent->SetTitle("normalContent's title");
+    req->SetContent(std::make_shared<NotificationContent>(normalContent));
+    std::string label = "publish's label";
+    while (state.KeepRunning()) {
+        if (!isCached) {
+            state.PauseTiming();
+            screenStatusManager->remoteStatusLoaded_ = false;
+            screenStatusManager->KvManagerFlowControlClear();
+            screenStatusManager->KvStoreFlowControlClear();
+            state.ResumeTiming();
+        }
+        ErrCode errCode = advancedNotificationService_->Publish(label, req);
+        if (errCode != ERR_OK) {
+            state.SkipWithError("RemindTypeTestCase failed.");
+        }
+    }
+
+    for (auto &deviceId : peers) {
+        if (screenStatusManager->kvStore_ != nullptr) {
+            screenStatusManager->kvStore_->Delete(DistributedKv::Key(deviceId + "|screen_status"));
+        }
+        screenStatusManager->onlineDevices_.erase(deviceId);
+    }
+    screenStatusManager->remoteStatusLoaded_ = false;
+}
+BENCHMARK_REGISTER_F(BenchmarkNotificationService, RemindTypeTestCase)
+    ->Args({0, 0})->Args({0, 1})->Args({1, 0})->Args({1, 1})->Args({5, 0})->Args({5, 1});
+
+/**
+ * @tc.name: DistributedWriteBurstTestCase
+ * @tc.desc: Write a burst of updates of 10 distributed notifications to the distributed database. The first argument
+ *           is the number of updates, the second how they are written, 0 for one put each, 1 for the batched writer.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+BENCHMARK_DEFINE_F(BenchmarkNotificationService, DistributedWriteBurstTestCase)(benchmark::State &state)
+{
+    const int32_t updateNum = state.range(0);
+    const bool isBatched = (state.range(1) != 0);
+    const int32_t keyNum = 10;
+    DistributedDatabaseCallback::IDatabaseChange databaseCallback;
+    DistributedDeviceCallback::IDeviceChange deviceCallback;
+    std::shared_ptr<DistributedDatabase> database = std::make_shared<DistributedDatabase>(
+        std::make_shared<DistributedDatabaseCallback>(databaseCallback),
+        std::make_shared<DistributedDeviceCallback>(deviceCallback));
+    // Flushed once per burst, as the flush interval would.
+    std::shared_ptr<DistributedNotificationWriter> writer =
+        std::make_shared<DistributedNotificationWriter>(nullptr, 0);
+    writer->SetDatabase(database);
+
+    std::string value(512, 'v');
+    int64_t transactions = 0;
+    int64_t rejected = 0;
+    while (state.KeepRunning()) {
+        uint64_t batches = writer->GetStats().batches;
+        for (int32_t i = 0; i < updateNum; i++) {
+            std::string key = "<deviceId>|<bundleName>|<label>|" + std::to_string(i % keyNum);
+            if (isBatched) {
+                writer->Put(key, value);
+            } else if (database->PutToDistributedDB(key, value)) {
+                transactions++;
+            } else {
+                rejected++;
+            }
+        }
+        if (isBatched) {
+            writer->Flush();
+            transactions += static_cast<int64_t>(writer->GetStats().batches - batches);
+        }
+    }
+    state.counters["transactionsPerBurst"] = benchmark::Counter(transactions, benchmark::Counter::kAvgIterations);
+    state.counters["rejectedPerBurst"] = benchmark::Counter(rejected, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_REGISTER_F(BenchmarkNotificationService, DistributedWriteBurstTestCase)
+    ->Args({10, 0})->Args({10, 1})->Args({100, 0})->Args({100, 1});
+
+/**
+ * @tc.name: DistributedRateLimiterTestCase
+ * @tc.desc: Check the flow control of the distributed database calls at a sustained rate, the argument is the number
+ *           of calls per second. The calls are timed on a simulated clock, so that the rates over the limits are
+ *           reached, and the cost of a check does not depend on the number of calls in the window.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+BENCHMARK_DEFINE_F(BenchmarkNotificationService, DistributedRateLimiterTestCase)(benchmark::State &state)
+{
+    const int64_t callsPerSecond = state.range(0);
+    const size_t secondMaxinum = 1000;
+    const size_t minuteMaxinum = 10000;
+    DistributedRateLimiter limiter(secondMaxinum, minuteMaxinum);
+    DistributedRateLimiter::Clock::time_point now(std::chrono::hours(1));
+    std::chrono::nanoseconds interval = std::chrono::nanoseconds(std::chrono::seconds(1)) / callsPerSecond;
+
+    int64_t allowed = 0;
+    while (state.KeepRunning()) {
+        now += interval;
+        if (limiter.TryAcquire(now)) {
+            allowed++;
+        }
+    }
+    state.counters["allowedRate"] = benchmark::Counter(allowed, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_REGISTER_F(BenchmarkNotificationService, DistributedRateLimiterTestCase)
+    ->Arg(10)->Arg(100)->Arg(1000)->Arg(100000);
+
+/**
+ * @tc.name: DistributedConvertRecordsTestCase
+ * @tc.desc: Convert the records of the remote notifications synchronized on a device reconnection. The arguments are
+ *           the number of records and the mode, 0 for one record after the other, 1 for the records converted by
+ *           several threads.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+BENCHMARK_DEFINE_F(BenchmarkNotificationService, DistributedConvertRecordsTestCase)(benchmark::State &state)
+{
+    const int64_t recordNum = state.range(0);
+    const bool isParallel = (state.range(1) != 0);
+    std::shared_ptr<DistributedNotificationManager> manager = DistributedNotificationManager::GetInstance();
+    std::vector<DistributedNotificationManager::RemoteRecord> records(recordNum);
+    for (int64_t i = 0; i < recordNum; i++) {
+        std::shared_ptr<NotificationLongTextContent> longTextContent =
+            std::make_shared<NotificationLongTextContent>(std::string(256, 'l'));
+        longTextContent->SetTitle("title");
+        longTextContent->SetText("text");
+        sptr<NotificationRequest> request = new NotificationRequest(i);
+        request->SetLabel("label");
+        request->SetContent(std::make_shared<NotificationContent>(longTextContent));
+        NotificationJsonConverter::ConvertToJsonString(request, records[i].value);
+        records[i].resolveKey.deviceId = "<remoteDeviceId>";
+        records[i].resolveKey.bundleName = "bundleName";
+    }
+
+    const std::map<std::string, std::string> images;
+    while (state.KeepRunning()) {
+        if (isParallel) {
+            manager->ConvertToRequests(records, images);
+        } else {
+            for (auto &record : records) {
+                record.request = manager->ConvertToRequest(record.resolveKey.deviceId, record.value, &images);
+            }
+        }
+        if (records.back().request == nullptr) {
+            state.SkipWithError("DistributedConvertRecordsTestCase failed.");
+            return;
+        }
+    }
+}
+BENCHMARK_REGISTER_F(BenchmarkNotificationService, DistributedConvertRecordsTestCase)
+    ->Args({8, 0})->Args({8, 1})->Args({64, 0})->Args({64, 1});
+#endif
 }
 
 // Run the benchmark
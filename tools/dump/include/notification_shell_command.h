@@ -46,6 +46,8 @@ private:
     ErrCode RunHelp();
     ErrCode RunActive(std::vector<std::string> &infos);
     ErrCode RunRecent(std::vector<std::string> &infos);
+    ErrCode RunSubscriber(std::vector<std::string> &infos);
+    ErrCode RunImageCache(std::vector<std::string> &infos);
 #ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
     ErrCode RunDistributed(std::vector<std::string> &infos);
 #endif
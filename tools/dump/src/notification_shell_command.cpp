@@ -29,10 +29,13 @@ static const struct option OPTIONS[] = {
     {"help", no_argument, nullptr, 'h'},
     {"active", no_argument, nullptr, 'A'},
     {"recent", no_argument, nullptr, 'R'},
+    {"subscriber", no_argument, nullptr, 'S'},
+    {"imageCache", no_argument, nullptr, 'I'},
 #ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
     {"distributed", no_argument, nullptr, 'D'},
 #endif
     {"setRecentCount", required_argument, nullptr, 0},
+    {"setSubscriberQueue", required_argument, nullptr, 0},
     {0, 0, 0, 0},
 };
 
@@ -46,10 +49,14 @@ static const std::string DUMP_HELP_MSG =
     "  --help, -h                   help menu\n"
     "  --active, -A                 list all active notifications\n"
     "  --recent, -R                 list recent notifications\n"
+    "  --subscriber, -S             list all subscribers with the state of their delivery queues\n"
+    "  --imageCache, -I             show the memory used by the shared notification images\n"
 #ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
     "  --distributed, -D            list all distributed notifications by remote device\n"
 #endif
-    "  --setRecentCount <N>         set the max count of recent notifications keeping in memory\n";
+    "  --setRecentCount <N>         set the max count of recent notifications keeping in memory\n"
+    "  --setSubscriberQueue <N>,<P> set the capacity and the overflow policy of subscriber delivery queues,\n"
+    "                               the policy is coalesce, dropOldest or disconnect\n";
 }  // namespace
 
 NotificationShellCommand::NotificationShellCommand(int argc, char *argv[]) : ShellCommand(argc, argv, "anm_dump")
@@ -123,6 +130,29 @@ ErrCode NotificationShellCommand::RunRecent(std::vector<std::string> &infos)
     return ret;
 }
 
+ErrCode NotificationShellCommand::RunSubscriber(std::vector<std::string> &infos)
+{
+    ErrCode ret = ERR_OK;
+    if (ans_ != nullptr) {
+        ret = ans_->ShellDump("subscriber", infos);
+        resultReceiver_.append("Total:" + std::to_string(infos.size()) + "\n");
+    } else {
+        ret = ERR_ANS_SERVICE_NOT_CONNECTED;
+    }
+    return ret;
+}
+
+ErrCode NotificationShellCommand::RunImageCache(std::vector<std::string> &infos)
+{
+    ErrCode ret = ERR_OK;
+    if (ans_ != nullptr) {
+        ret = ans_->ShellDump("imageCache", infos);
+    } else {
+        ret = ERR_ANS_SERVICE_NOT_CONNECTED;
+    }
+    return ret;
+}
+
 #ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
 ErrCode NotificationShellCommand::RunDistributed(std::vector<std::string> &infos)
 {
@@ -141,9 +171,9 @@ ErrCode NotificationShellCommand::RunAsDumpCommand()
 {
     int ind = 0;
 #ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
-    int option = getopt_long(argc_, argv_, "hARD", OPTIONS, &ind);
+    int option = getopt_long(argc_, argv_, "hARSID", OPTIONS, &ind);
 #else
-    int option = getopt_long(argc_, argv_, "hAR", OPTIONS, &ind);
+    int option = getopt_long(argc_, argv_, "hARSI", OPTIONS, &ind);
 #endif
 
     ErrCode ret = ERR_OK;
@@ -159,6 +189,12 @@ ErrCode NotificationShellCommand::RunAsDumpCommand()
         case 'R':
             ret = RunRecent(infos);
             break;
+        case 'S':
+            ret = RunSubscriber(infos);
+            break;
+        case 'I':
+            ret = RunImageCache(infos);
+            break;
 #ifdef DISTRIBUTED_NOTIFICATION_SUPPORTED
         case 'D':
             ret = RunDistributed(infos);